@@ -1,6 +1,15 @@
 #include "Application.h"
-#include <iostream>
+#include "Runtime/EngineCore/Core/Log.h"
+#include "RHI/BlockCompressor.h"
+#include "RHI/GltfImporter.h"
+#include "RHI/Ktx2File.h"
+#include "RHI/MeshOptimizer.h"
+#include "RHI/MeshletBuilder.h"
+#include "RHI/TextureDecoder.h"
+#include "RHI/VertexWelder.h"
+#include "Rendering/RenderGraph.h"
 #include <chrono>
+#include <vector>
 Application::Application()
 {
 }
@@ -11,27 +20,97 @@ Application::~Application()
 
 void Application::Run()
 {
+    // Messages logged before this point or after shutdown are written synchronously
+    Log::initialize();
+    for (size_t i = 0; i + 1 < m_Arguments.size(); ++i)
+    {
+        if (m_Arguments[i] == "--benchmark")
+        {
+            m_ExitCode = RunBenchmarks(m_Arguments[i + 1]) ? 0 : 1;
+            Log::shutdown();
+            return;
+        }
+    }
     InitializeWindow();
     InitializeEngine();
     MainLoop();
     Cleanup();
+    Log::shutdown();
+}
+
+void Application::SetCommandLine(int argc, char** argv)
+{
+    m_Arguments.assign(argv, argv + argc);
+}
+
+bool Application::RunBenchmarks(const std::string& folder)
+{
+    CAE_LOG_INFO(Core, "Running benchmarks on " << folder);
+    try
+    {
+        // Every self-check runs even after one fails, so a single run reports all of them
+        bool passed = BlockCompressor::runSelfCheck();
+        passed = Ktx2File::runSelfCheck() && passed;
+        passed = RenderGraph::RunSelfCheck() && passed;
+        if (!passed)
+        {
+            CAE_LOG_ERROR(Core, "Benchmark self-checks failed");
+        }
+
+        GltfImporter::runBenchmark(folder);
+        VertexWelder::runBenchmark(folder);
+        MeshOptimizer::runBenchmark(folder);
+        MeshletBuilder::runBenchmark(folder);
+        TextureDecoder::runBenchmark(folder);
+        RunLogBenchmark(folder);
+        return passed;
+    }
+    catch (const std::exception& e)
+    {
+        CAE_LOG_ERROR(Core, "Benchmark failed: " << e.what());
+        return false;
+    }
+}
+
+void Application::RunLogBenchmark(const std::string& folder)
+{
+    // Logging overhead of a real load: every scene in the folder imported, with the importer's per-primitive output
+    const std::vector<std::string> scenes = GltfImporter::findScenes(folder);
+    if (scenes.empty())
+    {
+        CAE_LOG_INFO(Core, "Log benchmark: no scenes in " << folder);
+        return;
+    }
+
+    Log::runBenchmark("glTF import of " + folder, [&scenes]()
+    {
+        for (const std::string& scene : scenes)
+        {
+            std::vector<Vertex> vertices;
+            std::vector<uint32_t> indices;
+            std::vector<Submesh> submeshes;
+            std::vector<MaterialDesc> materials;
+            GltfImporter importer(scene);
+            importer.import(vertices, indices, submeshes, materials);
+        }
+    });
 }
 
 void Application::InitializeWindow()
 {
-    std::cout << "Creating window..." << std::endl;
+    CAE_LOG_INFO(Core, "Creating window...");
     m_Window = new Window("CreationArtEngine", 800, 600);
-    std::cout << "Window created successfully!" << std::endl;
+    CAE_LOG_INFO(Core, "Window created successfully!");
 }
 
 void Application::InitializeEngine()
 {
-    std::cout << "Initializing engine..." << std::endl;
+    CAE_LOG_INFO(Core, "Initializing engine...");
     m_Engine = std::make_unique<GameEngine>();
     
-    std::cout << "Initializing engine with window..." << std::endl;
+    CAE_LOG_INFO(Core, "Initializing engine with window...");
     m_Engine->Initialize(m_Window);
-    std::cout << "Engine initialized successfully!" << std::endl;
+    CAE_LOG_INFO(Core, "Engine initialized successfully!");
 }
 
 void Application::MainLoop()
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <vector>
 #include "Window.h"
 #include "GameEngine.h"
 
@@ -15,6 +17,11 @@ public:
 	void MainLoop();
 	void Cleanup();
 
+	// "--benchmark <folder>" makes Run() benchmark the assets in folder and return without opening a window
+	void SetCommandLine(int argc, char** argv);
+	// Process exit code after Run(): nonzero when a benchmark self-check failed or a benchmark threw
+	int GetExitCode() const { return m_ExitCode; }
+
 	float GetCurrentFrameTime() { return CurrentFrameTime; };
 	float GetLastFrameTime() { return LastFrameTime; };
 	float GetElapsedTime() { return ElapsedTime; };
@@ -25,10 +32,15 @@ private:
 	//Window
 	void InitializeWindow();
 	void InitializeEngine();
+	// False when a self-check failed or a benchmark threw
+	bool RunBenchmarks(const std::string& folder);
+	void RunLogBenchmark(const std::string& folder);
 
 private:
 	Window* m_Window;
 	std::unique_ptr<GameEngine> m_Engine;
+	std::vector<std::string> m_Arguments;
+	int m_ExitCode = 0;
 
 	float CurrentFrameTime = 0.0f;
 	float LastFrameTime = 0.0f;
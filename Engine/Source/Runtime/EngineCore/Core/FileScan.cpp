@@ -0,0 +1,20 @@
+#include "FileScan.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+
+std::vector<std::string> findFiles(const std::string& folder, std::initializer_list<std::string_view> extensions)
+{
+    std::vector<std::string> paths;
+    for (const auto& entry : std::filesystem::directory_iterator(folder))
+    {
+        std::string extension = entry.path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (entry.is_regular_file() && std::find(extensions.begin(), extensions.end(), extension) != extensions.end())
+        {
+            paths.push_back(entry.path().string());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Regular files directly inside folder whose extension is one of extensions, given lowercase with
+// the dot (".png"). The comparison ignores case. Paths are sorted so every run visits them in the
+// same order.
+std::vector<std::string> findFiles(const std::string& folder, std::initializer_list<std::string_view> extensions);
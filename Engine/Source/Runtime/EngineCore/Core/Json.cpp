@@ -0,0 +1,345 @@
+#include "Json.h"
+#include <charconv>
+#include <stdexcept>
+
+namespace
+{
+    const JsonValue s_NullValue{};
+    const std::string s_EmptyString{};
+}
+
+class JsonParser
+{
+public:
+    JsonParser(const char* begin, const char* end)
+        : m_pCursor(begin), m_pBegin(begin), m_pEnd(end)
+    {
+    }
+
+    JsonValue parseDocument()
+    {
+        JsonValue value = parseValue(0);
+        skipWhitespace();
+        if (m_pCursor != m_pEnd)
+        {
+            fail("Unexpected trailing characters");
+        }
+        return value;
+    }
+
+private:
+    static constexpr int MaxDepth = 256;
+
+    [[noreturn]] void fail(const char* message) const
+    {
+        throw std::runtime_error(std::string("JSON parse error at offset ") +
+            std::to_string(m_pCursor - m_pBegin) + ": " + message);
+    }
+
+    void skipWhitespace()
+    {
+        while (m_pCursor != m_pEnd && (*m_pCursor == ' ' || *m_pCursor == '\t' || *m_pCursor == '\n' || *m_pCursor == '\r'))
+        {
+            ++m_pCursor;
+        }
+    }
+
+    bool consume(char expected)
+    {
+        skipWhitespace();
+        if (m_pCursor != m_pEnd && *m_pCursor == expected)
+        {
+            ++m_pCursor;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char expected)
+    {
+        if (!consume(expected))
+        {
+            fail("Unexpected character");
+        }
+    }
+
+    bool matchLiteral(const char* literal)
+    {
+        const char* cursor = m_pCursor;
+        for (; *literal; ++literal, ++cursor)
+        {
+            if (cursor == m_pEnd || *cursor != *literal)
+            {
+                return false;
+            }
+        }
+        m_pCursor = cursor;
+        return true;
+    }
+
+    JsonValue parseValue(int depth)
+    {
+        if (depth > MaxDepth)
+        {
+            fail("Nesting too deep");
+        }
+
+        skipWhitespace();
+        if (m_pCursor == m_pEnd)
+        {
+            fail("Unexpected end of input");
+        }
+
+        JsonValue value;
+        switch (*m_pCursor)
+        {
+        case '{':
+            value.m_Type = JsonValue::Type::Object;
+            ++m_pCursor;
+            if (consume('}'))
+            {
+                break;
+            }
+            do
+            {
+                skipWhitespace();
+                value.m_Keys.push_back(parseString());
+                expect(':');
+                value.m_Values.push_back(parseValue(depth + 1));
+            } while (consume(','));
+            expect('}');
+            break;
+        case '[':
+            value.m_Type = JsonValue::Type::Array;
+            ++m_pCursor;
+            if (consume(']'))
+            {
+                break;
+            }
+            do
+            {
+                value.m_Values.push_back(parseValue(depth + 1));
+            } while (consume(','));
+            expect(']');
+            break;
+        case '"':
+            value.m_Type = JsonValue::Type::String;
+            value.m_String = parseString();
+            break;
+        case 't':
+        case 'f':
+            value.m_Type = JsonValue::Type::Bool;
+            if (matchLiteral("true"))
+            {
+                value.m_Bool = true;
+            }
+            else if (!matchLiteral("false"))
+            {
+                fail("Invalid literal");
+            }
+            break;
+        case 'n':
+            if (!matchLiteral("null"))
+            {
+                fail("Invalid literal");
+            }
+            break;
+        default:
+            value.m_Type = JsonValue::Type::Number;
+            value.m_Number = parseNumber();
+            break;
+        }
+        return value;
+    }
+
+    double parseNumber()
+    {
+        double number = 0.0;
+        const char* start = m_pCursor;
+        if (start != m_pEnd && *start == '+')
+        {
+            fail("Invalid number");
+        }
+        auto [ptr, error] = std::from_chars(start, m_pEnd, number);
+        if (error != std::errc() || ptr == start)
+        {
+            fail("Invalid number");
+        }
+        m_pCursor = ptr;
+        return number;
+    }
+
+    uint32_t parseHex4()
+    {
+        if (m_pEnd - m_pCursor < 4)
+        {
+            fail("Truncated unicode escape");
+        }
+        uint32_t codePoint = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            char c = *m_pCursor++;
+            codePoint <<= 4;
+            if (c >= '0' && c <= '9') codePoint |= c - '0';
+            else if (c >= 'a' && c <= 'f') codePoint |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') codePoint |= c - 'A' + 10;
+            else fail("Invalid unicode escape");
+        }
+        return codePoint;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t codePoint)
+    {
+        if (codePoint < 0x80)
+        {
+            out.push_back(static_cast<char>(codePoint));
+        }
+        else if (codePoint < 0x800)
+        {
+            out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+        else if (codePoint < 0x10000)
+        {
+            out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+        else
+        {
+            out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+    }
+
+    std::string parseString()
+    {
+        if (m_pCursor == m_pEnd || *m_pCursor != '"')
+        {
+            fail("Expected string");
+        }
+        ++m_pCursor;
+
+        std::string result;
+        while (true)
+        {
+            if (m_pCursor == m_pEnd)
+            {
+                fail("Unterminated string");
+            }
+
+            char c = *m_pCursor++;
+            if (c == '"')
+            {
+                break;
+            }
+            if (c != '\\')
+            {
+                result.push_back(c);
+                continue;
+            }
+
+            if (m_pCursor == m_pEnd)
+            {
+                fail("Unterminated escape");
+            }
+            char escape = *m_pCursor++;
+            switch (escape)
+            {
+            case '"': result.push_back('"'); break;
+            case '\\': result.push_back('\\'); break;
+            case '/': result.push_back('/'); break;
+            case 'b': result.push_back('\b'); break;
+            case 'f': result.push_back('\f'); break;
+            case 'n': result.push_back('\n'); break;
+            case 'r': result.push_back('\r'); break;
+            case 't': result.push_back('\t'); break;
+            case 'u':
+            {
+                uint32_t codePoint = parseHex4();
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF && m_pEnd - m_pCursor >= 6 &&
+                    m_pCursor[0] == '\\' && m_pCursor[1] == 'u')
+                {
+                    m_pCursor += 2;
+                    uint32_t low = parseHex4();
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+                appendUtf8(result, codePoint);
+                break;
+            }
+            default:
+                fail("Invalid escape sequence");
+            }
+        }
+        return result;
+    }
+
+    const char* m_pCursor;
+    const char* m_pBegin;
+    const char* m_pEnd;
+};
+
+JsonValue JsonValue::parse(const char* begin, const char* end)
+{
+    return JsonParser(begin, end).parseDocument();
+}
+
+bool JsonValue::has(const std::string& key) const
+{
+    for (const std::string& candidate : m_Keys)
+    {
+        if (candidate == key)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+const JsonValue& JsonValue::operator[](const std::string& key) const
+{
+    for (size_t i = 0; i < m_Keys.size(); ++i)
+    {
+        if (m_Keys[i] == key)
+        {
+            return m_Values[i];
+        }
+    }
+    return s_NullValue;
+}
+
+const JsonValue& JsonValue::operator[](size_t index) const
+{
+    if (m_Type != Type::Array || index >= m_Values.size())
+    {
+        return s_NullValue;
+    }
+    return m_Values[index];
+}
+
+size_t JsonValue::size() const
+{
+    return (m_Type == Type::Array || m_Type == Type::Object) ? m_Values.size() : 0;
+}
+
+bool JsonValue::asBool(bool fallback) const
+{
+    return m_Type == Type::Bool ? m_Bool : fallback;
+}
+
+double JsonValue::asNumber(double fallback) const
+{
+    return m_Type == Type::Number ? m_Number : fallback;
+}
+
+int64_t JsonValue::asInt(int64_t fallback) const
+{
+    return m_Type == Type::Number ? static_cast<int64_t>(m_Number) : fallback;
+}
+
+const std::string& JsonValue::asString() const
+{
+    return m_Type == Type::String ? m_String : s_EmptyString;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Minimal read-only JSON document model, enough for asset manifests such as glTF.
+// Missing keys and out-of-range indices resolve to a shared null value, so lookups
+// can be chained without checking every level.
+class JsonValue
+{
+public:
+    enum class Type
+    {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    static JsonValue parse(const char* begin, const char* end);
+
+    Type getType() const { return m_Type; }
+    bool isNull() const { return m_Type == Type::Null; }
+    bool isNumber() const { return m_Type == Type::Number; }
+    bool isString() const { return m_Type == Type::String; }
+    bool isArray() const { return m_Type == Type::Array; }
+    bool isObject() const { return m_Type == Type::Object; }
+
+    bool has(const std::string& key) const;
+    const JsonValue& operator[](const std::string& key) const;
+    const JsonValue& operator[](size_t index) const;
+    size_t size() const;
+
+    bool asBool(bool fallback = false) const;
+    double asNumber(double fallback = 0.0) const;
+    int64_t asInt(int64_t fallback = 0) const;
+    const std::string& asString() const;
+
+    const std::vector<std::string>& getKeys() const { return m_Keys; }
+
+private:
+    friend class JsonParser;
+
+    Type m_Type = Type::Null;
+    bool m_Bool = false;
+    double m_Number = 0.0;
+    std::string m_String;
+    std::vector<std::string> m_Keys;   // Object keys, parallel to m_Values
+    std::vector<JsonValue> m_Values;   // Array elements or object values
+};
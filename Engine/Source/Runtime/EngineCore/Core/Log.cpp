@@ -0,0 +1,607 @@
+#include "Log.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr size_t CategoryCount = static_cast<size_t>(LogCategory::Count);
+
+    struct RecordHeader
+    {
+        uint64_t timestamp; // Nanoseconds since the log started
+        uint32_t length;
+        LogLevel level;
+        LogCategory category;
+    };
+
+    // Single-producer single-consumer byte ring: the owning thread appends records, the writer thread
+    // consumes them. head and tail count every byte ever written and read, so head - tail is the fill.
+    struct ThreadBuffer
+    {
+        std::unique_ptr<uint8_t[]> pData;
+        size_t capacity = 0; // Power of two
+        alignas(64) std::atomic<size_t> head{ 0 };
+        alignas(64) std::atomic<size_t> tail{ 0 };
+        std::atomic<bool> retired{ false }; // Set once the owning thread exits; its last records are still drained
+
+        void copyIn(size_t position, const void* pSource, size_t size)
+        {
+            const size_t offset = position & (capacity - 1);
+            const size_t first = std::min(size, capacity - offset);
+            memcpy(pData.get() + offset, pSource, first);
+            memcpy(pData.get(), static_cast<const uint8_t*>(pSource) + first, size - first);
+        }
+
+        void copyOut(size_t position, void* pDestination, size_t size) const
+        {
+            const size_t offset = position & (capacity - 1);
+            const size_t first = std::min(size, capacity - offset);
+            memcpy(pDestination, pData.get() + offset, first);
+            memcpy(static_cast<uint8_t*>(pDestination) + first, pData.get(), size - first);
+        }
+    };
+
+    struct Record
+    {
+        RecordHeader header;
+        size_t textOffset; // Into the drain's text arena
+    };
+
+    struct State
+    {
+        std::array<std::atomic<uint8_t>, CategoryCount> levels;
+        Log::Settings settings;
+        bool initialized = false;
+        const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+        // Rings of every thread that logged since initialize(); generation tells threads to register anew
+        std::atomic<bool> running{ false };
+        std::atomic<uint32_t> generation{ 0 };
+        std::mutex buffersMutex;
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+        std::thread writer;
+        std::mutex wakeMutex;
+        std::condition_variable wake;
+        std::condition_variable flushed;
+        std::atomic<bool> wakeRequested{ false };
+        bool stopRequested = false;
+        uint64_t flushRequested = 0;
+        uint64_t flushCompleted = 0;
+
+        std::mutex outputMutex; // Keeps direct writes and batches from interleaving
+        std::ofstream file;
+
+        // Reused by drain(), which only ever runs on one thread at a time
+        std::vector<Record> drainRecords;
+        std::string drainText;
+        std::string drainLines;
+
+        std::atomic<uint64_t> messages{ 0 };
+        std::atomic<uint64_t> bytes{ 0 };
+        std::atomic<uint64_t> batches{ 0 };
+        std::atomic<uint64_t> fullWaits{ 0 };
+
+        State()
+        {
+            for (std::atomic<uint8_t>& level : levels)
+            {
+                level.store(static_cast<uint8_t>(settings.level), std::memory_order_relaxed);
+            }
+        }
+
+        ~State();
+    };
+
+    State& getState()
+    {
+        static State state;
+        return state;
+    }
+
+    struct ThreadBufferHandle
+    {
+        std::shared_ptr<ThreadBuffer> pBuffer;
+        uint32_t generation = 0;
+
+        ~ThreadBufferHandle()
+        {
+            if (pBuffer)
+            {
+                pBuffer->retired.store(true, std::memory_order_release);
+            }
+        }
+    };
+
+    thread_local ThreadBufferHandle t_Buffer;
+    thread_local std::ostringstream t_Stream;
+
+    uint64_t getTimestamp(const State& state)
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - state.startTime).count());
+    }
+
+    // "[     12.345] [Info] [RHI] text", formatted without snprintf since the writer formats every line
+    void appendLine(std::string& out, uint64_t timestamp, LogLevel level, LogCategory category, std::string_view text)
+    {
+        const uint64_t milliseconds = timestamp / 1000000;
+        char seconds[24];
+        const char* secondsEnd = std::to_chars(seconds, seconds + sizeof(seconds), milliseconds / 1000).ptr;
+        const size_t secondsLength = static_cast<size_t>(secondsEnd - seconds);
+        const char fraction[3] = { static_cast<char>('0' + milliseconds / 100 % 10), static_cast<char>('0' + milliseconds / 10 % 10),
+            static_cast<char>('0' + milliseconds % 10) };
+
+        out.push_back('[');
+        out.append(secondsLength < 6 ? 6 - secondsLength : 0, ' ');
+        out.append(seconds, secondsLength);
+        out.push_back('.');
+        out.append(fraction, 3);
+        out.append("] [");
+        out.append(Log::getLevelName(level));
+        out.append("] [");
+        out.append(Log::getCategoryName(category));
+        out.append("] ");
+        out.append(text);
+        out.push_back('\n');
+    }
+
+    // Errors go to stderr like the std::cerr calls they replace; stdout is flushed first to keep the order
+    void writeLines(State& state, const std::string& lines, bool isError)
+    {
+        if (state.settings.console)
+        {
+            if (isError)
+            {
+                std::cout.flush();
+                std::cerr.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+                std::cerr.flush();
+            }
+            else
+            {
+                std::cout.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+            }
+        }
+        if (state.file.is_open())
+        {
+            state.file.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+        }
+    }
+
+    void flushOutputs(State& state)
+    {
+        std::cout.flush();
+        if (state.file.is_open())
+        {
+            state.file.flush();
+        }
+    }
+
+    void writeDirect(State& state, LogCategory category, LogLevel level, std::string_view message)
+    {
+        std::string line;
+        appendLine(line, getTimestamp(state), level, category, message);
+
+        std::lock_guard<std::mutex> lock(state.outputMutex);
+        writeLines(state, line, level == LogLevel::Error);
+        flushOutputs(state);
+        state.messages.fetch_add(1, std::memory_order_relaxed);
+        state.bytes.fetch_add(message.size(), std::memory_order_relaxed);
+    }
+
+    ThreadBuffer* getThreadBuffer(State& state)
+    {
+        const uint32_t generation = state.generation.load(std::memory_order_acquire);
+        if (t_Buffer.pBuffer && t_Buffer.generation == generation)
+        {
+            return t_Buffer.pBuffer.get();
+        }
+
+        auto pBuffer = std::make_shared<ThreadBuffer>();
+        pBuffer->capacity = std::bit_ceil(std::max<size_t>(state.settings.threadBufferSize, 4096));
+        pBuffer->pData = std::make_unique<uint8_t[]>(pBuffer->capacity);
+        {
+            std::lock_guard<std::mutex> lock(state.buffersMutex);
+            state.buffers.push_back(pBuffer);
+        }
+
+        if (t_Buffer.pBuffer)
+        {
+            t_Buffer.pBuffer->retired.store(true, std::memory_order_release);
+        }
+        t_Buffer.pBuffer = std::move(pBuffer);
+        t_Buffer.generation = generation;
+        return t_Buffer.pBuffer.get();
+    }
+
+    // Empties every ring and writes the messages in time order with one flush
+    void drain(State& state)
+    {
+        std::vector<Record>& records = state.drainRecords;
+        std::string& text = state.drainText;
+        records.clear();
+        text.clear();
+        {
+            std::lock_guard<std::mutex> lock(state.buffersMutex);
+            for (auto it = state.buffers.begin(); it != state.buffers.end();)
+            {
+                ThreadBuffer& buffer = **it;
+                // Read before head: records pushed before the thread retired are then always visible
+                const bool retired = buffer.retired.load(std::memory_order_acquire);
+                const size_t head = buffer.head.load(std::memory_order_acquire);
+                size_t tail = buffer.tail.load(std::memory_order_relaxed);
+                while (tail != head)
+                {
+                    Record record;
+                    buffer.copyOut(tail, &record.header, sizeof(RecordHeader));
+                    record.textOffset = text.size();
+                    text.resize(text.size() + record.header.length);
+                    buffer.copyOut(tail + sizeof(RecordHeader), text.data() + record.textOffset, record.header.length);
+                    tail += sizeof(RecordHeader) + record.header.length;
+                    records.push_back(record);
+                }
+                buffer.tail.store(tail, std::memory_order_release);
+
+                it = retired ? state.buffers.erase(it) : it + 1;
+            }
+        }
+
+        if (records.empty())
+        {
+            return;
+        }
+
+        // Each ring is already in order, so this only interleaves threads
+        std::stable_sort(records.begin(), records.end(), [](const Record& a, const Record& b)
+        {
+            return a.header.timestamp < b.header.timestamp;
+        });
+
+        std::string& lines = state.drainLines;
+        lines.clear();
+        uint64_t bytes = 0;
+        std::lock_guard<std::mutex> lock(state.outputMutex);
+        for (const Record& record : records)
+        {
+            const std::string_view recordText(text.data() + record.textOffset, record.header.length);
+            if (record.header.level == LogLevel::Error)
+            {
+                writeLines(state, lines, false);
+                lines.clear();
+
+                std::string line;
+                appendLine(line, record.header.timestamp, record.header.level, record.header.category, recordText);
+                writeLines(state, line, true);
+            }
+            else
+            {
+                appendLine(lines, record.header.timestamp, record.header.level, record.header.category, recordText);
+            }
+            bytes += record.header.length;
+        }
+        writeLines(state, lines, false);
+        flushOutputs(state);
+
+        state.messages.fetch_add(records.size(), std::memory_order_relaxed);
+        state.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        state.batches.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void writerLoop(State& state)
+    {
+        std::unique_lock<std::mutex> lock(state.wakeMutex);
+        while (true)
+        {
+            state.wake.wait_for(lock, std::chrono::milliseconds(state.settings.flushIntervalMs), [&state]()
+            {
+                return state.stopRequested || state.flushRequested != state.flushCompleted
+                    || state.wakeRequested.load(std::memory_order_relaxed);
+            });
+            const bool stop = state.stopRequested;
+            const uint64_t flushTarget = state.flushRequested;
+            state.wakeRequested.store(false, std::memory_order_relaxed);
+
+            lock.unlock();
+            drain(state);
+            lock.lock();
+
+            state.flushCompleted = flushTarget;
+            state.flushed.notify_all();
+            if (stop)
+            {
+                return;
+            }
+        }
+    }
+
+    void shutdownState(State& state)
+    {
+        if (state.writer.joinable())
+        {
+            state.running.store(false, std::memory_order_release);
+            {
+                std::lock_guard<std::mutex> lock(state.wakeMutex);
+                state.stopRequested = true;
+            }
+            state.wake.notify_one();
+            state.writer.join();
+
+            // Picks up messages from threads that passed the running check just before it was cleared
+            drain(state);
+            std::lock_guard<std::mutex> lock(state.buffersMutex);
+            state.buffers.clear();
+        }
+
+        std::lock_guard<std::mutex> lock(state.outputMutex);
+        flushOutputs(state);
+        if (state.file.is_open())
+        {
+            state.file.close();
+        }
+        state.initialized = false;
+    }
+
+    State::~State()
+    {
+        shutdownState(*this);
+    }
+}
+
+void Log::initialize(const Settings& settings)
+{
+    State& state = getState();
+    shutdownState(state);
+
+    state.settings = settings;
+    setLevel(settings.level);
+
+    if (!settings.filePath.empty())
+    {
+        std::lock_guard<std::mutex> lock(state.outputMutex);
+        state.file.open(settings.filePath, std::ios::out | std::ios::app);
+    }
+    if (!settings.filePath.empty() && !state.file.is_open())
+    {
+        writeDirect(state, LogCategory::Core, LogLevel::Warning, "Log: could not open " + settings.filePath);
+    }
+
+    if (settings.asynchronous)
+    {
+        state.stopRequested = false;
+        state.flushRequested = 0;
+        state.flushCompleted = 0;
+        state.generation.fetch_add(1, std::memory_order_acq_rel);
+        state.running.store(true, std::memory_order_release);
+        state.writer = std::thread(writerLoop, std::ref(state));
+    }
+    state.initialized = true;
+}
+
+void Log::shutdown()
+{
+    shutdownState(getState());
+}
+
+void Log::flush()
+{
+    State& state = getState();
+    if (!state.running.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock(state.outputMutex);
+        flushOutputs(state);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(state.wakeMutex);
+    const uint64_t target = ++state.flushRequested;
+    state.wake.notify_one();
+    state.flushed.wait(lock, [&state, target]() { return state.flushCompleted >= target || state.stopRequested; });
+}
+
+void Log::setLevel(LogLevel level)
+{
+    for (size_t i = 0; i < CategoryCount; ++i)
+    {
+        setLevel(static_cast<LogCategory>(i), level);
+    }
+}
+
+void Log::setLevel(LogCategory category, LogLevel level)
+{
+    getState().levels[static_cast<size_t>(category)].store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+}
+
+LogLevel Log::getLevel(LogCategory category)
+{
+    return static_cast<LogLevel>(getState().levels[static_cast<size_t>(category)].load(std::memory_order_relaxed));
+}
+
+bool Log::isEnabled(LogCategory category, LogLevel level)
+{
+    return level != LogLevel::Off && static_cast<uint8_t>(level) >= getState().levels[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+}
+
+void Log::write(LogCategory category, LogLevel level, std::string_view message)
+{
+    State& state = getState();
+    if (!state.running.load(std::memory_order_acquire))
+    {
+        writeDirect(state, category, level, message);
+        return;
+    }
+
+    ThreadBuffer* pBuffer = getThreadBuffer(state);
+    // Longer messages are truncated so one record can never fill the ring on its own
+    const size_t length = std::min(message.size(), pBuffer->capacity / 2);
+    const size_t recordSize = sizeof(RecordHeader) + length;
+
+    RecordHeader header{};
+    header.timestamp = getTimestamp(state);
+    header.length = static_cast<uint32_t>(length);
+    header.level = level;
+    header.category = category;
+
+    const size_t head = pBuffer->head.load(std::memory_order_relaxed);
+    if (head + recordSize - pBuffer->tail.load(std::memory_order_acquire) > pBuffer->capacity)
+    {
+        state.fullWaits.fetch_add(1, std::memory_order_relaxed);
+        while (head + recordSize - pBuffer->tail.load(std::memory_order_acquire) > pBuffer->capacity)
+        {
+            if (!state.running.load(std::memory_order_acquire))
+            {
+                writeDirect(state, category, level, message);
+                return;
+            }
+            state.wakeRequested.store(true, std::memory_order_relaxed);
+            state.wake.notify_one();
+            std::this_thread::yield();
+        }
+    }
+
+    pBuffer->copyIn(head, &header, sizeof(RecordHeader));
+    pBuffer->copyIn(head + sizeof(RecordHeader), message.data(), length);
+    pBuffer->head.store(head + recordSize, std::memory_order_release);
+
+    // Start draining at half full so bursts rarely have to wait
+    const size_t filled = head + recordSize - pBuffer->tail.load(std::memory_order_relaxed);
+    if (filled > pBuffer->capacity / 2 && !state.wakeRequested.exchange(true, std::memory_order_relaxed))
+    {
+        state.wake.notify_one();
+    }
+}
+
+std::ostringstream& Log::beginMessage()
+{
+    static const std::ios_base::fmtflags defaultFlags = std::ostringstream().flags();
+
+    t_Stream.str(std::string());
+    t_Stream.clear();
+    t_Stream.flags(defaultFlags);
+    t_Stream.precision(6);
+    t_Stream.fill(' ');
+    return t_Stream;
+}
+
+Log::Stats Log::getStats()
+{
+    const State& state = getState();
+    Stats stats;
+    stats.messages = state.messages.load(std::memory_order_relaxed);
+    stats.bytes = state.bytes.load(std::memory_order_relaxed);
+    stats.batches = state.batches.load(std::memory_order_relaxed);
+    stats.fullWaits = state.fullWaits.load(std::memory_order_relaxed);
+    return stats;
+}
+
+const char* Log::getLevelName(LogLevel level)
+{
+    switch (level)
+    {
+    case LogLevel::Trace: return "Trace";
+    case LogLevel::Debug: return "Debug";
+    case LogLevel::Info: return "Info";
+    case LogLevel::Warning: return "Warning";
+    case LogLevel::Error: return "Error";
+    default: return "Off";
+    }
+}
+
+const char* Log::getCategoryName(LogCategory category)
+{
+    switch (category)
+    {
+    case LogCategory::Core: return "Core";
+    case LogCategory::RHI: return "RHI";
+    case LogCategory::Render: return "Render";
+    case LogCategory::Asset: return "Asset";
+    default: return "Unknown";
+    }
+}
+
+void Log::runBenchmark(const std::string& name, const std::function<void()>& load, int iterations)
+{
+    State& state = getState();
+    const Settings savedSettings = state.settings;
+    const bool wasInitialized = state.initialized;
+    std::array<LogLevel, CategoryCount> savedLevels;
+    for (size_t i = 0; i < CategoryCount; ++i)
+    {
+        savedLevels[i] = getLevel(static_cast<LogCategory>(i));
+    }
+
+    struct Mode
+    {
+        const char* name;
+        bool asynchronous;
+        LogLevel level;
+        double loadSeconds = 0.0;
+        double drainSeconds = 0.0; // Time the writer still needed after the loads returned
+        uint64_t messages = 0;
+    };
+    Mode modes[] = {
+        { "synchronous", false, LogLevel::Trace },
+        { "asynchronous", true, LogLevel::Trace },
+        { "off", true, LogLevel::Off },
+    };
+
+    iterations = std::max(iterations, 1);
+    load(); // Warm file and driver caches so the first mode is not penalised
+
+    for (Mode& mode : modes)
+    {
+        Settings settings = savedSettings;
+        settings.asynchronous = mode.asynchronous;
+        settings.level = mode.level;
+        initialize(settings);
+        const uint64_t messagesBefore = getStats().messages;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            load();
+        }
+        const auto loaded = std::chrono::steady_clock::now();
+        flush();
+        const auto drained = std::chrono::steady_clock::now();
+
+        mode.loadSeconds = std::chrono::duration<double>(loaded - start).count() / iterations;
+        mode.drainSeconds = std::chrono::duration<double>(drained - loaded).count();
+        mode.messages = (getStats().messages - messagesBefore) / iterations;
+    }
+
+    if (wasInitialized)
+    {
+        initialize(savedSettings);
+    }
+    else
+    {
+        shutdown();
+        state.settings = savedSettings;
+    }
+    for (size_t i = 0; i < CategoryCount; ++i)
+    {
+        setLevel(static_cast<LogCategory>(i), savedLevels[i]);
+    }
+
+    CAE_LOG_INFO(Core, "Log benchmark: " << name << ", " << iterations << " loads, compiled minimum level "
+        << getLevelName(static_cast<LogLevel>(CAE_LOG_MIN_LEVEL)));
+    for (const Mode& mode : modes)
+    {
+        CAE_LOG_INFO(Core, "  Logging " << mode.name << ": " << mode.loadSeconds * 1000.0 << " ms per load, "
+            << mode.messages << " messages, writer drain " << mode.drainSeconds * 1000.0 << " ms, "
+            << mode.loadSeconds / modes[2].loadSeconds << "x the time with logging off");
+    }
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+// Numeric so the build can pass e.g. CAE_LOG_MIN_LEVEL=CAE_LOG_LEVEL_WARNING
+#define CAE_LOG_LEVEL_TRACE 0
+#define CAE_LOG_LEVEL_DEBUG 1
+#define CAE_LOG_LEVEL_INFO 2
+#define CAE_LOG_LEVEL_WARNING 3
+#define CAE_LOG_LEVEL_ERROR 4
+#define CAE_LOG_LEVEL_OFF 5
+
+// Messages below this level are compiled out, arguments included. CAE_DEBUG, CAE_RELEASE and CAE_DIST
+// come from the premake configurations; NDEBUG covers builds that do not define them.
+#ifndef CAE_LOG_MIN_LEVEL
+#if defined(CAE_DIST)
+#define CAE_LOG_MIN_LEVEL CAE_LOG_LEVEL_WARNING
+#elif defined(CAE_RELEASE) || (defined(NDEBUG) && !defined(CAE_DEBUG))
+#define CAE_LOG_MIN_LEVEL CAE_LOG_LEVEL_DEBUG
+#else
+#define CAE_LOG_MIN_LEVEL CAE_LOG_LEVEL_TRACE
+#endif
+#endif
+
+enum class LogLevel : uint8_t
+{
+    Trace = CAE_LOG_LEVEL_TRACE,     // Per-object creation and destruction
+    Debug = CAE_LOG_LEVEL_DEBUG,     // Details of a load or a device query
+    Info = CAE_LOG_LEVEL_INFO,       // One line per significant event
+    Warning = CAE_LOG_LEVEL_WARNING,
+    Error = CAE_LOG_LEVEL_ERROR,
+    Off = CAE_LOG_LEVEL_OFF
+};
+
+enum class LogCategory : uint8_t
+{
+    Core,   // Application, window and input
+    RHI,    // Vulkan objects and GPU memory
+    Render, // Renderer, layers and pipelines
+    Asset,  // Models, textures and their import
+    Count
+};
+
+//
+// Engine logging. Messages are formatted on the calling thread and pushed into a lock-free ring
+// owned by that thread; a background thread drains every ring, orders the messages by time and
+// writes them in batches with one flush per batch. Nothing is written synchronously on the hot path
+// unless the ring is full, in which case the caller waits for the writer. Before initialize() and
+// after shutdown() messages are written directly, so early and late output is never lost.
+//
+// Use the macros: CAE_LOG_INFO(RHI, "Buffer created with size: " << size << " bytes");
+//
+namespace Log
+{
+    struct Settings
+    {
+        LogLevel level = LogLevel::Info; // Initial runtime level of every category
+        bool asynchronous = true;        // false writes and flushes each message on the calling thread
+        size_t threadBufferSize = 64 * 1024; // Bytes of ring per logging thread, rounded up to a power of two
+        uint32_t flushIntervalMs = 10;   // Longest a message waits in a ring before it is written
+        bool console = true;
+        std::string filePath;            // Also appended to this file when not empty
+    };
+
+    struct Stats
+    {
+        uint64_t messages = 0;
+        uint64_t bytes = 0;
+        uint64_t batches = 0;   // Writes by the background thread
+        uint64_t fullWaits = 0; // Messages that had to wait for ring space
+    };
+
+    // Starts the writer thread; may be called again after shutdown() with other settings
+    void initialize(const Settings& settings = Settings{});
+    // Writes everything still queued and stops the writer. Other threads must not log concurrently.
+    void shutdown();
+    // Blocks until every message logged before the call has been written
+    void flush();
+
+    void setLevel(LogLevel level);
+    void setLevel(LogCategory category, LogLevel level);
+    LogLevel getLevel(LogCategory category);
+    bool isEnabled(LogCategory category, LogLevel level);
+
+    void write(LogCategory category, LogLevel level, std::string_view message);
+    // A cleared per-thread stream for the macros, reused instead of constructing a stream per message
+    std::ostringstream& beginMessage();
+
+    Stats getStats();
+    const char* getLevelName(LogLevel level);
+    const char* getCategoryName(LogCategory category);
+
+    // Times load() with synchronous logging (the old std::cout << std::endl behaviour), asynchronous
+    // logging and logging off, every category at Trace where enabled, and logs the average of
+    // iterations runs each. For example: runBenchmark("Sponza", [&] { Model model(...); });
+    void runBenchmark(const std::string& name, const std::function<void()>& load, int iterations = 3);
+}
+
+// The message is a stream expression; it is only evaluated when the level is enabled.
+// Message expressions must not log themselves.
+#define CAE_LOG(category, level, ...)                                                                   \
+    do                                                                                                  \
+    {                                                                                                   \
+        if constexpr (LogLevel::level >= static_cast<LogLevel>(CAE_LOG_MIN_LEVEL))                     \
+        {                                                                                               \
+            if (Log::isEnabled(LogCategory::category, LogLevel::level))                                 \
+            {                                                                                           \
+                std::ostringstream& logStream_ = Log::beginMessage();                                   \
+                logStream_ << __VA_ARGS__;                                                              \
+                Log::write(LogCategory::category, LogLevel::level, logStream_.view());                  \
+            }                                                                                           \
+        }                                                                                               \
+    } while (0)
+
+#define CAE_LOG_TRACE(category, ...) CAE_LOG(category, Trace, __VA_ARGS__)
+#define CAE_LOG_DEBUG(category, ...) CAE_LOG(category, Debug, __VA_ARGS__)
+#define CAE_LOG_INFO(category, ...) CAE_LOG(category, Info, __VA_ARGS__)
+#define CAE_LOG_WARNING(category, ...) CAE_LOG(category, Warning, __VA_ARGS__)
+#define CAE_LOG_ERROR(category, ...) CAE_LOG(category, Error, __VA_ARGS__)
@@ -0,0 +1,158 @@
+#include "MappedFile.h"
+#include <stdexcept>
+#include <utility>
+
+#ifdef CAE_PLATFORM_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& path)
+{
+    open(path);
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        m_Path = std::move(other.m_Path);
+        m_pData = std::exchange(other.m_pData, nullptr);
+        m_Size = std::exchange(other.m_Size, 0);
+        m_IsOpen = std::exchange(other.m_IsOpen, false);
+#ifdef CAE_PLATFORM_WINDOWS
+        m_FileHandle = std::exchange(other.m_FileHandle, nullptr);
+        m_MappingHandle = std::exchange(other.m_MappingHandle, nullptr);
+#else
+        m_FileDescriptor = std::exchange(other.m_FileDescriptor, -1);
+#endif
+    }
+    return *this;
+}
+
+void MappedFile::open(const std::string& path)
+{
+    close();
+    m_Path = path;
+
+#ifdef CAE_PLATFORM_WINDOWS
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        throw std::runtime_error("Failed to query file size: " + path);
+    }
+
+    m_FileHandle = file;
+    m_Size = static_cast<size_t>(fileSize.QuadPart);
+    m_IsOpen = true;
+
+    // Zero-length files cannot be mapped, but are still valid (empty) files
+    if (m_Size == 0)
+    {
+        return;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        close();
+        throw std::runtime_error("Failed to create file mapping: " + path);
+    }
+    m_MappingHandle = mapping;
+
+    m_pData = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_pData == nullptr)
+    {
+        close();
+        throw std::runtime_error("Failed to map view of file: " + path);
+    }
+#else
+    int fileDescriptor = ::open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0)
+    {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+
+    struct stat fileStat{};
+    if (fstat(fileDescriptor, &fileStat) != 0)
+    {
+        ::close(fileDescriptor);
+        throw std::runtime_error("Failed to query file size: " + path);
+    }
+
+    m_FileDescriptor = fileDescriptor;
+    m_Size = static_cast<size_t>(fileStat.st_size);
+    m_IsOpen = true;
+
+    if (m_Size == 0)
+    {
+        return;
+    }
+
+    void* mapping = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if (mapping == MAP_FAILED)
+    {
+        close();
+        throw std::runtime_error("Failed to map file: " + path);
+    }
+    m_pData = static_cast<const uint8_t*>(mapping);
+#endif
+}
+
+void MappedFile::close()
+{
+#ifdef CAE_PLATFORM_WINDOWS
+    if (m_pData)
+    {
+        UnmapViewOfFile(m_pData);
+    }
+    if (m_MappingHandle)
+    {
+        CloseHandle(static_cast<HANDLE>(m_MappingHandle));
+        m_MappingHandle = nullptr;
+    }
+    if (m_FileHandle)
+    {
+        CloseHandle(static_cast<HANDLE>(m_FileHandle));
+        m_FileHandle = nullptr;
+    }
+#else
+    if (m_pData)
+    {
+        munmap(const_cast<uint8_t*>(m_pData), m_Size);
+    }
+    if (m_FileDescriptor >= 0)
+    {
+        ::close(m_FileDescriptor);
+        m_FileDescriptor = -1;
+    }
+#endif
+    m_pData = nullptr;
+    m_Size = 0;
+    m_IsOpen = false;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only memory mapping of a whole file. The OS pages data in on first touch,
+// so large assets can be read in place without copying them into heap buffers.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    void open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return m_IsOpen; }
+    const uint8_t* data() const { return m_pData; }
+    size_t size() const { return m_Size; }
+    const std::string& getPath() const { return m_Path; }
+
+private:
+    std::string m_Path;
+    const uint8_t* m_pData = nullptr;
+    size_t m_Size = 0;
+    bool m_IsOpen = false;
+
+#ifdef CAE_PLATFORM_WINDOWS
+    void* m_FileHandle = nullptr;
+    void* m_MappingHandle = nullptr;
+#else
+    int m_FileDescriptor = -1;
+#endif
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs func(index) for every index in [0, count) on up to hardware_concurrency threads.
+// Indices are handed out one at a time, so items of very different cost still balance.
+// The first exception thrown by any item is rethrown on the calling thread.
+template<typename Func>
+void parallelFor(size_t count, Func&& func, size_t maxThreads = 0)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    size_t threadCount = maxThreads != 0 ? maxThreads : std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, count);
+
+    if (threadCount == 1)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            func(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> nextIndex{ 0 };
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+
+    auto worker = [&]()
+    {
+        for (size_t i = nextIndex.fetch_add(1); i < count; i = nextIndex.fetch_add(1))
+        {
+            try
+            {
+                func(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!firstError)
+                {
+                    firstError = std::current_exception();
+                }
+                nextIndex.store(count);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (size_t i = 1; i < threadCount; ++i)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    if (firstError)
+    {
+        std::rethrow_exception(firstError);
+    }
+}
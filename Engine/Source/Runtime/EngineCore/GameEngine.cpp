@@ -1,7 +1,7 @@
 #include "GameEngine.h"
-#include <iostream>
 #include "Rendering/Layer.h"
 #include "Rendering/Renderer.h"
+#include "Runtime/EngineCore/Core/Log.h"
 
 GameEngine::GameEngine()
     : m_Renderer(nullptr)
@@ -33,8 +33,8 @@ void GameEngine::Initialize(Window* window)
         m_Renderer->Initialize(window);
     }
 
-    std::cout << "GameEngine initialized!" << std::endl;
-    std::cout << "Renderer initialized successfully!" << std::endl;
+    CAE_LOG_INFO(Core, "GameEngine initialized!");
+    CAE_LOG_INFO(Core, "Renderer initialized successfully!");
 }
 
 void GameEngine::Shutdown()
@@ -7,9 +7,11 @@ extern Application* CreateApplication(int argc, char** argv);
 int Main(int argc, char** argv)
 {
 	Application* app = CreateApplication(argc, argv);
+	app->SetCommandLine(argc, argv);
 	app->Run();
+	const int exitCode = app->GetExitCode();
 	delete app;
-	return 0;
+	return exitCode;
 }
 
 #ifdef CAE_DIST
@@ -38,9 +40,11 @@ extern Application* CreateApplication(int argc, char** argv);
 int main(int argc, char** argv)
 {
 	Application* app = CreateApplication(argc, argv);
+	app->SetCommandLine(argc, argv);
 	app->Run();
+	const int exitCode = app->GetExitCode();
 	delete app;
-	return 0;
+	return exitCode;
 }
 
 #endif // CAE_PLATFORM_WINDOWS
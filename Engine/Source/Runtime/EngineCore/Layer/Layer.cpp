@@ -3,10 +3,16 @@
 
 #include "Layer.h"
 
+#include "Runtime/EngineCore/RHI/ParallelCommandRecorder.h"
+
 #include <string>
 
 	Layer::Layer(const std::string& debugName)
 		: m_Name(debugName)
 	{
 	}
-	
+
+	void Layer::OnRecord(ParallelCommandRecorder& recorder)
+	{
+		recorder.addTask([this](VkCommandBuffer commandBuffer) { OnRender(commandBuffer); }, !IsThreadSafeRender());
+	}
@@ -7,6 +7,8 @@
 
 // No forward declarations to avoid conflicts with your engine's Vulkan headers
 
+class ParallelCommandRecorder;
+
 class Layer
 {
 public:
@@ -18,6 +20,13 @@ public:
     virtual void OnUpdate(float deltaTime) {}
     virtual void OnRender(VkCommandBuffer commandBuffer) = 0;
 
+    // Adds this layer's recording tasks for the frame. The default records OnRender() as one task,
+    // on a worker thread if IsThreadSafeRender(); layers with many draws override this to split
+    // them into several tasks, which are executed in the order they are added.
+    virtual void OnRecord(ParallelCommandRecorder& recorder);
+    // True when OnRender() only records into the buffer it is given and touches no main-thread state
+    virtual bool IsThreadSafeRender() const { return false; }
+
     const std::string& GetName() const { return m_Name; }
     bool IsEnabled() const { return m_Enabled; }
     void SetEnabled(bool enabled) { m_Enabled = enabled; }
@@ -0,0 +1,794 @@
+#include "BlockCompressor.h"
+
+#include "Runtime/EngineCore/Core/ParallelFor.h"
+#include "Runtime/EngineCore/Core/Log.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    constexpr int BlockTexels = 16;
+
+    // Principal axis of the block through power iteration; endpoints are the extreme projections
+    template<int Channels>
+    void findEndpoints(const float points[BlockTexels][Channels], float e0[Channels], float e1[Channels])
+    {
+        float mean[Channels] = {};
+        for (int i = 0; i < BlockTexels; ++i)
+        {
+            for (int c = 0; c < Channels; ++c)
+            {
+                mean[c] += points[i][c] / BlockTexels;
+            }
+        }
+
+        float covariance[Channels][Channels] = {};
+        for (int i = 0; i < BlockTexels; ++i)
+        {
+            for (int a = 0; a < Channels; ++a)
+            {
+                for (int b = 0; b < Channels; ++b)
+                {
+                    covariance[a][b] += (points[i][a] - mean[a]) * (points[i][b] - mean[b]);
+                }
+            }
+        }
+
+        float axis[Channels];
+        for (int c = 0; c < Channels; ++c)
+        {
+            axis[c] = 1.0f;
+        }
+        for (int iteration = 0; iteration < 8; ++iteration)
+        {
+            float next[Channels] = {};
+            float length = 0.0f;
+            for (int a = 0; a < Channels; ++a)
+            {
+                for (int b = 0; b < Channels; ++b)
+                {
+                    next[a] += covariance[a][b] * axis[b];
+                }
+                length = std::max(length, std::abs(next[a]));
+            }
+            if (length < 1e-6f)
+            {
+                break;
+            }
+            for (int c = 0; c < Channels; ++c)
+            {
+                axis[c] = next[c] / length;
+            }
+        }
+
+        float axisLengthSq = 0.0f;
+        for (int c = 0; c < Channels; ++c)
+        {
+            axisLengthSq += axis[c] * axis[c];
+        }
+
+        float tMin = 0.0f;
+        float tMax = 0.0f;
+        for (int i = 0; i < BlockTexels; ++i)
+        {
+            float t = 0.0f;
+            for (int c = 0; c < Channels; ++c)
+            {
+                t += (points[i][c] - mean[c]) * axis[c];
+            }
+            t /= axisLengthSq;
+            tMin = std::min(tMin, t);
+            tMax = std::max(tMax, t);
+        }
+
+        for (int c = 0; c < Channels; ++c)
+        {
+            e0[c] = std::clamp(mean[c] + axis[c] * tMin, 0.0f, 255.0f);
+            e1[c] = std::clamp(mean[c] + axis[c] * tMax, 0.0f, 255.0f);
+        }
+    }
+
+    // Least-squares endpoints for fixed interpolation weights (0 = e0, 1 = e1)
+    template<int Channels>
+    void refineEndpoints(const float points[BlockTexels][Channels], const float weights[BlockTexels], float e0[Channels], float e1[Channels])
+    {
+        float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+        float ax[Channels] = {};
+        float bx[Channels] = {};
+        for (int i = 0; i < BlockTexels; ++i)
+        {
+            const float b = weights[i];
+            const float a = 1.0f - b;
+            aa += a * a;
+            ab += a * b;
+            bb += b * b;
+            for (int c = 0; c < Channels; ++c)
+            {
+                ax[c] += a * points[i][c];
+                bx[c] += b * points[i][c];
+            }
+        }
+
+        const float determinant = aa * bb - ab * ab;
+        if (std::abs(determinant) < 1e-6f)
+        {
+            return;
+        }
+
+        for (int c = 0; c < Channels; ++c)
+        {
+            e0[c] = std::clamp((bb * ax[c] - ab * bx[c]) / determinant, 0.0f, 255.0f);
+            e1[c] = std::clamp((aa * bx[c] - ab * ax[c]) / determinant, 0.0f, 255.0f);
+        }
+    }
+
+    // LSB-first bit packing used by BC7
+    class BitWriter
+    {
+    public:
+        explicit BitWriter(uint8_t* pOutput)
+            : m_pOutput(pOutput)
+        {
+            memset(m_pOutput, 0, 16);
+        }
+
+        void write(uint32_t value, uint32_t count)
+        {
+            for (uint32_t i = 0; i < count; ++i, ++m_Position)
+            {
+                if (value & (1u << i))
+                {
+                    m_pOutput[m_Position >> 3] |= static_cast<uint8_t>(1u << (m_Position & 7));
+                }
+            }
+        }
+
+    private:
+        uint8_t* m_pOutput;
+        uint32_t m_Position = 0;
+    };
+
+    // LSB-first bit reading, matching BitWriter
+    class BitReader
+    {
+    public:
+        explicit BitReader(const uint8_t* pInput)
+            : m_pInput(pInput)
+        {
+        }
+
+        uint32_t read(uint32_t count)
+        {
+            uint32_t value = 0;
+            for (uint32_t i = 0; i < count; ++i, ++m_Position)
+            {
+                value |= static_cast<uint32_t>((m_pInput[m_Position >> 3] >> (m_Position & 7)) & 1) << i;
+            }
+            return value;
+        }
+
+    private:
+        const uint8_t* m_pInput;
+        uint32_t m_Position = 0;
+    };
+
+    // ---- BC1 ----
+
+    uint16_t packRgb565(const float color[3])
+    {
+        const uint32_t r = static_cast<uint32_t>(std::lround(color[0] * 31.0f / 255.0f));
+        const uint32_t g = static_cast<uint32_t>(std::lround(color[1] * 63.0f / 255.0f));
+        const uint32_t b = static_cast<uint32_t>(std::lround(color[2] * 31.0f / 255.0f));
+        return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    void unpackRgb565(uint16_t packed, float color[3])
+    {
+        const uint32_t r = (packed >> 11) & 31;
+        const uint32_t g = (packed >> 5) & 63;
+        const uint32_t b = packed & 31;
+        color[0] = static_cast<float>((r << 3) | (r >> 2));
+        color[1] = static_cast<float>((g << 2) | (g >> 4));
+        color[2] = static_cast<float>((b << 3) | (b >> 2));
+    }
+
+    struct BC1Candidate
+    {
+        uint16_t color0 = 0;
+        uint16_t color1 = 0;
+        uint8_t indices[BlockTexels] = {};
+        float error = 0.0f;
+    };
+
+    BC1Candidate fitBC1(const float points[BlockTexels][3], const float e0[3], const float e1[3])
+    {
+        BC1Candidate candidate;
+        candidate.color0 = packRgb565(e0);
+        candidate.color1 = packRgb565(e1);
+
+        // Four-colour mode requires color0 > color1
+        if (candidate.color0 < candidate.color1)
+        {
+            std::swap(candidate.color0, candidate.color1);
+        }
+        if (candidate.color0 == candidate.color1)
+        {
+            float color[3];
+            unpackRgb565(candidate.color0, color);
+            for (int i = 0; i < BlockTexels; ++i)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    const float d = points[i][c] - color[c];
+                    candidate.error += d * d;
+                }
+            }
+            return candidate;
+        }
+
+        float palette[4][3];
+        unpackRgb565(candidate.color0, palette[0]);
+        unpackRgb565(candidate.color1, palette[1]);
+        for (int c = 0; c < 3; ++c)
+        {
+            palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+            palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+        }
+
+        for (int i = 0; i < BlockTexels; ++i)
+        {
+            float bestError = FLT_MAX;
+            for (uint8_t p = 0; p < 4; ++p)
+            {
+                float error = 0.0f;
+                for (int c = 0; c < 3; ++c)
+                {
+                    const float d = points[i][c] - palette[p][c];
+                    error += d * d;
+                }
+                if (error < bestError)
+                {
+                    bestError = error;
+                    candidate.indices[i] = p;
+                }
+            }
+            candidate.error += bestError;
+        }
+        return candidate;
+    }
+
+    // ---- BC7 mode 6 ----
+
+    constexpr uint32_t BC7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    struct BC7Endpoint
+    {
+        uint8_t quantized[4]; // 7 bits per channel
+        uint8_t pBit;
+        uint8_t value[4];     // Decoded 8-bit value
+    };
+
+    BC7Endpoint quantizeBC7Endpoint(const float color[4])
+    {
+        BC7Endpoint best{};
+        float bestError = FLT_MAX;
+        for (uint8_t pBit = 0; pBit < 2; ++pBit)
+        {
+            BC7Endpoint endpoint{};
+            endpoint.pBit = pBit;
+            float error = 0.0f;
+            for (int c = 0; c < 4; ++c)
+            {
+                const long q = std::clamp(std::lround((color[c] - pBit) * 0.5f), 0l, 127l);
+                endpoint.quantized[c] = static_cast<uint8_t>(q);
+                endpoint.value[c] = static_cast<uint8_t>((q << 1) | pBit);
+                const float d = color[c] - endpoint.value[c];
+                error += d * d;
+            }
+            if (error < bestError)
+            {
+                bestError = error;
+                best = endpoint;
+            }
+        }
+        return best;
+    }
+
+    struct BC7Candidate
+    {
+        BC7Endpoint endpoints[2];
+        uint8_t indices[BlockTexels] = {};
+        float error = 0.0f;
+    };
+
+    BC7Candidate fitBC7(const float points[BlockTexels][4], const float e0[4], const float e1[4])
+    {
+        BC7Candidate candidate;
+        candidate.endpoints[0] = quantizeBC7Endpoint(e0);
+        candidate.endpoints[1] = quantizeBC7Endpoint(e1);
+
+        float palette[16][4];
+        for (int p = 0; p < 16; ++p)
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                palette[p][c] = static_cast<float>(((64 - BC7Weights4[p]) * candidate.endpoints[0].value[c] +
+                                                    BC7Weights4[p] * candidate.endpoints[1].value[c] + 32) >> 6);
+            }
+        }
+
+        for (int i = 0; i < BlockTexels; ++i)
+        {
+            float bestError = FLT_MAX;
+            for (uint8_t p = 0; p < 16; ++p)
+            {
+                float error = 0.0f;
+                for (int c = 0; c < 4; ++c)
+                {
+                    const float d = points[i][c] - palette[p][c];
+                    error += d * d;
+                }
+                if (error < bestError)
+                {
+                    bestError = error;
+                    candidate.indices[i] = p;
+                }
+            }
+            candidate.error += bestError;
+        }
+        return candidate;
+    }
+}
+
+size_t BlockCompressor::getBlockSize(Format format)
+{
+    return (format == Format::BC1 || format == Format::BC4) ? 8 : 16;
+}
+
+void BlockCompressor::encodeBC1(const uint8_t* pBlock, uint8_t* pOutput)
+{
+    float points[BlockTexels][3];
+    for (int i = 0; i < BlockTexels; ++i)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            points[i][c] = pBlock[i * 4 + c];
+        }
+    }
+
+    float e0[3], e1[3];
+    findEndpoints<3>(points, e0, e1);
+    BC1Candidate best = fitBC1(points, e0, e1);
+
+    if (best.color0 != best.color1)
+    {
+        float palette0[3], palette1[3];
+        unpackRgb565(best.color0, palette0);
+        unpackRgb565(best.color1, palette1);
+        constexpr float IndexWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+        float weights[BlockTexels];
+        for (int i = 0; i < BlockTexels; ++i)
+        {
+            weights[i] = IndexWeights[best.indices[i]];
+        }
+        refineEndpoints<3>(points, weights, palette0, palette1);
+
+        BC1Candidate refined = fitBC1(points, palette0, palette1);
+        if (refined.error < best.error)
+        {
+            best = refined;
+        }
+    }
+
+    uint32_t indexBits = 0;
+    for (int i = 0; i < BlockTexels; ++i)
+    {
+        indexBits |= static_cast<uint32_t>(best.indices[i]) << (i * 2);
+    }
+
+    pOutput[0] = static_cast<uint8_t>(best.color0 & 0xFF);
+    pOutput[1] = static_cast<uint8_t>(best.color0 >> 8);
+    pOutput[2] = static_cast<uint8_t>(best.color1 & 0xFF);
+    pOutput[3] = static_cast<uint8_t>(best.color1 >> 8);
+    memcpy(pOutput + 4, &indexBits, 4);
+}
+
+void BlockCompressor::encodeBC4(const uint8_t* pValues, uint8_t* pOutput)
+{
+    uint8_t minValue = 255;
+    uint8_t maxValue = 0;
+    for (int i = 0; i < BlockTexels; ++i)
+    {
+        minValue = std::min(minValue, pValues[i]);
+        maxValue = std::max(maxValue, pValues[i]);
+    }
+
+    memset(pOutput, 0, 8);
+    pOutput[0] = maxValue;
+    pOutput[1] = minValue;
+    if (minValue == maxValue)
+    {
+        return;
+    }
+
+    // Eight-value mode (red0 > red1): red0, red1 and six interpolated steps
+    int palette[8];
+    palette[0] = maxValue;
+    palette[1] = minValue;
+    for (int i = 1; i <= 6; ++i)
+    {
+        palette[i + 1] = ((7 - i) * maxValue + i * minValue + 3) / 7;
+    }
+
+    uint64_t indexBits = 0;
+    for (int i = 0; i < BlockTexels; ++i)
+    {
+        int bestIndex = 0;
+        int bestError = 256;
+        for (int p = 0; p < 8; ++p)
+        {
+            const int error = std::abs(pValues[i] - palette[p]);
+            if (error < bestError)
+            {
+                bestError = error;
+                bestIndex = p;
+            }
+        }
+        indexBits |= static_cast<uint64_t>(bestIndex) << (i * 3);
+    }
+
+    for (int i = 0; i < 6; ++i)
+    {
+        pOutput[2 + i] = static_cast<uint8_t>(indexBits >> (i * 8));
+    }
+}
+
+void BlockCompressor::encodeBC5(const uint8_t* pRed, const uint8_t* pGreen, uint8_t* pOutput)
+{
+    encodeBC4(pRed, pOutput);
+    encodeBC4(pGreen, pOutput + 8);
+}
+
+void BlockCompressor::encodeBC7(const uint8_t* pBlock, uint8_t* pOutput)
+{
+    float points[BlockTexels][4];
+    for (int i = 0; i < BlockTexels; ++i)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            points[i][c] = pBlock[i * 4 + c];
+        }
+    }
+
+    float e0[4], e1[4];
+    findEndpoints<4>(points, e0, e1);
+    BC7Candidate best = fitBC7(points, e0, e1);
+
+    float weights[BlockTexels];
+    for (int i = 0; i < BlockTexels; ++i)
+    {
+        weights[i] = BC7Weights4[best.indices[i]] / 64.0f;
+    }
+    refineEndpoints<4>(points, weights, e0, e1);
+    BC7Candidate refined = fitBC7(points, e0, e1);
+    if (refined.error < best.error)
+    {
+        best = refined;
+    }
+
+    // The anchor index (texel 0) is stored with its top bit implied zero
+    if (best.indices[0] & 8)
+    {
+        std::swap(best.endpoints[0], best.endpoints[1]);
+        for (int i = 0; i < BlockTexels; ++i)
+        {
+            best.indices[i] = static_cast<uint8_t>(15 - best.indices[i]);
+        }
+    }
+
+    BitWriter writer(pOutput);
+    writer.write(1u << 6, 7); // Mode 6
+    for (int c = 0; c < 4; ++c)
+    {
+        writer.write(best.endpoints[0].quantized[c], 7);
+        writer.write(best.endpoints[1].quantized[c], 7);
+    }
+    writer.write(best.endpoints[0].pBit, 1);
+    writer.write(best.endpoints[1].pBit, 1);
+    writer.write(best.indices[0], 3);
+    for (int i = 1; i < BlockTexels; ++i)
+    {
+        writer.write(best.indices[i], 4);
+    }
+}
+
+void BlockCompressor::decodeBC1(const uint8_t* pInput, uint8_t* pBlock)
+{
+    const uint16_t color0 = static_cast<uint16_t>(pInput[0] | (pInput[1] << 8));
+    const uint16_t color1 = static_cast<uint16_t>(pInput[2] | (pInput[3] << 8));
+    uint32_t indexBits;
+    memcpy(&indexBits, pInput + 4, 4);
+
+    float endpoints[2][3];
+    unpackRgb565(color0, endpoints[0]);
+    unpackRgb565(color1, endpoints[1]);
+
+    uint8_t palette[4][4];
+    for (int c = 0; c < 3; ++c)
+    {
+        const int e0 = static_cast<int>(endpoints[0][c]);
+        const int e1 = static_cast<int>(endpoints[1][c]);
+        palette[0][c] = static_cast<uint8_t>(e0);
+        palette[1][c] = static_cast<uint8_t>(e1);
+        // Three-colour mode (color0 <= color1) replaces the last entry with transparent black
+        palette[2][c] = static_cast<uint8_t>(color0 > color1 ? (2 * e0 + e1) / 3 : (e0 + e1) / 2);
+        palette[3][c] = static_cast<uint8_t>(color0 > color1 ? (e0 + 2 * e1) / 3 : 0);
+    }
+    palette[0][3] = palette[1][3] = palette[2][3] = 255;
+    palette[3][3] = color0 > color1 ? 255 : 0;
+
+    for (int i = 0; i < BlockTexels; ++i)
+    {
+        memcpy(pBlock + i * 4, palette[(indexBits >> (i * 2)) & 3], 4);
+    }
+}
+
+void BlockCompressor::decodeBC4(const uint8_t* pInput, uint8_t* pValues)
+{
+    const int red0 = pInput[0];
+    const int red1 = pInput[1];
+
+    int palette[8];
+    palette[0] = red0;
+    palette[1] = red1;
+    if (red0 > red1)
+    {
+        for (int i = 1; i <= 6; ++i)
+        {
+            palette[i + 1] = ((7 - i) * red0 + i * red1 + 3) / 7;
+        }
+    }
+    else
+    {
+        for (int i = 1; i <= 4; ++i)
+        {
+            palette[i + 1] = ((5 - i) * red0 + i * red1 + 2) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    uint64_t indexBits = 0;
+    for (int i = 0; i < 6; ++i)
+    {
+        indexBits |= static_cast<uint64_t>(pInput[2 + i]) << (i * 8);
+    }
+    for (int i = 0; i < BlockTexels; ++i)
+    {
+        pValues[i] = static_cast<uint8_t>(palette[(indexBits >> (i * 3)) & 7]);
+    }
+}
+
+void BlockCompressor::decodeBC5(const uint8_t* pInput, uint8_t* pRed, uint8_t* pGreen)
+{
+    decodeBC4(pInput, pRed);
+    decodeBC4(pInput + 8, pGreen);
+}
+
+bool BlockCompressor::decodeBC7(const uint8_t* pInput, uint8_t* pBlock)
+{
+    BitReader reader(pInput);
+    if (reader.read(7) != (1u << 6))
+    {
+        return false;
+    }
+
+    uint32_t quantized[2][4];
+    for (int c = 0; c < 4; ++c)
+    {
+        quantized[0][c] = reader.read(7);
+        quantized[1][c] = reader.read(7);
+    }
+    const uint32_t pBits[2] = { reader.read(1), reader.read(1) };
+
+    uint32_t endpoints[2][4];
+    for (int e = 0; e < 2; ++e)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            endpoints[e][c] = (quantized[e][c] << 1) | pBits[e];
+        }
+    }
+
+    for (int i = 0; i < BlockTexels; ++i)
+    {
+        const uint32_t weight = BC7Weights4[reader.read(i == 0 ? 3 : 4)];
+        for (int c = 0; c < 4; ++c)
+        {
+            pBlock[i * 4 + c] = static_cast<uint8_t>(((64 - weight) * endpoints[0][c] + weight * endpoints[1][c] + 32) >> 6);
+        }
+    }
+    return true;
+}
+
+bool BlockCompressor::runSelfCheck()
+{
+    bool passed = true;
+    auto check = [&](bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            CAE_LOG_ERROR(Asset, "BlockCompressor self-check failed: " << what);
+            passed = false;
+        }
+    };
+
+    // Largest per-channel difference over the first channels of 16 texels with the given stride
+    auto maxError = [](const uint8_t* pExpected, const uint8_t* pActual, int stride, int channels)
+    {
+        int error = 0;
+        for (int i = 0; i < BlockTexels; ++i)
+        {
+            for (int c = 0; c < channels; ++c)
+            {
+                error = std::max(error, std::abs(pExpected[i * stride + c] - pActual[i * stride + c]));
+            }
+        }
+        return error;
+    };
+
+    // Known blocks: solid colours exactly representable in 5:6:5, a solid colour that is not, a
+    // two-colour checker, and gradients running both ways so both endpoint orders occur
+    struct TestBlock
+    {
+        const char* name;
+        uint8_t texels[BlockTexels * 4];
+        int bc1Error;
+        int bc7Error;
+        int bc4Error;
+    };
+    std::vector<TestBlock> blocks;
+    auto addBlock = [&](const char* name, int bc1Error, int bc7Error, int bc4Error, auto texel)
+    {
+        TestBlock block{ name, {}, bc1Error, bc7Error, bc4Error };
+        for (int i = 0; i < BlockTexels; ++i)
+        {
+            texel(i, block.texels + i * 4);
+        }
+        blocks.push_back(block);
+    };
+    const uint8_t solids[3][4] = { { 255, 0, 0, 255 }, { 0, 255, 0, 255 }, { 255, 255, 255, 255 } };
+    for (const uint8_t* pSolid : solids)
+    {
+        addBlock("solid 5:6:5", 0, 1, 0, [&](int, uint8_t* pTexel) { memcpy(pTexel, pSolid, 4); });
+    }
+    addBlock("solid", 8, 1, 0, [](int, uint8_t* pTexel) { pTexel[0] = 13; pTexel[1] = 77; pTexel[2] = 200; pTexel[3] = 128; });
+    addBlock("checker", 8, 2, 1, [](int i, uint8_t* pTexel)
+    {
+        const bool odd = ((i & 3) + (i >> 2)) & 1;
+        pTexel[0] = odd ? 240 : 16;
+        pTexel[1] = odd ? 32 : 200;
+        pTexel[2] = odd ? 64 : 96;
+        pTexel[3] = 255;
+    });
+    addBlock("rising gradient", 40, 4, 18, [](int i, uint8_t* pTexel)
+    {
+        pTexel[0] = pTexel[1] = pTexel[2] = static_cast<uint8_t>(i * 17);
+        pTexel[3] = 255;
+    });
+    addBlock("falling gradient", 40, 4, 18, [](int i, uint8_t* pTexel)
+    {
+        pTexel[0] = static_cast<uint8_t>(255 - i * 17);
+        pTexel[1] = static_cast<uint8_t>(128 - i * 4);
+        pTexel[2] = static_cast<uint8_t>(i * 8);
+        pTexel[3] = static_cast<uint8_t>(255 - i * 12);
+    });
+
+    for (const TestBlock& block : blocks)
+    {
+        CAE_LOG_DEBUG(Asset, "BlockCompressor self-check: " << block.name);
+        uint8_t encoded[16];
+        uint8_t decoded[BlockTexels * 4];
+
+        encodeBC1(block.texels, encoded);
+        decodeBC1(encoded, decoded);
+        check(maxError(block.texels, decoded, 4, 3) <= block.bc1Error, "BC1 error bound");
+        const uint16_t color0 = static_cast<uint16_t>(encoded[0] | (encoded[1] << 8));
+        const uint16_t color1 = static_cast<uint16_t>(encoded[2] | (encoded[3] << 8));
+        check(color0 >= color1, "BC1 must not select the three-colour mode");
+
+        encodeBC7(block.texels, encoded);
+        check((encoded[0] & 0x7F) == 0x40, "BC7 mode 6 header");
+        check(decodeBC7(encoded, decoded), "BC7 decode");
+        check(maxError(block.texels, decoded, 4, 4) <= block.bc7Error, "BC7 error bound");
+
+        uint8_t red[BlockTexels];
+        uint8_t green[BlockTexels];
+        uint8_t decodedRed[BlockTexels];
+        uint8_t decodedGreen[BlockTexels];
+        for (int i = 0; i < BlockTexels; ++i)
+        {
+            red[i] = block.texels[i * 4];
+            green[i] = block.texels[i * 4 + 1];
+        }
+        encodeBC4(red, encoded);
+        decodeBC4(encoded, decodedRed);
+        check(maxError(red, decodedRed, 1, 1) <= block.bc4Error, "BC4 error bound");
+
+        encodeBC5(red, green, encoded);
+        decodeBC5(encoded, decodedRed, decodedGreen);
+        check(maxError(red, decodedRed, 1, 1) <= block.bc4Error && maxError(green, decodedGreen, 1, 1) <= block.bc4Error,
+              "BC5 error bound");
+    }
+
+    // Exact bit patterns: a solid BC4 block stores the value twice and all-zero indices
+    uint8_t values[BlockTexels];
+    memset(values, 123, sizeof(values));
+    uint8_t encoded[8];
+    encodeBC4(values, encoded);
+    const uint8_t expected[8] = { 123, 123, 0, 0, 0, 0, 0, 0 };
+    check(memcmp(encoded, expected, sizeof(expected)) == 0, "BC4 solid block bits");
+
+    CAE_LOG_INFO(Asset, "BlockCompressor self-check " << (passed ? "passed" : "FAILED") << " on " << blocks.size() << " blocks");
+    return passed;
+}
+
+void BlockCompressor::compress(const uint8_t* pPixels, uint32_t width, uint32_t height, Format format,
+                               const uint32_t channels[2], std::vector<uint8_t>& output)
+{
+    const uint32_t blocksX = (width + 3) / 4;
+    const uint32_t blocksY = (height + 3) / 4;
+    const size_t blockSize = getBlockSize(format);
+    output.resize(static_cast<size_t>(blocksX) * blocksY * blockSize);
+
+    const uint32_t redChannel = channels ? channels[0] : 0;
+    const uint32_t greenChannel = (channels && format == Format::BC5) ? channels[1] : 1;
+    if (redChannel > 3 || greenChannel > 3)
+    {
+        throw std::runtime_error("BlockCompressor: channel index out of range");
+    }
+
+    parallelFor(blocksY, [&](size_t blockY)
+    {
+        uint8_t block[BlockTexels * 4];
+        uint8_t red[BlockTexels];
+        uint8_t green[BlockTexels];
+
+        for (uint32_t blockX = 0; blockX < blocksX; ++blockX)
+        {
+            for (uint32_t y = 0; y < 4; ++y)
+            {
+                const uint32_t sourceY = std::min(static_cast<uint32_t>(blockY) * 4 + y, height - 1);
+                for (uint32_t x = 0; x < 4; ++x)
+                {
+                    const uint32_t sourceX = std::min(blockX * 4 + x, width - 1);
+                    const uint8_t* pTexel = pPixels + (static_cast<size_t>(sourceY) * width + sourceX) * 4;
+                    memcpy(block + (y * 4 + x) * 4, pTexel, 4);
+                    red[y * 4 + x] = pTexel[redChannel];
+                    green[y * 4 + x] = pTexel[greenChannel];
+                }
+            }
+
+            uint8_t* pOutput = output.data() + (blockY * blocksX + blockX) * blockSize;
+            switch (format)
+            {
+            case Format::BC1:
+                encodeBC1(block, pOutput);
+                break;
+            case Format::BC4:
+                encodeBC4(red, pOutput);
+                break;
+            case Format::BC5:
+                encodeBC5(red, green, pOutput);
+                break;
+            case Format::BC7:
+                encodeBC7(block, pOutput);
+                break;
+            }
+        }
+    });
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//
+// CPU encoders for the BC block formats we ship. Every encoder works on one 4x4 block:
+//   BC1 - RGB 5:6:5 endpoints, 2-bit indices, 8 bytes (opaque colour)
+//   BC4 - one 8-bit channel, 3-bit indices, 8 bytes (masks)
+//   BC5 - two independent BC4 channels, 16 bytes (normal XY, packed masks)
+//   BC7 - mode 6 only: RGBA 7.7.7.7 endpoints with p-bits and 4-bit indices, 16 bytes (albedo)
+// Endpoints come from the principal axis of the block and are refined once by least squares.
+// Encoding BC7 with mode 6 alone trades a little quality on multi-colour blocks for a simple,
+// fast encoder; the output is valid for any BC7 decoder.
+//
+class BlockCompressor
+{
+public:
+    enum class Format
+    {
+        BC1,
+        BC4,
+        BC5,
+        BC7
+    };
+
+    static size_t getBlockSize(Format format);
+
+    // pBlock holds 16 RGBA8 texels in row order
+    static void encodeBC1(const uint8_t* pBlock, uint8_t* pOutput);
+    static void encodeBC7(const uint8_t* pBlock, uint8_t* pOutput);
+    // pValues holds 16 single-channel texels in row order
+    static void encodeBC4(const uint8_t* pValues, uint8_t* pOutput);
+    static void encodeBC5(const uint8_t* pRed, const uint8_t* pGreen, uint8_t* pOutput);
+
+    // Inverse of the encoders, writing the same texel layouts. decodeBC7 handles mode 6 only, the
+    // mode encodeBC7 emits, and returns false for blocks of any other mode.
+    static void decodeBC1(const uint8_t* pInput, uint8_t* pBlock);
+    static bool decodeBC7(const uint8_t* pInput, uint8_t* pBlock);
+    static void decodeBC4(const uint8_t* pInput, uint8_t* pValues);
+    static void decodeBC5(const uint8_t* pInput, uint8_t* pRed, uint8_t* pGreen);
+
+    // Encodes known blocks with every format, decodes them again and checks the error bounds and a
+    // few exact bit patterns. Logs each failure and returns false if any check failed.
+    static bool runSelfCheck();
+
+    // Compresses an RGBA8 image; edge blocks replicate the last row/column. BC4 reads
+    // channels[0], BC5 reads channels[0] and channels[1]; null selects R and G. Block rows are encoded in parallel.
+    static void compress(const uint8_t* pPixels, uint32_t width, uint32_t height, Format format,
+                         const uint32_t channels[2], std::vector<uint8_t>& output);
+};
@@ -1,6 +1,6 @@
 // Buffer.cpp
 #include "Buffer.h"
-#include <iostream>
+#include "Runtime/EngineCore/Core/Log.h"
 
 Buffer::Buffer(VmaAllocator allocator,
                VkDeviceSize size,
@@ -23,7 +23,7 @@ Buffer::Buffer(VmaAllocator allocator,
     {
         throw std::runtime_error("Failed to create buffer!");
     }
-	std::cout << "Buffer created with size: " << size << " bytes" << std::endl;
+	CAE_LOG_TRACE(RHI, "Buffer created with size: " << size << " bytes");
 }
 
 Buffer::~Buffer() 
@@ -32,7 +32,7 @@ Buffer::~Buffer()
         unmap();
     }
     vmaDestroyBuffer(m_Allocator, m_Buffer, m_Allocation);
-	std::cout << "Buffer destroyed." << std::endl;
+	CAE_LOG_TRACE(RHI, "Buffer destroyed.");
 }
 
 VkBuffer Buffer::get() const 
@@ -65,14 +65,7 @@ void Buffer::flush(VkDeviceSize size)
     vmaFlushAllocation(m_Allocator, m_Allocation, 0, size);
 }
 
-void Buffer::copyTo(CommandPool* commandPool,VkQueue queue, Buffer* dstBuffer)
+void Buffer::flush(VkDeviceSize offset, VkDeviceSize size)
 {
-	VkCommandBuffer commandBuffer = commandPool->beginSingleTimeCommands();
-	VkBufferCopy copyRegion{};
-	copyRegion.srcOffset = 0;
-	copyRegion.dstOffset = 0;
-	copyRegion.size = m_BufferSize;
-	vkCmdCopyBuffer(commandBuffer, m_Buffer, dstBuffer->get(), 1, &copyRegion);
-	commandPool->endSingleTimeCommands(commandBuffer, queue);
-	std::cout << "Buffer copied to destination buffer." << std::endl;
+    vmaFlushAllocation(m_Allocator, m_Allocation, offset, size);
 }
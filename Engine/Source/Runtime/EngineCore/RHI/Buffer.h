@@ -20,7 +20,7 @@ public:
     void* map();
     void unmap();
     void flush(VkDeviceSize size = VK_WHOLE_SIZE);
-	void copyTo(CommandPool* commandPool,VkQueue queue, Buffer* dstBuffer);
+    void flush(VkDeviceSize offset, VkDeviceSize size);
 
 private:
     VmaAllocator m_Allocator;
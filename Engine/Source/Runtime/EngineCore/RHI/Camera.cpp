@@ -1,6 +1,6 @@
 #include "Camera.h"
+#include "Runtime/EngineCore/Core/Log.h"
 #include <algorithm>
-#include <iostream>
 Camera::Camera(GLFWwindow* window, glm::vec3 position, glm::vec3 up, float yaw, float pitch)
     : m_Window(window), m_Position(position), m_WorldUp(up), m_Yaw(yaw), m_Pitch(pitch),
       m_FirstMouse(true), m_MovementSpeed(2.5f), m_MouseSensitivity(0.1f),
@@ -55,11 +55,11 @@ void Camera::processKeyboard(float deltaTime)
         if (!m_F10Pressed) {
             m_DebugMode = (m_DebugMode + 1) % 3; // Cycle through modes 0, 1, 2
             if (m_DebugMode == 0) {
-std::cout << "Debug mode: Normal view" << std::endl;
+CAE_LOG_INFO(Core, "Debug mode: Normal view");
             } else if (m_DebugMode == 1) {
-                std::cout << "Debug mode: Position check view" << std::endl;
+                CAE_LOG_INFO(Core, "Debug mode: Position check view");
             } else if (m_DebugMode == 2) {
-                std::cout << "Debug mode: rainbow view" << std::endl;
+                CAE_LOG_INFO(Core, "Debug mode: rainbow view");
 			}
             m_F10Pressed = true;
         }
@@ -72,18 +72,18 @@ std::cout << "Debug mode: Normal view" << std::endl;
         if (!m_F2Pressed) {
             if (m_DebugMode < 3 || m_DebugMode > 6) {
                 m_DebugMode = 3; // Start at diffuse view
-std::cout << "Debug mode: Diffuse view" << std::endl;
+CAE_LOG_INFO(Core, "Debug mode: Diffuse view");
             } else {
                 m_DebugMode = (m_DebugMode + 1) % 7;
                 if (m_DebugMode < 3) m_DebugMode = 3; // Keep in G-buffer range
                 if (m_DebugMode == 3) {
-                    std::cout << "Debug mode: Diffuse view" << std::endl;
+                    CAE_LOG_INFO(Core, "Debug mode: Diffuse view");
                 } else if (m_DebugMode == 4) {
-std::cout << "Debug mode: Normal view" << std::endl;
+CAE_LOG_INFO(Core, "Debug mode: Normal view");
                 } else if (m_DebugMode == 5) {
-                    std::cout << "Debug mode: Specular view" << std::endl;
+                    CAE_LOG_INFO(Core, "Debug mode: Specular view");
                 } else if (m_DebugMode == 6) {
-                    std::cout << "Debug mode: worldpos view" << std::endl;
+                    CAE_LOG_INFO(Core, "Debug mode: worldpos view");
 				}
 
             }
@@ -97,7 +97,7 @@ std::cout << "Debug mode: Normal view" << std::endl;
     if (glfwGetKey(m_Window, GLFW_KEY_F1) == GLFW_PRESS) {
         if (!m_F1Pressed) {
             m_DebugMode = 0;
-			std::cout << "Debug mode: Normal view" << std::endl;
+			CAE_LOG_INFO(Core, "Debug mode: Normal view");
             m_F1Pressed = true;
         }
     } else {
@@ -108,7 +108,7 @@ std::cout << "Debug mode: Normal view" << std::endl;
     if (glfwGetKey(m_Window, GLFW_KEY_I) == GLFW_PRESS) {
         if (!m_IPressedLast) {
             m_IblIntensity += 0.25f;
-			std::cout << "IBL Intensity increased to " << m_IblIntensity << std::endl;
+			CAE_LOG_INFO(Core, "IBL Intensity increased to " << m_IblIntensity);
             m_IPressedLast = true;
         }
     } else {
@@ -118,7 +118,7 @@ std::cout << "Debug mode: Normal view" << std::endl;
     if (glfwGetKey(m_Window, GLFW_KEY_K) == GLFW_PRESS) {
         if (!m_KPressedLast) {
             m_IblIntensity = std::max(0.0f, m_IblIntensity - 0.25f);
-			std::cout << "IBL Intensity decreased to " << m_IblIntensity << std::endl;
+			CAE_LOG_INFO(Core, "IBL Intensity decreased to " << m_IblIntensity);
             m_KPressedLast = true;
         }
     } else {
@@ -129,7 +129,7 @@ std::cout << "Debug mode: Normal view" << std::endl;
     if (glfwGetKey(m_Window, GLFW_KEY_O) == GLFW_PRESS) {
         if (!m_OPressedLast) {
             m_SunIntensity *= 10.0f;
-			std::cout << "Sun Intensity increased to " << m_SunIntensity << std::endl;
+			CAE_LOG_INFO(Core, "Sun Intensity increased to " << m_SunIntensity);
             m_OPressedLast = true;
         }
     } else {
@@ -139,7 +139,7 @@ std::cout << "Debug mode: Normal view" << std::endl;
     if (glfwGetKey(m_Window, GLFW_KEY_L) == GLFW_PRESS) {
         if (!m_LPressedLast) {
             m_SunIntensity = std::max(0.1f, m_SunIntensity / 10.0f);
-			std::cout << "Sun Intensity decreased to " << m_SunIntensity << std::endl;
+			CAE_LOG_INFO(Core, "Sun Intensity decreased to " << m_SunIntensity);
             m_LPressedLast = true;
         }
     } else {
@@ -152,12 +152,12 @@ std::cout << "Debug mode: Normal view" << std::endl;
     
     if (uPressed && !m_UPressedLast) {
         m_ExposureSettings.ISO *= 2.0f; // Double ISO (one stop up)
-		std::cout << "ISO increased to: " << m_ExposureSettings.ISO << std::endl;
+		CAE_LOG_INFO(Core, "ISO increased to: " << m_ExposureSettings.ISO);
     }
     
     if (jPressed && !m_JPressedLast) {
         m_ExposureSettings.ISO /= 2.0f; // Halve ISO (one stop down)
-		std::cout << "ISO decreased to: " << m_ExposureSettings.ISO << std::endl;
+		CAE_LOG_INFO(Core, "ISO decreased to: " << m_ExposureSettings.ISO);
     }
     
     m_UPressedLast = uPressed;
@@ -1,7 +1,7 @@
 // CommandPool.cpp
 #include "CommandPool.h"
+#include "Runtime/EngineCore/Core/Log.h"
 #include <stdexcept>
-#include <iostream>
 
 CommandPool::CommandPool(VkDevice device, uint32_t queueFamilyIndex)
     : m_Device(device) 
@@ -15,13 +15,18 @@ CommandPool::CommandPool(VkDevice device, uint32_t queueFamilyIndex)
     {
         throw std::runtime_error("failed to create command pool!");
     }
-	std::cout << "CommandPool Created." << std::endl;
+	CAE_LOG_TRACE(RHI, "CommandPool Created.");
 }
 
 CommandPool::~CommandPool() 
 {
+    waitAll();
+    for (VkFence fence : m_FreeFences)
+    {
+        vkDestroyFence(m_Device, fence, nullptr);
+    }
     vkDestroyCommandPool(m_Device, m_CommandPool, nullptr);
-	std::cout << "CommandPool Destroyed." << std::endl;
+	CAE_LOG_TRACE(RHI, "CommandPool Destroyed.");
 }
 
 VkCommandPool CommandPool::get() const 
@@ -52,15 +57,27 @@ void CommandPool::freeCommandBuffer(VkCommandBuffer commandBuffer)
 
 VkCommandBuffer CommandPool::beginSingleTimeCommands()
 {
-    VkCommandBufferAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandPool = m_CommandPool;
-    allocInfo.commandBufferCount = 1;
+    // Reclaim finished submissions nobody polled
+    for (size_t i = m_InFlight.size(); i-- > 0;)
+    {
+        if (vkGetFenceStatus(m_Device, m_InFlight[i].fence) == VK_SUCCESS)
+        {
+            retire(i);
+        }
+    }
 
     VkCommandBuffer commandBuffer;
-    vkAllocateCommandBuffers(m_Device, &allocInfo, &commandBuffer);
+    if (!m_FreeCommandBuffers.empty())
+    {
+        commandBuffer = m_FreeCommandBuffers.back();
+        m_FreeCommandBuffers.pop_back();
+    }
+    else
+    {
+        commandBuffer = allocateCommandBuffer();
+    }
 
+    // Beginning implicitly resets a recycled buffer (the pool has RESET_COMMAND_BUFFER)
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
@@ -70,17 +87,104 @@ VkCommandBuffer CommandPool::beginSingleTimeCommands()
     return commandBuffer;
 }
 
-void CommandPool::endSingleTimeCommands(VkCommandBuffer commandBuffer, VkQueue queue)
+uint64_t CommandPool::submitSingleTimeCommands(VkCommandBuffer commandBuffer, VkQueue queue, const SubmitSemaphores& semaphores)
 {
     vkEndCommandBuffer(commandBuffer);
 
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
+    VkFence fence;
+    if (!m_FreeFences.empty())
+    {
+        fence = m_FreeFences.back();
+        m_FreeFences.pop_back();
+    }
+    else
+    {
+        VkFenceCreateInfo fenceInfo{};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        if (vkCreateFence(m_Device, &fenceInfo, nullptr, &fence) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to create submission fence!");
+        }
+    }
 
-    vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(queue);
+    VkCommandBufferSubmitInfo commandBufferInfo{};
+    commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+    commandBufferInfo.commandBuffer = commandBuffer;
 
-    vkFreeCommandBuffers(m_Device, m_CommandPool, 1, &commandBuffer);
+    VkSubmitInfo2 submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+    submitInfo.waitSemaphoreInfoCount = static_cast<uint32_t>(semaphores.waits.size());
+    submitInfo.pWaitSemaphoreInfos = semaphores.waits.data();
+    submitInfo.commandBufferInfoCount = 1;
+    submitInfo.pCommandBufferInfos = &commandBufferInfo;
+    submitInfo.signalSemaphoreInfoCount = static_cast<uint32_t>(semaphores.signals.size());
+    submitInfo.pSignalSemaphoreInfos = semaphores.signals.data();
+
+    if (vkQueueSubmit2(queue, 1, &submitInfo, fence) != VK_SUCCESS)
+    {
+        m_FreeFences.push_back(fence);
+        throw std::runtime_error("failed to submit single time commands!");
+    }
+
+    const uint64_t id = m_NextSubmission++;
+    m_InFlight.push_back({ id, commandBuffer, fence });
+    return id;
+}
+
+void CommandPool::endSingleTimeCommands(VkCommandBuffer commandBuffer, VkQueue queue)
+{
+    wait(submitSingleTimeCommands(commandBuffer, queue));
+}
+
+bool CommandPool::isComplete(uint64_t submission)
+{
+    for (size_t i = 0; i < m_InFlight.size(); ++i)
+    {
+        if (m_InFlight[i].id != submission)
+        {
+            continue;
+        }
+        if (vkGetFenceStatus(m_Device, m_InFlight[i].fence) != VK_SUCCESS)
+        {
+            return false;
+        }
+        retire(i);
+        return true;
+    }
+
+    // Not in flight: either retired already or never submitted
+    return submission < m_NextSubmission;
+}
+
+void CommandPool::wait(uint64_t submission)
+{
+    for (size_t i = 0; i < m_InFlight.size(); ++i)
+    {
+        if (m_InFlight[i].id == submission)
+        {
+            vkWaitForFences(m_Device, 1, &m_InFlight[i].fence, VK_TRUE, UINT64_MAX);
+            retire(i);
+            return;
+        }
+    }
+}
+
+void CommandPool::waitAll()
+{
+    while (!m_InFlight.empty())
+    {
+        vkWaitForFences(m_Device, 1, &m_InFlight.back().fence, VK_TRUE, UINT64_MAX);
+        retire(m_InFlight.size() - 1);
+    }
+}
+
+void CommandPool::retire(size_t index)
+{
+    Submission submission = m_InFlight[index];
+    m_InFlight[index] = m_InFlight.back();
+    m_InFlight.pop_back();
+
+    vkResetFences(m_Device, 1, &submission.fence);
+    m_FreeFences.push_back(submission.fence);
+    m_FreeCommandBuffers.push_back(submission.commandBuffer);
 }
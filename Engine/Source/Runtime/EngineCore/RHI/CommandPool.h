@@ -1,9 +1,20 @@
 #pragma once
 #include <vulkan/vulkan.h>
 
+#include <cstdint>
+#include <vector>
+
 class CommandPool 
 {
 public:
+    // Semaphores a one-shot submission waits on and signals, for chaining it with other queue work.
+    // Timeline semaphores take their value from VkSemaphoreSubmitInfo::value.
+    struct SubmitSemaphores
+    {
+        std::vector<VkSemaphoreSubmitInfo> waits;
+        std::vector<VkSemaphoreSubmitInfo> signals;
+    };
+
     CommandPool(VkDevice device, uint32_t queueFamilyIndex);
     ~CommandPool();
 
@@ -12,10 +23,34 @@ public:
     VkCommandBuffer allocateCommandBuffer(VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
     void freeCommandBuffer(VkCommandBuffer commandBuffer);
 
+    // Begins a recycled primary command buffer for one submission
 	VkCommandBuffer beginSingleTimeCommands();
+    // Ends and submits the command buffer with a pool-owned fence and returns without waiting. The
+    // returned id increases with every submission; poll it with isComplete() or block with wait().
+    // The command buffer and fence are recycled once the submission is seen complete.
+    uint64_t submitSingleTimeCommands(VkCommandBuffer commandBuffer, VkQueue queue, const SubmitSemaphores& semaphores = {});
+    // Submits and waits for this submission only; other work on the queue keeps running
 	void endSingleTimeCommands(VkCommandBuffer commandBuffer, VkQueue queue);
 
+    bool isComplete(uint64_t submission);
+    void wait(uint64_t submission);
+    void waitAll();
+
 private:
+    struct Submission
+    {
+        uint64_t id;
+        VkCommandBuffer commandBuffer;
+        VkFence fence;
+    };
+
+    void retire(size_t index);
+
     VkDevice m_Device;
     VkCommandPool m_CommandPool;
+
+    uint64_t m_NextSubmission = 1;
+    std::vector<Submission> m_InFlight;
+    std::vector<VkCommandBuffer> m_FreeCommandBuffers;
+    std::vector<VkFence> m_FreeFences;
 };
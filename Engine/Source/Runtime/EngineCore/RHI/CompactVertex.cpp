@@ -0,0 +1,281 @@
+#include "CompactVertex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "Model.h"
+#include "Runtime/EngineCore/Core/Half.h"
+#include "Runtime/EngineCore/Core/ParallelFor.h"
+
+namespace
+{
+    constexpr uint32_t NoSubmesh = UINT32_MAX;
+
+    int16_t encodeSnorm16(float value)
+    {
+        return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    float decodeSnorm16(int16_t value)
+    {
+        return std::max(static_cast<float>(value) / 32767.0f, -1.0f);
+    }
+
+    float signNotZero(float value)
+    {
+        return value >= 0.0f ? 1.0f : -1.0f;
+    }
+
+    void encodeOctahedral(const glm::vec3& direction, int16_t out[2])
+    {
+        float sum = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+        if (sum == 0.0f)
+        {
+            out[0] = out[1] = 0;
+            return;
+        }
+
+        glm::vec2 p = glm::vec2(direction.x, direction.y) / sum;
+        if (direction.z < 0.0f)
+        {
+            p = glm::vec2((1.0f - std::abs(p.y)) * signNotZero(p.x), (1.0f - std::abs(p.x)) * signNotZero(p.y));
+        }
+        out[0] = encodeSnorm16(p.x);
+        out[1] = encodeSnorm16(p.y);
+    }
+
+    glm::vec3 decodeOctahedral(const int16_t in[2])
+    {
+        glm::vec3 v(decodeSnorm16(in[0]), decodeSnorm16(in[1]), 0.0f);
+        v.z = 1.0f - std::abs(v.x) - std::abs(v.y);
+        float t = std::max(-v.z, 0.0f);
+        v.x += v.x >= 0.0f ? -t : t;
+        v.y += v.y >= 0.0f ? -t : t;
+        return glm::normalize(v);
+    }
+
+    float angleDegrees(const glm::vec3& a, const glm::vec3& b)
+    {
+        if (glm::length(a) == 0.0f || glm::length(b) == 0.0f)
+        {
+            return 0.0f;
+        }
+        // atan2 stays accurate for the tiny angles quantization produces, unlike acos
+        return glm::degrees(std::atan2(glm::length(glm::cross(a, b)), glm::dot(a, b)));
+    }
+}
+
+VkVertexInputBindingDescription CompactVertex::getBindingDescription()
+{
+    VkVertexInputBindingDescription bindingDescription{};
+    bindingDescription.binding = 0;
+    bindingDescription.stride = sizeof(CompactVertex);
+    bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    return bindingDescription;
+}
+
+std::vector<VkVertexInputAttributeDescription> CompactVertex::getAttributeDescriptions(VertexFormat format)
+{
+    std::vector<VkVertexInputAttributeDescription> attributeDescriptions(4);
+
+    attributeDescriptions[0].binding = 0;
+    attributeDescriptions[0].location = 0;
+    attributeDescriptions[0].format = format == VertexFormat::CompactHalf ? VK_FORMAT_R16G16B16A16_SFLOAT : VK_FORMAT_R16G16B16A16_UNORM;
+    attributeDescriptions[0].offset = offsetof(CompactVertex, position);
+
+    attributeDescriptions[1].binding = 0;
+    attributeDescriptions[1].location = 1;
+    attributeDescriptions[1].format = VK_FORMAT_R16G16_SFLOAT;
+    attributeDescriptions[1].offset = offsetof(CompactVertex, texCoord);
+
+    attributeDescriptions[2].binding = 0;
+    attributeDescriptions[2].location = 2;
+    attributeDescriptions[2].format = VK_FORMAT_R16G16_SNORM;
+    attributeDescriptions[2].offset = offsetof(CompactVertex, normal);
+
+    attributeDescriptions[3].binding = 0;
+    attributeDescriptions[3].location = 3;
+    attributeDescriptions[3].format = VK_FORMAT_R16G16_SNORM;
+    attributeDescriptions[3].offset = offsetof(CompactVertex, tangent);
+
+    return attributeDescriptions;
+}
+
+CompactVertexEncoder::CompactVertexEncoder(VertexFormat format)
+    : m_Format(format)
+{
+    if (format == VertexFormat::Standard)
+    {
+        throw std::runtime_error("CompactVertexEncoder requires a compact vertex format");
+    }
+}
+
+void CompactVertexEncoder::getPositionDequantization(const Submesh& submesh, VertexFormat format, float offset[3], float scale[3])
+{
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (format == VertexFormat::CompactHalf)
+        {
+            offset[axis] = (submesh.bboxMin[axis] + submesh.bboxMax[axis]) * 0.5f;
+            scale[axis] = 1.0f;
+        }
+        else
+        {
+            offset[axis] = submesh.bboxMin[axis];
+            scale[axis] = submesh.bboxMax[axis] - submesh.bboxMin[axis];
+        }
+    }
+}
+
+void CompactVertexEncoder::encode(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                                  const std::vector<Submesh>& submeshes, std::vector<CompactVertex>& output)
+{
+    std::vector<uint32_t> owner(vertices.size(), NoSubmesh);
+    for (uint32_t s = 0; s < submeshes.size(); ++s)
+    {
+        const Submesh& submesh = submeshes[s];
+        for (uint32_t i = submesh.indexStart; i < submesh.indexStart + submesh.indexCount; ++i)
+        {
+            uint32_t& vertexOwner = owner[indices[i]];
+            if (vertexOwner != NoSubmesh && vertexOwner != s)
+            {
+                throw std::runtime_error("Compact vertices cannot be shared between submeshes; weld per submesh");
+            }
+            vertexOwner = s;
+        }
+    }
+
+    output.resize(vertices.size());
+
+    const size_t batchSize = 65536;
+    const size_t batchCount = (vertices.size() + batchSize - 1) / batchSize;
+    std::vector<ErrorReport> batchReports(batchCount);
+    std::vector<double> batchPositionErrorSums(batchCount, 0.0);
+    std::vector<double> batchNormalErrorSums(batchCount, 0.0);
+
+    parallelFor(batchCount, [&](size_t batch)
+    {
+        ErrorReport& report = batchReports[batch];
+        const size_t end = std::min(vertices.size(), (batch + 1) * batchSize);
+
+        for (size_t i = batch * batchSize; i < end; ++i)
+        {
+            const Vertex& source = vertices[i];
+            CompactVertex& encoded = output[i];
+
+            Submesh bounds{};
+            if (owner[i] != NoSubmesh)
+            {
+                bounds = submeshes[owner[i]];
+            }
+
+            float offset[3];
+            float scale[3];
+            getPositionDequantization(bounds, m_Format, offset, scale);
+
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                float value = source.pos[axis] - offset[axis];
+                if (m_Format == VertexFormat::CompactHalf)
+                {
+                    encoded.position[axis] = floatToHalf(value);
+                }
+                else
+                {
+                    float normalized = scale[axis] > 0.0f ? std::clamp(value / scale[axis], 0.0f, 1.0f) : 0.0f;
+                    encoded.position[axis] = static_cast<uint16_t>(std::lround(normalized * 65535.0f));
+                }
+            }
+
+            const bool negativeBitangent = glm::dot(glm::cross(source.normal, source.tangent), source.bitangent) < 0.0f;
+            if (m_Format == VertexFormat::CompactHalf)
+            {
+                encoded.position[3] = floatToHalf(negativeBitangent ? -1.0f : 1.0f);
+            }
+            else
+            {
+                encoded.position[3] = negativeBitangent ? 0 : 65535;
+            }
+
+            encoded.texCoord[0] = floatToHalf(source.texCoord.x);
+            encoded.texCoord[1] = floatToHalf(source.texCoord.y);
+            encodeOctahedral(source.normal, encoded.normal);
+            encodeOctahedral(source.tangent, encoded.tangent);
+
+            if (owner[i] == NoSubmesh)
+            {
+                continue; // Never drawn, so it does not contribute to the error report
+            }
+
+            const Vertex decoded = decode(encoded, bounds, m_Format);
+
+            float positionError = glm::length(decoded.pos - source.pos);
+            float normalError = angleDegrees(decoded.normal, source.normal);
+            glm::vec2 texCoordError = glm::abs(decoded.texCoord - source.texCoord);
+
+            ++report.vertexCount;
+            report.maxPositionError = std::max(report.maxPositionError, positionError);
+            report.maxNormalErrorDegrees = std::max(report.maxNormalErrorDegrees, normalError);
+            report.maxTangentErrorDegrees = std::max(report.maxTangentErrorDegrees, angleDegrees(decoded.tangent, source.tangent));
+            report.maxBitangentErrorDegrees = std::max(report.maxBitangentErrorDegrees, angleDegrees(decoded.bitangent, source.bitangent));
+            report.maxTexCoordError = std::max({ report.maxTexCoordError, texCoordError.x, texCoordError.y });
+            batchPositionErrorSums[batch] += positionError;
+            batchNormalErrorSums[batch] += normalError;
+        }
+    });
+
+    m_ErrorReport = ErrorReport{};
+    double positionErrorSum = 0.0;
+    double normalErrorSum = 0.0;
+    for (size_t batch = 0; batch < batchCount; ++batch)
+    {
+        const ErrorReport& report = batchReports[batch];
+        m_ErrorReport.vertexCount += report.vertexCount;
+        m_ErrorReport.maxPositionError = std::max(m_ErrorReport.maxPositionError, report.maxPositionError);
+        m_ErrorReport.maxNormalErrorDegrees = std::max(m_ErrorReport.maxNormalErrorDegrees, report.maxNormalErrorDegrees);
+        m_ErrorReport.maxTangentErrorDegrees = std::max(m_ErrorReport.maxTangentErrorDegrees, report.maxTangentErrorDegrees);
+        m_ErrorReport.maxBitangentErrorDegrees = std::max(m_ErrorReport.maxBitangentErrorDegrees, report.maxBitangentErrorDegrees);
+        m_ErrorReport.maxTexCoordError = std::max(m_ErrorReport.maxTexCoordError, report.maxTexCoordError);
+        positionErrorSum += batchPositionErrorSums[batch];
+        normalErrorSum += batchNormalErrorSums[batch];
+    }
+
+    if (m_ErrorReport.vertexCount > 0)
+    {
+        m_ErrorReport.meanPositionError = static_cast<float>(positionErrorSum / m_ErrorReport.vertexCount);
+        m_ErrorReport.meanNormalErrorDegrees = static_cast<float>(normalErrorSum / m_ErrorReport.vertexCount);
+    }
+}
+
+Vertex CompactVertexEncoder::decode(const CompactVertex& vertex, const Submesh& submesh, VertexFormat format)
+{
+    float offset[3];
+    float scale[3];
+    getPositionDequantization(submesh, format, offset, scale);
+
+    Vertex decoded{};
+    float bitangentSign;
+    if (format == VertexFormat::CompactHalf)
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            decoded.pos[axis] = offset[axis] + scale[axis] * halfToFloat(vertex.position[axis]);
+        }
+        bitangentSign = signNotZero(halfToFloat(vertex.position[3]));
+    }
+    else
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            decoded.pos[axis] = offset[axis] + scale[axis] * (vertex.position[axis] / 65535.0f);
+        }
+        bitangentSign = vertex.position[3] >= 32768 ? 1.0f : -1.0f;
+    }
+
+    decoded.texCoord = glm::vec2(halfToFloat(vertex.texCoord[0]), halfToFloat(vertex.texCoord[1]));
+    decoded.normal = decodeOctahedral(vertex.normal);
+    decoded.tangent = decodeOctahedral(vertex.tangent);
+    decoded.bitangent = glm::cross(decoded.normal, decoded.tangent) * bitangentSign;
+    return decoded;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct Vertex;
+struct Submesh;
+
+enum class VertexFormat
+{
+    Standard,         // Vertex: 56 bytes, full floats
+    CompactQuantized, // CompactVertex with UNORM16 positions inside the submesh AABB
+    CompactHalf       // CompactVertex with half-float positions relative to the AABB centre
+};
+
+//
+// 20-byte vertex. Positions are stored relative to the owning Submesh's bounds, so the
+// shader reconstructs them as offset + scale * position.xyz using getPositionDequantization().
+// position.w carries the bitangent sign; the bitangent is cross(normal, tangent) * sign.
+// Normals and tangents are octahedral encoded.
+//
+struct CompactVertex
+{
+    uint16_t position[4]; // R16G16B16A16_UNORM or _SFLOAT depending on the format
+    uint16_t texCoord[2]; // R16G16_SFLOAT
+    int16_t normal[2];    // R16G16_SNORM octahedral
+    int16_t tangent[2];   // R16G16_SNORM octahedral
+
+    static VkVertexInputBindingDescription getBindingDescription();
+    static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions(VertexFormat format);
+};
+
+static_assert(sizeof(CompactVertex) == 20, "CompactVertex layout must match its attribute descriptions");
+
+class CompactVertexEncoder
+{
+public:
+    struct ErrorReport
+    {
+        size_t vertexCount = 0;
+        float maxPositionError = 0.0f;      // World units
+        float meanPositionError = 0.0f;
+        float maxNormalErrorDegrees = 0.0f;
+        float meanNormalErrorDegrees = 0.0f;
+        float maxTangentErrorDegrees = 0.0f;
+        float maxBitangentErrorDegrees = 0.0f; // Includes non-orthogonal source bitangents
+        float maxTexCoordError = 0.0f;
+    };
+
+    explicit CompactVertexEncoder(VertexFormat format);
+
+    // Each vertex is quantized against the bounds of the submesh that references it,
+    // so vertices must not be shared between submeshes (weld per submesh).
+    void encode(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                const std::vector<Submesh>& submeshes, std::vector<CompactVertex>& output);
+
+    static Vertex decode(const CompactVertex& vertex, const Submesh& submesh, VertexFormat format);
+
+    // Shader constants for a submesh: position = offset + scale * encoded.xyz
+    static void getPositionDequantization(const Submesh& submesh, VertexFormat format, float offset[3], float scale[3]);
+
+    const ErrorReport& getErrorReport() const { return m_ErrorReport; }
+
+private:
+    VertexFormat m_Format;
+    ErrorReport m_ErrorReport;
+};
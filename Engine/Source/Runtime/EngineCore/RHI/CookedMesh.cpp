@@ -0,0 +1,501 @@
+#include "CookedMesh.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Model.h"
+
+// Sections holding these types are written and read as raw arrays
+static_assert(std::is_trivially_copyable_v<Vertex> && sizeof(Vertex) == 56, "Vertex layout is part of the cooked format");
+static_assert(std::is_trivially_copyable_v<MeshLod> && sizeof(MeshLod) == 12, "MeshLod layout is part of the cooked format");
+static_assert(std::is_trivially_copyable_v<Meshlet> && sizeof(Meshlet) == 64, "Meshlet layout is part of the cooked format");
+
+namespace
+{
+    size_t alignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    void writeString(std::vector<uint8_t>& output, const std::string& text)
+    {
+        uint32_t length = static_cast<uint32_t>(text.size());
+        const uint8_t* pLength = reinterpret_cast<const uint8_t*>(&length);
+        output.insert(output.end(), pLength, pLength + sizeof(length));
+        output.insert(output.end(), text.begin(), text.end());
+    }
+
+    // Texture paths are written relative to the cooked file's directory so the cook can be moved along
+    // with its textures, and independently of the working directory of the cooker
+    std::string makeRelativePath(const std::string& path, const std::filesystem::path& directory)
+    {
+        if (path.empty())
+        {
+            return path;
+        }
+        return std::filesystem::absolute(path).lexically_proximate(directory).generic_string();
+    }
+
+    std::string resolveRelativePath(const std::string& path, const std::filesystem::path& directory)
+    {
+        if (path.empty() || std::filesystem::path(path).is_absolute())
+        {
+            return path;
+        }
+        return (directory / path).lexically_normal().string();
+    }
+
+    std::string readString(const uint8_t*& pData, const uint8_t* pEnd)
+    {
+        uint32_t length;
+        if (static_cast<size_t>(pEnd - pData) < sizeof(length))
+        {
+            throw std::runtime_error("Cooked mesh: truncated material table");
+        }
+        memcpy(&length, pData, sizeof(length));
+        pData += sizeof(length);
+        if (static_cast<size_t>(pEnd - pData) < length)
+        {
+            throw std::runtime_error("Cooked mesh: truncated material table");
+        }
+        std::string text(reinterpret_cast<const char*>(pData), length);
+        pData += length;
+        return text;
+    }
+
+    // The sampler state a glTF material can carry; the other Desc fields keep their defaults
+    struct SamplerRecord
+    {
+        uint8_t magFilter;
+        uint8_t minFilter;
+        uint8_t mipmapMode;
+        uint8_t addressModeU;
+        uint8_t addressModeV;
+        uint8_t padding[3];
+        float maxAnisotropy;
+        float maxLod;
+    };
+
+    // Three empty path strings and a sampler; bounds the material count a table of a given size can hold
+    constexpr size_t MinMaterialRecordSize = 3 * sizeof(uint32_t) + sizeof(SamplerRecord);
+
+    void writeSampler(std::vector<uint8_t>& output, const SamplerCache::Desc& desc)
+    {
+        SamplerRecord record{};
+        record.magFilter = static_cast<uint8_t>(desc.magFilter);
+        record.minFilter = static_cast<uint8_t>(desc.minFilter);
+        record.mipmapMode = static_cast<uint8_t>(desc.mipmapMode);
+        record.addressModeU = static_cast<uint8_t>(desc.addressModeU);
+        record.addressModeV = static_cast<uint8_t>(desc.addressModeV);
+        record.maxAnisotropy = desc.maxAnisotropy;
+        record.maxLod = desc.maxLod;
+        const uint8_t* pRecord = reinterpret_cast<const uint8_t*>(&record);
+        output.insert(output.end(), pRecord, pRecord + sizeof(record));
+    }
+
+    SamplerCache::Desc readSampler(const uint8_t*& pData, const uint8_t* pEnd, const std::string& path)
+    {
+        SamplerRecord record;
+        if (static_cast<size_t>(pEnd - pData) < sizeof(record))
+        {
+            throw std::runtime_error("Cooked mesh: truncated material table");
+        }
+        memcpy(&record, pData, sizeof(record));
+        pData += sizeof(record);
+
+        // Only values cook() can write are accepted, so a corrupt record never becomes an invalid Vk enum
+        if (record.magFilter > VK_FILTER_LINEAR || record.minFilter > VK_FILTER_LINEAR)
+        {
+            throw std::runtime_error("Cooked mesh sampler has an invalid filter: " + path);
+        }
+        if (record.mipmapMode > VK_SAMPLER_MIPMAP_MODE_LINEAR)
+        {
+            throw std::runtime_error("Cooked mesh sampler has an invalid mipmap mode: " + path);
+        }
+        if (record.addressModeU > VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER || record.addressModeV > VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER)
+        {
+            throw std::runtime_error("Cooked mesh sampler has an invalid address mode: " + path);
+        }
+
+        SamplerCache::Desc desc;
+        desc.magFilter = static_cast<VkFilter>(record.magFilter);
+        desc.minFilter = static_cast<VkFilter>(record.minFilter);
+        desc.mipmapMode = static_cast<VkSamplerMipmapMode>(record.mipmapMode);
+        desc.addressModeU = static_cast<VkSamplerAddressMode>(record.addressModeU);
+        desc.addressModeV = static_cast<VkSamplerAddressMode>(record.addressModeV);
+        desc.maxAnisotropy = record.maxAnisotropy;
+        desc.maxLod = record.maxLod;
+        return desc;
+    }
+
+    template<typename T>
+    std::pair<const void*, size_t> arrayBytes(const std::vector<T>* pArray)
+    {
+        if (pArray == nullptr || pArray->empty())
+        {
+            return { nullptr, 0 };
+        }
+        return { pArray->data(), pArray->size() * sizeof(T) };
+    }
+}
+
+CookedMesh::CookedMesh(const std::string& path)
+{
+    open(path);
+}
+
+size_t CookedMesh::getIndexSize(VkIndexType indexType)
+{
+    return indexType == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+size_t CookedMesh::getVertexStride(VertexFormat format)
+{
+    return format == VertexFormat::Standard ? sizeof(Vertex) : sizeof(CompactVertex);
+}
+
+void CookedMesh::cook(const std::string& path, const Contents& contents)
+{
+    if (contents.pSubmeshes == nullptr)
+    {
+        throw std::runtime_error("Cooked mesh: no submeshes to cook for " + path);
+    }
+
+    std::vector<SubmeshRecord> submeshRecords;
+    submeshRecords.reserve(contents.pSubmeshes->size());
+    for (const Submesh& submesh : *contents.pSubmeshes)
+    {
+        SubmeshRecord record{};
+        record.indexStart = submesh.indexStart;
+        record.indexCount = submesh.indexCount;
+        record.materialIndex = submesh.materialIndex;
+        record.meshletOffset = submesh.meshletOffset;
+        record.meshletCount = submesh.meshletCount;
+        record.lodOffset = submesh.lodOffset;
+        record.lodCount = submesh.lodCount;
+        record.vertexOffset = submesh.vertexOffset;
+        memcpy(record.bboxMin, &submesh.bboxMin, sizeof(record.bboxMin));
+        memcpy(record.bboxMax, &submesh.bboxMax, sizeof(record.bboxMax));
+        submeshRecords.push_back(record);
+    }
+
+    std::vector<uint8_t> materialTable;
+    if (contents.pMaterials != nullptr)
+    {
+        const std::filesystem::path directory = std::filesystem::absolute(path).parent_path();
+        uint32_t materialCount = static_cast<uint32_t>(contents.pMaterials->size());
+        const uint8_t* pCount = reinterpret_cast<const uint8_t*>(&materialCount);
+        materialTable.insert(materialTable.end(), pCount, pCount + sizeof(materialCount));
+        for (const MaterialDesc& material : *contents.pMaterials)
+        {
+            writeString(materialTable, makeRelativePath(material.diffusePath, directory));
+            writeString(materialTable, makeRelativePath(material.normalPath, directory));
+            writeString(materialTable, makeRelativePath(material.metallicRoughnessPath, directory));
+            writeSampler(materialTable, material.sampler);
+        }
+    }
+
+    const size_t vertexStride = getVertexStride(contents.vertexFormat);
+    std::pair<const void*, size_t> sections[SectionCount] = {
+        { contents.pVertices, contents.vertexCount * vertexStride },
+        { contents.pIndices, contents.indexCount * getIndexSize(contents.indexType) },
+        { submeshRecords.data(), submeshRecords.size() * sizeof(SubmeshRecord) },
+        arrayBytes(contents.pLods),
+        arrayBytes(contents.pMeshlets),
+        arrayBytes(contents.pMeshletVertices),
+        arrayBytes(contents.pMeshletTriangles),
+        { materialTable.data(), materialTable.size() },
+        { contents.pDepthVertices, contents.depthVertexDataSize },
+    };
+
+    Header header{};
+    header.magic = Magic;
+    header.version = Version;
+    header.vertexFormat = static_cast<uint32_t>(contents.vertexFormat);
+    header.vertexStride = static_cast<uint32_t>(vertexStride);
+    header.vertexCount = contents.vertexCount;
+    header.indexCount = contents.indexCount;
+    header.indexSize = static_cast<uint32_t>(getIndexSize(contents.indexType));
+    header.depthStream = static_cast<uint32_t>(contents.depthStream);
+    header.depthStride = DepthVertexStream::getStride(contents.vertexFormat, contents.depthStream);
+    memcpy(header.bboxMin, &contents.bboxMin, sizeof(header.bboxMin));
+    memcpy(header.bboxMax, &contents.bboxMax, sizeof(header.bboxMax));
+
+    size_t offset = alignUp(sizeof(Header), SectionAlignment);
+    for (uint32_t i = 0; i < SectionCount; ++i)
+    {
+        header.sections[i].offset = offset;
+        header.sections[i].size = sections[i].second;
+        offset = alignUp(offset + sections[i].second, SectionAlignment);
+    }
+
+    // Write to a temporary file first so an interrupted cook never leaves a valid-looking blob behind
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Failed to create cooked mesh: " + tempPath);
+        }
+
+        static const char padding[SectionAlignment] = {};
+        auto pad = [&](size_t position)
+        {
+            file.write(padding, static_cast<std::streamsize>(alignUp(position, SectionAlignment) - position));
+        };
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        pad(sizeof(header));
+        for (uint32_t i = 0; i < SectionCount; ++i)
+        {
+            if (sections[i].second != 0)
+            {
+                file.write(static_cast<const char*>(sections[i].first), static_cast<std::streamsize>(sections[i].second));
+            }
+            pad(header.sections[i].offset + sections[i].second);
+        }
+
+        if (!file)
+        {
+            throw std::runtime_error("Failed to write cooked mesh: " + tempPath);
+        }
+    }
+
+    std::remove(path.c_str());
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0)
+    {
+        throw std::runtime_error("Failed to move cooked mesh into place: " + path);
+    }
+}
+
+void CookedMesh::open(const std::string& path)
+{
+    close();
+    m_File.open(path);
+
+    if (m_File.size() < sizeof(Header))
+    {
+        close();
+        throw std::runtime_error("Cooked mesh is truncated: " + path);
+    }
+
+    memcpy(&m_Header, m_File.data(), sizeof(Header));
+    if (m_Header.magic != Magic)
+    {
+        close();
+        throw std::runtime_error("Not a cooked mesh: " + path);
+    }
+    if (m_Header.version != Version)
+    {
+        const uint32_t version = m_Header.version;
+        close();
+        throw std::runtime_error("Cooked mesh version " + std::to_string(version) + " is not supported (expected " +
+                                 std::to_string(Version) + "), re-cook: " + path);
+    }
+    if (m_Header.vertexFormat > static_cast<uint32_t>(VertexFormat::CompactHalf) ||
+        m_Header.vertexStride != getVertexStride(static_cast<VertexFormat>(m_Header.vertexFormat)))
+    {
+        close();
+        throw std::runtime_error("Cooked mesh vertex layout does not match this build, re-cook: " + path);
+    }
+
+    for (const SectionRecord& section : m_Header.sections)
+    {
+        if (section.offset % SectionAlignment != 0 || section.offset > m_File.size() || section.size > m_File.size() - section.offset)
+        {
+            close();
+            throw std::runtime_error("Cooked mesh has an invalid section table: " + path);
+        }
+    }
+
+    m_VertexFormat = static_cast<VertexFormat>(m_Header.vertexFormat);
+
+    size_t vertexCount = 0;
+    m_pVertices = getSection(SectionVertices, m_Header.vertexStride, vertexCount);
+    m_VertexDataSize = m_Header.sections[SectionVertices].size;
+    m_VertexCount = vertexCount;
+
+    if (m_Header.indexSize != sizeof(uint16_t) && m_Header.indexSize != sizeof(uint32_t))
+    {
+        close();
+        throw std::runtime_error("Cooked mesh has an invalid index size: " + path);
+    }
+    m_IndexType = m_Header.indexSize == sizeof(uint16_t) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+
+    size_t indexCount = 0;
+    m_pIndices = getSection(SectionIndices, m_Header.indexSize, indexCount);
+    m_IndexCount = indexCount;
+
+    if (m_VertexCount != m_Header.vertexCount || m_IndexCount != m_Header.indexCount)
+    {
+        close();
+        throw std::runtime_error("Cooked mesh section sizes do not match its header: " + path);
+    }
+
+    if (m_Header.depthStream > static_cast<uint32_t>(DepthStream::PositionTexCoord) ||
+        m_Header.depthStride != DepthVertexStream::getStride(m_VertexFormat, static_cast<DepthStream>(m_Header.depthStream)))
+    {
+        close();
+        throw std::runtime_error("Cooked mesh depth stream layout does not match this build, re-cook: " + path);
+    }
+
+    m_DepthStream = static_cast<DepthStream>(m_Header.depthStream);
+    m_DepthVertexDataSize = m_Header.sections[SectionDepthVertices].size;
+    m_pDepthVertices = m_DepthVertexDataSize != 0 ? m_File.data() + m_Header.sections[SectionDepthVertices].offset : nullptr;
+    if (m_DepthStream != DepthStream::None && m_DepthVertexDataSize != m_VertexCount * m_Header.depthStride)
+    {
+        close();
+        throw std::runtime_error("Cooked mesh depth stream does not cover every vertex: " + path);
+    }
+
+    m_BoundsMin = glm::vec3(m_Header.bboxMin[0], m_Header.bboxMin[1], m_Header.bboxMin[2]);
+    m_BoundsMax = glm::vec3(m_Header.bboxMax[0], m_Header.bboxMax[1], m_Header.bboxMax[2]);
+}
+
+void CookedMesh::close()
+{
+    m_File.close();
+    m_Header = Header{};
+    m_pVertices = nullptr;
+    m_VertexDataSize = 0;
+    m_VertexCount = 0;
+    m_pIndices = nullptr;
+    m_IndexCount = 0;
+    m_IndexType = VK_INDEX_TYPE_UINT32;
+    m_DepthStream = DepthStream::None;
+    m_pDepthVertices = nullptr;
+    m_DepthVertexDataSize = 0;
+}
+
+const uint8_t* CookedMesh::getSection(Section section, size_t elementSize, size_t& count) const
+{
+    const SectionRecord& record = m_Header.sections[section];
+    if (record.size % elementSize != 0)
+    {
+        throw std::runtime_error("Cooked mesh section has a partial element: " + m_File.getPath());
+    }
+    count = static_cast<size_t>(record.size / elementSize);
+    return record.size != 0 ? m_File.data() + record.offset : nullptr;
+}
+
+void CookedMesh::readSubmeshes(std::vector<Submesh>& submeshes) const
+{
+    size_t count = 0;
+    const uint8_t* pData = getSection(SectionSubmeshes, sizeof(SubmeshRecord), count);
+
+    submeshes.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        SubmeshRecord record;
+        memcpy(&record, pData + i * sizeof(SubmeshRecord), sizeof(record));
+
+        if (static_cast<uint64_t>(record.indexStart) + record.indexCount > m_IndexCount)
+        {
+            throw std::runtime_error("Cooked mesh submesh range is out of bounds: " + m_File.getPath());
+        }
+
+        Submesh& submesh = submeshes[i];
+        submesh.indexStart = record.indexStart;
+        submesh.indexCount = record.indexCount;
+        submesh.materialIndex = static_cast<uint16_t>(record.materialIndex);
+        submesh.meshletOffset = record.meshletOffset;
+        submesh.meshletCount = record.meshletCount;
+        submesh.lodOffset = record.lodOffset;
+        submesh.lodCount = record.lodCount;
+        submesh.vertexOffset = record.vertexOffset;
+        submesh.bboxMin = glm::vec3(record.bboxMin[0], record.bboxMin[1], record.bboxMin[2]);
+        submesh.bboxMax = glm::vec3(record.bboxMax[0], record.bboxMax[1], record.bboxMax[2]);
+    }
+}
+
+void CookedMesh::readLods(std::vector<MeshLod>& lods) const
+{
+    size_t count = 0;
+    const uint8_t* pData = getSection(SectionLods, sizeof(MeshLod), count);
+    lods.resize(count);
+    if (count != 0)
+    {
+        memcpy(lods.data(), pData, count * sizeof(MeshLod));
+    }
+
+    for (const MeshLod& lod : lods)
+    {
+        if (static_cast<uint64_t>(lod.indexStart) + lod.indexCount > m_IndexCount)
+        {
+            throw std::runtime_error("Cooked mesh LOD range is out of bounds: " + m_File.getPath());
+        }
+    }
+}
+
+void CookedMesh::readMeshlets(std::vector<Meshlet>& meshlets, std::vector<uint32_t>& meshletVertices, std::vector<uint8_t>& meshletTriangles) const
+{
+    size_t count = 0;
+    const uint8_t* pData = getSection(SectionMeshlets, sizeof(Meshlet), count);
+    meshlets.resize(count);
+    if (count != 0)
+    {
+        memcpy(meshlets.data(), pData, count * sizeof(Meshlet));
+    }
+
+    pData = getSection(SectionMeshletVertices, sizeof(uint32_t), count);
+    meshletVertices.resize(count);
+    if (count != 0)
+    {
+        memcpy(meshletVertices.data(), pData, count * sizeof(uint32_t));
+    }
+
+    pData = getSection(SectionMeshletTriangles, sizeof(uint8_t), count);
+    meshletTriangles.assign(pData, pData + count);
+
+    for (const Meshlet& meshlet : meshlets)
+    {
+        if (static_cast<uint64_t>(meshlet.vertexOffset) + meshlet.vertexCount > meshletVertices.size() ||
+            static_cast<uint64_t>(meshlet.triangleOffset) + static_cast<uint64_t>(meshlet.triangleCount) * 3 > meshletTriangles.size())
+        {
+            throw std::runtime_error("Cooked mesh meshlet range is out of bounds: " + m_File.getPath());
+        }
+    }
+}
+
+void CookedMesh::readMaterials(std::vector<MaterialDesc>& materials) const
+{
+    size_t size = 0;
+    const uint8_t* pData = getSection(SectionMaterials, 1, size);
+    materials.clear();
+    if (size == 0)
+    {
+        return;
+    }
+
+    const uint8_t* pEnd = pData + size;
+    uint32_t materialCount;
+    if (size < sizeof(materialCount))
+    {
+        throw std::runtime_error("Cooked mesh: truncated material table");
+    }
+    memcpy(&materialCount, pData, sizeof(materialCount));
+    pData += sizeof(materialCount);
+
+    // A corrupt count must not turn into a huge reserve()
+    if (materialCount > static_cast<size_t>(pEnd - pData) / MinMaterialRecordSize)
+    {
+        throw std::runtime_error("Cooked mesh material count exceeds its table: " + m_File.getPath());
+    }
+
+    const std::filesystem::path directory = std::filesystem::path(m_File.getPath()).parent_path();
+    materials.reserve(materialCount);
+    for (uint32_t i = 0; i < materialCount; ++i)
+    {
+        MaterialDesc material;
+        material.diffusePath = resolveRelativePath(readString(pData, pEnd), directory);
+        material.normalPath = resolveRelativePath(readString(pData, pEnd), directory);
+        material.metallicRoughnessPath = resolveRelativePath(readString(pData, pEnd), directory);
+        material.sampler = readSampler(pData, pEnd, m_File.getPath());
+        materials.push_back(std::move(material));
+    }
+}
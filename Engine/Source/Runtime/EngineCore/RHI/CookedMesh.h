@@ -0,0 +1,157 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CompactVertex.h"
+#include "DepthVertexStream.h"
+#include "MeshSimplifier.h"
+#include "MeshletBuilder.h"
+#include "Runtime/EngineCore/Core/MappedFile.h"
+
+struct Vertex;
+struct Submesh;
+struct MaterialDesc;
+
+//
+// Versioned binary blob of a fully processed model (welded, optimized, LODs, meshlets),
+// written once by an offline cook step. Every section starts on a SectionAlignment boundary,
+// so the vertex and index ranges are used in place from the memory mapping and loading does
+// no per-vertex work. Submesh records, LODs, meshlets and material descriptions are small and copied.
+//
+class CookedMesh
+{
+public:
+    static constexpr uint32_t Magic = 0x4D454143; // "CAEM"
+    static constexpr uint32_t Version = 5;
+    static constexpr size_t SectionAlignment = 64;
+
+    // Everything cook() writes; the pointers refer to the caller's arrays
+    struct Contents
+    {
+        VertexFormat vertexFormat = VertexFormat::Standard;
+        const void* pVertices = nullptr;
+        size_t vertexCount = 0;
+        const void* pIndices = nullptr;
+        size_t indexCount = 0;
+        VkIndexType indexType = VK_INDEX_TYPE_UINT32;
+        DepthStream depthStream = DepthStream::None;
+        const void* pDepthVertices = nullptr;
+        size_t depthVertexDataSize = 0;
+        const std::vector<Submesh>* pSubmeshes = nullptr;
+        const std::vector<MeshLod>* pLods = nullptr;
+        const std::vector<Meshlet>* pMeshlets = nullptr;
+        const std::vector<uint32_t>* pMeshletVertices = nullptr;
+        const std::vector<uint8_t>* pMeshletTriangles = nullptr;
+        const std::vector<MaterialDesc>* pMaterials = nullptr;
+        glm::vec3 bboxMin{ 0.0f };
+        glm::vec3 bboxMax{ 0.0f };
+    };
+
+    static void cook(const std::string& path, const Contents& contents);
+    static size_t getVertexStride(VertexFormat format);
+    static size_t getIndexSize(VkIndexType indexType);
+
+    CookedMesh() = default;
+    explicit CookedMesh(const std::string& path);
+
+    // Maps the file and validates the header and section table; throws on mismatch
+    void open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_File.isOpen(); }
+
+    VertexFormat getVertexFormat() const { return m_VertexFormat; }
+    const void* getVertexData() const { return m_pVertices; }
+    size_t getVertexDataSize() const { return m_VertexDataSize; }
+    size_t getVertexCount() const { return m_VertexCount; }
+    const void* getIndexData() const { return m_pIndices; }
+    size_t getIndexCount() const { return m_IndexCount; }
+    VkIndexType getIndexType() const { return m_IndexType; }
+    DepthStream getDepthStream() const { return m_DepthStream; }
+    const void* getDepthVertexData() const { return m_pDepthVertices; }
+    size_t getDepthVertexDataSize() const { return m_DepthVertexDataSize; }
+    glm::vec3 getBoundsMin() const { return m_BoundsMin; }
+    glm::vec3 getBoundsMax() const { return m_BoundsMax; }
+
+    void readSubmeshes(std::vector<Submesh>& submeshes) const;
+    void readLods(std::vector<MeshLod>& lods) const;
+    void readMeshlets(std::vector<Meshlet>& meshlets, std::vector<uint32_t>& meshletVertices, std::vector<uint8_t>& meshletTriangles) const;
+    // Texture paths are stored relative to the cooked file and returned resolved against its directory
+    void readMaterials(std::vector<MaterialDesc>& materials) const;
+
+private:
+    enum Section : uint32_t
+    {
+        SectionVertices,
+        SectionIndices,
+        SectionSubmeshes,
+        SectionLods,
+        SectionMeshlets,
+        SectionMeshletVertices,
+        SectionMeshletTriangles,
+        SectionMaterials,
+        SectionDepthVertices,
+        SectionCount
+    };
+
+    struct SectionRecord
+    {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t vertexFormat;
+        uint32_t vertexStride;
+        uint64_t vertexCount;
+        uint64_t indexCount;
+        uint32_t indexSize;
+        uint32_t depthStream;
+        uint32_t depthStride;
+        uint32_t reserved;
+        float bboxMin[3];
+        float bboxMax[3];
+        SectionRecord sections[SectionCount];
+    };
+
+    // Fixed on-disk layout of a Submesh, independent of the in-memory struct's padding
+    struct SubmeshRecord
+    {
+        uint32_t indexStart;
+        uint32_t indexCount;
+        uint32_t materialIndex;
+        uint32_t meshletOffset;
+        uint32_t meshletCount;
+        uint32_t lodOffset;
+        uint32_t lodCount;
+        int32_t vertexOffset;
+        float bboxMin[3];
+        float bboxMax[3];
+    };
+
+    const uint8_t* getSection(Section section, size_t elementSize, size_t& count) const;
+
+    MappedFile m_File;
+    Header m_Header{};
+    VertexFormat m_VertexFormat = VertexFormat::Standard;
+    const void* m_pVertices = nullptr;
+    size_t m_VertexDataSize = 0;
+    size_t m_VertexCount = 0;
+    const void* m_pIndices = nullptr;
+    size_t m_IndexCount = 0;
+    VkIndexType m_IndexType = VK_INDEX_TYPE_UINT32;
+    DepthStream m_DepthStream = DepthStream::None;
+    const void* m_pDepthVertices = nullptr;
+    size_t m_DepthVertexDataSize = 0;
+    glm::vec3 m_BoundsMin{ 0.0f };
+    glm::vec3 m_BoundsMax{ 0.0f };
+};
@@ -0,0 +1,131 @@
+#include "DepthVertexStream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "Model.h"
+#include "Runtime/EngineCore/Core/ParallelFor.h"
+
+namespace
+{
+    constexpr size_t VerticesPerTask = 64 * 1024;
+
+    uint32_t getPositionSize(VertexFormat format)
+    {
+        return format == VertexFormat::Standard ? static_cast<uint32_t>(sizeof(Vertex::pos)) : static_cast<uint32_t>(sizeof(CompactVertex::position));
+    }
+
+    uint32_t getTexCoordSize(VertexFormat format)
+    {
+        return format == VertexFormat::Standard ? static_cast<uint32_t>(sizeof(Vertex::texCoord)) : static_cast<uint32_t>(sizeof(CompactVertex::texCoord));
+    }
+
+    template<typename SourceVertex>
+    void extract(const std::vector<SourceVertex>& source, size_t positionOffset, size_t positionSize, size_t texCoordOffset,
+                 size_t texCoordSize, uint32_t stride, std::vector<uint8_t>& output)
+    {
+        output.resize(source.size() * stride);
+
+        const size_t taskCount = (source.size() + VerticesPerTask - 1) / VerticesPerTask;
+        parallelFor(taskCount, [&](size_t task)
+        {
+            const size_t begin = task * VerticesPerTask;
+            const size_t end = std::min(begin + VerticesPerTask, source.size());
+            uint8_t* pOut = output.data() + begin * stride;
+            for (size_t i = begin; i < end; ++i, pOut += stride)
+            {
+                const uint8_t* pVertex = reinterpret_cast<const uint8_t*>(&source[i]);
+                memcpy(pOut, pVertex + positionOffset, positionSize);
+                if (texCoordSize != 0)
+                {
+                    memcpy(pOut + positionSize, pVertex + texCoordOffset, texCoordSize);
+                }
+            }
+        });
+    }
+}
+
+uint32_t DepthVertexStream::getStride(VertexFormat format, DepthStream stream)
+{
+    switch (stream)
+    {
+    case DepthStream::None:
+        return 0;
+    case DepthStream::Position:
+        return getPositionSize(format);
+    case DepthStream::PositionTexCoord:
+        return getPositionSize(format) + getTexCoordSize(format);
+    }
+    return 0;
+}
+
+VkVertexInputBindingDescription DepthVertexStream::getBindingDescription(VertexFormat format, DepthStream stream, uint32_t binding)
+{
+    VkVertexInputBindingDescription bindingDescription{};
+    bindingDescription.binding = binding;
+    bindingDescription.stride = getStride(format, stream);
+    bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    return bindingDescription;
+}
+
+std::vector<VkVertexInputAttributeDescription> DepthVertexStream::getAttributeDescriptions(VertexFormat format, DepthStream stream, uint32_t binding)
+{
+    std::vector<VkVertexInputAttributeDescription> attributeDescriptions;
+    if (stream == DepthStream::None)
+    {
+        return attributeDescriptions;
+    }
+
+    VkVertexInputAttributeDescription position{};
+    position.binding = binding;
+    position.location = 0;
+    position.offset = 0;
+    switch (format)
+    {
+    case VertexFormat::Standard:
+        position.format = VK_FORMAT_R32G32B32_SFLOAT;
+        break;
+    case VertexFormat::CompactQuantized:
+        position.format = VK_FORMAT_R16G16B16A16_UNORM;
+        break;
+    case VertexFormat::CompactHalf:
+        position.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+        break;
+    }
+    attributeDescriptions.push_back(position);
+
+    if (stream == DepthStream::PositionTexCoord)
+    {
+        VkVertexInputAttributeDescription texCoord{};
+        texCoord.binding = binding;
+        texCoord.location = 1;
+        texCoord.format = format == VertexFormat::Standard ? VK_FORMAT_R32G32_SFLOAT : VK_FORMAT_R16G16_SFLOAT;
+        texCoord.offset = getPositionSize(format);
+        attributeDescriptions.push_back(texCoord);
+    }
+
+    return attributeDescriptions;
+}
+
+void DepthVertexStream::build(VertexFormat format, DepthStream stream, const std::vector<Vertex>& vertices,
+                              const std::vector<CompactVertex>& compactVertices, std::vector<uint8_t>& output)
+{
+    output.clear();
+    if (stream == DepthStream::None)
+    {
+        return;
+    }
+
+    const uint32_t stride = getStride(format, stream);
+    const size_t texCoordSize = stream == DepthStream::PositionTexCoord ? getTexCoordSize(format) : 0;
+    if (format == VertexFormat::Standard)
+    {
+        extract(vertices, offsetof(Vertex, pos), getPositionSize(format), offsetof(Vertex, texCoord), texCoordSize, stride, output);
+    }
+    else
+    {
+        extract(compactVertices, offsetof(CompactVertex, position), getPositionSize(format), offsetof(CompactVertex, texCoord),
+                texCoordSize, stride, output);
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CompactVertex.h"
+
+struct Vertex;
+
+enum class DepthStream
+{
+    None,
+    Position,        // Depth prepass and opaque shadow casters
+    PositionTexCoord // Alpha-tested depth and shadow passes
+};
+
+//
+// Tightly packed copy of the position (and optionally UV) attributes, bound on its own by
+// depth-only pipelines so they do not fetch the full interleaved vertex. Attributes keep the
+// encoding of the main vertex format, so depth written by a prepass matches the main pass
+// bit for bit and compact formats use the same per-submesh dequantization.
+//
+class DepthVertexStream
+{
+public:
+    // Bytes per vertex: 12/20 for Standard, 8/12 for the compact formats
+    static uint32_t getStride(VertexFormat format, DepthStream stream);
+
+    static VkVertexInputBindingDescription getBindingDescription(VertexFormat format, DepthStream stream, uint32_t binding = 0);
+    // Position at location 0, texCoord at location 1, matching Vertex::getDepthAttributeDescriptions
+    static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions(VertexFormat format, DepthStream stream, uint32_t binding = 0);
+
+    // Extracts the stream from the final vertex array (compactVertices for compact formats)
+    static void build(VertexFormat format, DepthStream stream, const std::vector<Vertex>& vertices,
+                      const std::vector<CompactVertex>& compactVertices, std::vector<uint8_t>& output);
+};
@@ -1,8 +1,8 @@
 // DescriptorManager.cpp
 #include "DescriptorManager.h"
+#include "Runtime/EngineCore/Core/Log.h"
 #include <array>
 #include <stdexcept>
-#include <iostream>
 
 DescriptorManager::DescriptorManager(VkDevice device, size_t maxFramesInFlight, size_t materialCount)
     : m_Device(device), m_MaxFramesInFlight(maxFramesInFlight), m_MaterialCount(materialCount)
@@ -11,7 +11,7 @@ DescriptorManager::DescriptorManager(VkDevice device, size_t maxFramesInFlight,
     //createDescriptorPool();
 	m_FinalPassDescriptorSets.resize(maxFramesInFlight); // Initialize the final pass descriptor sets
 	m_ComputeDescriptorSets.resize(maxFramesInFlight); // Initialize the compute descriptor sets
-    std::cout << "DescriptorManager created." << std::endl;
+    CAE_LOG_TRACE(RHI, "DescriptorManager created.");
 }
 
 DescriptorManager::~DescriptorManager()
@@ -32,31 +32,36 @@ DescriptorManager::~DescriptorManager()
     {
         vkDestroyDescriptorSetLayout(m_Device, m_ComputeDescriptorSetLayout, nullptr);
     }
-    std::cout << "DescriptorManager destroyed." << std::endl;
+    CAE_LOG_TRACE(RHI, "DescriptorManager destroyed.");
 }
 
-void DescriptorManager::createDescriptorSetLayout()
+void DescriptorManager::createDescriptorSetLayout(VkSampler immutableSampler, bool dynamicUniformBuffer)
 {
     if (m_DescriptorSetLayout != VK_NULL_HANDLE)
     {
         vkDestroyDescriptorSetLayout(m_Device, m_DescriptorSetLayout, nullptr);
     }
 
+    m_DynamicUniformBuffer = dynamicUniformBuffer;
+
     // Binding for Uniform Buffer Object
     VkDescriptorSetLayoutBinding uboLayoutBinding{};
     uboLayoutBinding.binding = 0; // Binding 0 for the UBO
-    uboLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    uboLayoutBinding.descriptorType = dynamicUniformBuffer ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
     uboLayoutBinding.descriptorCount = 1;
     uboLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT; // Allow usage in both shaders
     uboLayoutBinding.pImmutableSamplers = nullptr;
 
+    // An immutable sampler is baked into the layout and the sampler in descriptor writes is ignored
+    const VkSampler* pImmutableSampler = immutableSampler != VK_NULL_HANDLE ? &immutableSampler : nullptr;
+
     // Binding for Combined Image Sampler (Diffuse Texture)
     VkDescriptorSetLayoutBinding diffuseSamplerBinding{};
     diffuseSamplerBinding.binding = 1;
     diffuseSamplerBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
     diffuseSamplerBinding.descriptorCount = 1;
     diffuseSamplerBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-    diffuseSamplerBinding.pImmutableSamplers = nullptr;
+    diffuseSamplerBinding.pImmutableSamplers = pImmutableSampler;
 
     // Binding for Combined Image Sampler (normal Texture)
     VkDescriptorSetLayoutBinding normalSamplerBinding{};
@@ -64,7 +69,7 @@ void DescriptorManager::createDescriptorSetLayout()
     normalSamplerBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
     normalSamplerBinding.descriptorCount = 1;
     normalSamplerBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-    normalSamplerBinding.pImmutableSamplers = nullptr;
+    normalSamplerBinding.pImmutableSamplers = pImmutableSampler;
 
     // Binding for Combined Image Sampler (metallic roughness Texture)
     VkDescriptorSetLayoutBinding metallicRoughnessSamplerBinding{};
@@ -72,7 +77,7 @@ void DescriptorManager::createDescriptorSetLayout()
     metallicRoughnessSamplerBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
     metallicRoughnessSamplerBinding.descriptorCount = 1;
     metallicRoughnessSamplerBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-    metallicRoughnessSamplerBinding.pImmutableSamplers = nullptr;
+    metallicRoughnessSamplerBinding.pImmutableSamplers = pImmutableSampler;
 
     std::array<VkDescriptorSetLayoutBinding, 4> bindings = {
         uboLayoutBinding,
@@ -90,7 +95,7 @@ void DescriptorManager::createDescriptorSetLayout()
     {
         throw std::runtime_error("Failed to create descriptor set layout!");
     }
-    std::cout << "Descriptor set layout created." << std::endl;
+    CAE_LOG_TRACE(RHI, "Descriptor set layout created.");
 }
 
 void DescriptorManager::createDescriptorPool()
@@ -113,6 +118,11 @@ void DescriptorManager::createDescriptorPool()
                 static_cast<uint32_t>(m_MaxFramesInFlight * 2) }, // Input and output images per frame
 
     };
+    if (m_DynamicUniformBuffer && m_MaterialCount != 0)
+    {
+        // One dynamic uniform buffer per material set
+        poolSizes.push_back({ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, static_cast<uint32_t>(m_MaterialCount) });
+    }
 
     VkDescriptorPoolCreateInfo poolInfo{};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
@@ -162,77 +172,117 @@ void DescriptorManager::createDescriptorSets(
         {
             size_t descriptorSetIndex = frame * m_MaterialCount + matIndex;
 
-            VkDescriptorBufferInfo bufferInfo{};
-            bufferInfo.buffer = uniformBuffers[frame];
-            bufferInfo.offset = 0;
-            bufferInfo.range = uniformBufferObjectSize;
-
-            // Collect image infos from the material's textures
-            VkDescriptorImageInfo diffuseImageInfo{};
-            diffuseImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            diffuseImageInfo.imageView = materials[matIndex]->pDiffuseTexture->getTextureImageView();
-            diffuseImageInfo.sampler = Texture::getTextureSampler();
-
-            VkDescriptorImageInfo normalImageInfo{};
-            normalImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            normalImageInfo.imageView = materials[matIndex]->pNormalTexture->getTextureImageView();
-            normalImageInfo.sampler = Texture::getTextureSampler();
-
-            VkDescriptorImageInfo metallicRoughnessImageInfo{};
-            metallicRoughnessImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            metallicRoughnessImageInfo.imageView = materials[matIndex]->pMetallicRoughnessTexture->getTextureImageView();
-            metallicRoughnessImageInfo.sampler = Texture::getTextureSampler();
-
-            std::array<VkWriteDescriptorSet, 4> descriptorWrites{};
-
-            // Uniform Buffer
-            descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrites[0].dstSet = m_DescriptorSets[descriptorSetIndex];
-            descriptorWrites[0].dstBinding = 0;
-            descriptorWrites[0].dstArrayElement = 0;
-            descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-            descriptorWrites[0].descriptorCount = 1;
-            descriptorWrites[0].pBufferInfo = &bufferInfo;
-
-            // Diffuse Texture
-            descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrites[1].dstSet = m_DescriptorSets[descriptorSetIndex];
-            descriptorWrites[1].dstBinding = 1;
-            descriptorWrites[1].dstArrayElement = 0;
-            descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            descriptorWrites[1].descriptorCount = 1;
-            descriptorWrites[1].pImageInfo = &diffuseImageInfo;
-
-            // Normal Texture
-            descriptorWrites[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrites[2].dstSet = m_DescriptorSets[descriptorSetIndex];
-            descriptorWrites[2].dstBinding = 2;
-            descriptorWrites[2].dstArrayElement = 0;
-            descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            descriptorWrites[2].descriptorCount = 1;
-            descriptorWrites[2].pImageInfo = &normalImageInfo;
-
-            // Metallic Roughness Texture
-            descriptorWrites[3].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrites[3].dstSet = m_DescriptorSets[descriptorSetIndex];
-            descriptorWrites[3].dstBinding = 3;
-            descriptorWrites[3].dstArrayElement = 0;
-            descriptorWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            descriptorWrites[3].descriptorCount = 1;
-            descriptorWrites[3].pImageInfo = &metallicRoughnessImageInfo;
-
-            vkUpdateDescriptorSets(
-                m_Device,
-                static_cast<uint32_t>(descriptorWrites.size()),
-                descriptorWrites.data(),
-                0,
-                nullptr
-            );
-            std::cout << "Descriptor set updated for frame " << frame << ", material " << matIndex << std::endl;
+            writeMaterialDescriptorSet(m_DescriptorSets[descriptorSetIndex], uniformBuffers[frame], uniformBufferObjectSize, materials[matIndex]);
+            CAE_LOG_TRACE(RHI, "Descriptor set updated for frame " << frame << ", material " << matIndex);
         }
     }
 }
 
+void DescriptorManager::createDynamicDescriptorSets(
+    VkBuffer uniformBuffer,
+    const std::vector<Material*>& materials,
+    size_t uniformBufferObjectSize)
+{
+    if (materials.size() != m_MaterialCount)
+    {
+        throw std::runtime_error("Material count does not match the expected number.");
+    }
+    if (!m_DynamicUniformBuffer)
+    {
+        throw std::runtime_error("Dynamic descriptor sets need a layout created with dynamicUniformBuffer");
+    }
+
+    m_DescriptorSets.resize(m_MaterialCount);
+
+    std::vector<VkDescriptorSetLayout> layouts(m_MaterialCount, m_DescriptorSetLayout);
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = m_DescriptorPool;
+    allocInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+    allocInfo.pSetLayouts = layouts.data();
+
+    if (vkAllocateDescriptorSets(m_Device, &allocInfo, m_DescriptorSets.data()) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to allocate descriptor sets!");
+    }
+
+    for (size_t matIndex = 0; matIndex < m_MaterialCount; ++matIndex)
+    {
+        writeMaterialDescriptorSet(m_DescriptorSets[matIndex], uniformBuffer, uniformBufferObjectSize, materials[matIndex]);
+    }
+    CAE_LOG_DEBUG(RHI, "Dynamic descriptor sets created for " << m_MaterialCount << " materials");
+}
+
+void DescriptorManager::writeMaterialDescriptorSet(VkDescriptorSet descriptorSet, VkBuffer uniformBuffer, size_t uniformBufferObjectSize,
+    const Material* pMaterial)
+{
+    VkDescriptorBufferInfo bufferInfo{};
+    bufferInfo.buffer = uniformBuffer;
+    bufferInfo.offset = 0;
+    bufferInfo.range = uniformBufferObjectSize;
+
+    // Collect image infos from the material's textures
+    VkDescriptorImageInfo diffuseImageInfo{};
+    diffuseImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    diffuseImageInfo.imageView = pMaterial->pDiffuseTexture->getTextureImageView();
+    diffuseImageInfo.sampler = pMaterial->sampler;
+
+    VkDescriptorImageInfo normalImageInfo{};
+    normalImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    normalImageInfo.imageView = pMaterial->pNormalTexture->getTextureImageView();
+    normalImageInfo.sampler = pMaterial->sampler;
+
+    VkDescriptorImageInfo metallicRoughnessImageInfo{};
+    metallicRoughnessImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    metallicRoughnessImageInfo.imageView = pMaterial->pMetallicRoughnessTexture->getTextureImageView();
+    metallicRoughnessImageInfo.sampler = pMaterial->sampler;
+
+    std::array<VkWriteDescriptorSet, 4> descriptorWrites{};
+
+    // Uniform Buffer
+    descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[0].dstSet = descriptorSet;
+    descriptorWrites[0].dstBinding = 0;
+    descriptorWrites[0].dstArrayElement = 0;
+    descriptorWrites[0].descriptorType = m_DynamicUniformBuffer ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptorWrites[0].descriptorCount = 1;
+    descriptorWrites[0].pBufferInfo = &bufferInfo;
+
+    // Diffuse Texture
+    descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[1].dstSet = descriptorSet;
+    descriptorWrites[1].dstBinding = 1;
+    descriptorWrites[1].dstArrayElement = 0;
+    descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    descriptorWrites[1].descriptorCount = 1;
+    descriptorWrites[1].pImageInfo = &diffuseImageInfo;
+
+    // Normal Texture
+    descriptorWrites[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[2].dstSet = descriptorSet;
+    descriptorWrites[2].dstBinding = 2;
+    descriptorWrites[2].dstArrayElement = 0;
+    descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    descriptorWrites[2].descriptorCount = 1;
+    descriptorWrites[2].pImageInfo = &normalImageInfo;
+
+    // Metallic Roughness Texture
+    descriptorWrites[3].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[3].dstSet = descriptorSet;
+    descriptorWrites[3].dstBinding = 3;
+    descriptorWrites[3].dstArrayElement = 0;
+    descriptorWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    descriptorWrites[3].descriptorCount = 1;
+    descriptorWrites[3].pImageInfo = &metallicRoughnessImageInfo;
+
+    vkUpdateDescriptorSets(
+        m_Device,
+        static_cast<uint32_t>(descriptorWrites.size()),
+        descriptorWrites.data(),
+        0,
+        nullptr
+    );
+}
 
 VkDescriptorSetLayout DescriptorManager::getDescriptorSetLayout() const
 {
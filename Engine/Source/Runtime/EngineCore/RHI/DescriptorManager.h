@@ -10,13 +10,24 @@ public:
     DescriptorManager(VkDevice device, size_t maxFramesInFlight, size_t materialCount);
     ~DescriptorManager();
 
-    void createDescriptorSetLayout();
+    // With an immutable sampler (e.g. from a SamplerCache, which keeps it alive) every material texture
+    // binding uses it and per-material samplers are ignored; VK_NULL_HANDLE keeps the sampler per descriptor.
+    // dynamicUniformBuffer makes binding 0 a UNIFORM_BUFFER_DYNAMIC for createDynamicDescriptorSets().
+    void createDescriptorSetLayout(VkSampler immutableSampler = VK_NULL_HANDLE, bool dynamicUniformBuffer = false);
     void createDescriptorPool();
     void createDescriptorSets(
         const std::vector<VkBuffer>& uniformBuffers,
         const std::vector<Material*>& materials,
         size_t uniformBufferObjectSize
     );
+    // One set per material, shared by every frame and draw: binding 0 points at a single buffer (e.g.
+    // FrameUniformAllocator::getBuffer()) and each draw selects its data with a dynamic offset.
+    // getDescriptorSets() is then indexed by material only.
+    void createDynamicDescriptorSets(
+        VkBuffer uniformBuffer,
+        const std::vector<Material*>& materials,
+        size_t uniformBufferObjectSize
+    );
 
     void createFinalPassDescriptorSetLayout();
     void createFinalPassDescriptorSet(
@@ -75,9 +86,13 @@ public:
     const std::vector<VkDescriptorSet>& getComputeDescriptorSets() const;
 
 private:
+    void writeMaterialDescriptorSet(VkDescriptorSet descriptorSet, VkBuffer uniformBuffer, size_t uniformBufferObjectSize,
+        const Material* pMaterial);
+
     VkDevice m_Device;
     size_t m_MaxFramesInFlight;
     size_t m_MaterialCount;
+    bool m_DynamicUniformBuffer = false;
 
     VkDescriptorSetLayout m_DescriptorSetLayout{};
     VkDescriptorSetLayout m_FinalPassDescriptorSetLayout{};
@@ -1,10 +1,12 @@
 #include "Device.h"
 #include "PhysicalDevice.h"
-#include <iostream>
+#include "Runtime/EngineCore/Core/Log.h"
 #include <vk_mem_alloc.h>
 
-Device::Device(VkDevice device, VkQueue graphicsQueue, VkQueue presentQueue, VkPhysicalDevice physicalDevice, VkInstance instance)
-    : m_Device(device), m_GraphicsQueue(graphicsQueue), m_PresentQueue(presentQueue) 
+Device::Device(VkDevice device, VkQueue graphicsQueue, VkQueue presentQueue, VkQueue transferQueue, uint32_t graphicsQueueFamily,
+               uint32_t transferQueueFamily, VkPhysicalDevice physicalDevice, VkInstance instance, const VkPhysicalDeviceFeatures& enabledFeatures)
+    : m_Device(device), m_GraphicsQueue(graphicsQueue), m_PresentQueue(presentQueue), m_TransferQueue(transferQueue),
+    m_GraphicsQueueFamily(graphicsQueueFamily), m_TransferQueueFamily(transferQueueFamily), m_EnabledFeatures(enabledFeatures)
 {
     // Create VMA allocator
     VmaAllocatorCreateInfo allocatorInfo = {};
@@ -17,7 +19,7 @@ Device::Device(VkDevice device, VkQueue graphicsQueue, VkQueue presentQueue, VkP
         throw std::runtime_error("Failed to create VMA allocator!");
     }
     
-	std::cout << "Device created successfully." << std::endl;
+	CAE_LOG_TRACE(RHI, "Device created successfully.");
 }
 
 Device::~Device() 
@@ -30,7 +32,7 @@ Device::~Device()
     {
         vkDestroyDevice(m_Device, nullptr);
     }
-	std::cout << "Device destroyed." << std::endl;
+	CAE_LOG_TRACE(RHI, "Device destroyed.");
 }
 
 VkDevice Device::get() const 
@@ -48,6 +50,11 @@ VkQueue Device::getPresentQueue() const
     return m_PresentQueue;
 }
 
+VkQueue Device::getTransferQueue() const
+{
+    return m_TransferQueue;
+}
+
 VmaAllocator Device::getAllocator() const
 {
     return m_Allocator;
@@ -58,6 +65,10 @@ Device::Device(Device&& other) noexcept
     m_Device = other.m_Device;
     m_GraphicsQueue = other.m_GraphicsQueue;
     m_PresentQueue = other.m_PresentQueue;
+    m_TransferQueue = other.m_TransferQueue;
+    m_GraphicsQueueFamily = other.m_GraphicsQueueFamily;
+    m_TransferQueueFamily = other.m_TransferQueueFamily;
+    m_EnabledFeatures = other.m_EnabledFeatures;
 
     other.m_Device = VK_NULL_HANDLE;
 }
@@ -73,6 +84,10 @@ Device& Device::operator=(Device&& other) noexcept
         m_Device = other.m_Device;
         m_GraphicsQueue = other.m_GraphicsQueue;
         m_PresentQueue = other.m_PresentQueue;
+        m_TransferQueue = other.m_TransferQueue;
+        m_GraphicsQueueFamily = other.m_GraphicsQueueFamily;
+        m_TransferQueueFamily = other.m_TransferQueueFamily;
+        m_EnabledFeatures = other.m_EnabledFeatures;
 
         other.m_Device = VK_NULL_HANDLE;
     }
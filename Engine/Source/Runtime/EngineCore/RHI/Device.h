@@ -5,8 +5,8 @@
 #include <set>
 #include <string>
 #include <fstream>
-#include <iostream>
 #include <vk_mem_alloc.h>
+#include "Runtime/EngineCore/Core/Log.h"
 
 namespace
 {
@@ -46,7 +46,7 @@ namespace
         {
             throw std::runtime_error("Failed to create shader module");
         }
-        std::cout << "Shader module created with code:\"" << code.data() << "\"" << std::endl;
+        CAE_LOG_TRACE(RHI, "Shader module created from " << code.size() << " bytes of SPIR-V");
         return shaderModule;
     }
 }
@@ -55,7 +55,9 @@ class PhysicalDevice;
 class Device 
 {
 public:
-    Device(VkDevice device, VkQueue graphicsQueue, VkQueue presentQueue, VkPhysicalDevice physicalDevice, VkInstance instance);
+    // transferQueue may equal graphicsQueue when the device has no separate transfer family
+    Device(VkDevice device, VkQueue graphicsQueue, VkQueue presentQueue, VkQueue transferQueue, uint32_t graphicsQueueFamily,
+           uint32_t transferQueueFamily, VkPhysicalDevice physicalDevice, VkInstance instance, const VkPhysicalDeviceFeatures& enabledFeatures);
     ~Device();
 
     Device(const Device&) = delete;
@@ -66,10 +68,20 @@ public:
     VkDevice get() const;
     VkQueue getGraphicsQueue() const;
     VkQueue getPresentQueue() const;
+    VkQueue getTransferQueue() const;
+    uint32_t getGraphicsQueueFamily() const { return m_GraphicsQueueFamily; }
+    uint32_t getTransferQueueFamily() const { return m_TransferQueueFamily; }
+    bool hasDedicatedTransferQueue() const { return m_TransferQueueFamily != m_GraphicsQueueFamily; }
+    // Features the device was created with, a subset of what the physical device supports
+    const VkPhysicalDeviceFeatures& getEnabledFeatures() const { return m_EnabledFeatures; }
     VmaAllocator getAllocator() const;
 private:
     VkDevice m_Device;
     VkQueue m_GraphicsQueue;
     VkQueue m_PresentQueue;
+    VkQueue m_TransferQueue;
+    uint32_t m_GraphicsQueueFamily;
+    uint32_t m_TransferQueueFamily;
+    VkPhysicalDeviceFeatures m_EnabledFeatures;
     VmaAllocator m_Allocator;
 };
@@ -1,7 +1,7 @@
 #include "DeviceBuilder.h"
 #include "Device.h"
+#include "Runtime/EngineCore/Core/Log.h"
 #include <set>
-#include <iostream>
 
 DeviceBuilder& DeviceBuilder::setPhysicalDevice(VkPhysicalDevice physicalDevice) 
 {
@@ -72,6 +72,10 @@ Device* DeviceBuilder::build()
         m_QueueFamilyIndices.graphicsFamily.value(),
         m_QueueFamilyIndices.presentFamily.value()
     };
+    if (m_QueueFamilyIndices.transferFamily.has_value())
+    {
+        uniqueQueueFamilies.insert(m_QueueFamilyIndices.transferFamily.value());
+    }
 
     float queuePriority = 1.0f;
     for (uint32_t queueFamily : uniqueQueueFamilies)
@@ -146,6 +150,18 @@ Device* DeviceBuilder::build()
     VkQueue presentQueue;
     vkGetDeviceQueue(device, m_QueueFamilyIndices.presentFamily.value(), 0, &presentQueue);
 
-    return new Device(device, graphicsQueue, presentQueue, m_PhysicalDevice, m_Instance);
+    // Without a dedicated family uploads share the graphics queue
+    const uint32_t graphicsFamily = m_QueueFamilyIndices.graphicsFamily.value();
+    const uint32_t transferFamily = m_QueueFamilyIndices.transferFamily.value_or(graphicsFamily);
+    VkQueue transferQueue = graphicsQueue;
+    if (transferFamily != graphicsFamily)
+    {
+        vkGetDeviceQueue(device, transferFamily, 0, &transferQueue);
+    }
+    CAE_LOG_INFO(RHI, "Transfer queue: " << (transferFamily != graphicsFamily ? "dedicated family " : "shared with graphics, family ")
+        << transferFamily);
+
+    return new Device(device, graphicsQueue, presentQueue, transferQueue, graphicsFamily, transferFamily, m_PhysicalDevice, m_Instance,
+        m_EnabledFeatures);
 }
 
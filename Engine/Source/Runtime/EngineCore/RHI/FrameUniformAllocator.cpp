@@ -0,0 +1,96 @@
+#include "FrameUniformAllocator.h"
+
+#include "Device.h"
+#include "Runtime/EngineCore/Core/Log.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+FrameUniformAllocator::FrameUniformAllocator(Device* pDevice, VmaAllocator allocator, VkPhysicalDevice physicalDevice,
+    uint32_t framesInFlight, const Settings& settings)
+    : m_pDevice(pDevice), m_FramesInFlight(framesInFlight)
+{
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    // Storage offsets share the buffer, so honour both limits (both are powers of two)
+    m_Alignment = std::max<VkDeviceSize>({ properties.limits.minUniformBufferOffsetAlignment,
+        properties.limits.minStorageBufferOffsetAlignment, 16 });
+    m_MaxRange = properties.limits.maxUniformBufferRange;
+    m_FrameSize = alignUp(settings.bytesPerFrame, m_Alignment);
+
+    // Dynamic offsets are 32-bit
+    if (m_FrameSize * m_FramesInFlight > UINT32_MAX)
+    {
+        throw std::runtime_error("FrameUniformAllocator: bytesPerFrame * framesInFlight exceeds 4 GB");
+    }
+
+    m_pBuffer = std::make_unique<Buffer>(
+        allocator,
+        m_FrameSize * m_FramesInFlight,
+        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        VMA_MEMORY_USAGE_CPU_TO_GPU,
+        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT);
+    m_pData = static_cast<uint8_t*>(m_pBuffer->map());
+}
+
+FrameUniformAllocator::~FrameUniformAllocator()
+{
+    CAE_LOG_DEBUG(RHI, "FrameUniformAllocator destroyed (peak " << m_Stats.peakBytesUsed / 1024 << " KB of "
+        << m_FrameSize / 1024 << " KB per frame)");
+}
+
+void FrameUniformAllocator::beginFrame(uint32_t frameIndex, VkFence frameFence)
+{
+    if (frameIndex >= m_FramesInFlight)
+    {
+        throw std::runtime_error("FrameUniformAllocator: frame index out of range");
+    }
+    if (frameFence != VK_NULL_HANDLE)
+    {
+        vkWaitForFences(m_pDevice->get(), 1, &frameFence, VK_TRUE, UINT64_MAX);
+    }
+
+    m_FrameIndex = frameIndex;
+    m_Head = 0;
+    m_Stats.allocations = 0;
+    m_Stats.bytesUsed = 0;
+}
+
+FrameUniformAllocator::Allocation FrameUniformAllocator::allocate(VkDeviceSize size)
+{
+    const VkDeviceSize offset = alignUp(m_Head, m_Alignment);
+    if (offset + size > m_FrameSize)
+    {
+        throw std::runtime_error("FrameUniformAllocator: frame region of " + std::to_string(m_FrameSize) + " bytes exhausted");
+    }
+    m_Head = offset + size;
+
+    ++m_Stats.allocations;
+    m_Stats.bytesUsed = m_Head;
+    m_Stats.peakBytesUsed = std::max(m_Stats.peakBytesUsed, m_Head);
+
+    const VkDeviceSize absoluteOffset = static_cast<VkDeviceSize>(m_FrameIndex) * m_FrameSize + offset;
+    Allocation allocation;
+    allocation.buffer = m_pBuffer->get();
+    allocation.offset = static_cast<uint32_t>(absoluteOffset);
+    allocation.pData = m_pData + absoluteOffset;
+    return allocation;
+}
+
+void FrameUniformAllocator::flush()
+{
+    if (m_Head != 0)
+    {
+        m_pBuffer->flush(static_cast<VkDeviceSize>(m_FrameIndex) * m_FrameSize, m_Head);
+    }
+}
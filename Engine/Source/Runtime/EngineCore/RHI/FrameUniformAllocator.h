@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include "vk_mem_alloc.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "Buffer.h"
+
+class Device;
+
+//
+// Per-frame linear allocator for uniform and other per-draw data. One persistently mapped buffer is
+// split into a region per frame in flight; allocate() bumps an offset inside the current frame's
+// region, aligned to minUniformBufferOffsetAlignment, so the returned offset can be passed straight
+// to vkCmdBindDescriptorSets as a VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC offset. Every draw can
+// then share the same descriptor set. beginFrame() waits for the frame's fence and rewinds its region.
+//
+class FrameUniformAllocator
+{
+public:
+    struct Settings
+    {
+        VkDeviceSize bytesPerFrame = 4ull * 1024ull * 1024ull;
+    };
+
+    struct Allocation
+    {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        uint32_t offset = 0;    // Dynamic offset into getBuffer()
+        void* pData = nullptr;  // Mapped pointer, write-only
+    };
+
+    struct Stats
+    {
+        size_t allocations = 0;         // Current frame
+        VkDeviceSize bytesUsed = 0;     // Current frame
+        VkDeviceSize peakBytesUsed = 0; // Highest usage of any frame so far
+    };
+
+    FrameUniformAllocator(Device* pDevice, VmaAllocator allocator, VkPhysicalDevice physicalDevice, uint32_t framesInFlight,
+        const Settings& settings = Settings{});
+    ~FrameUniformAllocator();
+
+    FrameUniformAllocator(const FrameUniformAllocator&) = delete;
+    FrameUniformAllocator& operator=(const FrameUniformAllocator&) = delete;
+
+    // Waits for frameFence (the fence of the last submission that read this frame's region), then
+    // rewinds the region. Call before allocating for the frame and before the fence is reset.
+    void beginFrame(uint32_t frameIndex, VkFence frameFence);
+
+    // Throws when the frame's region is exhausted; raise Settings::bytesPerFrame
+    Allocation allocate(VkDeviceSize size);
+
+    // Makes the frame's writes visible on non-coherent memory; call before submitting the frame
+    void flush();
+
+    template<typename T>
+    Allocation push(const T& value)
+    {
+        Allocation allocation = allocate(sizeof(T));
+        memcpy(allocation.pData, &value, sizeof(T));
+        return allocation;
+    }
+
+    // Bind with range = the size of the shader's uniform block and the allocation offsets as dynamic offsets
+    VkBuffer getBuffer() const { return m_pBuffer->get(); }
+    VkDeviceSize getAlignment() const { return m_Alignment; }
+    VkDeviceSize getMaxRange() const { return m_MaxRange; }
+    const Stats& getStats() const { return m_Stats; }
+
+private:
+    Device* m_pDevice;
+    std::unique_ptr<Buffer> m_pBuffer;
+    uint8_t* m_pData = nullptr;
+
+    uint32_t m_FramesInFlight;
+    VkDeviceSize m_FrameSize;
+    VkDeviceSize m_Alignment;
+    VkDeviceSize m_MaxRange;
+
+    uint32_t m_FrameIndex = 0;
+    VkDeviceSize m_Head = 0; // Relative to the current frame's region
+    Stats m_Stats;
+};
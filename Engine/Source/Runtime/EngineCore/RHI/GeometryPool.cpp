@@ -0,0 +1,338 @@
+#include "GeometryPool.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include "CommandPool.h"
+#include "Device.h"
+#include "Model.h"
+#include "TransferQueue.h"
+
+GeometryPool::RangeAllocator::RangeAllocator(uint32_t capacity)
+    : m_Capacity(capacity)
+{
+    if (capacity != 0)
+    {
+        m_FreeRanges.emplace(0, capacity);
+    }
+}
+
+bool GeometryPool::RangeAllocator::allocate(uint32_t count, uint32_t& offset)
+{
+    if (count == 0)
+    {
+        offset = 0;
+        return true;
+    }
+
+    for (auto it = m_FreeRanges.begin(); it != m_FreeRanges.end(); ++it)
+    {
+        if (it->second < count)
+        {
+            continue;
+        }
+
+        offset = it->first;
+        const uint32_t remaining = it->second - count;
+        m_FreeRanges.erase(it);
+        if (remaining != 0)
+        {
+            m_FreeRanges.emplace(offset + count, remaining);
+        }
+        m_Used += count;
+        return true;
+    }
+    return false;
+}
+
+void GeometryPool::RangeAllocator::free(uint32_t offset, uint32_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    auto next = m_FreeRanges.lower_bound(offset);
+    if (next != m_FreeRanges.end() && next->first < offset + count)
+    {
+        throw std::runtime_error("GeometryPool: range freed twice");
+    }
+
+    // Merge with the preceding and following free ranges when they touch
+    if (next != m_FreeRanges.begin())
+    {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second > offset)
+        {
+            throw std::runtime_error("GeometryPool: range freed twice");
+        }
+        if (previous->first + previous->second == offset)
+        {
+            offset = previous->first;
+            count += previous->second;
+            m_FreeRanges.erase(previous);
+        }
+    }
+    if (next != m_FreeRanges.end() && offset + count == next->first)
+    {
+        count += next->second;
+        m_FreeRanges.erase(next);
+    }
+
+    m_FreeRanges.emplace(offset, count);
+    m_Used -= std::min(m_Used, count);
+}
+
+uint32_t GeometryPool::RangeAllocator::getLargestFreeRange() const
+{
+    uint32_t largest = 0;
+    for (const auto& range : m_FreeRanges)
+    {
+        largest = std::max(largest, range.second);
+    }
+    return largest;
+}
+
+GeometryPool::GeometryPool(Device* pDevice, VmaAllocator allocator, CommandPool* pCommandPool, const Settings& settings,
+                           StagingRing* pStagingRing, TransferQueue* pTransferQueue)
+    : m_pDevice(pDevice), m_Allocator(allocator), m_pCommandPool(pCommandPool), m_pStagingRing(pStagingRing),
+    m_pTransferQueue(pTransferQueue), m_Settings(settings)
+{
+    if (settings.indexType != VK_INDEX_TYPE_UINT16 && settings.indexType != VK_INDEX_TYPE_UINT32)
+    {
+        throw std::runtime_error("GeometryPool: unsupported index type");
+    }
+
+    m_VertexStride = settings.vertexFormat == VertexFormat::Standard ? sizeof(Vertex) : sizeof(CompactVertex);
+    m_DepthStride = DepthVertexStream::getStride(settings.vertexFormat, settings.depthStream);
+    m_IndexSize = settings.indexType == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+
+    if (!m_pStagingRing && !m_pTransferQueue)
+    {
+        throw std::runtime_error("GeometryPool: a staging ring or a transfer queue is required");
+    }
+
+    createBlock(settings.verticesPerBlock, settings.indicesPerBlock);
+}
+
+GeometryPool::~GeometryPool()
+{
+    m_Blocks.clear();
+}
+
+void GeometryPool::createBlock(uint32_t vertexCapacity, uint32_t indexCapacity)
+{
+    auto pBlock = std::make_unique<Block>(vertexCapacity, indexCapacity);
+
+    const VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    pBlock->pVertexBuffer = std::make_unique<Buffer>(m_Allocator, static_cast<VkDeviceSize>(vertexCapacity) * m_VertexStride,
+        usage | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+    if (m_DepthStride != 0)
+    {
+        pBlock->pDepthVertexBuffer = std::make_unique<Buffer>(m_Allocator, static_cast<VkDeviceSize>(vertexCapacity) * m_DepthStride,
+            usage | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+    }
+    pBlock->pIndexBuffer = std::make_unique<Buffer>(m_Allocator, static_cast<VkDeviceSize>(indexCapacity) * m_IndexSize,
+        usage | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+
+    // Reuse a slot freed by an earlier release so block indices stay small
+    for (std::unique_ptr<Block>& slot : m_Blocks)
+    {
+        if (!slot)
+        {
+            slot = std::move(pBlock);
+            return;
+        }
+    }
+    m_Blocks.push_back(std::move(pBlock));
+}
+
+GeometryPool::Allocation GeometryPool::allocate(uint32_t vertexCount, uint32_t indexCount)
+{
+    for (size_t attempt = 0; attempt < 2; ++attempt)
+    {
+        for (size_t i = 0; i < m_Blocks.size(); ++i)
+        {
+            Block* pBlock = m_Blocks[i].get();
+            if (!pBlock)
+            {
+                continue;
+            }
+
+            Allocation allocation;
+            if (!pBlock->vertices.allocate(vertexCount, allocation.firstVertex))
+            {
+                continue;
+            }
+            if (!pBlock->indices.allocate(indexCount, allocation.firstIndex))
+            {
+                pBlock->vertices.free(allocation.firstVertex, vertexCount);
+                continue;
+            }
+
+            allocation.block = static_cast<uint32_t>(i);
+            allocation.vertexCount = vertexCount;
+            allocation.indexCount = indexCount;
+            ++pBlock->allocationCount;
+            return allocation;
+        }
+
+        // Nothing fits: add a block, sized up for meshes larger than the default
+        createBlock(std::max(vertexCount, m_Settings.verticesPerBlock), std::max(indexCount, m_Settings.indicesPerBlock));
+    }
+
+    throw std::runtime_error("GeometryPool: allocation failed");
+}
+
+void GeometryPool::free(const Allocation& allocation)
+{
+    if (!allocation.isValid())
+    {
+        return;
+    }
+    if (allocation.block >= m_Blocks.size() || !m_Blocks[allocation.block])
+    {
+        throw std::runtime_error("GeometryPool: freeing an allocation from an unknown block");
+    }
+
+    Block& block = *m_Blocks[allocation.block];
+    block.vertices.free(allocation.firstVertex, allocation.vertexCount);
+    block.indices.free(allocation.firstIndex, allocation.indexCount);
+    --block.allocationCount;
+
+    // Give whole blocks back to VMA once they empty out, but always keep one around
+    size_t liveBlocks = 0;
+    for (const std::unique_ptr<Block>& pBlock : m_Blocks)
+    {
+        liveBlocks += pBlock ? 1 : 0;
+    }
+    if (block.allocationCount == 0 && liveBlocks > 1)
+    {
+        m_Blocks[allocation.block].reset();
+    }
+}
+
+uint64_t GeometryPool::upload(const Allocation& allocation, const void* pVertices, const void* pDepthVertices,
+                              const void* pIndices, VkIndexType sourceIndexType)
+{
+    const Block& block = getBlock(allocation.block);
+    if (m_DepthStride != 0 && pDepthVertices == nullptr && allocation.vertexCount != 0)
+    {
+        throw std::runtime_error("GeometryPool: the pool has a depth stream but none was provided");
+    }
+    if (sourceIndexType == VK_INDEX_TYPE_UINT32 && m_Settings.indexType == VK_INDEX_TYPE_UINT16)
+    {
+        throw std::runtime_error("GeometryPool: 32-bit indices cannot be uploaded into a 16-bit pool");
+    }
+
+    const VkDeviceSize vertexBytes = static_cast<VkDeviceSize>(allocation.vertexCount) * m_VertexStride;
+    const VkDeviceSize depthBytes = static_cast<VkDeviceSize>(allocation.vertexCount) * m_DepthStride;
+    const VkDeviceSize indexBytes = static_cast<VkDeviceSize>(allocation.indexCount) * m_IndexSize;
+    const VkDeviceSize totalBytes = vertexBytes + depthBytes + indexBytes;
+    if (totalBytes == 0)
+    {
+        return 0;
+    }
+
+    std::vector<StagingRing::BufferUpload> uploads;
+    if (vertexBytes != 0)
+    {
+        uploads.push_back({ pVertices, vertexBytes, block.pVertexBuffer->get(),
+            static_cast<VkDeviceSize>(allocation.firstVertex) * m_VertexStride });
+    }
+    if (depthBytes != 0)
+    {
+        uploads.push_back({ pDepthVertices, depthBytes, block.pDepthVertexBuffer->get(),
+            static_cast<VkDeviceSize>(allocation.firstVertex) * m_DepthStride });
+    }
+
+    // 16-bit source into a 32-bit pool
+    std::vector<uint32_t> widenedIndices;
+    if (indexBytes != 0)
+    {
+        const void* pIndexData = pIndices;
+        if (sourceIndexType != m_Settings.indexType)
+        {
+            const uint16_t* pSource = static_cast<const uint16_t*>(pIndices);
+            widenedIndices.assign(pSource, pSource + allocation.indexCount);
+            pIndexData = widenedIndices.data();
+        }
+        uploads.push_back({ pIndexData, indexBytes, block.pIndexBuffer->get(),
+            static_cast<VkDeviceSize>(allocation.firstIndex) * m_IndexSize });
+    }
+
+    if (m_pTransferQueue)
+    {
+        // All ranges land in the same open job, so the last ticket covers them
+        uint64_t ticket = 0;
+        for (const StagingRing::BufferUpload& upload : uploads)
+        {
+            ticket = m_pTransferQueue->uploadBuffer(upload.pData, upload.size, upload.dstBuffer, upload.dstOffset);
+        }
+        return ticket;
+    }
+
+    m_pStagingRing->uploadBuffers(m_pCommandPool, m_pDevice->getGraphicsQueue(), uploads);
+    return 0;
+}
+
+void GeometryPool::bind(VkCommandBuffer commandBuffer, uint32_t block, bool depthOnly) const
+{
+    const Block& poolBlock = getBlock(block);
+    if (depthOnly && !poolBlock.pDepthVertexBuffer)
+    {
+        throw std::runtime_error("GeometryPool: the pool has no depth stream");
+    }
+
+    VkBuffer vertexBuffer = depthOnly ? poolBlock.pDepthVertexBuffer->get() : poolBlock.pVertexBuffer->get();
+    VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer, &offset);
+    vkCmdBindIndexBuffer(commandBuffer, poolBlock.pIndexBuffer->get(), 0, m_Settings.indexType);
+}
+
+VkBuffer GeometryPool::getVertexBuffer(uint32_t block) const
+{
+    return getBlock(block).pVertexBuffer->get();
+}
+
+VkBuffer GeometryPool::getDepthVertexBuffer(uint32_t block) const
+{
+    const Block& poolBlock = getBlock(block);
+    return poolBlock.pDepthVertexBuffer ? poolBlock.pDepthVertexBuffer->get() : VK_NULL_HANDLE;
+}
+
+VkBuffer GeometryPool::getIndexBuffer(uint32_t block) const
+{
+    return getBlock(block).pIndexBuffer->get();
+}
+
+const GeometryPool::Block& GeometryPool::getBlock(uint32_t block) const
+{
+    if (block >= m_Blocks.size() || !m_Blocks[block])
+    {
+        throw std::runtime_error("GeometryPool: invalid block " + std::to_string(block));
+    }
+    return *m_Blocks[block];
+}
+
+GeometryPool::Stats GeometryPool::getStats() const
+{
+    Stats stats;
+    for (const std::unique_ptr<Block>& pBlock : m_Blocks)
+    {
+        if (!pBlock)
+        {
+            continue;
+        }
+        ++stats.blockCount;
+        stats.allocationCount += pBlock->allocationCount;
+        stats.vertexCapacity += pBlock->vertices.getCapacity();
+        stats.vertexUsed += pBlock->vertices.getUsed();
+        stats.indexCapacity += pBlock->indices.getCapacity();
+        stats.indexUsed += pBlock->indices.getUsed();
+        stats.largestFreeVertexRange = std::max<size_t>(stats.largestFreeVertexRange, pBlock->vertices.getLargestFreeRange());
+    }
+    return stats;
+}
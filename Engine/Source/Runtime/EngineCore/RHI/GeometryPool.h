@@ -0,0 +1,144 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include "vk_mem_alloc.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "Buffer.h"
+#include "CompactVertex.h"
+#include "DepthVertexStream.h"
+#include "StagingRing.h"
+
+class Device;
+class CommandPool;
+class TransferQueue;
+
+//
+// Shared geometry megabuffer. Vertex and index ranges of many Models are sub-allocated out of
+// a few large device-local blocks, so a whole scene can be drawn with one vertex/index bind
+// per block and a single VMA allocation backs thousands of meshes. All models in a pool share
+// one vertex format, optional depth stream and index type. Ranges are tracked in elements
+// (vertices, indices) so allocation offsets map directly onto vkCmdDrawIndexed parameters.
+//
+class GeometryPool
+{
+public:
+    struct Settings
+    {
+        VertexFormat vertexFormat = VertexFormat::Standard;
+        DepthStream depthStream = DepthStream::None;
+        VkIndexType indexType = VK_INDEX_TYPE_UINT32;
+
+        // Capacity of each block; a larger block is created for meshes that do not fit
+        uint32_t verticesPerBlock = 4u * 1024u * 1024u;
+        uint32_t indicesPerBlock = 16u * 1024u * 1024u;
+    };
+
+    struct Allocation
+    {
+        uint32_t block = UINT32_MAX;
+        uint32_t firstVertex = 0; // vertexOffset for vkCmdDrawIndexed
+        uint32_t vertexCount = 0;
+        uint32_t firstIndex = 0;  // firstIndex for vkCmdDrawIndexed
+        uint32_t indexCount = 0;
+
+        bool isValid() const { return block != UINT32_MAX; }
+    };
+
+    struct Stats
+    {
+        size_t blockCount = 0;
+        size_t allocationCount = 0;
+        uint64_t vertexCapacity = 0;
+        uint64_t vertexUsed = 0;
+        uint64_t indexCapacity = 0;
+        uint64_t indexUsed = 0;
+        size_t largestFreeVertexRange = 0; // Fragmentation indicator
+    };
+
+    // Needs pStagingRing or pTransferQueue. With pTransferQueue uploads are recorded into its open job and
+    // complete asynchronously; otherwise they go through pStagingRing and are waited on.
+    GeometryPool(Device* pDevice, VmaAllocator allocator, CommandPool* pCommandPool, const Settings& settings,
+                 StagingRing* pStagingRing, TransferQueue* pTransferQueue);
+    ~GeometryPool();
+
+    GeometryPool(const GeometryPool&) = delete;
+    GeometryPool& operator=(const GeometryPool&) = delete;
+
+    Allocation allocate(uint32_t vertexCount, uint32_t indexCount);
+    // Releases the ranges; adjacent free ranges are merged and empty blocks beyond the first are destroyed.
+    // The caller must ensure the GPU no longer reads the ranges.
+    void free(const Allocation& allocation);
+
+    // pDepthVertices is required when the pool has a depth stream. Indices of sourceIndexType are
+    // widened when the pool uses 32-bit indices; 32-bit sources cannot go into a 16-bit pool.
+    // Returns the TransferQueue ticket the ranges may be drawn after, or 0 when the copy already completed.
+    uint64_t upload(const Allocation& allocation, const void* pVertices, const void* pDepthVertices,
+                const void* pIndices, VkIndexType sourceIndexType);
+
+    // Binds block buffers: the main vertex stream (or the depth stream when depthOnly) at binding 0
+    void bind(VkCommandBuffer commandBuffer, uint32_t block, bool depthOnly = false) const;
+
+    VkBuffer getVertexBuffer(uint32_t block) const;
+    VkBuffer getDepthVertexBuffer(uint32_t block) const;
+    VkBuffer getIndexBuffer(uint32_t block) const;
+    size_t getBlockCount() const { return m_Blocks.size(); }
+
+    const Settings& getSettings() const { return m_Settings; }
+    Stats getStats() const;
+
+private:
+    // First-fit free list over [0, capacity); freed ranges coalesce with their neighbours
+    class RangeAllocator
+    {
+    public:
+        explicit RangeAllocator(uint32_t capacity);
+
+        bool allocate(uint32_t count, uint32_t& offset);
+        void free(uint32_t offset, uint32_t count);
+
+        uint32_t getCapacity() const { return m_Capacity; }
+        uint32_t getUsed() const { return m_Used; }
+        uint32_t getLargestFreeRange() const;
+
+    private:
+        std::map<uint32_t, uint32_t> m_FreeRanges; // offset -> count
+        uint32_t m_Capacity;
+        uint32_t m_Used = 0;
+    };
+
+    struct Block
+    {
+        std::unique_ptr<Buffer> pVertexBuffer;
+        std::unique_ptr<Buffer> pDepthVertexBuffer;
+        std::unique_ptr<Buffer> pIndexBuffer;
+        RangeAllocator vertices;
+        RangeAllocator indices;
+        size_t allocationCount = 0;
+
+        Block(uint32_t vertexCapacity, uint32_t indexCapacity)
+            : vertices(vertexCapacity), indices(indexCapacity)
+        {
+        }
+    };
+
+    void createBlock(uint32_t vertexCapacity, uint32_t indexCapacity);
+    const Block& getBlock(uint32_t block) const;
+
+    Device* m_pDevice;
+    VmaAllocator m_Allocator;
+    CommandPool* m_pCommandPool;
+    StagingRing* m_pStagingRing;
+    TransferQueue* m_pTransferQueue;
+    Settings m_Settings;
+    uint32_t m_VertexStride;
+    uint32_t m_DepthStride;
+    uint32_t m_IndexSize;
+
+    std::vector<std::unique_ptr<Block>> m_Blocks; // Destroyed blocks leave a null slot so indices stay stable
+};
@@ -0,0 +1,944 @@
+#include "GltfImporter.h"
+
+#include <glm/gtc/quaternion.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include "Runtime/EngineCore/Core/FileScan.h"
+#include "Runtime/EngineCore/Core/ParallelFor.h"
+#include "Runtime/EngineCore/Core/Log.h"
+
+namespace
+{
+    constexpr uint32_t GlbMagic = 0x46546C67;     // "glTF"
+    constexpr uint32_t GlbChunkJson = 0x4E4F534A; // "JSON"
+    constexpr uint32_t GlbChunkBin = 0x004E4942;  // "BIN\0"
+
+    constexpr uint32_t ComponentByte = 5120;
+    constexpr uint32_t ComponentUnsignedByte = 5121;
+    constexpr uint32_t ComponentShort = 5122;
+    constexpr uint32_t ComponentUnsignedShort = 5123;
+    constexpr uint32_t ComponentUnsignedInt = 5125;
+    constexpr uint32_t ComponentFloat = 5126;
+
+    constexpr int64_t ModeTriangles = 4;
+    constexpr int MaxNodeDepth = 256;
+
+    constexpr int64_t FilterNearest = 9728;
+    constexpr int64_t FilterLinear = 9729;
+    constexpr int64_t FilterNearestMipmapNearest = 9984;
+    constexpr int64_t FilterLinearMipmapNearest = 9985;
+    constexpr int64_t FilterNearestMipmapLinear = 9986;
+    constexpr int64_t WrapClampToEdge = 33071;
+    constexpr int64_t WrapMirroredRepeat = 33648;
+
+    VkSamplerAddressMode getAddressMode(int64_t wrap)
+    {
+        switch (wrap)
+        {
+        case WrapClampToEdge:
+            return VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        case WrapMirroredRepeat:
+            return VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
+        default:
+            return VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        }
+    }
+
+    uint32_t readU32(const uint8_t* pData)
+    {
+        uint32_t value;
+        memcpy(&value, pData, sizeof(value));
+        return value;
+    }
+
+    size_t getComponentSize(uint32_t componentType)
+    {
+        switch (componentType)
+        {
+        case ComponentByte:
+        case ComponentUnsignedByte:
+            return 1;
+        case ComponentShort:
+        case ComponentUnsignedShort:
+            return 2;
+        case ComponentUnsignedInt:
+        case ComponentFloat:
+            return 4;
+        default:
+            throw std::runtime_error("glTF: unsupported accessor component type " + std::to_string(componentType));
+        }
+    }
+
+    uint32_t getComponentCount(const std::string& type)
+    {
+        if (type == "SCALAR") return 1;
+        if (type == "VEC2") return 2;
+        if (type == "VEC3") return 3;
+        if (type == "VEC4") return 4;
+        if (type == "MAT2") return 4;
+        if (type == "MAT3") return 9;
+        if (type == "MAT4") return 16;
+        throw std::runtime_error("glTF: unsupported accessor type " + type);
+    }
+
+    bool startsWith(const std::string& text, const char* prefix)
+    {
+        return text.rfind(prefix, 0) == 0;
+    }
+
+    std::string decodeUri(const std::string& uri)
+    {
+        std::string result;
+        result.reserve(uri.size());
+        for (size_t i = 0; i < uri.size(); ++i)
+        {
+            if (uri[i] == '%' && i + 2 < uri.size())
+            {
+                result.push_back(static_cast<char>(std::stoi(uri.substr(i + 1, 2), nullptr, 16)));
+                i += 2;
+            }
+            else
+            {
+                result.push_back(uri[i]);
+            }
+        }
+        return result;
+    }
+
+    std::vector<uint8_t> decodeBase64(const char* pBegin, const char* pEnd)
+    {
+        auto decodeChar = [](char c) -> int
+        {
+            if (c >= 'A' && c <= 'Z') return c - 'A';
+            if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+            if (c >= '0' && c <= '9') return c - '0' + 52;
+            if (c == '+' || c == '-') return 62;
+            if (c == '/' || c == '_') return 63;
+            return -1;
+        };
+
+        std::vector<uint8_t> result;
+        result.reserve(static_cast<size_t>(pEnd - pBegin) * 3 / 4);
+
+        uint32_t accumulator = 0;
+        int bits = 0;
+        for (const char* p = pBegin; p != pEnd; ++p)
+        {
+            int value = decodeChar(*p);
+            if (value < 0)
+            {
+                continue; // Padding and whitespace
+            }
+            accumulator = (accumulator << 6) | static_cast<uint32_t>(value);
+            bits += 6;
+            if (bits >= 8)
+            {
+                bits -= 8;
+                result.push_back(static_cast<uint8_t>((accumulator >> bits) & 0xFF));
+            }
+        }
+        return result;
+    }
+
+    glm::vec3 safeNormalize(const glm::vec3& v)
+    {
+        float length = glm::length(v);
+        return length > 0.0f ? v / length : v;
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Smooth normals for primitives without NORMAL. The unnormalized face cross product weights each
+    // triangle by its area, so slivers barely bend the shading.
+    void generateNormals(Vertex* pVertices, size_t vertexCount, const uint32_t* pIndices, size_t indexCount,
+                         uint32_t baseVertex)
+    {
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            pVertices[i].normal = glm::vec3(0.0f);
+        }
+        for (size_t i = 0; i + 2 < indexCount; i += 3)
+        {
+            Vertex& v0 = pVertices[pIndices[i] - baseVertex];
+            Vertex& v1 = pVertices[pIndices[i + 1] - baseVertex];
+            Vertex& v2 = pVertices[pIndices[i + 2] - baseVertex];
+            glm::vec3 faceNormal = glm::cross(v1.pos - v0.pos, v2.pos - v0.pos);
+            v0.normal += faceNormal;
+            v1.normal += faceNormal;
+            v2.normal += faceNormal;
+        }
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            pVertices[i].normal = safeNormalize(pVertices[i].normal);
+        }
+    }
+
+    // Tangent frames for primitives without TANGENT, from the texture coordinate gradients of the
+    // surrounding triangles. Vertices without usable UVs get an arbitrary frame around the normal.
+    void generateTangents(Vertex* pVertices, size_t vertexCount, const uint32_t* pIndices, size_t indexCount,
+                          uint32_t baseVertex)
+    {
+        std::vector<glm::vec3> bitangents(vertexCount, glm::vec3(0.0f));
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            pVertices[i].tangent = glm::vec3(0.0f);
+        }
+        for (size_t i = 0; i + 2 < indexCount; i += 3)
+        {
+            const uint32_t corners[3] = { pIndices[i] - baseVertex, pIndices[i + 1] - baseVertex, pIndices[i + 2] - baseVertex };
+            const Vertex& v0 = pVertices[corners[0]];
+            const Vertex& v1 = pVertices[corners[1]];
+            const Vertex& v2 = pVertices[corners[2]];
+
+            glm::vec3 edge1 = v1.pos - v0.pos;
+            glm::vec3 edge2 = v2.pos - v0.pos;
+            glm::vec2 deltaUv1 = v1.texCoord - v0.texCoord;
+            glm::vec2 deltaUv2 = v2.texCoord - v0.texCoord;
+            float determinant = deltaUv1.x * deltaUv2.y - deltaUv2.x * deltaUv1.y;
+            if (std::fabs(determinant) < 1e-12f)
+            {
+                continue;
+            }
+
+            glm::vec3 tangent = (edge1 * deltaUv2.y - edge2 * deltaUv1.y) / determinant;
+            glm::vec3 bitangent = (edge2 * deltaUv1.x - edge1 * deltaUv2.x) / determinant;
+            for (uint32_t corner : corners)
+            {
+                pVertices[corner].tangent += tangent;
+                bitangents[corner] += bitangent;
+            }
+        }
+
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            Vertex& vertex = pVertices[i];
+            const glm::vec3& n = vertex.normal;
+            glm::vec3 t = safeNormalize(vertex.tangent - n * glm::dot(n, vertex.tangent));
+            if (glm::dot(t, t) == 0.0f)
+            {
+                glm::vec3 axis = std::fabs(n.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+                t = safeNormalize(glm::cross(axis, n));
+            }
+            vertex.tangent = t;
+            float handedness = glm::dot(glm::cross(n, t), bitangents[i]) < 0.0f ? -1.0f : 1.0f;
+            vertex.bitangent = glm::cross(n, t) * handedness;
+        }
+    }
+}
+
+struct GltfImporter::Accessor
+{
+    const uint8_t* pData = nullptr;
+    size_t count = 0;
+    size_t stride = 0;
+    uint32_t componentType = 0;
+    uint32_t componentCount = 0;
+    bool normalized = false;
+
+    bool isValid() const { return pData != nullptr; }
+
+    // Reads up to outCount components of element i as floats, zero-filling the rest
+    void readFloats(size_t i, float* pOut, uint32_t outCount) const
+    {
+        const uint8_t* pElement = pData + i * stride;
+        uint32_t n = outCount < componentCount ? outCount : componentCount;
+
+        switch (componentType)
+        {
+        case ComponentFloat:
+            memcpy(pOut, pElement, n * sizeof(float));
+            break;
+        case ComponentUnsignedByte:
+            for (uint32_t c = 0; c < n; ++c)
+                pOut[c] = normalized ? pElement[c] / 255.0f : static_cast<float>(pElement[c]);
+            break;
+        case ComponentByte:
+            for (uint32_t c = 0; c < n; ++c)
+            {
+                float value = static_cast<float>(static_cast<int8_t>(pElement[c]));
+                pOut[c] = normalized ? glm::max(value / 127.0f, -1.0f) : value;
+            }
+            break;
+        case ComponentUnsignedShort:
+            for (uint32_t c = 0; c < n; ++c)
+            {
+                uint16_t value;
+                memcpy(&value, pElement + c * 2, sizeof(value));
+                pOut[c] = normalized ? value / 65535.0f : static_cast<float>(value);
+            }
+            break;
+        case ComponentShort:
+            for (uint32_t c = 0; c < n; ++c)
+            {
+                int16_t value;
+                memcpy(&value, pElement + c * 2, sizeof(value));
+                pOut[c] = normalized ? glm::max(value / 32767.0f, -1.0f) : static_cast<float>(value);
+            }
+            break;
+        case ComponentUnsignedInt:
+            for (uint32_t c = 0; c < n; ++c)
+                pOut[c] = static_cast<float>(readU32(pElement + c * 4));
+            break;
+        }
+
+        for (uint32_t c = n; c < outCount; ++c)
+        {
+            pOut[c] = 0.0f;
+        }
+    }
+
+    uint32_t readIndex(size_t i) const
+    {
+        const uint8_t* pElement = pData + i * stride;
+        switch (componentType)
+        {
+        case ComponentUnsignedByte:
+            return *pElement;
+        case ComponentUnsignedShort:
+        {
+            uint16_t value;
+            memcpy(&value, pElement, sizeof(value));
+            return value;
+        }
+        case ComponentUnsignedInt:
+            return readU32(pElement);
+        default:
+            throw std::runtime_error("glTF: invalid index component type");
+        }
+    }
+};
+
+double GltfImporter::Stats::getMegabytesPerSecond() const
+{
+    double seconds = getTotalSeconds();
+    return seconds > 0.0 ? (static_cast<double>(sourceBytes) / (1024.0 * 1024.0)) / seconds : 0.0;
+}
+
+double GltfImporter::Stats::getVerticesPerSecond() const
+{
+    double seconds = getTotalSeconds();
+    return seconds > 0.0 ? static_cast<double>(vertexCount) / seconds : 0.0;
+}
+
+GltfImporter::GltfImporter(const std::string& path)
+    : m_Path(path)
+{
+    size_t lastSlash = m_Path.find_last_of("/\\");
+    m_Directory = (lastSlash == std::string::npos) ? "." : m_Path.substr(0, lastSlash);
+}
+
+GltfImporter::~GltfImporter() = default;
+
+void GltfImporter::import(std::vector<Vertex>& vertices,
+                          std::vector<uint32_t>& indices,
+                          std::vector<Submesh>& submeshes,
+                          std::vector<MaterialDesc>& materials)
+{
+    m_Stats = Stats{};
+
+    auto parseStart = std::chrono::steady_clock::now();
+    loadDocument();
+    loadBuffers();
+    m_Stats.parseSeconds = secondsSince(parseStart);
+
+    auto decodeStart = std::chrono::steady_clock::now();
+
+    std::vector<DrawItem> items;
+    uint32_t defaultMaterialIndex = UINT32_MAX;
+    collectDrawItems(items, defaultMaterialIndex);
+
+    const size_t materialBase = materials.size();
+    const size_t vertexBase = vertices.size();
+    const size_t indexBase = indices.size();
+    const size_t submeshBase = submeshes.size();
+
+    // Prefix sums give every primitive its own disjoint output range, so decoding
+    // needs no synchronization and no intermediate per-primitive arrays.
+    std::vector<size_t> vertexOffsets(items.size());
+    std::vector<size_t> indexOffsets(items.size());
+    size_t vertexTotal = vertexBase;
+    size_t indexTotal = indexBase;
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        vertexOffsets[i] = vertexTotal;
+        indexOffsets[i] = indexTotal;
+        vertexTotal += items[i].vertexCount;
+        indexTotal += items[i].indexCount;
+    }
+
+    if (vertexTotal > UINT32_MAX || indexTotal > UINT32_MAX)
+    {
+        throw std::runtime_error("glTF: scene exceeds 32-bit vertex/index range: " + m_Path);
+    }
+
+    vertices.resize(vertexTotal);
+    indices.resize(indexTotal);
+    submeshes.resize(submeshBase + items.size());
+
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        size_t materialIndex = materialBase + items[i].materialIndex;
+        if (materialIndex > UINT16_MAX)
+        {
+            throw std::runtime_error("glTF: too many materials: " + m_Path);
+        }
+
+        Submesh& submesh = submeshes[submeshBase + i];
+        submesh.indexStart = static_cast<uint32_t>(indexOffsets[i]);
+        submesh.indexCount = static_cast<uint32_t>(items[i].indexCount);
+        submesh.materialIndex = static_cast<uint16_t>(materialIndex);
+        CAE_LOG_TRACE(Asset, "glTF: primitive " << i << " of " << m_Path << ": " << items[i].vertexCount << " vertices, "
+            << items[i].indexCount << " indices, material " << materialIndex);
+    }
+
+    parallelFor(items.size(), [&](size_t i)
+    {
+        decodePrimitive(items[i], vertices.data() + vertexOffsets[i], indices.data() + indexOffsets[i],
+            static_cast<uint32_t>(vertexOffsets[i]), submeshes[submeshBase + i]);
+    }, m_MaxThreads);
+
+    const JsonValue& gltfMaterials = m_Document["materials"];
+    for (size_t i = 0; i < gltfMaterials.size(); ++i)
+    {
+        const JsonValue& gltfMaterial = gltfMaterials[i];
+        const JsonValue& pbr = gltfMaterial["pbrMetallicRoughness"];
+
+        MaterialDesc desc;
+        desc.diffusePath = resolveImagePath(pbr["baseColorTexture"]);
+        desc.normalPath = resolveImagePath(gltfMaterial["normalTexture"]);
+        desc.metallicRoughnessPath = resolveImagePath(pbr["metallicRoughnessTexture"]);
+        desc.sampler = readSampler(pbr["baseColorTexture"]);
+        materials.push_back(desc);
+    }
+    if (defaultMaterialIndex != UINT32_MAX)
+    {
+        materials.push_back(MaterialDesc{});
+    }
+
+    m_Stats.decodeSeconds = secondsSince(decodeStart);
+    m_Stats.vertexCount = vertexTotal - vertexBase;
+    m_Stats.indexCount = indexTotal - indexBase;
+    m_Stats.primitiveCount = items.size();
+    CAE_LOG_DEBUG(Asset, "glTF: imported " << m_Path << ": " << m_Stats.primitiveCount << " primitives, " << m_Stats.vertexCount
+        << " vertices, parse " << m_Stats.parseSeconds * 1000.0 << " ms, decode " << m_Stats.decodeSeconds * 1000.0 << " ms");
+}
+
+std::vector<std::string> GltfImporter::findScenes(const std::string& folder)
+{
+    return findFiles(folder, { ".gltf", ".glb" });
+}
+
+void GltfImporter::runBenchmark(const std::string& folder)
+{
+    const std::vector<std::string> paths = findScenes(folder);
+    if (paths.empty())
+    {
+        CAE_LOG_INFO(Asset, "glTF import benchmark: no scenes in " << folder);
+        return;
+    }
+
+    const size_t coreCount = std::max(1u, std::thread::hardware_concurrency());
+    CAE_LOG_INFO(Asset, "glTF import benchmark: " << paths.size() << " scenes from " << folder);
+
+    double singleThreadSeconds = 0.0;
+    for (size_t threads = 1;; threads = std::min(threads * 2, coreCount))
+    {
+        Stats total;
+        for (const std::string& path : paths)
+        {
+            std::vector<Vertex> vertices;
+            std::vector<uint32_t> indices;
+            std::vector<Submesh> submeshes;
+            std::vector<MaterialDesc> materials;
+
+            GltfImporter importer(path);
+            importer.setMaxThreads(threads);
+            importer.import(vertices, indices, submeshes, materials);
+
+            const Stats& stats = importer.getStats();
+            total.sourceBytes += stats.sourceBytes;
+            total.vertexCount += stats.vertexCount;
+            total.indexCount += stats.indexCount;
+            total.primitiveCount += stats.primitiveCount;
+            total.parseSeconds += stats.parseSeconds;
+            total.decodeSeconds += stats.decodeSeconds;
+        }
+        if (threads == 1)
+        {
+            singleThreadSeconds = total.getTotalSeconds();
+        }
+
+        CAE_LOG_INFO(Asset, "  " << threads << " threads: parse " << total.parseSeconds * 1000.0 << " ms, decode "
+            << total.decodeSeconds * 1000.0 << " ms, " << total.getMegabytesPerSecond() << " MB/s, "
+            << total.getVerticesPerSecond() << " vertices/s, speedup " << singleThreadSeconds / total.getTotalSeconds() << "x");
+
+        if (threads == coreCount)
+        {
+            break;
+        }
+    }
+}
+
+void GltfImporter::loadDocument()
+{
+    m_SourceFile.open(m_Path);
+    m_Stats.sourceBytes += m_SourceFile.size();
+
+    const uint8_t* pData = m_SourceFile.data();
+    const size_t size = m_SourceFile.size();
+
+    const char* pJsonBegin = reinterpret_cast<const char*>(pData);
+    const char* pJsonEnd = pJsonBegin + size;
+
+    if (size >= 12 && readU32(pData) == GlbMagic)
+    {
+        uint32_t version = readU32(pData + 4);
+        uint32_t length = readU32(pData + 8);
+        if (version != 2 || length > size)
+        {
+            throw std::runtime_error("glTF: invalid GLB header: " + m_Path);
+        }
+
+        size_t offset = 12;
+        bool hasJson = false;
+        while (offset + 8 <= length)
+        {
+            uint32_t chunkLength = readU32(pData + offset);
+            uint32_t chunkType = readU32(pData + offset + 4);
+            offset += 8;
+            if (offset + chunkLength > length)
+            {
+                throw std::runtime_error("glTF: truncated GLB chunk: " + m_Path);
+            }
+
+            if (chunkType == GlbChunkJson && !hasJson)
+            {
+                pJsonBegin = reinterpret_cast<const char*>(pData + offset);
+                pJsonEnd = pJsonBegin + chunkLength;
+                hasJson = true;
+            }
+            else if (chunkType == GlbChunkBin && m_BinaryChunk.pData == nullptr)
+            {
+                m_BinaryChunk.pData = pData + offset;
+                m_BinaryChunk.size = chunkLength;
+            }
+            offset += (chunkLength + 3) & ~3u;
+        }
+
+        if (!hasJson)
+        {
+            throw std::runtime_error("glTF: GLB has no JSON chunk: " + m_Path);
+        }
+    }
+
+    m_Document = JsonValue::parse(pJsonBegin, pJsonEnd);
+
+    const std::string& version = m_Document["asset"]["version"].asString();
+    if (!startsWith(version, "2."))
+    {
+        throw std::runtime_error("glTF: unsupported asset version '" + version + "': " + m_Path);
+    }
+}
+
+void GltfImporter::loadBuffers()
+{
+    const JsonValue& buffers = m_Document["buffers"];
+    m_Buffers.resize(buffers.size());
+
+    for (size_t i = 0; i < buffers.size(); ++i)
+    {
+        const JsonValue& buffer = buffers[i];
+        const size_t byteLength = static_cast<size_t>(buffer["byteLength"].asInt());
+        BufferData& data = m_Buffers[i];
+
+        if (!buffer.has("uri"))
+        {
+            data = m_BinaryChunk;
+        }
+        else
+        {
+            const std::string& uri = buffer["uri"].asString();
+            if (startsWith(uri, "data:"))
+            {
+                size_t comma = uri.find(',');
+                if (comma == std::string::npos || uri.rfind(";base64", comma) == std::string::npos)
+                {
+                    throw std::runtime_error("glTF: unsupported data URI in buffer " + std::to_string(i));
+                }
+                auto decoded = std::make_unique<std::vector<uint8_t>>(decodeBase64(uri.data() + comma + 1, uri.data() + uri.size()));
+                data.pData = decoded->data();
+                data.size = decoded->size();
+                m_Stats.sourceBytes += decoded->size();
+                m_DecodedBuffers.push_back(std::move(decoded));
+            }
+            else
+            {
+                MappedFile& file = m_ExternalFiles.emplace_back(m_Directory + "/" + decodeUri(uri));
+                data.pData = file.data();
+                data.size = file.size();
+                m_Stats.sourceBytes += file.size();
+            }
+        }
+
+        if (data.size < byteLength)
+        {
+            throw std::runtime_error("glTF: buffer " + std::to_string(i) + " is smaller than its declared byteLength");
+        }
+    }
+}
+
+GltfImporter::Accessor GltfImporter::getAccessor(int64_t accessorIndex) const
+{
+    Accessor accessor;
+    if (accessorIndex < 0)
+    {
+        return accessor;
+    }
+
+    const JsonValue& json = m_Document["accessors"][static_cast<size_t>(accessorIndex)];
+    if (json.isNull())
+    {
+        throw std::runtime_error("glTF: accessor index out of range: " + std::to_string(accessorIndex));
+    }
+    if (json.has("sparse"))
+    {
+        throw std::runtime_error("glTF: sparse accessors are not supported");
+    }
+
+    accessor.count = static_cast<size_t>(json["count"].asInt());
+    accessor.componentType = static_cast<uint32_t>(json["componentType"].asInt());
+    accessor.componentCount = getComponentCount(json["type"].asString());
+    accessor.normalized = json["normalized"].asBool();
+
+    const size_t elementSize = getComponentSize(accessor.componentType) * accessor.componentCount;
+
+    if (!json.has("bufferView"))
+    {
+        throw std::runtime_error("glTF: accessors without a bufferView are not supported");
+    }
+
+    const JsonValue& view = m_Document["bufferViews"][static_cast<size_t>(json["bufferView"].asInt())];
+    const size_t bufferIndex = static_cast<size_t>(view["buffer"].asInt());
+    if (bufferIndex >= m_Buffers.size())
+    {
+        throw std::runtime_error("glTF: bufferView references a missing buffer");
+    }
+
+    const BufferData& buffer = m_Buffers[bufferIndex];
+    const size_t viewOffset = static_cast<size_t>(view["byteOffset"].asInt());
+    const size_t viewLength = static_cast<size_t>(view["byteLength"].asInt());
+    const size_t accessorOffset = static_cast<size_t>(json["byteOffset"].asInt());
+
+    accessor.stride = static_cast<size_t>(view["byteStride"].asInt(0));
+    if (accessor.stride == 0)
+    {
+        accessor.stride = elementSize;
+    }
+
+    if (viewOffset + viewLength > buffer.size ||
+        (accessor.count > 0 && accessorOffset + (accessor.count - 1) * accessor.stride + elementSize > viewLength))
+    {
+        throw std::runtime_error("glTF: accessor " + std::to_string(accessorIndex) + " reads past the end of its buffer");
+    }
+
+    accessor.pData = buffer.pData + viewOffset + accessorOffset;
+    return accessor;
+}
+
+void GltfImporter::collectDrawItems(std::vector<DrawItem>& items, uint32_t& defaultMaterialIndex) const
+{
+    const JsonValue& scenes = m_Document["scenes"];
+    if (scenes.size() == 0)
+    {
+        // No scene graph: every mesh is drawn once, untransformed
+        const JsonValue& meshes = m_Document["meshes"];
+        for (size_t i = 0; i < meshes.size(); ++i)
+        {
+            appendMeshPrimitives(meshes[i], glm::mat4(1.0f), items, defaultMaterialIndex);
+        }
+        return;
+    }
+
+    const JsonValue& scene = scenes[static_cast<size_t>(m_Document["scene"].asInt(0))];
+    const JsonValue& rootNodes = scene["nodes"];
+    for (size_t i = 0; i < rootNodes.size(); ++i)
+    {
+        collectNode(static_cast<size_t>(rootNodes[i].asInt()), glm::mat4(1.0f), items, defaultMaterialIndex, 0);
+    }
+}
+
+void GltfImporter::collectNode(size_t nodeIndex, const glm::mat4& parentTransform, std::vector<DrawItem>& items,
+                               uint32_t& defaultMaterialIndex, int depth) const
+{
+    if (depth > MaxNodeDepth)
+    {
+        throw std::runtime_error("glTF: node hierarchy too deep or cyclic: " + m_Path);
+    }
+
+    const JsonValue& node = m_Document["nodes"][nodeIndex];
+    if (node.isNull())
+    {
+        throw std::runtime_error("glTF: node index out of range: " + std::to_string(nodeIndex));
+    }
+
+    glm::mat4 localTransform(1.0f);
+    if (node.has("matrix"))
+    {
+        const JsonValue& matrix = node["matrix"];
+        float values[16];
+        for (size_t i = 0; i < 16; ++i)
+        {
+            values[i] = static_cast<float>(matrix[i].asNumber(i % 5 == 0 ? 1.0 : 0.0));
+        }
+        localTransform = glm::make_mat4(values);
+    }
+    else
+    {
+        const JsonValue& t = node["translation"];
+        const JsonValue& r = node["rotation"];
+        const JsonValue& s = node["scale"];
+
+        glm::vec3 translation(
+            static_cast<float>(t[0].asNumber()), static_cast<float>(t[1].asNumber()), static_cast<float>(t[2].asNumber()));
+        glm::quat rotation(
+            static_cast<float>(r[3].asNumber(1.0)), static_cast<float>(r[0].asNumber()),
+            static_cast<float>(r[1].asNumber()), static_cast<float>(r[2].asNumber()));
+        glm::vec3 scale(
+            static_cast<float>(s[0].asNumber(1.0)), static_cast<float>(s[1].asNumber(1.0)), static_cast<float>(s[2].asNumber(1.0)));
+
+        localTransform = glm::translate(glm::mat4(1.0f), translation) * glm::mat4_cast(rotation) * glm::scale(glm::mat4(1.0f), scale);
+    }
+
+    glm::mat4 worldTransform = parentTransform * localTransform;
+
+    if (node.has("mesh"))
+    {
+        const JsonValue& mesh = m_Document["meshes"][static_cast<size_t>(node["mesh"].asInt())];
+        appendMeshPrimitives(mesh, worldTransform, items, defaultMaterialIndex);
+    }
+
+    const JsonValue& children = node["children"];
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        collectNode(static_cast<size_t>(children[i].asInt()), worldTransform, items, defaultMaterialIndex, depth + 1);
+    }
+}
+
+void GltfImporter::appendMeshPrimitives(const JsonValue& mesh, const glm::mat4& transform, std::vector<DrawItem>& items,
+                                        uint32_t& defaultMaterialIndex) const
+{
+    const JsonValue& primitives = mesh["primitives"];
+    for (size_t i = 0; i < primitives.size(); ++i)
+    {
+        const JsonValue& primitive = primitives[i];
+        if (primitive["mode"].asInt(ModeTriangles) != ModeTriangles)
+        {
+            CAE_LOG_WARNING(Asset, "glTF: skipping non-triangle primitive in " << m_Path);
+            continue;
+        }
+
+        const JsonValue& attributes = primitive["attributes"];
+        if (!attributes.has("POSITION"))
+        {
+            continue;
+        }
+
+        DrawItem item;
+        item.pPrimitive = &primitive;
+        item.transform = transform;
+        item.vertexCount = static_cast<size_t>(m_Document["accessors"][static_cast<size_t>(attributes["POSITION"].asInt())]["count"].asInt());
+        item.indexCount = primitive.has("indices")
+            ? static_cast<size_t>(m_Document["accessors"][static_cast<size_t>(primitive["indices"].asInt())]["count"].asInt())
+            : item.vertexCount;
+        item.indexCount -= item.indexCount % 3;
+
+        if (primitive.has("material"))
+        {
+            item.materialIndex = static_cast<uint32_t>(primitive["material"].asInt());
+            if (item.materialIndex >= m_Document["materials"].size())
+            {
+                throw std::runtime_error("glTF: primitive references a missing material");
+            }
+        }
+        else
+        {
+            defaultMaterialIndex = static_cast<uint32_t>(m_Document["materials"].size());
+            item.materialIndex = defaultMaterialIndex;
+        }
+
+        items.push_back(item);
+    }
+}
+
+void GltfImporter::decodePrimitive(const DrawItem& item, Vertex* pVertices, uint32_t* pIndices,
+                                   uint32_t baseVertex, Submesh& submesh) const
+{
+    const JsonValue& primitive = *item.pPrimitive;
+    const JsonValue& attributes = primitive["attributes"];
+
+    Accessor positions = getAccessor(attributes["POSITION"].asInt(-1));
+    Accessor normals = getAccessor(attributes["NORMAL"].asInt(-1));
+    Accessor texCoords = getAccessor(attributes["TEXCOORD_0"].asInt(-1));
+    Accessor tangents = getAccessor(attributes["TANGENT"].asInt(-1));
+
+    const glm::mat3 linearTransform(item.transform);
+    const glm::mat3 normalTransform = glm::transpose(glm::inverse(linearTransform));
+    const bool mirrored = glm::determinant(linearTransform) < 0.0f;
+
+    glm::vec3 bboxMin(FLT_MAX);
+    glm::vec3 bboxMax(-FLT_MAX);
+
+    for (size_t i = 0; i < item.vertexCount; ++i)
+    {
+        Vertex vertex{};
+
+        float position[3];
+        positions.readFloats(i, position, 3);
+        vertex.pos = glm::vec3(item.transform * glm::vec4(position[0], position[1], position[2], 1.0f));
+
+        bboxMin = glm::min(bboxMin, vertex.pos);
+        bboxMax = glm::max(bboxMax, vertex.pos);
+
+        if (normals.isValid() && i < normals.count)
+        {
+            float normal[3];
+            normals.readFloats(i, normal, 3);
+            vertex.normal = safeNormalize(normalTransform * glm::vec3(normal[0], normal[1], normal[2]));
+        }
+
+        if (texCoords.isValid() && i < texCoords.count)
+        {
+            float texCoord[2];
+            texCoords.readFloats(i, texCoord, 2);
+            vertex.texCoord = glm::vec2(texCoord[0], texCoord[1]);
+        }
+
+        if (tangents.isValid() && normals.isValid() && i < tangents.count)
+        {
+            float tangent[4];
+            tangents.readFloats(i, tangent, 4);
+            glm::vec3 t = linearTransform * glm::vec3(tangent[0], tangent[1], tangent[2]);
+
+            // Re-orthogonalize against the transformed normal and rebuild the bitangent from the handedness in w
+            vertex.tangent = safeNormalize(t - vertex.normal * glm::dot(vertex.normal, t));
+            float handedness = (tangent[3] < 0.0f) != mirrored ? -1.0f : 1.0f;
+            vertex.bitangent = glm::cross(vertex.normal, vertex.tangent) * handedness;
+        }
+
+        pVertices[i] = vertex;
+    }
+
+    Accessor indexAccessor = getAccessor(primitive["indices"].asInt(-1));
+    for (size_t i = 0; i < item.indexCount; i += 3)
+    {
+        uint32_t triangle[3];
+        for (size_t corner = 0; corner < 3; ++corner)
+        {
+            uint32_t index = indexAccessor.isValid() ? indexAccessor.readIndex(i + corner) : static_cast<uint32_t>(i + corner);
+            if (index >= item.vertexCount)
+            {
+                throw std::runtime_error("glTF: vertex index out of range in " + m_Path);
+            }
+            triangle[corner] = baseVertex + index;
+        }
+
+        // Mirroring transforms flip the facing, so restore counter-clockwise winding
+        pIndices[i] = triangle[0];
+        pIndices[i + 1] = mirrored ? triangle[2] : triangle[1];
+        pIndices[i + 2] = mirrored ? triangle[1] : triangle[2];
+    }
+
+    // Generated from the final, transformed and rewound triangles
+    if (!normals.isValid())
+    {
+        generateNormals(pVertices, item.vertexCount, pIndices, item.indexCount, baseVertex);
+    }
+    if (!tangents.isValid() || !normals.isValid())
+    {
+        generateTangents(pVertices, item.vertexCount, pIndices, item.indexCount, baseVertex);
+    }
+
+    if (item.vertexCount == 0)
+    {
+        bboxMin = bboxMax = glm::vec3(0.0f);
+    }
+    submesh.bboxMin = bboxMin;
+    submesh.bboxMax = bboxMax;
+}
+
+std::string GltfImporter::resolveImagePath(const JsonValue& textureInfo) const
+{
+    if (!textureInfo.has("index"))
+    {
+        return {};
+    }
+
+    const JsonValue& texture = m_Document["textures"][static_cast<size_t>(textureInfo["index"].asInt())];
+    const JsonValue& image = m_Document["images"][static_cast<size_t>(texture["source"].asInt(-1))];
+
+    const std::string& uri = image["uri"].asString();
+    if (uri.empty() || startsWith(uri, "data:"))
+    {
+        // Texture loads from files only; embedded images fall back to the default texture
+        CAE_LOG_WARNING(Asset, "glTF: embedded image not supported, using default texture (" << m_Path << ")");
+        return {};
+    }
+
+    return m_Directory + "/" + decodeUri(uri);
+}
+
+SamplerCache::Desc GltfImporter::readSampler(const JsonValue& textureInfo) const
+{
+    SamplerCache::Desc desc;
+    if (!textureInfo.has("index"))
+    {
+        return desc;
+    }
+
+    const JsonValue& texture = m_Document["textures"][static_cast<size_t>(textureInfo["index"].asInt())];
+    if (!texture.has("sampler"))
+    {
+        return desc;
+    }
+    const JsonValue& sampler = m_Document["samplers"][static_cast<size_t>(texture["sampler"].asInt())];
+
+    const int64_t minFilter = sampler["minFilter"].asInt(-1);
+    desc.magFilter = sampler["magFilter"].asInt(FilterLinear) == FilterNearest ? VK_FILTER_NEAREST : VK_FILTER_LINEAR;
+    if (minFilter == FilterNearest || minFilter == FilterNearestMipmapNearest || minFilter == FilterNearestMipmapLinear)
+    {
+        desc.minFilter = VK_FILTER_NEAREST;
+    }
+    switch (minFilter)
+    {
+    case FilterNearest:
+    case FilterLinear:
+        // No mipmapping: clamping the LOD range keeps sampling on level 0
+        desc.maxLod = 0.25f;
+        break;
+    case FilterNearestMipmapNearest:
+    case FilterLinearMipmapNearest:
+        desc.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        break;
+    default:
+        break;
+    }
+
+    // Point-sampled textures (pixel art, lookup tables) must not be blurred by anisotropic taps
+    if (desc.magFilter == VK_FILTER_NEAREST || desc.minFilter == VK_FILTER_NEAREST)
+    {
+        desc.maxAnisotropy = 1.0f;
+    }
+
+    desc.addressModeU = getAddressMode(sampler["wrapS"].asInt(-1));
+    desc.addressModeV = getAddressMode(sampler["wrapT"].asInt(-1));
+    return desc;
+}
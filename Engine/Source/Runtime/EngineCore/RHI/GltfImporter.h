@@ -0,0 +1,102 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "Model.h"
+#include "Runtime/EngineCore/Core/Json.h"
+#include "Runtime/EngineCore/Core/MappedFile.h"
+
+//
+// Native glTF 2.0 (.gltf / .glb) importer.
+// Source files are memory mapped and accessors are decoded straight out of the mapped
+// buffers into the caller's vertex and index arrays. Every mesh primitive instance becomes
+// one Submesh; primitives are decoded in parallel into pre-sized, disjoint output ranges.
+//
+class GltfImporter
+{
+public:
+    struct Stats
+    {
+        size_t sourceBytes = 0;     // JSON + binary buffer bytes backing the scene
+        size_t vertexCount = 0;
+        size_t indexCount = 0;
+        size_t primitiveCount = 0;
+        double parseSeconds = 0.0;  // File mapping and JSON parsing
+        double decodeSeconds = 0.0; // Attribute and index decoding
+
+        double getTotalSeconds() const { return parseSeconds + decodeSeconds; }
+        double getMegabytesPerSecond() const;
+        double getVerticesPerSecond() const;
+    };
+
+    explicit GltfImporter(const std::string& path);
+    ~GltfImporter();
+
+    GltfImporter(const GltfImporter&) = delete;
+    GltfImporter& operator=(const GltfImporter&) = delete;
+
+    // Appends the scene to the given arrays. Submesh material indices are relative to
+    // the start of the materials array passed in.
+    void import(std::vector<Vertex>& vertices,
+                std::vector<uint32_t>& indices,
+                std::vector<Submesh>& submeshes,
+                std::vector<MaterialDesc>& materials);
+
+    const Stats& getStats() const { return m_Stats; }
+
+    // Caps the threads decoding primitives; 0 uses every core
+    void setMaxThreads(size_t maxThreads) { m_MaxThreads = maxThreads; }
+
+    // Paths of the .gltf/.glb scenes directly inside folder, sorted
+    static std::vector<std::string> findScenes(const std::string& folder);
+
+    // Imports every .gltf/.glb in folder with 1, 2, 4... threads and logs MB/s, vertices/s and speedup
+    static void runBenchmark(const std::string& folder);
+
+private:
+    struct BufferData
+    {
+        const uint8_t* pData = nullptr;
+        size_t size = 0;
+    };
+
+    struct Accessor;
+
+    struct DrawItem
+    {
+        const JsonValue* pPrimitive = nullptr;
+        glm::mat4 transform{ 1.0f };
+        uint32_t materialIndex = 0;
+        size_t vertexCount = 0;
+        size_t indexCount = 0;
+    };
+
+    void loadDocument();
+    void loadBuffers();
+    void collectDrawItems(std::vector<DrawItem>& items, uint32_t& defaultMaterialIndex) const;
+    void collectNode(size_t nodeIndex, const glm::mat4& parentTransform, std::vector<DrawItem>& items,
+                     uint32_t& defaultMaterialIndex, int depth) const;
+    void appendMeshPrimitives(const JsonValue& mesh, const glm::mat4& transform, std::vector<DrawItem>& items,
+                              uint32_t& defaultMaterialIndex) const;
+    Accessor getAccessor(int64_t accessorIndex) const;
+    void decodePrimitive(const DrawItem& item, Vertex* pVertices, uint32_t* pIndices,
+                         uint32_t baseVertex, Submesh& submesh) const;
+    std::string resolveImagePath(const JsonValue& textureInfo) const;
+    // Sampler state of the texture's glTF sampler; defaults when the texture names none
+    SamplerCache::Desc readSampler(const JsonValue& textureInfo) const;
+
+    std::string m_Path;
+    std::string m_Directory;
+
+    MappedFile m_SourceFile;
+    std::vector<MappedFile> m_ExternalFiles;
+    std::vector<std::unique_ptr<std::vector<uint8_t>>> m_DecodedBuffers; // data: URIs
+    std::vector<BufferData> m_Buffers;
+    BufferData m_BinaryChunk;
+
+    JsonValue m_Document;
+    Stats m_Stats;
+    size_t m_MaxThreads = 0;
+};
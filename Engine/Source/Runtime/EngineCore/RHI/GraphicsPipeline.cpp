@@ -1,10 +1,10 @@
 #include "GraphicsPipeline.h"
-#include <iostream>
+#include "Runtime/EngineCore/Core/Log.h"
 
 GraphicsPipeline::GraphicsPipeline(VkDevice device, VkPipelineLayout pipelineLayout, VkPipeline graphicsPipeline)
     : m_Device(device), m_PipelineLayout(pipelineLayout), m_GraphicsPipeline(graphicsPipeline) 
 {
-	std::cout << "GraphicsPipeline created." << std::endl;
+	CAE_LOG_TRACE(RHI, "GraphicsPipeline created.");
 }
 
 GraphicsPipeline::~GraphicsPipeline() 
@@ -17,7 +17,7 @@ GraphicsPipeline::~GraphicsPipeline()
     {
         vkDestroyPipelineLayout(m_Device, m_PipelineLayout, nullptr);
     }
-	std::cout << "GraphicsPipeline destroyed." << std::endl;
+	CAE_LOG_TRACE(RHI, "GraphicsPipeline destroyed.");
 }
 
 VkPipelineLayout GraphicsPipeline::getPipelineLayout() const 
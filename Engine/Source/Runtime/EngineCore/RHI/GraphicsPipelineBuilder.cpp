@@ -3,8 +3,8 @@
 #include <fstream>
 #include <stdexcept>
 #include <array>
-#include <iostream>
 #include "Device.h"
+#include "Runtime/EngineCore/Core/Log.h"
 
 GraphicsPipelineBuilder& GraphicsPipelineBuilder::setDevice(VkDevice device) {
     m_Device = device;
@@ -27,11 +27,23 @@ GraphicsPipelineBuilder& GraphicsPipelineBuilder::setSwapChainExtent(VkExtent2D
 }
 
 GraphicsPipelineBuilder& GraphicsPipelineBuilder::setVertexInputBindingDescription(const VkVertexInputBindingDescription& bindingDescription) {
-    m_BindingDescription = bindingDescription;
+    m_BindingDescriptions = { bindingDescription };
     m_HasVertexInput = true;
     return *this;
 }
 
+GraphicsPipelineBuilder& GraphicsPipelineBuilder::addVertexInputBindingDescription(const VkVertexInputBindingDescription& bindingDescription) {
+    m_BindingDescriptions.push_back(bindingDescription);
+    m_HasVertexInput = true;
+    return *this;
+}
+
+GraphicsPipelineBuilder& GraphicsPipelineBuilder::setVertexInputBindingDescriptions(const std::vector<VkVertexInputBindingDescription>& bindingDescriptions) {
+    m_BindingDescriptions = bindingDescriptions;
+    m_HasVertexInput = !bindingDescriptions.empty();
+    return *this;
+}
+
 GraphicsPipelineBuilder& GraphicsPipelineBuilder::setVertexInputAttributeDescriptions(const std::vector<VkVertexInputAttributeDescription>& attributeDescriptions) {
     m_AttributeDescriptions = attributeDescriptions;
     return *this;
@@ -104,30 +116,30 @@ GraphicsPipelineBuilder& GraphicsPipelineBuilder::setDepthBiasSlopeFactor(float
 }
 
 GraphicsPipeline* GraphicsPipelineBuilder::build() {
-    std::cout << "Building graphics pipeline with vertex shader: " << m_VertShaderPath << " and fragment shader: " << m_FragShaderPath << std::endl;
+    CAE_LOG_DEBUG(Render, "Building graphics pipeline with vertex shader: " << m_VertShaderPath << " and fragment shader: " << m_FragShaderPath);
 
     // Load shader code
     auto vertShaderCode = readFile(m_VertShaderPath);
     auto fragShaderCode = readFile(m_FragShaderPath);
     
-    std::cout << "Vertex shader code size: " << vertShaderCode.size() << " bytes" << std::endl;
-    std::cout << "Fragment shader code size: " << fragShaderCode.size() << " bytes" << std::endl;
+    CAE_LOG_TRACE(Render, "Vertex shader code size: " << vertShaderCode.size() << " bytes");
+    CAE_LOG_TRACE(Render, "Fragment shader code size: " << fragShaderCode.size() << " bytes");
     
     // Print first 8 bytes to verify SPIR-V magic number
     if (vertShaderCode.size() >= 4) {
         uint32_t magic = *reinterpret_cast<const uint32_t*>(vertShaderCode.data());
-        std::cout << "Vertex shader magic: 0x" << std::hex << magic << std::dec << std::endl;
+        CAE_LOG_TRACE(Render, "Vertex shader magic: 0x" << std::hex << magic << std::dec);
     }
     if (fragShaderCode.size() >= 4) {
         uint32_t magic = *reinterpret_cast<const uint32_t*>(fragShaderCode.data());
-        std::cout << "Fragment shader magic: 0x" << std::hex << magic << std::dec << std::endl;
+        CAE_LOG_TRACE(Render, "Fragment shader magic: 0x" << std::hex << magic << std::dec);
     }
     
     if (vertShaderCode.empty()) {
-        std::cout << "ERROR: Vertex shader code is empty!" << std::endl;
+        CAE_LOG_ERROR(Render, "ERROR: Vertex shader code is empty!");
     }
     if (fragShaderCode.empty()) {
-        std::cout << "ERROR: Fragment shader code is empty!" << std::endl;
+        CAE_LOG_ERROR(Render, "ERROR: Fragment shader code is empty!");
     }
 
     // Create shader modules
@@ -162,8 +174,19 @@ GraphicsPipeline* GraphicsPipelineBuilder::build() {
     }
     else {
         // Use provided vertex input descriptions
-        vertexInputInfo.vertexBindingDescriptionCount = 1;
-        vertexInputInfo.pVertexBindingDescriptions = &m_BindingDescription;
+        for (const VkVertexInputAttributeDescription& attribute : m_AttributeDescriptions) {
+            bool bound = false;
+            for (const VkVertexInputBindingDescription& binding : m_BindingDescriptions) {
+                bound = bound || binding.binding == attribute.binding;
+            }
+            if (!bound) {
+                vkDestroyShaderModule(m_Device, vertShaderModule, nullptr);
+                vkDestroyShaderModule(m_Device, fragShaderModule, nullptr);
+                throw std::runtime_error("Vertex attribute at location " + std::to_string(attribute.location) + " uses an undeclared binding");
+            }
+        }
+        vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(m_BindingDescriptions.size());
+        vertexInputInfo.pVertexBindingDescriptions = m_BindingDescriptions.data();
         vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(m_AttributeDescriptions.size());
         vertexInputInfo.pVertexAttributeDescriptions = m_AttributeDescriptions.data();
     }
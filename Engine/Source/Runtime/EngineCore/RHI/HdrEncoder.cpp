@@ -0,0 +1,250 @@
+#include "HdrEncoder.h"
+
+#include "Runtime/EngineCore/Core/ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    constexpr uint32_t RowsPerTask = 64;
+    constexpr size_t ParallelTexelThreshold = 256 * 1024;
+
+    // Shared-exponent constants from the Vulkan specification: 9-bit mantissas, exponent bias 15
+    constexpr int SharedExponentBias = 15;
+    constexpr int SharedMantissaBits = 9;
+    constexpr float SharedExponentMax = 65408.0f; // (511 / 512) * 2^16
+
+    uint32_t floatBits(float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    float bitsFloat(uint32_t bits)
+    {
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    // Encodes a non-negative float as an unsigned float with a 5-bit exponent (bias 15) and
+    // mantissaBits of mantissa, rounding to nearest. Negative and NaN map to 0, overflow clamps.
+    uint32_t packUnsignedFloat(float value, uint32_t mantissaBits)
+    {
+        const uint32_t maxEncoded = (30u << mantissaBits) | ((1u << mantissaBits) - 1);
+        const uint32_t bits = floatBits(value);
+        if ((bits & 0x80000000u) || (bits & 0x7fffffffu) > 0x7f800000u)
+        {
+            return 0;
+        }
+
+        // Below the smallest normal (2^-14) the result is denormal: a plain fixed-point mantissa
+        if (bits < (113u << 23))
+        {
+            return static_cast<uint32_t>(value * bitsFloat((127u + 14u + mantissaBits) << 23) + 0.5f);
+        }
+
+        // Rebias the exponent and round the mantissa; a carry correctly bumps the exponent
+        const uint32_t shift = 23 - mantissaBits;
+        const uint32_t rebased = bits - (112u << 23);
+        return std::min((rebased + (1u << (shift - 1))) >> shift, maxEncoded);
+    }
+}
+
+VkFormat HdrEncoder::getVkFormat(Encoding encoding)
+{
+    switch (encoding)
+    {
+    case Encoding::RGBA16F:
+        return VK_FORMAT_R16G16B16A16_SFLOAT;
+    case Encoding::B10G11R11:
+        return VK_FORMAT_B10G11R11_UFLOAT_PACK32;
+    case Encoding::E5B9G9R9:
+        return VK_FORMAT_E5B9G9R9_UFLOAT_PACK32;
+    }
+    return VK_FORMAT_UNDEFINED;
+}
+
+uint32_t HdrEncoder::getTexelSize(Encoding encoding)
+{
+    return encoding == Encoding::RGBA16F ? 8 : 4;
+}
+
+uint16_t HdrEncoder::packHalf(float value)
+{
+    const uint32_t sign = (floatBits(value) >> 16) & 0x8000u;
+    return static_cast<uint16_t>(sign | packUnsignedFloat(std::abs(value), 10));
+}
+
+uint32_t HdrEncoder::packB10G11R11(const float* pRgb)
+{
+    return packUnsignedFloat(pRgb[0], 6) | (packUnsignedFloat(pRgb[1], 6) << 11) | (packUnsignedFloat(pRgb[2], 5) << 22);
+}
+
+uint32_t HdrEncoder::packE5B9G9R9(const float* pRgb)
+{
+    // NaN fails both comparisons and becomes 0
+    float rgb[3];
+    for (int c = 0; c < 3; ++c)
+    {
+        rgb[c] = pRgb[c] > 0.0f ? std::min(pRgb[c], SharedExponentMax) : 0.0f;
+    }
+
+    const float maxComponent = std::max(rgb[0], std::max(rgb[1], rgb[2]));
+    const int floorLog2 = static_cast<int>(floatBits(maxComponent) >> 23) - 127;
+    int exponent = std::max(-SharedExponentBias - 1, floorLog2) + 1 + SharedExponentBias;
+
+    // scale = 2^-(exponent - bias - mantissaBits), built directly from exponent bits
+    float scale = bitsFloat(static_cast<uint32_t>(127 + SharedExponentBias + SharedMantissaBits - exponent) << 23);
+    if (static_cast<uint32_t>(maxComponent * scale + 0.5f) == (1u << SharedMantissaBits))
+    {
+        ++exponent;
+        scale *= 0.5f;
+    }
+
+    const uint32_t r = static_cast<uint32_t>(rgb[0] * scale + 0.5f);
+    const uint32_t g = static_cast<uint32_t>(rgb[1] * scale + 0.5f);
+    const uint32_t b = static_cast<uint32_t>(rgb[2] * scale + 0.5f);
+    return r | (g << 9) | (b << 18) | (static_cast<uint32_t>(exponent) << 27);
+}
+
+void HdrEncoder::encode(const float* pPixels, uint32_t width, uint32_t height, Encoding encoding,
+                        std::vector<uint8_t>& output, std::vector<MipLevel>& levels, bool parallel)
+{
+    const uint32_t mipCount = MipGenerator::getMipCount(width, height);
+    const uint32_t texelSize = getTexelSize(encoding);
+
+    levels.clear();
+    levels.reserve(mipCount);
+    VkDeviceSize totalSize = 0;
+    for (uint32_t mip = 0, w = width, h = height; mip < mipCount; ++mip)
+    {
+        MipLevel level;
+        level.offset = totalSize;
+        level.size = static_cast<VkDeviceSize>(w) * h * texelSize;
+        level.width = w;
+        level.height = h;
+        levels.push_back(level);
+
+        totalSize += level.size;
+        w = std::max(1u, w / 2);
+        h = std::max(1u, h / 2);
+    }
+    output.resize(static_cast<size_t>(totalSize));
+
+    // Filtering stays in float; only the current and next level are kept at full precision
+    std::vector<float> current;
+    std::vector<float> next;
+    const float* pLevel = pPixels;
+    for (uint32_t mip = 0; mip < mipCount; ++mip)
+    {
+        const MipLevel& level = levels[mip];
+        uint8_t* pOutput = output.data() + level.offset;
+
+        if (!parallel || static_cast<size_t>(level.width) * level.height < ParallelTexelThreshold)
+        {
+            encodeRows(pLevel, level.width, 0, level.height, encoding, pOutput);
+        }
+        else
+        {
+            const size_t taskCount = (level.height + RowsPerTask - 1) / RowsPerTask;
+            parallelFor(taskCount, [&](size_t task)
+            {
+                const uint32_t rowBegin = static_cast<uint32_t>(task) * RowsPerTask;
+                encodeRows(pLevel, level.width, rowBegin, std::min(rowBegin + RowsPerTask, level.height), encoding, pOutput);
+            });
+        }
+
+        if (mip + 1 < mipCount)
+        {
+            const MipLevel& nextLevel = levels[mip + 1];
+            next.resize(static_cast<size_t>(nextLevel.width) * nextLevel.height * 4);
+            downsample(pLevel, level.width, level.height, next.data(), nextLevel.width, nextLevel.height, parallel);
+            current.swap(next);
+            pLevel = current.data();
+        }
+    }
+}
+
+void HdrEncoder::encodeRows(const float* pPixels, uint32_t width, uint32_t rowBegin, uint32_t rowEnd,
+                            Encoding encoding, uint8_t* pOutput)
+{
+    const size_t texelBegin = static_cast<size_t>(rowBegin) * width;
+    const size_t texelEnd = static_cast<size_t>(rowEnd) * width;
+
+    switch (encoding)
+    {
+    case Encoding::RGBA16F:
+    {
+        uint16_t* pHalves = reinterpret_cast<uint16_t*>(pOutput);
+        for (size_t i = texelBegin * 4; i < texelEnd * 4; ++i)
+        {
+            pHalves[i] = packHalf(pPixels[i]);
+        }
+        break;
+    }
+    case Encoding::B10G11R11:
+    {
+        uint32_t* pPacked = reinterpret_cast<uint32_t*>(pOutput);
+        for (size_t i = texelBegin; i < texelEnd; ++i)
+        {
+            pPacked[i] = packB10G11R11(pPixels + i * 4);
+        }
+        break;
+    }
+    case Encoding::E5B9G9R9:
+    {
+        uint32_t* pPacked = reinterpret_cast<uint32_t*>(pOutput);
+        for (size_t i = texelBegin; i < texelEnd; ++i)
+        {
+            pPacked[i] = packE5B9G9R9(pPixels + i * 4);
+        }
+        break;
+    }
+    default:
+        throw std::runtime_error("Unknown HDR encoding");
+    }
+}
+
+void HdrEncoder::downsample(const float* pSource, uint32_t sourceWidth, uint32_t sourceHeight,
+                            float* pDestination, uint32_t width, uint32_t height, bool parallel)
+{
+    // HDR data is already linear, so all four channels are averaged directly.
+    // Odd source sizes clamp the second tap to the last row/column
+    auto filterRows = [&](uint32_t rowBegin, uint32_t rowEnd)
+    {
+        for (uint32_t y = rowBegin; y < rowEnd; ++y)
+        {
+            const float* pRow0 = pSource + static_cast<size_t>(std::min(y * 2, sourceHeight - 1)) * sourceWidth * 4;
+            const float* pRow1 = pSource + static_cast<size_t>(std::min(y * 2 + 1, sourceHeight - 1)) * sourceWidth * 4;
+            float* pOut = pDestination + static_cast<size_t>(y) * width * 4;
+
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                const uint32_t x0 = std::min(x * 2, sourceWidth - 1) * 4;
+                const uint32_t x1 = std::min(x * 2 + 1, sourceWidth - 1) * 4;
+                for (uint32_t c = 0; c < 4; ++c)
+                {
+                    pOut[x * 4 + c] = (pRow0[x0 + c] + pRow0[x1 + c] + pRow1[x0 + c] + pRow1[x1 + c]) * 0.25f;
+                }
+            }
+        }
+    };
+
+    if (!parallel || static_cast<size_t>(width) * height < ParallelTexelThreshold)
+    {
+        filterRows(0, height);
+        return;
+    }
+
+    const size_t taskCount = (height + RowsPerTask - 1) / RowsPerTask;
+    parallelFor(taskCount, [&](size_t task)
+    {
+        const uint32_t rowBegin = static_cast<uint32_t>(task) * RowsPerTask;
+        filterRows(rowBegin, std::min(rowBegin + RowsPerTask, height));
+    });
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MipGenerator.h"
+
+//
+// Converts linear float RGBA images into the GPU formats we use for HDR data:
+//   RGBA16F    - 8 bytes per texel, keeps alpha and negative values (half the size of RGBA32F)
+//   B10G11R11  - 4 bytes per texel, unsigned 11/11/10-bit floats, no alpha (a quarter of RGBA32F)
+//   E5B9G9R9   - 4 bytes per texel, 9-bit mantissas with a shared exponent, no alpha; more
+//                precise than B10G11R11 for saturated colours but cannot be a render target
+// Negative and NaN inputs become 0 in the unsigned formats and values above the format range are
+// clamped to its largest finite value. The per-texel kernels are branch-light bit manipulation so
+// the compiler can vectorize the inner loops; rows are processed in parallel.
+//
+class HdrEncoder
+{
+public:
+    enum class Encoding
+    {
+        RGBA16F,
+        B10G11R11,
+        E5B9G9R9
+    };
+
+    static VkFormat getVkFormat(Encoding encoding);
+    static uint32_t getTexelSize(Encoding encoding);
+
+    static uint16_t packHalf(float value);
+    static uint32_t packB10G11R11(const float* pRgb);
+    static uint32_t packE5B9G9R9(const float* pRgb);
+
+    // Builds the full mip chain of an RGBA32F image with a linear 2x2 box filter and writes every
+    // level, converted to the encoding, into output. Callers already on a worker thread pass parallel = false.
+    static void encode(const float* pPixels, uint32_t width, uint32_t height, Encoding encoding,
+                       std::vector<uint8_t>& output, std::vector<MipLevel>& levels, bool parallel = true);
+
+private:
+    static void encodeRows(const float* pPixels, uint32_t width, uint32_t rowBegin, uint32_t rowEnd,
+                           Encoding encoding, uint8_t* pOutput);
+    static void downsample(const float* pSource, uint32_t sourceWidth, uint32_t sourceHeight,
+                           float* pDestination, uint32_t width, uint32_t height, bool parallel);
+};
@@ -1,15 +1,14 @@
 // Image.cpp
 
 #include "Image.h"
-#include "CommandPool.h"
 #include "Device.h"
+#include "Runtime/EngineCore/Core/Log.h"
 #include <stdexcept>
-#include <iostream>
 
 Image::Image(Device* device, VmaAllocator allocator)
     : m_pDevice(device), m_Allocator(allocator), m_Image(VK_NULL_HANDLE), m_Allocation(VK_NULL_HANDLE) 
 {
-	std::cout << "Image created." << std::endl;
+	CAE_LOG_TRACE(RHI, "Image created.");
 }
 
 Image::~Image() {
@@ -17,14 +16,14 @@ Image::~Image() {
     {
         vmaDestroyImage(m_Allocator, m_Image, m_Allocation);
     }
-	std::cout << "Image destroyed." << std::endl;
+	CAE_LOG_TRACE(RHI, "Image destroyed.");
 }
 
 void Image::createImage(uint32_t width, uint32_t height,
                         VkFormat format, VkImageTiling tiling,
-                        VkImageUsageFlags usage, VmaMemoryUsage memoryUsage) 
+                        VkImageUsageFlags usage, VmaMemoryUsage memoryUsage, uint32_t mipLevels) 
 {
-	createImage(width, height, format, tiling, usage, 0, 1,memoryUsage);
+	createImage(width, height, format, tiling, usage, 0, 1, memoryUsage, mipLevels);
 }
 
 void Image::createImage(
@@ -34,16 +33,18 @@ void Image::createImage(
     VkImageUsageFlags usage,
     VkImageCreateFlags flags,
 	size_t layerCount,
-    VmaMemoryUsage memoryUsage
+    VmaMemoryUsage memoryUsage,
+    uint32_t mipLevels
     )
 {
 	m_Width = width;
 	m_Height = height;
+	m_MipLevels = mipLevels;
 	VkImageCreateInfo imageInfo{};
 	imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
 	imageInfo.imageType = VK_IMAGE_TYPE_2D;
 	imageInfo.extent = { width, height, 1 };
-	imageInfo.mipLevels = 1;
+	imageInfo.mipLevels = mipLevels;
 	imageInfo.arrayLayers = layerCount;
 	imageInfo.format = format;
 	imageInfo.tiling = tiling;
@@ -58,18 +59,19 @@ void Image::createImage(
 	{
 		throw std::runtime_error("Failed to create image!");
 	}
-	std::cout << "Image created with width: " << width << ", height: " << height << std::endl;
+	CAE_LOG_TRACE(RHI, "Image created with width: " << width << ", height: " << height << ", mip levels: " << mipLevels);
 }
 
-VkImageView Image::createImageView(VkFormat format, VkImageAspectFlags aspectFlags) 
+VkImageView Image::createImageView(VkFormat format, VkImageAspectFlags aspectFlags, const VkComponentMapping& components)
 {
     VkImageViewCreateInfo viewInfo{};
     viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
     viewInfo.image = m_Image;
     viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
     viewInfo.format = format;
+    viewInfo.components = components;
     viewInfo.subresourceRange.aspectMask = aspectFlags;
-    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.levelCount = m_MipLevels;
     viewInfo.subresourceRange.layerCount = 1;
 
     VkImageView imageView;
@@ -78,105 +80,11 @@ VkImageView Image::createImageView(VkFormat format, VkImageAspectFlags aspectFla
         throw std::runtime_error("Failed to create texture image view!");
     }
 
-	std::cout << "Image view created." << std::endl;
+	CAE_LOG_TRACE(RHI, "Image view created.");
 
     return imageView;
 }
 
-void Image::transitionImageLayout(CommandPool* commandPool, VkQueue graphicsQueue,
-    VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout)
-{
-    VkCommandBuffer commandBuffer = commandPool->beginSingleTimeCommands();
-
-    VkPipelineStageFlags2 srcStageMask = 0;
-    VkPipelineStageFlags2 dstStageMask = 0;
-    VkAccessFlags2 srcAccessMask = 0;
-    VkAccessFlags2 dstAccessMask = 0;
-
-    // Handle different layout transitions
-    if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
-        srcStageMask = VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT;
-        dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
-        srcAccessMask = 0;
-        dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
-    }
-    else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
-        srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
-        dstStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
-        srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
-        dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT;
-    }
-    else
-    {
-		throw std::runtime_error("Unsupported layout transition!");
-    }
-
-    VkImageMemoryBarrier2 barrier{};
-    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
-    barrier.srcStageMask = srcStageMask;
-    barrier.srcAccessMask = srcAccessMask;
-    barrier.dstStageMask = dstStageMask;
-    barrier.dstAccessMask = dstAccessMask;
-    barrier.oldLayout = oldLayout;
-    barrier.newLayout = newLayout;
-    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image = m_Image;
-
-    // Correctly set the aspect mask based on the format
-    if (format == VK_FORMAT_D32_SFLOAT || format == VK_FORMAT_D16_UNORM) {
-        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-    }
-    else if (hasStencilComponent(format)) {
-        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
-    }
-    else {
-        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    }
-
-    barrier.subresourceRange.baseMipLevel = 0;
-    barrier.subresourceRange.levelCount = 1;
-    barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount = 1;
-
-    VkDependencyInfo dependencyInfo{};
-    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
-    dependencyInfo.imageMemoryBarrierCount = 1;
-    dependencyInfo.pImageMemoryBarriers = &barrier;
-
-    vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
-
-    commandPool->endSingleTimeCommands(commandBuffer, graphicsQueue);
-
-	setImageLayout(newLayout);
-}
-
-
-void Image::copyBufferToImage(CommandPool* commandPool, VkBuffer buffer, uint32_t width, uint32_t height)
-{
-    VkCommandBuffer commandBuffer = commandPool->beginSingleTimeCommands();
-
-    VkBufferImageCopy region{};
-    region.bufferOffset = 0;
-    region.bufferRowLength = 0;
-    region.bufferImageHeight = 0;
-    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageSubresource.mipLevel = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = 1;
-    region.imageOffset = { 0, 0, 0 };
-    region.imageExtent = {
-        width,
-        height,
-        1
-    };
-
-    vkCmdCopyBufferToImage(commandBuffer, buffer, m_Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-    commandPool->endSingleTimeCommands(commandBuffer, m_pDevice->getGraphicsQueue());
-	std::cout << "Buffer copied to image." << std::endl;
-}
-
 VkImage Image::getImage() const 
 {
     return m_Image;
@@ -5,7 +5,6 @@
 #include "vk_mem_alloc.h"
 
 class Device;
-class CommandPool;
 class Image 
 {
 public:
@@ -17,7 +16,8 @@ public:
         VkFormat format,
         VkImageTiling tiling,
         VkImageUsageFlags usage,
-        VmaMemoryUsage memoryUsage);
+        VmaMemoryUsage memoryUsage,
+        uint32_t mipLevels = 1);
 
     void createImage(
         uint32_t width, uint32_t height,
@@ -26,16 +26,13 @@ public:
         VkImageUsageFlags usage,
         VkImageCreateFlags flags,
 		size_t layerCount,
-        VmaMemoryUsage memoryUsage
+        VmaMemoryUsage memoryUsage,
+        uint32_t mipLevels = 1
         );
 
 
-    VkImageView createImageView(VkFormat format, VkImageAspectFlags aspectFlags);
-
-    void transitionImageLayout(CommandPool* commandPool, VkQueue graphicsQueue,
-                               VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout);
-
-	void copyBufferToImage(CommandPool* commandPool, VkBuffer buffer, uint32_t width, uint32_t height);
+    // Views cover every mip level of the image
+    VkImageView createImageView(VkFormat format, VkImageAspectFlags aspectFlags, const VkComponentMapping& components = {});
 
     VkImage getImage() const;
     VmaAllocation getAllocation() const;
@@ -50,6 +47,7 @@ public:
 
 	uint32_t getWidth() const { return m_Width; }
     uint32_t getHeight() const { return m_Height; }
+    uint32_t getMipLevels() const { return m_MipLevels; }
 
 private:
     Device* m_pDevice;
@@ -59,4 +57,5 @@ private:
 	VkImageLayout m_ImageLayout;
 	uint32_t m_Width;
     uint32_t m_Height;
+    uint32_t m_MipLevels = 1;
 };
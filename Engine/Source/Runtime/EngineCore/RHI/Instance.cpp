@@ -1,10 +1,9 @@
 #include "Instance.h"
 #include "InstanceBuilder.h"
+#include "Runtime/EngineCore/Core/Log.h"
 
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
-#include <iostream>
-#include <iostream>
 #include <stdexcept>
 #include <cstring>
 
@@ -56,13 +55,13 @@ Instance::Instance()
     setupDebugMessenger();
 
     // Log used extensions
-    std::cout << "Used extensions:" << std::endl;
+    CAE_LOG_DEBUG(RHI, "Used extensions:");
     for (const auto& extension : extensions) 
     {
-        std::cout << "\t" << extension << std::endl;
+        CAE_LOG_DEBUG(RHI, "\t" << extension);
     }
 
-	std::cout << "Instance created." << std::endl;
+	CAE_LOG_TRACE(RHI, "Instance created.");
 }
 
 Instance::~Instance() 
@@ -72,7 +71,7 @@ Instance::~Instance()
         DestroyDebugUtilsMessengerEXT(m_Instance, m_DebugMessenger, nullptr);
     }
     vkDestroyInstance(m_Instance, nullptr);
-	std::cout << "Destroying Instance." << std::endl;
+	CAE_LOG_TRACE(RHI, "Destroying Instance.");
 }
 
 VkInstance Instance::getInstance() const 
@@ -91,7 +90,7 @@ void Instance::setupDebugMessenger()
     {
         throw std::runtime_error("Failed to set up debug messenger!");
     }
-	std::cout << "Debug messenger created." << std::endl;
+	CAE_LOG_TRACE(RHI, "Debug messenger created.");
 }
 
 void Instance::populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo) 
@@ -163,7 +162,18 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(
     const VkDebugUtilsMessengerCallbackDataEXT*  pCallbackData,
     void*                                        pUserData) 
 {
-    std::cerr << "Validation layer: " << pCallbackData->pMessage << std::endl;
+    if (messageSeverity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)
+    {
+        CAE_LOG_ERROR(RHI, "Validation layer: " << pCallbackData->pMessage);
+    }
+    else if (messageSeverity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT)
+    {
+        CAE_LOG_WARNING(RHI, "Validation layer: " << pCallbackData->pMessage);
+    }
+    else
+    {
+        CAE_LOG_DEBUG(RHI, "Validation layer: " << pCallbackData->pMessage);
+    }
 
     return VK_FALSE;
 }
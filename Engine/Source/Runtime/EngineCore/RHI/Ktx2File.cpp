@@ -0,0 +1,483 @@
+#include "Ktx2File.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include "Runtime/EngineCore/Core/Log.h"
+
+namespace
+{
+    const uint8_t Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+    struct Header
+    {
+        uint8_t identifier[12];
+        uint32_t vkFormat;
+        uint32_t typeSize;
+        uint32_t pixelWidth;
+        uint32_t pixelHeight;
+        uint32_t pixelDepth;
+        uint32_t layerCount;
+        uint32_t faceCount;
+        uint32_t levelCount;
+        uint32_t supercompressionScheme;
+        uint32_t dfdByteOffset;
+        uint32_t dfdByteLength;
+        uint32_t kvdByteOffset;
+        uint32_t kvdByteLength;
+        uint64_t sgdByteOffset;
+        uint64_t sgdByteLength;
+    };
+    static_assert(sizeof(Header) == 80, "KTX2 header must be 80 bytes");
+
+    struct LevelRecord
+    {
+        uint64_t byteOffset;
+        uint64_t byteLength;
+        uint64_t uncompressedByteLength;
+    };
+
+    // Khronos data format descriptor values (KHR_DF_*)
+    constexpr uint8_t ModelRgbsda = 1;
+    constexpr uint8_t ModelBC1A = 128;
+    constexpr uint8_t ModelBC4 = 131;
+    constexpr uint8_t ModelBC5 = 132;
+    constexpr uint8_t ModelBC7 = 134;
+    constexpr uint8_t PrimariesBT709 = 1;
+    constexpr uint8_t TransferLinear = 1;
+    constexpr uint8_t TransferSrgb = 2;
+    constexpr uint8_t SampleLinear = 0x10; // Qualifier on an alpha sample of an sRGB format
+    constexpr uint8_t ChannelAlpha = 15;
+
+    struct Sample
+    {
+        uint16_t bitOffset;
+        uint8_t bitLength; // Minus one
+        uint8_t channelType;
+        uint32_t upper;
+    };
+
+    void append(std::vector<uint8_t>& output, const void* pData, size_t size)
+    {
+        const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+        output.insert(output.end(), pBytes, pBytes + size);
+    }
+
+    template<typename T>
+    void append(std::vector<uint8_t>& output, T value)
+    {
+        append(output, &value, sizeof(value));
+    }
+
+    std::vector<uint8_t> buildDataFormatDescriptor(VkFormat format)
+    {
+        uint8_t model = 0;
+        uint8_t transfer = TransferLinear;
+        bool blockCompressed = true;
+        std::vector<Sample> samples;
+
+        switch (format)
+        {
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+            transfer = TransferSrgb;
+            [[fallthrough]];
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+            model = ModelBC1A;
+            samples.push_back({ 0, 63, 0, UINT32_MAX });
+            break;
+        case VK_FORMAT_BC4_UNORM_BLOCK:
+            model = ModelBC4;
+            samples.push_back({ 0, 63, 0, UINT32_MAX });
+            break;
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+            model = ModelBC5;
+            samples.push_back({ 0, 63, 0, UINT32_MAX });
+            samples.push_back({ 64, 63, 1, UINT32_MAX });
+            break;
+        case VK_FORMAT_BC7_SRGB_BLOCK:
+            transfer = TransferSrgb;
+            [[fallthrough]];
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+            model = ModelBC7;
+            samples.push_back({ 0, 127, 0, UINT32_MAX });
+            break;
+        case VK_FORMAT_R8G8B8A8_SRGB:
+            transfer = TransferSrgb;
+            [[fallthrough]];
+        case VK_FORMAT_R8G8B8A8_UNORM:
+            model = ModelRgbsda;
+            blockCompressed = false;
+            samples.push_back({ 0, 7, 0, 255 });
+            samples.push_back({ 8, 7, 1, 255 });
+            samples.push_back({ 16, 7, 2, 255 });
+            samples.push_back({ 24, 7, static_cast<uint8_t>(ChannelAlpha | (transfer == TransferSrgb ? SampleLinear : 0)), 255 });
+            break;
+        default:
+            throw std::runtime_error("KTX2: no data format descriptor for VkFormat " + std::to_string(format));
+        }
+
+        const uint16_t blockSize = static_cast<uint16_t>(24 + 16 * samples.size());
+        std::vector<uint8_t> dfd;
+        append<uint32_t>(dfd, 4u + blockSize);  // dfdTotalSize
+        append<uint32_t>(dfd, 0);               // vendorId = Khronos, descriptorType = basic
+        append<uint16_t>(dfd, 2);               // versionNumber
+        append<uint16_t>(dfd, blockSize);
+        append<uint8_t>(dfd, model);
+        append<uint8_t>(dfd, PrimariesBT709);
+        append<uint8_t>(dfd, transfer);
+        append<uint8_t>(dfd, 0);                // flags: straight alpha
+
+        const uint8_t dimension = blockCompressed ? 3 : 0;
+        const uint8_t texelBlockDimension[4] = { dimension, dimension, 0, 0 };
+        append(dfd, texelBlockDimension, sizeof(texelBlockDimension));
+        uint8_t bytesPlane[8] = {};
+        bytesPlane[0] = static_cast<uint8_t>(Ktx2File::getBlockSize(format));
+        append(dfd, bytesPlane, sizeof(bytesPlane));
+
+        for (const Sample& sample : samples)
+        {
+            append<uint16_t>(dfd, sample.bitOffset);
+            append<uint8_t>(dfd, sample.bitLength);
+            append<uint8_t>(dfd, sample.channelType);
+            append<uint32_t>(dfd, 0);           // samplePosition
+            append<uint32_t>(dfd, 0);           // sampleLower
+            append<uint32_t>(dfd, sample.upper);
+        }
+        return dfd;
+    }
+
+    size_t alignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+uint32_t Ktx2File::getBlockSize(VkFormat format)
+{
+    switch (format)
+    {
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+    case VK_FORMAT_BC4_UNORM_BLOCK:
+        return 8;
+    case VK_FORMAT_BC5_UNORM_BLOCK:
+    case VK_FORMAT_BC7_UNORM_BLOCK:
+    case VK_FORMAT_BC7_SRGB_BLOCK:
+        return 16;
+    case VK_FORMAT_R8G8B8A8_UNORM:
+    case VK_FORMAT_R8G8B8A8_SRGB:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+bool Ktx2File::isBlockCompressed(VkFormat format)
+{
+    return getBlockSize(format) != 0 && format != VK_FORMAT_R8G8B8A8_UNORM && format != VK_FORMAT_R8G8B8A8_SRGB;
+}
+
+void Ktx2File::write(const std::string& path, VkFormat format, uint32_t width, uint32_t height,
+                     const std::vector<uint8_t>& data, const std::vector<MipLevel>& levels)
+{
+    const uint32_t blockSize = getBlockSize(format);
+    if (blockSize == 0 || levels.empty())
+    {
+        throw std::runtime_error("KTX2: nothing to write or unsupported format for " + path);
+    }
+
+    const std::vector<uint8_t> dfd = buildDataFormatDescriptor(format);
+    const size_t levelCount = levels.size();
+    const size_t dfdOffset = sizeof(Header) + levelCount * sizeof(LevelRecord);
+
+    // Levels are stored smallest first; every level starts on lcm(blockSize, 4)
+    const size_t levelAlignment = std::max<size_t>(blockSize, 4);
+    std::vector<LevelRecord> records(levelCount);
+    size_t offset = dfdOffset + dfd.size();
+    for (size_t i = levelCount; i-- > 0;)
+    {
+        offset = alignUp(offset, levelAlignment);
+        records[i].byteOffset = offset;
+        records[i].byteLength = levels[i].size;
+        records[i].uncompressedByteLength = levels[i].size;
+        offset += static_cast<size_t>(levels[i].size);
+    }
+
+    Header header{};
+    memcpy(header.identifier, Identifier, sizeof(Identifier));
+    header.vkFormat = static_cast<uint32_t>(format);
+    header.typeSize = 1;
+    header.pixelWidth = width;
+    header.pixelHeight = height;
+    header.faceCount = 1;
+    header.levelCount = static_cast<uint32_t>(levelCount);
+    header.dfdByteOffset = static_cast<uint32_t>(dfdOffset);
+    header.dfdByteLength = static_cast<uint32_t>(dfd.size());
+
+    std::vector<uint8_t> file;
+    file.reserve(offset);
+    append(file, header);
+    append(file, records.data(), records.size() * sizeof(LevelRecord));
+    append(file, dfd.data(), dfd.size());
+    for (size_t i = levelCount; i-- > 0;)
+    {
+        file.resize(static_cast<size_t>(records[i].byteOffset), 0);
+        append(file, data.data() + levels[i].offset, static_cast<size_t>(levels[i].size));
+    }
+
+    // Write to a temporary file first so an interrupted cook never leaves a valid-looking texture behind
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream output(tempPath, std::ios::binary | std::ios::trunc);
+        if (!output.is_open())
+        {
+            throw std::runtime_error("Failed to create KTX2 file: " + tempPath);
+        }
+        output.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+        if (!output)
+        {
+            throw std::runtime_error("Failed to write KTX2 file: " + tempPath);
+        }
+    }
+
+    std::remove(path.c_str());
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0)
+    {
+        throw std::runtime_error("Failed to move KTX2 file into place: " + path);
+    }
+}
+
+Ktx2File::Ktx2File(const std::string& path)
+{
+    open(path);
+}
+
+void Ktx2File::open(const std::string& path)
+{
+    close();
+    m_File.open(path);
+
+    auto fail = [&](const std::string& reason)
+    {
+        close();
+        throw std::runtime_error("KTX2 " + reason + ": " + path);
+    };
+
+    if (m_File.size() < sizeof(Header))
+    {
+        fail("file is truncated");
+    }
+
+    Header header;
+    memcpy(&header, m_File.data(), sizeof(Header));
+    if (memcmp(header.identifier, Identifier, sizeof(Identifier)) != 0)
+    {
+        fail("identifier is missing");
+    }
+    if (getBlockSize(static_cast<VkFormat>(header.vkFormat)) == 0)
+    {
+        fail("format " + std::to_string(header.vkFormat) + " is not supported");
+    }
+    if (header.supercompressionScheme != 0)
+    {
+        fail("supercompression is not supported");
+    }
+    if (header.pixelDepth > 1 || header.layerCount > 1 || header.faceCount != 1 || header.pixelWidth == 0 || header.pixelHeight == 0)
+    {
+        fail("only single 2D images are supported");
+    }
+    if (header.levelCount == 0)
+    {
+        fail("has no stored mip levels");
+    }
+    uint32_t maxLevelCount = 1;
+    for (uint32_t extent = std::max(header.pixelWidth, header.pixelHeight); extent > 1; extent >>= 1)
+    {
+        ++maxLevelCount;
+    }
+    if (header.levelCount > maxLevelCount)
+    {
+        fail("has more mip levels than its extent allows");
+    }
+
+    const size_t levelCount = header.levelCount;
+    if (sizeof(Header) + levelCount * sizeof(LevelRecord) > m_File.size())
+    {
+        fail("level index is truncated");
+    }
+
+    std::vector<LevelRecord> records(levelCount);
+    memcpy(records.data(), m_File.data() + sizeof(Header), levelCount * sizeof(LevelRecord));
+
+    m_Format = static_cast<VkFormat>(header.vkFormat);
+    m_Width = header.pixelWidth;
+    m_Height = header.pixelHeight;
+
+    uint64_t dataBegin = UINT64_MAX;
+    uint64_t dataEnd = 0;
+    for (const LevelRecord& record : records)
+    {
+        if (record.byteOffset + record.byteLength > m_File.size() || record.byteOffset % getBlockSize(m_Format) != 0)
+        {
+            fail("level range is invalid");
+        }
+        dataBegin = std::min(dataBegin, record.byteOffset);
+        dataEnd = std::max(dataEnd, record.byteOffset + record.byteLength);
+    }
+
+    const uint32_t blockSize = getBlockSize(m_Format);
+    const bool blockCompressed = isBlockCompressed(m_Format);
+    m_Levels.resize(levelCount);
+    for (size_t i = 0; i < levelCount; ++i)
+    {
+        MipLevel& level = m_Levels[i];
+        level.width = std::max(1u, m_Width >> i);
+        level.height = std::max(1u, m_Height >> i);
+        level.offset = records[i].byteOffset - dataBegin;
+        level.size = records[i].byteLength;
+
+        const uint64_t expectedSize = blockCompressed
+            ? static_cast<uint64_t>((level.width + 3) / 4) * ((level.height + 3) / 4) * blockSize
+            : static_cast<uint64_t>(level.width) * level.height * blockSize;
+        if (level.size != expectedSize)
+        {
+            fail("level " + std::to_string(i) + " size does not match its extent");
+        }
+    }
+
+    m_pLevelData = m_File.data() + dataBegin;
+    m_LevelDataSize = dataEnd - dataBegin;
+}
+
+void Ktx2File::close()
+{
+    m_File.close();
+    m_Format = VK_FORMAT_UNDEFINED;
+    m_Width = 0;
+    m_Height = 0;
+    m_Levels.clear();
+    m_pLevelData = nullptr;
+    m_LevelDataSize = 0;
+}
+
+bool Ktx2File::runSelfCheck()
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "cae_ktx2_selfcheck.ktx2").string();
+    bool passed = true;
+    auto check = [&](bool condition, const std::string& what)
+    {
+        if (!condition)
+        {
+            CAE_LOG_ERROR(Asset, "Ktx2File self-check failed: " << what);
+            passed = false;
+        }
+    };
+
+    struct TestImage
+    {
+        VkFormat format;
+        uint32_t width;
+        uint32_t height;
+    };
+    // A power-of-two chain, a non-power-of-two chain with partial blocks, and an uncompressed image
+    const TestImage images[] = {
+        { VK_FORMAT_BC7_SRGB_BLOCK, 16, 8 },
+        { VK_FORMAT_BC1_RGB_UNORM_BLOCK, 5, 3 },
+        { VK_FORMAT_R8G8B8A8_UNORM, 3, 7 },
+    };
+
+    try
+    {
+        for (const TestImage& image : images)
+        {
+            const uint32_t blockSize = getBlockSize(image.format);
+            const bool blockCompressed = isBlockCompressed(image.format);
+
+            std::vector<MipLevel> levels;
+            for (uint32_t width = image.width, height = image.height;; width = std::max(1u, width / 2), height = std::max(1u, height / 2))
+            {
+                MipLevel level;
+                level.width = width;
+                level.height = height;
+                level.offset = levels.empty() ? 0 : levels.back().offset + levels.back().size;
+                level.size = blockCompressed
+                    ? static_cast<VkDeviceSize>((width + 3) / 4) * ((height + 3) / 4) * blockSize
+                    : static_cast<VkDeviceSize>(width) * height * blockSize;
+                levels.push_back(level);
+                if (width == 1 && height == 1)
+                {
+                    break;
+                }
+            }
+
+            std::vector<uint8_t> data(static_cast<size_t>(levels.back().offset + levels.back().size));
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                data[i] = static_cast<uint8_t>(i * 7 + 3);
+            }
+            write(path, image.format, image.width, image.height, data, levels);
+
+            const std::string name = std::to_string(image.width) + "x" + std::to_string(image.height) + " format " + std::to_string(image.format);
+            Ktx2File file(path);
+            check(file.getFormat() == image.format && file.getWidth() == image.width && file.getHeight() == image.height,
+                  name + ": header does not round trip");
+            check(file.getLevels().size() == levels.size(), name + ": level count does not round trip");
+            for (size_t i = 0; i < levels.size() && i < file.getLevels().size(); ++i)
+            {
+                const MipLevel& level = file.getLevels()[i];
+                check(level.width == levels[i].width && level.height == levels[i].height && level.size == levels[i].size &&
+                      level.offset + level.size <= file.getLevelDataSize() &&
+                      memcmp(file.getLevelData() + level.offset, data.data() + levels[i].offset, static_cast<size_t>(level.size)) == 0,
+                      name + ": level " + std::to_string(i) + " does not round trip");
+            }
+        }
+
+        // A level count past the full chain of the extent must be rejected, not shifted past 31 bits
+        {
+            std::vector<uint8_t> texel = { 1, 2, 3, 4 };
+            MipLevel level;
+            level.width = 1;
+            level.height = 1;
+            level.size = 4;
+            write(path, VK_FORMAT_R8G8B8A8_UNORM, 1, 1, texel, { level });
+
+            std::vector<uint8_t> bytes(static_cast<size_t>(std::filesystem::file_size(path)));
+            {
+                std::ifstream input(path, std::ios::binary);
+                input.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            }
+            const uint32_t levelCount = 40;
+            memcpy(bytes.data() + offsetof(Header, levelCount), &levelCount, sizeof(levelCount));
+            bytes.resize(sizeof(Header) + levelCount * sizeof(LevelRecord), 0);
+            {
+                std::ofstream output(path, std::ios::binary | std::ios::trunc);
+                output.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            }
+
+            bool rejected = false;
+            try
+            {
+                Ktx2File file(path);
+            }
+            catch (const std::runtime_error& e)
+            {
+                rejected = std::string(e.what()).find("more mip levels") != std::string::npos;
+            }
+            check(rejected, "a level count beyond the extent was not rejected");
+        }
+    }
+    catch (const std::exception& e)
+    {
+        check(false, e.what());
+    }
+
+    std::error_code error;
+    std::filesystem::remove(path, error);
+
+    CAE_LOG_INFO(Asset, "Ktx2File self-check " << (passed ? "passed" : "FAILED"));
+    return passed;
+}
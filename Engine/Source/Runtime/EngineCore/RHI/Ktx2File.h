@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MipGenerator.h"
+#include "Runtime/EngineCore/Core/MappedFile.h"
+
+//
+// Minimal KTX 2.0 container: single 2D image (no arrays, cube faces or supercompression) with a
+// full mip chain. The writer emits a spec-conforming basic data format descriptor and stores the
+// levels smallest first, each aligned to the format's block size. The reader maps the file and
+// exposes the level data in place, so blocks go straight from the mapping into staging memory.
+//
+class Ktx2File
+{
+public:
+    // Levels index data; level 0 is the full-resolution image
+    static void write(const std::string& path, VkFormat format, uint32_t width, uint32_t height,
+                      const std::vector<uint8_t>& data, const std::vector<MipLevel>& levels);
+
+    // Bytes per 4x4 block for block-compressed formats, per texel otherwise; 0 when unsupported
+    static uint32_t getBlockSize(VkFormat format);
+    static bool isBlockCompressed(VkFormat format);
+
+    // Writes and reopens small BC7, BC1 and RGBA8 chains in the temp directory, comparing every level
+    // byte for byte, and checks that a corrupt level count is rejected. Returns false on any failure.
+    static bool runSelfCheck();
+
+    Ktx2File() = default;
+    explicit Ktx2File(const std::string& path);
+
+    // Maps the file and validates the header and level index; throws on anything unsupported
+    void open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_File.isOpen(); }
+
+    VkFormat getFormat() const { return m_Format; }
+    uint32_t getWidth() const { return m_Width; }
+    uint32_t getHeight() const { return m_Height; }
+
+    // Level offsets are relative to getLevelData()
+    const std::vector<MipLevel>& getLevels() const { return m_Levels; }
+    const uint8_t* getLevelData() const { return m_pLevelData; }
+    VkDeviceSize getLevelDataSize() const { return m_LevelDataSize; }
+
+private:
+    MappedFile m_File;
+    VkFormat m_Format = VK_FORMAT_UNDEFINED;
+    uint32_t m_Width = 0;
+    uint32_t m_Height = 0;
+    std::vector<MipLevel> m_Levels;
+    const uint8_t* m_pLevelData = nullptr;
+    VkDeviceSize m_LevelDataSize = 0;
+};
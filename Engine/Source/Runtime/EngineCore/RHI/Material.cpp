@@ -1,8 +1,9 @@
 // Material.cpp
 #include "Material.h"
+#include "TextureCache.h"
 
 Material::Material()
-    : pDiffuseTexture(nullptr), pNormalTexture(nullptr), pMetallicRoughnessTexture(nullptr)
+    : pDiffuseTexture(nullptr), pNormalTexture(nullptr), pMetallicRoughnessTexture(nullptr), sampler(VK_NULL_HANDLE), pTextureCache(nullptr)
 {
     // Constructor implementation (initialize pointers to nullptr or any default initialization)
 }
@@ -10,6 +11,14 @@ Material::Material()
 Material::~Material()
 {
     // Destructor implementation (clean up resources)
+    if (pTextureCache)
+    {
+        pTextureCache->release(pDiffuseTexture);
+        pTextureCache->release(pNormalTexture);
+        pTextureCache->release(pMetallicRoughnessTexture);
+        return;
+    }
+
     delete pDiffuseTexture;
     delete pNormalTexture;
     delete pMetallicRoughnessTexture;
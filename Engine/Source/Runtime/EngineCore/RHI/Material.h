@@ -2,8 +2,21 @@
 #pragma once
 #include <string>
 #include <vector>
+#include "SamplerCache.h"
 #include "Texture.h"
 
+class TextureCache;
+
+// Source description of a material as read from a model file. Empty paths mean the
+// texture is absent and a default should be used.
+struct MaterialDesc
+{
+    std::string diffusePath;
+    std::string normalPath;
+    std::string metallicRoughnessPath;
+    SamplerCache::Desc sampler; // Filtering and addressing shared by the material's textures
+};
+
 class Material {
 public:
     Material();
@@ -11,6 +24,10 @@ public:
 
     // Material properties
     Texture* pDiffuseTexture;
-    Texture* pNormalTexture;
-	Texture* pMetallicRoughnessTexture;
+    Texture* pNormalTexture; // Two channels: tangent-space X/Y, Z is rebuilt in the shader
+	Texture* pMetallicRoughnessTexture; // Two channels: R = metallic, G = roughness
+    VkSampler sampler; // Owned by the SamplerCache it came from
+
+    // When set, the textures were acquired from this cache and are released to it instead of deleted
+    TextureCache* pTextureCache;
 };
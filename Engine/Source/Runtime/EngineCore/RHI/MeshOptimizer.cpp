@@ -0,0 +1,374 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "GltfImporter.h"
+#include "Model.h"
+#include "Runtime/EngineCore/Core/ParallelFor.h"
+#include "Runtime/EngineCore/Core/Log.h"
+
+namespace
+{
+    struct Cluster
+    {
+        size_t firstTriangle;
+        size_t triangleCount;
+        float sortKey;
+    };
+}
+
+MeshOptimizer::MeshOptimizer()
+    : m_Settings()
+{
+}
+
+MeshOptimizer::MeshOptimizer(const Settings& settings)
+    : m_Settings(settings)
+{
+}
+
+void MeshOptimizer::optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, const std::vector<Submesh>& submeshes)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    m_Stats = Stats{};
+    m_Stats.before = analyzeVertexCache(indices, submeshes, vertices.size(), m_Settings.cacheSize);
+
+    parallelFor(submeshes.size(), [&](size_t i)
+    {
+        const Submesh& submesh = submeshes[i];
+        optimizeSubmesh(vertices, indices.data() + submesh.indexStart, submesh.indexCount, submesh);
+    });
+
+    if (m_Settings.optimizeVertexFetch)
+    {
+        optimizeVertexFetch(vertices, indices);
+    }
+
+    m_Stats.after = analyzeVertexCache(indices, submeshes, vertices.size(), m_Settings.cacheSize);
+    m_Stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+MeshOptimizer::CacheStats MeshOptimizer::analyzeVertexCache(const std::vector<uint32_t>& indices, const std::vector<Submesh>& submeshes,
+                                                            size_t vertexCount, uint32_t cacheSize)
+{
+    // A vertex is resident while fewer than cacheSize misses happened since it was inserted
+    std::vector<uint32_t> insertTime(vertexCount, 0);
+    std::vector<uint32_t> lastSubmesh(vertexCount, UINT32_MAX);
+
+    uint32_t time = 0;
+    size_t misses = 0;
+    size_t triangles = 0;
+    size_t uniqueVertices = 0;
+
+    for (uint32_t s = 0; s < submeshes.size(); ++s)
+    {
+        const Submesh& submesh = submeshes[s];
+        time += cacheSize + 1; // Flush between draws
+
+        for (uint32_t i = submesh.indexStart; i < submesh.indexStart + submesh.indexCount; ++i)
+        {
+            uint32_t vertex = indices[i];
+            if (lastSubmesh[vertex] != s)
+            {
+                lastSubmesh[vertex] = s;
+                ++uniqueVertices;
+            }
+            if (time - insertTime[vertex] > cacheSize)
+            {
+                insertTime[vertex] = time++;
+                ++misses;
+            }
+        }
+        triangles += submesh.indexCount / 3;
+    }
+
+    CacheStats stats;
+    stats.acmr = triangles > 0 ? static_cast<double>(misses) / static_cast<double>(triangles) : 0.0;
+    stats.atvr = uniqueVertices > 0 ? static_cast<double>(misses) / static_cast<double>(uniqueVertices) : 0.0;
+    return stats;
+}
+
+// Tipsify (Sander, Nehab and Barczak, "Fast Triangle Reordering for Vertex Locality
+// and Reduced Overdraw", 2007), followed by its view-independent cluster sort.
+void MeshOptimizer::runBenchmark(const std::string& folder)
+{
+    const std::vector<std::string> paths = GltfImporter::findScenes(folder);
+    if (paths.empty())
+    {
+        CAE_LOG_INFO(Asset, "Mesh optimizer benchmark: no scenes in " << folder);
+        return;
+    }
+
+    const Settings settings;
+    CAE_LOG_INFO(Asset, "Mesh optimizer benchmark: " << paths.size() << " scenes from " << folder << ", " << settings.cacheSize
+        << "-entry FIFO cache");
+
+    // Totals are computed from summed misses, so larger scenes weigh more
+    double missesBefore = 0.0;
+    double missesAfter = 0.0;
+    double uniqueVertices = 0.0; // Per-draw unique vertices, the ATVR denominator
+    size_t triangles = 0;
+    double seconds = 0.0;
+    for (const std::string& path : paths)
+    {
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<Submesh> submeshes;
+        std::vector<MaterialDesc> materials;
+        GltfImporter importer(path);
+        importer.import(vertices, indices, submeshes, materials);
+
+        MeshOptimizer optimizer(settings);
+        optimizer.optimize(vertices, indices, submeshes);
+        const Stats& stats = optimizer.getStats();
+
+        const size_t sceneTriangles = indices.size() / 3;
+        CAE_LOG_INFO(Asset, "  " << path << ": " << sceneTriangles << " triangles, ACMR " << stats.before.acmr << " -> " << stats.after.acmr
+            << ", ATVR " << stats.before.atvr << " -> " << stats.after.atvr << ", " << stats.seconds * 1000.0 << " ms");
+
+        missesBefore += stats.before.acmr * sceneTriangles;
+        missesAfter += stats.after.acmr * sceneTriangles;
+        triangles += sceneTriangles;
+        uniqueVertices += stats.before.atvr > 0.0 ? stats.before.acmr * sceneTriangles / stats.before.atvr : 0.0;
+        seconds += stats.seconds;
+    }
+
+    if (triangles == 0 || uniqueVertices == 0.0)
+    {
+        return;
+    }
+    CAE_LOG_INFO(Asset, "  Total: " << triangles << " triangles, ACMR " << missesBefore / triangles << " -> " << missesAfter / triangles
+        << ", ATVR " << missesBefore / uniqueVertices << " -> " << missesAfter / uniqueVertices << ", "
+        << triangles / seconds / 1.0e6 << " M triangles/s");
+}
+
+void MeshOptimizer::optimizeSubmesh(const std::vector<Vertex>& vertices, uint32_t* pIndices, size_t indexCount, const Submesh& submesh) const
+{
+    const size_t triangleCount = indexCount / 3;
+    if (triangleCount < 2)
+    {
+        return;
+    }
+
+    // Work in a local vertex range so per-vertex arrays stay proportional to the submesh
+    uint32_t minVertex = UINT32_MAX;
+    uint32_t maxVertex = 0;
+    for (size_t i = 0; i < triangleCount * 3; ++i)
+    {
+        minVertex = std::min(minVertex, pIndices[i]);
+        maxVertex = std::max(maxVertex, pIndices[i]);
+    }
+    const size_t localVertexCount = static_cast<size_t>(maxVertex - minVertex) + 1;
+
+    std::vector<uint32_t> localIndices(triangleCount * 3);
+    std::vector<uint32_t> liveCount(localVertexCount, 0);
+    for (size_t i = 0; i < localIndices.size(); ++i)
+    {
+        localIndices[i] = pIndices[i] - minVertex;
+        ++liveCount[localIndices[i]];
+    }
+
+    // Vertex -> triangle adjacency in CSR form
+    std::vector<uint32_t> adjacencyOffsets(localVertexCount + 1, 0);
+    for (size_t v = 0; v < localVertexCount; ++v)
+    {
+        adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveCount[v];
+    }
+    std::vector<uint32_t> adjacency(localIndices.size());
+    {
+        std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t i = 0; i < localIndices.size(); ++i)
+        {
+            adjacency[fill[localIndices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    const uint32_t cacheSize = m_Settings.cacheSize;
+    std::vector<uint32_t> cacheTime(localVertexCount, 0);
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    std::vector<uint32_t> deadEnd;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> orderedTriangles;
+    std::vector<size_t> clusterStarts{ 0 };
+    orderedTriangles.reserve(triangleCount);
+    deadEnd.reserve(localIndices.size());
+
+    uint32_t time = cacheSize + 1;
+    size_t cursor = 0;
+
+    auto skipDeadEnd = [&]() -> int64_t
+    {
+        while (!deadEnd.empty())
+        {
+            uint32_t vertex = deadEnd.back();
+            deadEnd.pop_back();
+            if (liveCount[vertex] > 0)
+            {
+                return vertex;
+            }
+        }
+        for (; cursor < localVertexCount; ++cursor)
+        {
+            if (liveCount[cursor] > 0)
+            {
+                return static_cast<int64_t>(cursor);
+            }
+        }
+        return -1;
+    };
+
+    int64_t fanningVertex = skipDeadEnd();
+    while (fanningVertex >= 0)
+    {
+        candidates.clear();
+
+        for (uint32_t a = adjacencyOffsets[fanningVertex]; a < adjacencyOffsets[fanningVertex + 1]; ++a)
+        {
+            uint32_t triangle = adjacency[a];
+            if (emitted[triangle])
+            {
+                continue;
+            }
+            emitted[triangle] = 1;
+            orderedTriangles.push_back(triangle);
+
+            for (size_t corner = 0; corner < 3; ++corner)
+            {
+                uint32_t vertex = localIndices[triangle * 3 + corner];
+                deadEnd.push_back(vertex);
+                candidates.push_back(vertex);
+                --liveCount[vertex];
+                if (time - cacheTime[vertex] > cacheSize)
+                {
+                    cacheTime[vertex] = time++;
+                }
+            }
+        }
+
+        // Prefer the candidate that will still be in cache after its remaining triangles are emitted
+        int64_t nextVertex = -1;
+        int64_t bestPriority = -1;
+        for (uint32_t vertex : candidates)
+        {
+            if (liveCount[vertex] == 0)
+            {
+                continue;
+            }
+            int64_t priority = 0;
+            if (time - cacheTime[vertex] + 2 * liveCount[vertex] <= cacheSize)
+            {
+                priority = time - cacheTime[vertex];
+            }
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                nextVertex = vertex;
+            }
+        }
+
+        if (nextVertex < 0)
+        {
+            nextVertex = skipDeadEnd();
+
+            // Jumping to a vertex that is no longer cached is a hard boundary; clusters
+            // between boundaries can be reordered without hurting cache efficiency much
+            if (nextVertex >= 0 && time - cacheTime[nextVertex] > cacheSize)
+            {
+                clusterStarts.push_back(orderedTriangles.size());
+            }
+        }
+
+        fanningVertex = nextVertex;
+    }
+
+    std::vector<Cluster> clusters(clusterStarts.size());
+    for (size_t c = 0; c < clusterStarts.size(); ++c)
+    {
+        size_t end = c + 1 < clusterStarts.size() ? clusterStarts[c + 1] : orderedTriangles.size();
+        clusters[c] = Cluster{ clusterStarts[c], end - clusterStarts[c], 0.0f };
+    }
+
+    if (m_Settings.optimizeOverdraw && clusters.size() > 1)
+    {
+        // Clusters facing away from the submesh centre are likely to occlude the rest,
+        // so drawing them first lets early depth testing reject more fragments
+        const glm::vec3 center = (submesh.bboxMin + submesh.bboxMax) * 0.5f;
+
+        for (Cluster& cluster : clusters)
+        {
+            glm::vec3 centroid(0.0f);
+            glm::vec3 normal(0.0f);
+            float totalArea = 0.0f;
+
+            for (size_t t = cluster.firstTriangle; t < cluster.firstTriangle + cluster.triangleCount; ++t)
+            {
+                const uint32_t* pTriangle = &localIndices[orderedTriangles[t] * 3];
+                const glm::vec3& p0 = vertices[pTriangle[0] + minVertex].pos;
+                const glm::vec3& p1 = vertices[pTriangle[1] + minVertex].pos;
+                const glm::vec3& p2 = vertices[pTriangle[2] + minVertex].pos;
+
+                glm::vec3 faceNormal = glm::cross(p1 - p0, p2 - p0); // Length is twice the area
+                float area = glm::length(faceNormal);
+                centroid += (p0 + p1 + p2) * (area / 3.0f);
+                normal += faceNormal;
+                totalArea += area;
+            }
+
+            float normalLength = glm::length(normal);
+            if (totalArea > 0.0f && normalLength > 0.0f)
+            {
+                cluster.sortKey = glm::dot(centroid / totalArea - center, normal / normalLength);
+            }
+        }
+
+        std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b)
+        {
+            return a.sortKey > b.sortKey;
+        });
+    }
+
+    size_t out = 0;
+    for (const Cluster& cluster : clusters)
+    {
+        for (size_t t = cluster.firstTriangle; t < cluster.firstTriangle + cluster.triangleCount; ++t)
+        {
+            const uint32_t* pTriangle = &localIndices[orderedTriangles[t] * 3];
+            pIndices[out++] = pTriangle[0] + minVertex;
+            pIndices[out++] = pTriangle[1] + minVertex;
+            pIndices[out++] = pTriangle[2] + minVertex;
+        }
+    }
+}
+
+void MeshOptimizer::optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+    std::vector<uint32_t> remap(vertices.size(), UINT32_MAX);
+    uint32_t nextVertex = 0;
+
+    for (uint32_t& index : indices)
+    {
+        if (remap[index] == UINT32_MAX)
+        {
+            remap[index] = nextVertex++;
+        }
+        index = remap[index];
+    }
+
+    // Unreferenced vertices keep their relative order at the end of the buffer
+    for (uint32_t& target : remap)
+    {
+        if (target == UINT32_MAX)
+        {
+            target = nextVertex++;
+        }
+    }
+
+    std::vector<Vertex> reordered(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        reordered[remap[i]] = vertices[i];
+    }
+    vertices = std::move(reordered);
+}
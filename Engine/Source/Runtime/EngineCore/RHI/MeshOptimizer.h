@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct Vertex;
+struct Submesh;
+
+//
+// Reorders index and vertex data for the GPU front end, one Submesh at a time:
+//   1. Tipsify triangle ordering for the post-transform vertex cache
+//   2. Clusters from (1) sorted outside-in around the submesh bounds to reduce overdraw
+//   3. Vertices renumbered in first-use order for vertex fetch locality
+// Submesh index ranges and materials are unchanged; only the order within them moves.
+//
+class MeshOptimizer
+{
+public:
+    struct Settings
+    {
+        uint32_t cacheSize = 16;        // Modelled post-transform cache entries (FIFO)
+        bool optimizeOverdraw = true;
+        bool optimizeVertexFetch = true;
+    };
+
+    struct CacheStats
+    {
+        double acmr = 0.0; // Average cache miss ratio: transformed vertices per triangle (0.5 best, 3.0 worst)
+        double atvr = 0.0; // Average transform to vertex ratio: transformed per unique vertex (1.0 best)
+    };
+
+    struct Stats
+    {
+        CacheStats before;
+        CacheStats after;
+        double seconds = 0.0;
+    };
+
+    MeshOptimizer();
+    explicit MeshOptimizer(const Settings& settings);
+
+    void optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, const std::vector<Submesh>& submeshes);
+
+    // Simulates a FIFO post-transform cache over every submesh. The cache is flushed
+    // between submeshes since each one is a separate draw.
+    static CacheStats analyzeVertexCache(const std::vector<uint32_t>& indices, const std::vector<Submesh>& submeshes,
+                                         size_t vertexCount, uint32_t cacheSize);
+
+    const Stats& getStats() const { return m_Stats; }
+
+    // Optimizes every .gltf/.glb in folder with the default settings and logs ACMR and ATVR before
+    // and after, per scene and over all of them. Runs on the CPU only.
+    static void runBenchmark(const std::string& folder);
+
+private:
+    void optimizeSubmesh(const std::vector<Vertex>& vertices, uint32_t* pIndices, size_t indexCount, const Submesh& submesh) const;
+    static void optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+    Settings m_Settings;
+    Stats m_Stats;
+};
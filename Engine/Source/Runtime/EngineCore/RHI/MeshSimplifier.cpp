@@ -0,0 +1,443 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+#include "Model.h"
+#include "Runtime/EngineCore/Core/ParallelFor.h"
+
+namespace
+{
+    // Symmetric 4x4 plane quadric plus the accumulated area weight
+    struct Quadric
+    {
+        double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+        double b0 = 0, b1 = 0, b2 = 0;
+        double c = 0;
+        double weight = 0;
+
+        void addPlane(const glm::vec3& normal, float distance, double planeWeight)
+        {
+            double nx = normal.x, ny = normal.y, nz = normal.z, d = distance;
+            a00 += planeWeight * nx * nx; a01 += planeWeight * nx * ny; a02 += planeWeight * nx * nz;
+            a11 += planeWeight * ny * ny; a12 += planeWeight * ny * nz; a22 += planeWeight * nz * nz;
+            b0 += planeWeight * nx * d; b1 += planeWeight * ny * d; b2 += planeWeight * nz * d;
+            c += planeWeight * d * d;
+            weight += planeWeight;
+        }
+
+        Quadric& operator+=(const Quadric& other)
+        {
+            a00 += other.a00; a01 += other.a01; a02 += other.a02;
+            a11 += other.a11; a12 += other.a12; a22 += other.a22;
+            b0 += other.b0; b1 += other.b1; b2 += other.b2;
+            c += other.c;
+            weight += other.weight;
+            return *this;
+        }
+
+        // Area-weighted mean squared distance from p to the accumulated planes
+        double evaluate(const glm::vec3& p) const
+        {
+            double x = p.x, y = p.y, z = p.z;
+            double result = a00 * x * x + a11 * y * y + a22 * z * z
+                + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+                + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+            return weight > 0.0 ? std::max(result, 0.0) / weight : 0.0;
+        }
+    };
+
+    struct Collapse
+    {
+        uint32_t from;
+        uint32_t to;
+        double cost;
+    };
+
+    bool lessPosition(const glm::vec3& a, const glm::vec3& b)
+    {
+        if (a.x != b.x) return a.x < b.x;
+        if (a.y != b.y) return a.y < b.y;
+        return a.z < b.z;
+    }
+}
+
+MeshSimplifier::MeshSimplifier()
+    : m_Settings()
+{
+}
+
+MeshSimplifier::MeshSimplifier(const Settings& settings)
+    : m_Settings(settings)
+{
+    if (settings.lodCount == 0 || settings.lodCount > MaxLodCount || settings.reductionRatio <= 0.0f || settings.reductionRatio >= 1.0f)
+    {
+        throw std::runtime_error("Invalid LOD settings");
+    }
+}
+
+float MeshSimplifier::simplify(const std::vector<Vertex>& vertices, const uint32_t* pIndices, size_t indexCount,
+                               size_t targetIndexCount, float maxError, std::vector<uint32_t>& output)
+{
+    indexCount -= indexCount % 3;
+    output.clear();
+    if (indexCount == 0)
+    {
+        return 0.0f;
+    }
+
+    // Local vertex range keeps per-vertex arrays proportional to the submesh
+    uint32_t minVertex = UINT32_MAX;
+    uint32_t maxVertex = 0;
+    for (size_t i = 0; i < indexCount; ++i)
+    {
+        minVertex = std::min(minVertex, pIndices[i]);
+        maxVertex = std::max(maxVertex, pIndices[i]);
+    }
+    const uint32_t localCount = maxVertex - minVertex + 1;
+
+    std::vector<uint32_t> triangles(indexCount);
+    std::vector<uint8_t> referenced(localCount, 0);
+    for (size_t i = 0; i < indexCount; ++i)
+    {
+        triangles[i] = pIndices[i] - minVertex;
+        referenced[triangles[i]] = 1;
+    }
+
+    auto position = [&](uint32_t local) -> const glm::vec3& { return vertices[local + minVertex].pos; };
+
+    // Group vertices by position. Groups with several vertices are attribute seams.
+    std::vector<uint32_t> sortedVertices;
+    sortedVertices.reserve(localCount);
+    for (uint32_t v = 0; v < localCount; ++v)
+    {
+        if (referenced[v])
+        {
+            sortedVertices.push_back(v);
+        }
+    }
+    std::sort(sortedVertices.begin(), sortedVertices.end(), [&](uint32_t a, uint32_t b)
+    {
+        return lessPosition(position(a), position(b));
+    });
+
+    std::vector<uint32_t> group(localCount);
+    std::vector<uint8_t> locked(localCount, 0);
+    for (size_t i = 0; i < sortedVertices.size();)
+    {
+        size_t end = i + 1;
+        while (end < sortedVertices.size() && position(sortedVertices[end]) == position(sortedVertices[i]))
+        {
+            ++end;
+        }
+        for (size_t j = i; j < end; ++j)
+        {
+            group[sortedVertices[j]] = sortedVertices[i];
+            locked[sortedVertices[j]] = end - i > 1;
+        }
+        i = end;
+    }
+
+    // Lock open borders and non-manifold edges: every directed edge needs exactly one opposite
+    {
+        std::vector<uint64_t> edges;
+        edges.reserve(indexCount);
+        for (size_t t = 0; t < indexCount; t += 3)
+        {
+            for (size_t e = 0; e < 3; ++e)
+            {
+                uint64_t a = group[triangles[t + e]];
+                uint64_t b = group[triangles[t + (e + 1) % 3]];
+                edges.push_back((a << 32) | b);
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+
+        for (size_t i = 0; i < edges.size(); ++i)
+        {
+            uint64_t edge = edges[i];
+            uint64_t reverse = (edge << 32) | (edge >> 32);
+            bool duplicate = (i > 0 && edges[i - 1] == edge) || (i + 1 < edges.size() && edges[i + 1] == edge);
+            auto range = std::equal_range(edges.begin(), edges.end(), reverse);
+            if (duplicate || range.second - range.first != 1)
+            {
+                uint32_t a = static_cast<uint32_t>(edge >> 32);
+                uint32_t b = static_cast<uint32_t>(edge & 0xFFFFFFFFu);
+                locked[a] = 1;
+                locked[b] = 1;
+            }
+        }
+
+        // Propagate the lock to every vertex sharing the position
+        for (uint32_t v = 0; v < localCount; ++v)
+        {
+            if (referenced[v] && locked[group[v]])
+            {
+                locked[v] = 1;
+            }
+        }
+    }
+
+    // Plane quadrics accumulated per position group
+    std::vector<Quadric> quadrics(localCount);
+    for (size_t t = 0; t < indexCount; t += 3)
+    {
+        const glm::vec3& p0 = position(triangles[t]);
+        glm::vec3 normal = glm::cross(position(triangles[t + 1]) - p0, position(triangles[t + 2]) - p0);
+        float length = glm::length(normal);
+        if (length == 0.0f)
+        {
+            continue;
+        }
+        normal /= length;
+
+        Quadric plane;
+        plane.addPlane(normal, -glm::dot(normal, p0), length * 0.5);
+        for (size_t corner = 0; corner < 3; ++corner)
+        {
+            quadrics[group[triangles[t + corner]]] += plane;
+        }
+    }
+
+    const double maxCost = static_cast<double>(maxError) * static_cast<double>(maxError);
+    double resultCost = 0.0;
+
+    std::vector<Collapse> collapses;
+    std::vector<uint32_t> adjacencyOffsets(localCount + 1);
+    std::vector<uint32_t> adjacency;
+    std::vector<uint8_t> touched(localCount);
+    std::vector<uint32_t> remap(localCount);
+
+    // Each pass collapses a batch of independent edges, cheapest first, then rebuilds
+    while (triangles.size() > targetIndexCount)
+    {
+        collapses.clear();
+        for (size_t t = 0; t < triangles.size(); t += 3)
+        {
+            for (size_t e = 0; e < 3; ++e)
+            {
+                uint32_t a = triangles[t + e];
+                uint32_t b = triangles[t + (e + 1) % 3];
+                if (!locked[a])
+                {
+                    Quadric combined = quadrics[group[a]];
+                    combined += quadrics[group[b]];
+                    collapses.push_back(Collapse{ a, b, combined.evaluate(position(b)) });
+                }
+                if (!locked[b])
+                {
+                    Quadric combined = quadrics[group[b]];
+                    combined += quadrics[group[a]];
+                    collapses.push_back(Collapse{ b, a, combined.evaluate(position(a)) });
+                }
+            }
+        }
+        if (collapses.empty())
+        {
+            break;
+        }
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+        std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+        for (uint32_t v : triangles)
+        {
+            ++adjacencyOffsets[v + 1];
+        }
+        for (uint32_t v = 0; v < localCount; ++v)
+        {
+            adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+        }
+        adjacency.resize(triangles.size());
+        {
+            std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (size_t i = 0; i < triangles.size(); ++i)
+            {
+                adjacency[fill[triangles[i]]++] = static_cast<uint32_t>(i / 3);
+            }
+        }
+
+        std::fill(touched.begin(), touched.end(), 0);
+        for (uint32_t v = 0; v < localCount; ++v)
+        {
+            remap[v] = v;
+        }
+
+        // Stop a pass early once the expected triangle count reaches the target
+        size_t remainingIndices = triangles.size();
+        size_t collapseCount = 0;
+
+        for (const Collapse& collapse : collapses)
+        {
+            if (collapse.cost > maxCost || remainingIndices <= targetIndexCount)
+            {
+                break;
+            }
+            if (touched[collapse.from] || touched[collapse.to])
+            {
+                continue;
+            }
+
+            // Reject collapses that would flip a surviving triangle
+            bool flips = false;
+            size_t removedTriangles = 0;
+            const glm::vec3& target = position(collapse.to);
+            for (uint32_t a = adjacencyOffsets[collapse.from]; a < adjacencyOffsets[collapse.from + 1] && !flips; ++a)
+            {
+                const uint32_t* pTriangle = &triangles[adjacency[a] * 3];
+                if (pTriangle[0] == collapse.to || pTriangle[1] == collapse.to || pTriangle[2] == collapse.to)
+                {
+                    ++removedTriangles;
+                    continue;
+                }
+
+                glm::vec3 before[3];
+                glm::vec3 after[3];
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    before[corner] = position(pTriangle[corner]);
+                    after[corner] = pTriangle[corner] == collapse.from ? target : before[corner];
+                }
+                glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+                glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+                flips = glm::dot(normalBefore, normalAfter) <= 0.0f;
+            }
+            if (flips)
+            {
+                continue;
+            }
+
+            remap[collapse.from] = collapse.to;
+            quadrics[group[collapse.to]] += quadrics[group[collapse.from]];
+            resultCost = std::max(resultCost, collapse.cost);
+            remainingIndices -= std::min(remainingIndices, removedTriangles * 3);
+            ++collapseCount;
+
+            // Freeze the whole one-ring so flip checks in this pass stay valid
+            for (uint32_t a = adjacencyOffsets[collapse.from]; a < adjacencyOffsets[collapse.from + 1]; ++a)
+            {
+                const uint32_t* pTriangle = &triangles[adjacency[a] * 3];
+                touched[pTriangle[0]] = touched[pTriangle[1]] = touched[pTriangle[2]] = 1;
+            }
+        }
+
+        if (collapseCount == 0)
+        {
+            break;
+        }
+
+        size_t write = 0;
+        for (size_t t = 0; t < triangles.size(); t += 3)
+        {
+            uint32_t a = remap[triangles[t]];
+            uint32_t b = remap[triangles[t + 1]];
+            uint32_t c = remap[triangles[t + 2]];
+            if (a != b && b != c && a != c)
+            {
+                triangles[write++] = a;
+                triangles[write++] = b;
+                triangles[write++] = c;
+            }
+        }
+        triangles.resize(write);
+    }
+
+    output.resize(triangles.size());
+    for (size_t i = 0; i < triangles.size(); ++i)
+    {
+        output[i] = triangles[i] + minVertex;
+    }
+    return static_cast<float>(std::sqrt(resultCost));
+}
+
+void MeshSimplifier::generateLods(const std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+                                  std::vector<Submesh>& submeshes, std::vector<MeshLod>& lods)
+{
+    auto start = std::chrono::steady_clock::now();
+    m_Stats = Stats{};
+    lods.clear();
+
+    struct SubmeshLods
+    {
+        std::vector<std::vector<uint32_t>> indices;
+        std::vector<float> errors;
+    };
+    std::vector<SubmeshLods> perSubmesh(submeshes.size());
+
+    parallelFor(submeshes.size(), [&](size_t i)
+    {
+        const Submesh& submesh = submeshes[i];
+        SubmeshLods& result = perSubmesh[i];
+
+        const float maxError = m_Settings.maxRelativeError * glm::length(submesh.bboxMax - submesh.bboxMin);
+        const uint32_t* pSource = indices.data() + submesh.indexStart;
+        size_t sourceCount = submesh.indexCount;
+        float sourceError = 0.0f;
+
+        for (uint32_t level = 1; level < m_Settings.lodCount; ++level)
+        {
+            size_t target = static_cast<size_t>(static_cast<float>(sourceCount / 3) * m_Settings.reductionRatio) * 3;
+            if (target < 3)
+            {
+                break;
+            }
+
+            std::vector<uint32_t> lodIndices;
+            float error = simplify(vertices, pSource, sourceCount, target, maxError, lodIndices);
+
+            // Not worth a LOD level if it barely removes anything
+            if (lodIndices.empty() || lodIndices.size() * 10 > sourceCount * 9)
+            {
+                break;
+            }
+
+            // Errors are measured against the previous level, so accumulate them
+            sourceError += error;
+            result.errors.push_back(sourceError);
+            result.indices.push_back(std::move(lodIndices));
+
+            pSource = result.indices.back().data();
+            sourceCount = result.indices.back().size();
+        }
+    });
+
+    for (size_t i = 0; i < submeshes.size(); ++i)
+    {
+        Submesh& submesh = submeshes[i];
+        SubmeshLods& result = perSubmesh[i];
+
+        submesh.lodOffset = static_cast<uint32_t>(lods.size());
+        submesh.lodCount = static_cast<uint32_t>(result.indices.size() + 1);
+        lods.push_back(MeshLod{ submesh.indexStart, submesh.indexCount, 0.0f });
+        m_Stats.sourceTriangles += submesh.indexCount / 3;
+
+        for (size_t level = 0; level < result.indices.size(); ++level)
+        {
+            const std::vector<uint32_t>& lodIndices = result.indices[level];
+            lods.push_back(MeshLod{ static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(lodIndices.size()), result.errors[level] });
+            indices.insert(indices.end(), lodIndices.begin(), lodIndices.end());
+            m_Stats.lodTriangles += lodIndices.size() / 3;
+            ++m_Stats.lodCount;
+        }
+    }
+
+    m_Stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+float MeshSimplifier::getProjectionScale(float fovY, float viewportHeight)
+{
+    return viewportHeight / (2.0f * std::tan(fovY * 0.5f));
+}
+
+uint32_t MeshSimplifier::selectLod(const MeshLod* pLods, uint32_t lodCount, float distance, float projectionScale, float maxPixelError)
+{
+    for (uint32_t level = lodCount; level > 1; --level)
+    {
+        if (pLods[level - 1].error * projectionScale <= maxPixelError * distance)
+        {
+            return level - 1;
+        }
+    }
+    return 0;
+}
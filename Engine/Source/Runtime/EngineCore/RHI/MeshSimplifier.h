@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct Vertex;
+struct Submesh;
+
+// One level of detail of a Submesh: an index range into the model's shared index buffer
+struct MeshLod
+{
+    uint32_t indexStart;
+    uint32_t indexCount;
+    float error; // Approximate deviation from LOD 0 in world units; projected to pixels by selectLod
+};
+
+//
+// Quadric error metric simplification (Garland and Heckbert) restricted to half-edge
+// collapses, so every LOD reuses the original vertices and only needs new indices.
+// Open borders, UV/normal seams and non-manifold edges are locked to keep LODs crack-free.
+//
+class MeshSimplifier
+{
+public:
+    struct Settings
+    {
+        uint32_t lodCount = 4;          // Including LOD 0; at most MaxLodCount
+        float reductionRatio = 0.5f;    // Target triangle ratio between consecutive LODs
+        float maxRelativeError = 0.05f; // Error limit as a fraction of the submesh bbox diagonal
+    };
+
+    struct Stats
+    {
+        size_t sourceTriangles = 0;
+        size_t lodTriangles = 0; // Sum over all generated LODs beyond LOD 0
+        size_t lodCount = 0;     // Generated LODs beyond LOD 0
+        double seconds = 0.0;
+    };
+
+    static constexpr uint32_t MaxLodCount = 5;
+
+    MeshSimplifier();
+    explicit MeshSimplifier(const Settings& settings);
+
+    // Appends the index ranges of LOD 1+ to indices and fills each submesh's LOD range
+    // (LOD 0 is the submesh's own range).
+    void generateLods(const std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+                      std::vector<Submesh>& submeshes, std::vector<MeshLod>& lods);
+
+    // Reduces a triangle list towards targetIndexCount without exceeding maxError.
+    // Returns the error of the result.
+    static float simplify(const std::vector<Vertex>& vertices, const uint32_t* pIndices, size_t indexCount,
+                          size_t targetIndexCount, float maxError, std::vector<uint32_t>& output);
+
+    // Pixels per world unit at distance 1 for a perspective projection
+    static float getProjectionScale(float fovY, float viewportHeight);
+
+    // Coarsest LOD whose projected error at the given distance stays within maxPixelError
+    static uint32_t selectLod(const MeshLod* pLods, uint32_t lodCount, float distance, float projectionScale, float maxPixelError);
+
+    const Stats& getStats() const { return m_Stats; }
+
+private:
+    Settings m_Settings;
+    Stats m_Stats;
+};
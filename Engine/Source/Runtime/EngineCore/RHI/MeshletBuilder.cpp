@@ -0,0 +1,427 @@
+#include "MeshletBuilder.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <stdexcept>
+
+#include "GltfImporter.h"
+#include "Model.h"
+#include "Runtime/EngineCore/Core/ParallelFor.h"
+#include "Runtime/EngineCore/Core/Log.h"
+
+namespace
+{
+    // Bounds the per-meshlet scratch arrays used for the normal cone
+    constexpr uint32_t MaxMeshletTriangles = 512;
+
+    using Triangle = std::array<uint32_t, 3>;
+
+    // Rotates the smallest index to the front, so equal triangles compare equal with their winding kept
+    Triangle canonicalTriangle(uint32_t a, uint32_t b, uint32_t c)
+    {
+        if (b < a && b <= c)
+        {
+            return { b, c, a };
+        }
+        if (c < a && c < b)
+        {
+            return { c, a, b };
+        }
+        return { a, b, c };
+    }
+
+    // Wavy grid whose triangles face many directions, so normal cones of every width are exercised
+    void makeGrid(uint32_t size, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, std::vector<Submesh>& submeshes)
+    {
+        for (uint32_t z = 0; z <= size; ++z)
+        {
+            for (uint32_t x = 0; x <= size; ++x)
+            {
+                Vertex vertex{};
+                vertex.pos = glm::vec3(static_cast<float>(x), std::sin(x * 0.3f) * std::cos(z * 0.2f) * 4.0f, static_cast<float>(z));
+                vertices.push_back(vertex);
+            }
+        }
+        for (uint32_t z = 0; z < size; ++z)
+        {
+            for (uint32_t x = 0; x < size; ++x)
+            {
+                const uint32_t corner = z * (size + 1) + x;
+                indices.insert(indices.end(), { corner, corner + size + 1, corner + 1, corner + 1, corner + size + 1, corner + size + 2 });
+            }
+        }
+
+        // Two submeshes, so meshlet ranges are rebased onto the shared arrays
+        const uint32_t half = static_cast<uint32_t>(indices.size() / 6) * 3;
+        Submesh first{};
+        first.indexStart = 0;
+        first.indexCount = half;
+        Submesh second{};
+        second.indexStart = half;
+        second.indexCount = static_cast<uint32_t>(indices.size()) - half;
+        submeshes = { first, second };
+    }
+}
+
+MeshletBuilder::MeshletBuilder()
+    : m_Settings()
+{
+}
+
+MeshletBuilder::MeshletBuilder(const Settings& settings)
+    : m_Settings(settings)
+{
+    // Local indices are stored in 8 bits
+    if (settings.maxVertices < 3 || settings.maxVertices > 256 || settings.maxTriangles == 0 || settings.maxTriangles > MaxMeshletTriangles)
+    {
+        throw std::runtime_error("Invalid meshlet limits");
+    }
+}
+
+void MeshletBuilder::build(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, std::vector<Submesh>& submeshes,
+                           std::vector<Meshlet>& meshlets, std::vector<uint32_t>& meshletVertices, std::vector<uint8_t>& meshletTriangles)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    m_Stats = Stats{};
+    meshlets.clear();
+    meshletVertices.clear();
+    meshletTriangles.clear();
+
+    std::vector<SubmeshMeshlets> perSubmesh(submeshes.size());
+    parallelFor(submeshes.size(), [&](size_t i)
+    {
+        const Submesh& submesh = submeshes[i];
+        buildSubmesh(vertices, indices.data() + submesh.indexStart, submesh.indexCount, perSubmesh[i]);
+    });
+
+    size_t vertexTotal = 0;
+    for (size_t i = 0; i < submeshes.size(); ++i)
+    {
+        Submesh& submesh = submeshes[i];
+        SubmeshMeshlets& local = perSubmesh[i];
+
+        submesh.meshletOffset = static_cast<uint32_t>(meshlets.size());
+        submesh.meshletCount = static_cast<uint32_t>(local.meshlets.size());
+
+        // Rebase the per-submesh offsets onto the shared arrays
+        for (Meshlet& meshlet : local.meshlets)
+        {
+            meshlet.vertexOffset += static_cast<uint32_t>(meshletVertices.size());
+            meshlet.triangleOffset += static_cast<uint32_t>(meshletTriangles.size());
+            vertexTotal += meshlet.vertexCount;
+            m_Stats.triangleCount += meshlet.triangleCount;
+        }
+
+        meshlets.insert(meshlets.end(), local.meshlets.begin(), local.meshlets.end());
+        meshletVertices.insert(meshletVertices.end(), local.vertices.begin(), local.vertices.end());
+        meshletTriangles.insert(meshletTriangles.end(), local.triangles.begin(), local.triangles.end());
+    }
+
+    m_Stats.meshletCount = meshlets.size();
+    if (!meshlets.empty())
+    {
+        m_Stats.averageVertices = static_cast<double>(vertexTotal) / static_cast<double>(meshlets.size());
+        m_Stats.averageTriangles = static_cast<double>(m_Stats.triangleCount) / static_cast<double>(meshlets.size());
+    }
+    m_Stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void MeshletBuilder::buildSubmesh(const std::vector<Vertex>& vertices, const uint32_t* pIndices, size_t indexCount, SubmeshMeshlets& output) const
+{
+    const size_t triangleCount = indexCount / 3;
+    output.meshlets.reserve(triangleCount / m_Settings.maxTriangles + 1);
+    output.triangles.reserve(triangleCount * 3);
+
+    Meshlet current{};
+
+    auto flush = [&]()
+    {
+        if (current.triangleCount == 0)
+        {
+            return;
+        }
+        computeBounds(vertices, output, current);
+        output.meshlets.push_back(current);
+
+        current = Meshlet{};
+        current.vertexOffset = static_cast<uint32_t>(output.vertices.size());
+        current.triangleOffset = static_cast<uint32_t>(output.triangles.size());
+    };
+
+    for (size_t t = 0; t < triangleCount; ++t)
+    {
+        const uint32_t* pTriangle = pIndices + t * 3;
+
+        // Local slot of each corner, or -1 when the vertex is new to this meshlet.
+        // A linear scan is fine: the meshlet vertex list never exceeds maxVertices.
+        int local[3];
+        uint32_t newVertices = 0;
+        for (int corner = 0; corner < 3; ++corner)
+        {
+            local[corner] = -1;
+            const uint32_t* pBegin = output.vertices.data() + current.vertexOffset;
+            const uint32_t* pEnd = pBegin + current.vertexCount;
+            const uint32_t* pFound = std::find(pBegin, pEnd, pTriangle[corner]);
+            if (pFound != pEnd)
+            {
+                local[corner] = static_cast<int>(pFound - pBegin);
+            }
+            else if ((corner < 1 || pTriangle[corner] != pTriangle[0]) && (corner < 2 || pTriangle[corner] != pTriangle[1]))
+            {
+                ++newVertices;
+            }
+        }
+
+        if (current.vertexCount + newVertices > m_Settings.maxVertices || current.triangleCount + 1 > m_Settings.maxTriangles)
+        {
+            flush();
+            local[0] = local[1] = local[2] = -1;
+        }
+
+        for (int corner = 0; corner < 3; ++corner)
+        {
+            if (local[corner] < 0)
+            {
+                // Re-check: an earlier corner of this triangle may have just added the same vertex
+                const uint32_t* pBegin = output.vertices.data() + current.vertexOffset;
+                const uint32_t* pEnd = pBegin + current.vertexCount;
+                const uint32_t* pFound = std::find(pBegin, pEnd, pTriangle[corner]);
+                if (pFound != pEnd)
+                {
+                    local[corner] = static_cast<int>(pFound - pBegin);
+                }
+                else
+                {
+                    local[corner] = static_cast<int>(current.vertexCount++);
+                    output.vertices.push_back(pTriangle[corner]);
+                }
+            }
+            output.triangles.push_back(static_cast<uint8_t>(local[corner]));
+        }
+        ++current.triangleCount;
+    }
+
+    flush();
+}
+
+void MeshletBuilder::computeBounds(const std::vector<Vertex>& vertices, const SubmeshMeshlets& output, Meshlet& meshlet)
+{
+    const uint32_t* pVertexIndices = output.vertices.data() + meshlet.vertexOffset;
+    const uint8_t* pTriangles = output.triangles.data() + meshlet.triangleOffset;
+
+    // Sphere around the AABB centre: cheap and within a few percent of Ritter's for meshlet-sized clusters
+    glm::vec3 boundsMin(vertices[pVertexIndices[0]].pos);
+    glm::vec3 boundsMax = boundsMin;
+    for (uint32_t v = 1; v < meshlet.vertexCount; ++v)
+    {
+        boundsMin = glm::min(boundsMin, vertices[pVertexIndices[v]].pos);
+        boundsMax = glm::max(boundsMax, vertices[pVertexIndices[v]].pos);
+    }
+    meshlet.center = (boundsMin + boundsMax) * 0.5f;
+
+    float radiusSquared = 0.0f;
+    for (uint32_t v = 0; v < meshlet.vertexCount; ++v)
+    {
+        glm::vec3 offset = vertices[pVertexIndices[v]].pos - meshlet.center;
+        radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+    }
+    meshlet.radius = std::sqrt(radiusSquared);
+
+    // Normal cone around the average face normal
+    glm::vec3 normals[MaxMeshletTriangles];
+    glm::vec3 corners[MaxMeshletTriangles];
+    uint32_t faceCount = 0;
+    glm::vec3 normalSum(0.0f);
+
+    for (uint32_t t = 0; t < meshlet.triangleCount; ++t)
+    {
+        const glm::vec3& p0 = vertices[pVertexIndices[pTriangles[t * 3 + 0]]].pos;
+        const glm::vec3& p1 = vertices[pVertexIndices[pTriangles[t * 3 + 1]]].pos;
+        const glm::vec3& p2 = vertices[pVertexIndices[pTriangles[t * 3 + 2]]].pos;
+
+        glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+        float length = glm::length(normal);
+        if (length == 0.0f)
+        {
+            continue; // Degenerate triangles are never visible, so they do not constrain the cone
+        }
+
+        normals[faceCount] = normal / length;
+        corners[faceCount] = p0;
+        normalSum += normals[faceCount];
+        ++faceCount;
+    }
+
+    meshlet.coneApex = meshlet.center;
+    meshlet.coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+    meshlet.coneCutoff = 1.0f;
+
+    float axisLength = glm::length(normalSum);
+    if (faceCount == 0 || axisLength == 0.0f)
+    {
+        return;
+    }
+    glm::vec3 axis = normalSum / axisLength;
+
+    float minDot = 1.0f;
+    for (uint32_t f = 0; f < faceCount; ++f)
+    {
+        minDot = std::min(minDot, glm::dot(axis, normals[f]));
+    }
+
+    // Cones wider than ~84 degrees reject too little to be worth testing
+    if (minDot <= 0.1f)
+    {
+        return;
+    }
+
+    // Move the apex back along the axis until every triangle plane lies in front of it
+    float maxDistance = 0.0f;
+    for (uint32_t f = 0; f < faceCount; ++f)
+    {
+        float distance = glm::dot(meshlet.center - corners[f], normals[f]) / glm::dot(axis, normals[f]);
+        maxDistance = std::max(maxDistance, distance);
+    }
+
+    meshlet.coneApex = meshlet.center - axis * maxDistance;
+    meshlet.coneAxis = axis;
+    meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+}
+
+bool MeshletBuilder::validate(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const std::vector<Submesh>& submeshes,
+                              const std::vector<Meshlet>& meshlets, const std::vector<uint32_t>& meshletVertices,
+                              const std::vector<uint8_t>& meshletTriangles) const
+{
+    for (size_t s = 0; s < submeshes.size(); ++s)
+    {
+        const Submesh& submesh = submeshes[s];
+        if (static_cast<size_t>(submesh.meshletOffset) + submesh.meshletCount > meshlets.size())
+        {
+            CAE_LOG_ERROR(Asset, "Meshlets: submesh " << s << " meshlet range out of bounds");
+            return false;
+        }
+
+        std::vector<Triangle> expected;
+        expected.reserve(submesh.indexCount / 3);
+        for (uint32_t i = 0; i + 2 < submesh.indexCount; i += 3)
+        {
+            const uint32_t* pTriangle = indices.data() + submesh.indexStart + i;
+            expected.push_back(canonicalTriangle(pTriangle[0], pTriangle[1], pTriangle[2]));
+        }
+
+        std::vector<Triangle> actual;
+        actual.reserve(expected.size());
+        for (uint32_t m = submesh.meshletOffset; m < submesh.meshletOffset + submesh.meshletCount; ++m)
+        {
+            const Meshlet& meshlet = meshlets[m];
+            if (meshlet.vertexCount > m_Settings.maxVertices || meshlet.triangleCount > m_Settings.maxTriangles || meshlet.triangleCount == 0)
+            {
+                CAE_LOG_ERROR(Asset, "Meshlets: meshlet " << m << " has " << meshlet.vertexCount << " vertices and "
+                    << meshlet.triangleCount << " triangles, limits are " << m_Settings.maxVertices << " and " << m_Settings.maxTriangles);
+                return false;
+            }
+            if (static_cast<size_t>(meshlet.vertexOffset) + meshlet.vertexCount > meshletVertices.size()
+                || static_cast<size_t>(meshlet.triangleOffset) + meshlet.triangleCount * 3 > meshletTriangles.size())
+            {
+                CAE_LOG_ERROR(Asset, "Meshlets: meshlet " << m << " range out of bounds");
+                return false;
+            }
+
+            for (uint32_t t = 0; t < meshlet.triangleCount; ++t)
+            {
+                uint32_t corners[3];
+                for (uint32_t c = 0; c < 3; ++c)
+                {
+                    const uint8_t local = meshletTriangles[meshlet.triangleOffset + t * 3 + c];
+                    if (local >= meshlet.vertexCount)
+                    {
+                        CAE_LOG_ERROR(Asset, "Meshlets: meshlet " << m << " references local vertex " << static_cast<uint32_t>(local)
+                            << " of " << meshlet.vertexCount);
+                        return false;
+                    }
+                    corners[c] = meshletVertices[meshlet.vertexOffset + local];
+                }
+
+                // The cone apex must lie behind every triangle the cone claims to cull
+                const glm::vec3& p0 = vertices[corners[0]].pos;
+                glm::vec3 normal = glm::cross(vertices[corners[1]].pos - p0, vertices[corners[2]].pos - p0);
+                float length = glm::length(normal);
+                if (meshlet.coneCutoff < 1.0f && length > 0.0f
+                    && glm::dot(meshlet.coneApex - p0, normal / length) > 1e-3f * (1.0f + meshlet.radius))
+                {
+                    CAE_LOG_ERROR(Asset, "Meshlets: meshlet " << m << " normal cone apex lies in front of a triangle");
+                    return false;
+                }
+
+                actual.push_back(canonicalTriangle(corners[0], corners[1], corners[2]));
+            }
+        }
+
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        if (expected != actual)
+        {
+            CAE_LOG_ERROR(Asset, "Meshlets: submesh " << s << " has " << expected.size() << " triangles, its meshlets "
+                << actual.size() << ", or the triangles differ");
+            return false;
+        }
+    }
+    return true;
+}
+
+void MeshletBuilder::runBenchmark(const std::string& folder)
+{
+    struct Scene
+    {
+        std::string name;
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<Submesh> submeshes;
+    };
+
+    std::vector<Scene> scenes(1);
+    scenes[0].name = "256x256 grid";
+    makeGrid(256, scenes[0].vertices, scenes[0].indices, scenes[0].submeshes);
+
+    for (const std::string& path : GltfImporter::findScenes(folder))
+    {
+        Scene scene;
+        scene.name = std::filesystem::path(path).filename().string();
+        std::vector<MaterialDesc> materials;
+        GltfImporter importer(path);
+        importer.import(scene.vertices, scene.indices, scene.submeshes, materials);
+        scenes.push_back(std::move(scene));
+    }
+
+    // The default limits, and small ones that flush on both the vertex and the triangle limit
+    Settings limits[2];
+    limits[1].maxVertices = 16;
+    limits[1].maxTriangles = 8;
+
+    CAE_LOG_INFO(Asset, "Meshlet benchmark: " << scenes.size() << " meshes");
+    for (Scene& scene : scenes)
+    {
+        for (const Settings& settings : limits)
+        {
+            std::vector<Meshlet> meshlets;
+            std::vector<uint32_t> meshletVertices;
+            std::vector<uint8_t> meshletTriangles;
+
+            MeshletBuilder builder(settings);
+            builder.build(scene.vertices, scene.indices, scene.submeshes, meshlets, meshletVertices, meshletTriangles);
+            // Building twice must not accumulate stats
+            builder.build(scene.vertices, scene.indices, scene.submeshes, meshlets, meshletVertices, meshletTriangles);
+            const bool valid = builder.validate(scene.vertices, scene.indices, scene.submeshes, meshlets, meshletVertices, meshletTriangles);
+
+            const Stats& stats = builder.getStats();
+            CAE_LOG_INFO(Asset, "  " << scene.name << " (" << settings.maxVertices << "/" << settings.maxTriangles << "): "
+                << stats.meshletCount << " meshlets, " << stats.averageVertices << " vertices and " << stats.averageTriangles
+                << " triangles on average, " << stats.getTrianglesPerSecond() / 1.0e6 << " M triangles/s, "
+                << (valid && stats.triangleCount == scene.indices.size() / 3 ? "valid" : "INVALID"));
+        }
+    }
+}
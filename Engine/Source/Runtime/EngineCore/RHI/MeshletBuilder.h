@@ -0,0 +1,88 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct Vertex;
+struct Submesh;
+
+// A small cluster of triangles with its own vertex list, sized for mesh shaders and
+// fine-grained culling. Triangle corners index into the meshlet's vertex list.
+struct Meshlet
+{
+    uint32_t vertexOffset;   // First entry in the meshlet vertex array (global vertex indices)
+    uint32_t triangleOffset; // First byte in the meshlet triangle array (3 local indices per triangle)
+    uint32_t vertexCount;
+    uint32_t triangleCount;
+
+    // Bounding sphere
+    glm::vec3 center;
+    float radius;
+
+    // Normal cone: every triangle is backfacing, and the meshlet can be skipped, when
+    // dot(normalize(coneApex - cameraPosition), coneAxis) >= coneCutoff. A cutoff of 1
+    // means the triangles face too many directions to cull this way.
+    glm::vec3 coneApex;
+    glm::vec3 coneAxis;
+    float coneCutoff;
+};
+
+class MeshletBuilder
+{
+public:
+    struct Settings
+    {
+        uint32_t maxVertices = 64;
+        uint32_t maxTriangles = 124;
+    };
+
+    struct Stats
+    {
+        size_t meshletCount = 0;
+        size_t triangleCount = 0;
+        double averageVertices = 0.0;
+        double averageTriangles = 0.0;
+        double seconds = 0.0;
+
+        double getTrianglesPerSecond() const { return seconds > 0.0 ? static_cast<double>(triangleCount) / seconds : 0.0; }
+    };
+
+    MeshletBuilder();
+    explicit MeshletBuilder(const Settings& settings);
+
+    // Splits every submesh into meshlets in index order, so run it after the vertex cache
+    // optimization to get spatially coherent clusters. Fills each submesh's meshlet range.
+    void build(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, std::vector<Submesh>& submeshes,
+               std::vector<Meshlet>& meshlets, std::vector<uint32_t>& meshletVertices, std::vector<uint8_t>& meshletTriangles);
+
+    const Stats& getStats() const { return m_Stats; }
+
+    // Checks the output of build(): every meshlet within the vertex and triangle limits, its ranges
+    // inside the shared arrays, and every input triangle in exactly one meshlet of its submesh with
+    // its winding kept. Logs the first problem found.
+    bool validate(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const std::vector<Submesh>& submeshes,
+                  const std::vector<Meshlet>& meshlets, const std::vector<uint32_t>& meshletVertices,
+                  const std::vector<uint8_t>& meshletTriangles) const;
+
+    // Builds and validates meshlets for a generated grid and every .gltf/.glb in folder, logging
+    // triangles/s and the average meshlet fill
+    static void runBenchmark(const std::string& folder);
+
+private:
+    struct SubmeshMeshlets
+    {
+        std::vector<Meshlet> meshlets;
+        std::vector<uint32_t> vertices;
+        std::vector<uint8_t> triangles;
+    };
+
+    void buildSubmesh(const std::vector<Vertex>& vertices, const uint32_t* pIndices, size_t indexCount, SubmeshMeshlets& output) const;
+    static void computeBounds(const std::vector<Vertex>& vertices, const SubmeshMeshlets& output, Meshlet& meshlet);
+
+    Settings m_Settings;
+    Stats m_Stats;
+};
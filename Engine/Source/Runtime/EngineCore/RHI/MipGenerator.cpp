@@ -0,0 +1,136 @@
+#include "MipGenerator.h"
+
+#include "Runtime/EngineCore/Core/ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    constexpr uint32_t RowsPerTask = 64;
+    constexpr size_t ParallelTexelThreshold = 256 * 1024;
+    constexpr size_t LinearToSrgbTableSize = 65536;
+    constexpr VkDeviceSize LevelAlignment = 4;
+
+    struct SrgbTables
+    {
+        float toLinear[256];
+        uint8_t fromLinear[LinearToSrgbTableSize];
+
+        SrgbTables()
+        {
+            for (int i = 0; i < 256; ++i)
+            {
+                float c = i / 255.0f;
+                toLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            for (size_t i = 0; i < LinearToSrgbTableSize; ++i)
+            {
+                float l = static_cast<float>(i) / (LinearToSrgbTableSize - 1);
+                float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+                fromLinear[i] = static_cast<uint8_t>(std::clamp(c * 255.0f + 0.5f, 0.0f, 255.0f));
+            }
+        }
+    };
+
+    const SrgbTables& getSrgbTables()
+    {
+        static const SrgbTables tables;
+        return tables;
+    }
+}
+
+uint32_t MipGenerator::getMipCount(uint32_t width, uint32_t height)
+{
+    uint32_t levels = 1;
+    for (uint32_t size = std::max(width, height); size > 1; size >>= 1)
+    {
+        ++levels;
+    }
+    return levels;
+}
+
+void MipGenerator::generate(const uint8_t* pPixels, uint32_t width, uint32_t height, uint32_t channels, bool srgb,
+                            std::vector<uint8_t>& output, std::vector<MipLevel>& levels, bool parallel)
+{
+    const uint32_t mipCount = getMipCount(width, height);
+
+    levels.clear();
+    levels.reserve(mipCount);
+    VkDeviceSize totalSize = 0;
+    for (uint32_t mip = 0, w = width, h = height; mip < mipCount; ++mip)
+    {
+        MipLevel level;
+        level.offset = totalSize;
+        level.size = static_cast<VkDeviceSize>(w) * h * channels;
+        level.width = w;
+        level.height = h;
+        levels.push_back(level);
+
+        // Buffer-to-image copies need 4-byte aligned offsets, which 1- and 2-channel levels may not land on
+        totalSize = (totalSize + level.size + LevelAlignment - 1) & ~(LevelAlignment - 1);
+        w = std::max(1u, w / 2);
+        h = std::max(1u, h / 2);
+    }
+
+    output.resize(static_cast<size_t>(totalSize));
+    memcpy(output.data(), pPixels, static_cast<size_t>(levels[0].size));
+
+    for (uint32_t mip = 1; mip < mipCount; ++mip)
+    {
+        const MipLevel& source = levels[mip - 1];
+        const MipLevel& level = levels[mip];
+        downsample(output.data() + source.offset, source.width, source.height,
+                   output.data() + level.offset, level.width, level.height, channels, srgb, parallel);
+    }
+}
+
+void MipGenerator::downsample(const uint8_t* pSource, uint32_t sourceWidth, uint32_t sourceHeight,
+                              uint8_t* pDestination, uint32_t width, uint32_t height, uint32_t channels,
+                              bool srgb, bool parallel)
+{
+    const SrgbTables* pTables = srgb ? &getSrgbTables() : nullptr;
+    const uint32_t colorChannels = srgb ? std::min(channels, 3u) : 0;
+
+    // Odd source sizes clamp the second tap to the last row/column
+    auto filterRows = [&](uint32_t rowBegin, uint32_t rowEnd)
+    {
+        for (uint32_t y = rowBegin; y < rowEnd; ++y)
+        {
+            const uint8_t* pRow0 = pSource + static_cast<size_t>(std::min(y * 2, sourceHeight - 1)) * sourceWidth * channels;
+            const uint8_t* pRow1 = pSource + static_cast<size_t>(std::min(y * 2 + 1, sourceHeight - 1)) * sourceWidth * channels;
+            uint8_t* pOut = pDestination + static_cast<size_t>(y) * width * channels;
+
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                const uint32_t x0 = std::min(x * 2, sourceWidth - 1) * channels;
+                const uint32_t x1 = std::min(x * 2 + 1, sourceWidth - 1) * channels;
+
+                for (uint32_t c = 0; c < colorChannels; ++c)
+                {
+                    float linear = (pTables->toLinear[pRow0[x0 + c]] + pTables->toLinear[pRow0[x1 + c]] +
+                                    pTables->toLinear[pRow1[x0 + c]] + pTables->toLinear[pRow1[x1 + c]]) * 0.25f;
+                    pOut[x * channels + c] = pTables->fromLinear[static_cast<size_t>(linear * (LinearToSrgbTableSize - 1) + 0.5f)];
+                }
+                for (uint32_t c = colorChannels; c < channels; ++c)
+                {
+                    pOut[x * channels + c] = static_cast<uint8_t>((pRow0[x0 + c] + pRow0[x1 + c] + pRow1[x0 + c] + pRow1[x1 + c] + 2) / 4);
+                }
+            }
+        }
+    };
+
+    if (!parallel || static_cast<size_t>(width) * height < ParallelTexelThreshold)
+    {
+        filterRows(0, height);
+        return;
+    }
+
+    const size_t taskCount = (height + RowsPerTask - 1) / RowsPerTask;
+    parallelFor(taskCount, [&](size_t task)
+    {
+        const uint32_t rowBegin = static_cast<uint32_t>(task) * RowsPerTask;
+        filterRows(rowBegin, std::min(rowBegin + RowsPerTask, height));
+    });
+}
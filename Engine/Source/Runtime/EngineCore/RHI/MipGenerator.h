@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One level of a mip chain packed into a single byte array
+struct MipLevel
+{
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+//
+// Builds full 8-bit mip chains (1 to 4 channels per texel) on the CPU with a 2x2 box filter, down
+// to 1x1. For sRGB data the first three channels are averaged in linear space through lookup
+// tables, so minified textures keep their brightness instead of darkening; a fourth (alpha) channel
+// is always averaged linearly. Rows of large levels are filtered in parallel.
+//
+class MipGenerator
+{
+public:
+    static uint32_t getMipCount(uint32_t width, uint32_t height);
+
+    // Writes level 0 (a copy of pPixels) followed by every smaller level into output.
+    // Callers already running on a worker thread pass parallel = false.
+    static void generate(const uint8_t* pPixels, uint32_t width, uint32_t height, uint32_t channels, bool srgb,
+                         std::vector<uint8_t>& output, std::vector<MipLevel>& levels, bool parallel = true);
+
+private:
+    static void downsample(const uint8_t* pSource, uint32_t sourceWidth, uint32_t sourceHeight,
+                           uint8_t* pDestination, uint32_t width, uint32_t height, uint32_t channels,
+                           bool srgb, bool parallel);
+};
@@ -1,12 +1,40 @@
 #include "Model.h"
 
-#include <glm/gtx/matrix_decompose.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cfloat>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+#include "GltfImporter.h"
 #include "PhysicalDevice.h"
-
-Model::Model(VmaAllocator allocator, Device* device, PhysicalDevice* pPhysicalDevice, CommandPool* commandPool, const std::string& modelPath)
-    : m_Allocator(allocator), m_pDevice(device), m_pPhysicalDevice(pPhysicalDevice), m_pCommandPool(commandPool), m_ModelPath(modelPath),
-    m_pVertexBuffer(nullptr), m_pIndexBuffer(nullptr)
+#include "TransferQueue.h"
+#include "Runtime/EngineCore/Core/ParallelFor.h"
+#include "Runtime/EngineCore/Core/Log.h"
+
+Model::Model(VmaAllocator allocator, Device* device, PhysicalDevice* pPhysicalDevice, CommandPool* commandPool, const std::string& modelPath,
+             const ModelSettings& settings, TextureCache* pTextureCache, SamplerCache* pSamplerCache, StagingRing* pStagingRing,
+             TransferQueue* pTransferQueue)
+    : m_Allocator(allocator), m_pDevice(device), m_pPhysicalDevice(pPhysicalDevice), m_pCommandPool(commandPool), m_pTextureCache(pTextureCache),
+    m_pSamplerCache(pSamplerCache), m_pStagingRing(pStagingRing), m_pTransferQueue(pTransferQueue), m_ModelPath(modelPath), m_Settings(settings), m_pVertexBuffer(nullptr), m_pIndexBuffer(nullptr), m_pDepthVertexBuffer(nullptr)
 {
+    if (!m_pStagingRing && !m_pTransferQueue)
+    {
+        throw std::runtime_error("Model: a staging ring or a transfer queue is required for " + m_ModelPath);
+    }
+    if (!m_pTextureCache)
+    {
+        m_pOwnedTextureCache = std::make_unique<TextureCache>(m_pDevice, m_Allocator, m_pCommandPool, m_pPhysicalDevice->get(),
+            TextureCache::Settings{}, m_pStagingRing, m_pTransferQueue);
+        m_pTextureCache = m_pOwnedTextureCache.get();
+    }
+    if (!m_pSamplerCache)
+    {
+        m_pOwnedSamplerCache = std::make_unique<SamplerCache>(m_pDevice, m_pPhysicalDevice->get());
+        m_pSamplerCache = m_pOwnedSamplerCache.get();
+    }
     //spdlog::debug("Model created with path: {}", m_ModelPath);
 }
 
@@ -14,6 +42,11 @@ Model::~Model()
 {
     delete m_pVertexBuffer;
     delete m_pIndexBuffer;
+    delete m_pDepthVertexBuffer;
+    if (m_pGeometryPool)
+    {
+        m_pGeometryPool->free(m_PoolAllocation);
+    }
 
     for (Material* material : m_Materials)
     {
@@ -24,337 +57,599 @@ Model::~Model()
 
 void Model::loadModel()
 {
+    m_Vertices.clear();
+    m_CompactVertices.clear();
+    m_Indices.clear();
+    m_ShortIndices.clear();
+    m_DepthVertices.clear();
+    m_Submeshes.clear();
+    m_Lods.clear();
+    m_Meshlets.clear();
+    m_MeshletVertices.clear();
+    m_MeshletTriangles.clear();
+    m_MaterialDescs.clear();
+    m_CookedMesh.close();
+    for (Material* material : m_Materials)
+    {
+        delete material;
+    }
+    m_Materials.clear();
+
     m_BoundingBoxMin = glm::vec3(FLT_MAX);
     m_BoundingBoxMax = glm::vec3(-FLT_MAX);
 
-   // spdlog::debug("Loading model from path: {}", m_ModelPath);
-  //  Assimp::Importer importer;
+    size_t lastSlash = m_ModelPath.find_last_of("/\\");
+    m_Directory = (lastSlash == std::string::npos) ? "." : m_ModelPath.substr(0, lastSlash);
 
-  /*  const aiScene* scene = importer.ReadFile(m_ModelPath, aiProcess_Triangulate |
-        aiProcess_CalcTangentSpace |
-        aiProcess_GenSmoothNormals |
-        aiProcess_FlipUVs |
-        aiProcess_JoinIdenticalVertices |
-        aiProcess_LimitBoneWeights |
-        aiProcess_OptimizeMeshes |
-        aiProcess_SortByPType);
+    std::string extension = m_ModelPath.substr(m_ModelPath.find_last_of('.') + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (extension == "cmesh")
+    {
+        loadCooked();
+    }
+    else if (extension == "gltf" || extension == "glb")
+    {
+        importSource();
+    }
+    else
+    {
+        throw std::runtime_error("Unsupported model format: " + m_ModelPath);
+    }
 
-    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
+    // Every material texture is requested at once so cache misses decode in parallel; the results
+    // are staged together and uploaded with a single submit
+    std::vector<TextureCache::Request> textureRequests;
+    textureRequests.reserve(m_MaterialDescs.size() * 3);
+    for (const MaterialDesc& desc : m_MaterialDescs)
     {
-        spdlog::error("Assimp Error: {}", importer.GetErrorString());
-        throw std::runtime_error("Failed to load model");
+        appendTextureRequests(desc, textureRequests);
     }
 
-    m_Vertices.clear();
-    m_Indices.clear();
-    m_Submeshes.clear();
-    m_Materials.clear();
+    std::vector<Texture*> textures;
+    m_pTextureCache->beginBatch();
+    m_pTextureCache->acquire(textureRequests, textures);
+    m_pTextureCache->endBatch();
+    for (const Texture* pTexture : textures)
+    {
+        m_UploadTicket = std::max(m_UploadTicket, pTexture->getUploadTicket());
+    }
 
-    std::unordered_map<Vertex, uint32_t> uniqueVertices{};
+    for (size_t i = 0; i < m_MaterialDescs.size(); ++i)
+    {
+        m_Materials.push_back(createMaterial(m_MaterialDescs[i], &textures[i * 3]));
+    }
 
-    m_Directory = m_ModelPath.substr(0, m_ModelPath.find_last_of('/'));
+    const TextureCache::Stats textureStats = m_pTextureCache->getStats();
+    CAE_LOG_DEBUG(Asset, "Texture cache: " << textureStats.requests << " requests, " << textureStats.loads << " loads, "
+        << textureStats.hits << " hits, " << textureStats.liveTextures << " live textures ("
+        << textureStats.residentBytes / 1024 << " KB resident, " << textureStats.bytesSaved / 1024 << " KB saved, "
+        << textureStats.decodeMs << " ms decoding)");
+}
 
-    processNode(scene->mRootNode, scene, uniqueVertices, glm::mat4(1.0f));
+void Model::importSource()
+{
+    GltfImporter importer(m_ModelPath);
+    importer.import(m_Vertices, m_Indices, m_Submeshes, m_MaterialDescs);
 
+    const bool compactVertices = m_Settings.vertexFormat != VertexFormat::Standard;
 
-    spdlog::debug("Loaded model with {} vertices, {} indices, and {} materials.", m_Vertices.size(), m_Indices.size(), m_Materials.size());*/
-}
+    VertexWelder::Stats weldStats{};
+    if (m_Settings.weldVertices)
+    {
+        VertexWelder::Settings weldSettings = m_Settings.weld;
+        if (compactVertices)
+        {
+            weldSettings.mode = VertexWelder::Mode::PerSubmesh;
+        }
 
-void Model::createVertexBuffer()
-{
-   // spdlog::debug("Creating vertex buffer");
-    VkDeviceSize bufferSize = sizeof(m_Vertices[0]) * m_Vertices.size();
+        VertexWelder welder(weldSettings);
+        welder.weld(m_Vertices, m_Indices, m_Submeshes);
+        weldStats = welder.getStats();
+    }
 
-    Buffer stagingBuffer(
-        m_Allocator,
-        bufferSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VMA_MEMORY_USAGE_CPU_ONLY,
-        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT
-    );
+    MeshOptimizer::Stats optimizerStats{};
+    if (m_Settings.optimizeMesh)
+    {
+        MeshOptimizer optimizer(m_Settings.optimizer);
+        optimizer.optimize(m_Vertices, m_Indices, m_Submeshes);
+        optimizerStats = optimizer.getStats();
+    }
 
-    void* data = stagingBuffer.map();
-    memcpy(data, m_Vertices.data(), static_cast<size_t>(bufferSize));
-    stagingBuffer.unmap();
-    stagingBuffer.flush();
+    MeshSimplifier::Stats lodStats{};
+    if (m_Settings.generateLods)
+    {
+        MeshSimplifier simplifier(m_Settings.lods);
+        simplifier.generateLods(m_Vertices, m_Indices, m_Submeshes, m_Lods);
+        lodStats = simplifier.getStats();
 
-    m_pVertexBuffer = new Buffer(
-        m_Allocator,
-        bufferSize,
-        VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-        VMA_MEMORY_USAGE_GPU_ONLY
-    );
+        if (m_Settings.optimizeMesh)
+        {
+            // Cache-optimize the new LOD ranges in place; the vertex order stays driven by LOD 0
+            std::vector<Submesh> lodRanges;
+            for (const Submesh& submesh : m_Submeshes)
+            {
+                for (uint32_t level = 1; level < submesh.lodCount; ++level)
+                {
+                    Submesh range = submesh;
+                    range.indexStart = m_Lods[submesh.lodOffset + level].indexStart;
+                    range.indexCount = m_Lods[submesh.lodOffset + level].indexCount;
+                    lodRanges.push_back(range);
+                }
+            }
+
+            MeshOptimizer::Settings lodOptimizerSettings = m_Settings.optimizer;
+            lodOptimizerSettings.optimizeVertexFetch = false;
+            MeshOptimizer lodOptimizer(lodOptimizerSettings);
+            lodOptimizer.optimize(m_Vertices, m_Indices, lodRanges);
+        }
+    }
 
-    stagingBuffer.copyTo(m_pCommandPool, m_pDevice->getGraphicsQueue(), m_pVertexBuffer);
+    MeshletBuilder::Stats meshletStats{};
+    if (m_Settings.buildMeshlets)
+    {
+        MeshletBuilder meshletBuilder(m_Settings.meshlets);
+        meshletBuilder.build(m_Vertices, m_Indices, m_Submeshes, m_Meshlets, m_MeshletVertices, m_MeshletTriangles);
+        meshletStats = meshletBuilder.getStats();
+    }
 
-   // spdlog::debug("Vertex buffer created with size: {}", bufferSize);
-}
+    CompactVertexEncoder::ErrorReport compactErrors{};
+    if (compactVertices)
+    {
+        CompactVertexEncoder encoder(m_Settings.vertexFormat);
+        encoder.encode(m_Vertices, m_Indices, m_Submeshes, m_CompactVertices);
+        compactErrors = encoder.getErrorReport();
+    }
 
-void Model::createIndexBuffer()
-{
-   // spdlog::debug("Creating index buffer");
-    VkDeviceSize bufferSize = sizeof(m_Indices[0]) * m_Indices.size();
+    if (m_Settings.allowShortIndices)
+    {
+        packShortIndices();
+    }
 
-    Buffer stagingBuffer(
-        m_Allocator,
-        bufferSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VMA_MEMORY_USAGE_CPU_ONLY,
-        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT
-    );
+    DepthVertexStream::build(m_Settings.vertexFormat, m_Settings.depthStream, m_Vertices, m_CompactVertices, m_DepthVertices);
 
-    void* data = stagingBuffer.map();
-    memcpy(data, m_Indices.data(), static_cast<size_t>(bufferSize));
-    stagingBuffer.unmap();
-    stagingBuffer.flush();
+    for (const Submesh& submesh : m_Submeshes)
+    {
+        m_BoundingBoxMin = glm::min(m_BoundingBoxMin, submesh.bboxMin);
+        m_BoundingBoxMax = glm::max(m_BoundingBoxMax, submesh.bboxMax);
+    }
 
-    m_pIndexBuffer = new Buffer(
-        m_Allocator,
-        bufferSize,
-        VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-        VMA_MEMORY_USAGE_GPU_ONLY
-    );
+    const GltfImporter::Stats& stats = importer.getStats();
+    CAE_LOG_INFO(Asset, "Loaded model " << m_ModelPath << ": " << m_Vertices.size() << " vertices, " << m_Indices.size()
+        << (m_ShortIndices.empty() ? " 32-bit" : " 16-bit") << " indices, " << m_Submeshes.size() << " submeshes, " << m_MaterialDescs.size() << " materials");
+    CAE_LOG_DEBUG(Asset, "  Import: " << stats.getTotalSeconds() * 1000.0 << " ms (parse " << stats.parseSeconds * 1000.0
+        << " ms, decode " << stats.decodeSeconds * 1000.0 << " ms), " << stats.getMegabytesPerSecond() << " MB/s, "
+        << stats.getVerticesPerSecond() << " vertices/s");
+    if (m_Settings.weldVertices)
+    {
+        CAE_LOG_DEBUG(Asset, "  Weld: " << weldStats.inputVertexCount << " -> " << weldStats.outputVertexCount << " vertices in "
+            << weldStats.seconds * 1000.0 << " ms");
+    }
+    if (m_Settings.optimizeMesh)
+    {
+        CAE_LOG_DEBUG(Asset, "  Optimize: ACMR " << optimizerStats.before.acmr << " -> " << optimizerStats.after.acmr
+            << ", ATVR " << optimizerStats.before.atvr << " -> " << optimizerStats.after.atvr << " in "
+            << optimizerStats.seconds * 1000.0 << " ms");
+    }
+    if (m_Settings.generateLods)
+    {
+        CAE_LOG_DEBUG(Asset, "  LODs: " << lodStats.lodCount << " generated, " << lodStats.sourceTriangles << " source triangles, "
+            << lodStats.lodTriangles << " LOD triangles in " << lodStats.seconds * 1000.0 << " ms");
+    }
+    if (m_Settings.buildMeshlets)
+    {
+        CAE_LOG_DEBUG(Asset, "  Meshlets: " << meshletStats.meshletCount << " (avg " << meshletStats.averageVertices << " vertices, "
+            << meshletStats.averageTriangles << " triangles) in " << meshletStats.seconds * 1000.0 << " ms, "
+            << meshletStats.getTrianglesPerSecond() << " triangles/s");
+    }
+    if (compactVertices)
+    {
+        CAE_LOG_DEBUG(Asset, "  Compact vertices: " << sizeof(Vertex) << " -> " << sizeof(CompactVertex) << " bytes, position error max "
+            << compactErrors.maxPositionError << " mean " << compactErrors.meanPositionError << ", normal error max "
+            << compactErrors.maxNormalErrorDegrees << " deg mean " << compactErrors.meanNormalErrorDegrees
+            << " deg, tangent max " << compactErrors.maxTangentErrorDegrees << " deg, bitangent max "
+            << compactErrors.maxBitangentErrorDegrees << " deg, uv max " << compactErrors.maxTexCoordError);
+    }
+    if (m_Settings.depthStream != DepthStream::None)
+    {
+        CAE_LOG_DEBUG(Asset, "  Depth stream: " << DepthVertexStream::getStride(m_Settings.vertexFormat, m_Settings.depthStream)
+            << " bytes per vertex, " << m_DepthVertices.size() << " bytes");
+    }
+}
 
-    stagingBuffer.copyTo(m_pCommandPool, m_pDevice->getGraphicsQueue(), m_pIndexBuffer);
+void Model::loadCooked()
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // Geometry stays in the mapping and is uploaded from there; only the small tables are copied
+    m_CookedMesh.open(m_ModelPath);
+    // The cooked blob was processed with its own settings; its vertex format and depth stream win
+    m_Settings.vertexFormat = m_CookedMesh.getVertexFormat();
+    m_Settings.depthStream = m_CookedMesh.getDepthStream();
+    m_CookedMesh.readSubmeshes(m_Submeshes);
+    m_CookedMesh.readLods(m_Lods);
+    m_CookedMesh.readMeshlets(m_Meshlets, m_MeshletVertices, m_MeshletTriangles);
+    m_CookedMesh.readMaterials(m_MaterialDescs);
+    m_BoundingBoxMin = m_CookedMesh.getBoundsMin();
+    m_BoundingBoxMax = m_CookedMesh.getBoundsMax();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    CAE_LOG_INFO(Asset, "Loaded cooked model " << m_ModelPath << ": " << m_CookedMesh.getVertexCount() << " vertices, "
+        << m_CookedMesh.getIndexCount() << " indices, " << m_Submeshes.size() << " submeshes, " << m_MaterialDescs.size()
+        << " materials in " << seconds * 1000.0 << " ms");
+}
 
-    //spdlog::debug("Index buffer created with size: {}", bufferSize);
-    //spdlog::debug("Index buffer created successfully");
+void Model::cook(const std::string& cookedPath) const
+{
+    auto start = std::chrono::steady_clock::now();
+
+    CookedMesh::Contents contents;
+    contents.vertexFormat = m_Settings.vertexFormat;
+    VkDeviceSize vertexDataSize = 0;
+    contents.pVertices = getVertexData(vertexDataSize);
+    contents.vertexCount = static_cast<size_t>(vertexDataSize) / CookedMesh::getVertexStride(m_Settings.vertexFormat);
+    contents.pIndices = getIndexData(contents.indexCount, contents.indexType);
+    contents.depthStream = m_Settings.depthStream;
+    VkDeviceSize depthVertexDataSize = 0;
+    contents.pDepthVertices = getDepthVertexData(depthVertexDataSize);
+    contents.depthVertexDataSize = static_cast<size_t>(depthVertexDataSize);
+    contents.pSubmeshes = &m_Submeshes;
+    contents.pLods = &m_Lods;
+    contents.pMeshlets = &m_Meshlets;
+    contents.pMeshletVertices = &m_MeshletVertices;
+    contents.pMeshletTriangles = &m_MeshletTriangles;
+    contents.pMaterials = &m_MaterialDescs;
+    contents.bboxMin = m_BoundingBoxMin;
+    contents.bboxMax = m_BoundingBoxMax;
+    CookedMesh::cook(cookedPath, contents);
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    CAE_LOG_INFO(Asset, "Cooked " << m_ModelPath << " -> " << cookedPath << " in " << seconds * 1000.0 << " ms");
 }
 
-/*
-void Model::processNode(aiNode* node, const aiScene* scene, std::unordered_map<Vertex, uint32_t>& uniqueVertices, glm::mat4 parentTransform)
+void Model::cookTextures() const
 {
-    // Convert Assimp's aiMatrix4x4 to glm::mat4
-    aiMatrix4x4 nodeTransformation = node->mTransformation;
-    glm::mat4 nodeTransform = glm::transpose(glm::make_mat4(&nodeTransformation.a1));
+    auto cookTexture = [this](const std::string& path, TextureCompressor::Usage usage)
+    {
+        if (path.empty() || Texture::isCompressedPath(path))
+        {
+            return;
+        }
 
-    // Compute the current transformation by combining with the parent
-    glm::mat4 currentTransform = parentTransform * nodeTransform;
+        const std::string cookedPath = TextureCompressor::getCookedPath(path);
+        std::error_code error;
+        if (std::filesystem::exists(cookedPath, error) &&
+            std::filesystem::last_write_time(cookedPath, error) >= std::filesystem::last_write_time(path, error))
+        {
+            return;
+        }
+        TextureCompressor::cook(path, cookedPath, usage, m_Settings.textureCompression);
+    };
 
-    // Process all the node's meshes
-    for (unsigned int i = 0; i < node->mNumMeshes; i++)
+    for (const MaterialDesc& desc : m_MaterialDescs)
     {
-        aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-        processMesh(mesh, scene, uniqueVertices, currentTransform);
+        cookTexture(desc.diffusePath, TextureCompressor::Usage::Albedo);
+        cookTexture(desc.normalPath, TextureCompressor::Usage::Normal);
+        cookTexture(desc.metallicRoughnessPath, TextureCompressor::Usage::MetallicRoughness);
     }
+}
 
-    // Recursively process each of the children nodes
-    for (unsigned int i = 0; i < node->mNumChildren; i++)
+const void* Model::getVertexData(VkDeviceSize& size) const
+{
+    if (m_CookedMesh.isOpen())
     {
-        processNode(node->mChildren[i], scene, uniqueVertices, currentTransform);
+        size = m_CookedMesh.getVertexDataSize();
+        return m_CookedMesh.getVertexData();
     }
+    if (m_Settings.vertexFormat != VertexFormat::Standard)
+    {
+        size = sizeof(CompactVertex) * m_CompactVertices.size();
+        return m_CompactVertices.data();
+    }
+    size = sizeof(Vertex) * m_Vertices.size();
+    return m_Vertices.data();
 }
 
-void Model::processMesh(aiMesh* mesh, const aiScene* scene, std::unordered_map<Vertex, uint32_t>& uniqueVertices, glm::mat4 transform)
+const void* Model::getDepthVertexData(VkDeviceSize& size) const
 {
-    Submesh submesh{};
-    glm::vec3 bboxMin(FLT_MAX);
-    glm::vec3 bboxMax(-FLT_MAX);
-
-    submesh.indexStart = static_cast<uint32_t>(m_Indices.size());
+    if (m_CookedMesh.isOpen())
+    {
+        size = m_CookedMesh.getDepthVertexDataSize();
+        return m_CookedMesh.getDepthVertexData();
+    }
+    size = m_DepthVertices.size();
+    return m_DepthVertices.data();
+}
 
-    // Process vertices
-    for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+const void* Model::getIndexData(size_t& count, VkIndexType& indexType) const
+{
+    if (m_CookedMesh.isOpen())
     {
-        Vertex vertex{};
+        count = m_CookedMesh.getIndexCount();
+        indexType = m_CookedMesh.getIndexType();
+        return m_CookedMesh.getIndexData();
+    }
+    count = m_Indices.size();
+    if (!m_ShortIndices.empty())
+    {
+        indexType = VK_INDEX_TYPE_UINT16;
+        return m_ShortIndices.data();
+    }
+    indexType = VK_INDEX_TYPE_UINT32;
+    return m_Indices.data();
+}
 
-        // Apply the transformation to the vertex position
-        glm::vec4 pos(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z, 1.0f);
-        pos = transform * pos;
-        vertex.pos = glm::vec3(pos);
+void Model::packShortIndices()
+{
+    m_ShortIndices.clear();
+    if (m_Indices.empty())
+    {
+        return;
+    }
 
-        bboxMin = glm::min(bboxMin, vertex.pos);
-        bboxMax = glm::max(bboxMax, vertex.pos);
+    constexpr uint32_t MaxShortVertexRange = 1u << 16;
+    const bool fitsWithoutRebasing = m_Vertices.size() <= MaxShortVertexRange;
 
-        if (mesh->HasNormals())
+    // Every index range drawn for a submesh: its LODs (LOD 0 included), or just its own range
+    auto forEachRange = [&](const Submesh& submesh, auto&& func)
+    {
+        if (submesh.lodCount == 0)
         {
-            // Transform the normal
-            glm::vec4 normal(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z, 0.0f);
-            normal = transform * normal;
-            vertex.normal = glm::normalize(glm::vec3(normal));
+            func(submesh.indexStart, submesh.indexCount);
+            return;
         }
-
-        if (mesh->mTextureCoords[0])
+        for (uint32_t level = 0; level < submesh.lodCount; ++level)
         {
-            vertex.texCoord = glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
+            const MeshLod& lod = m_Lods[submesh.lodOffset + level];
+            func(lod.indexStart, lod.indexCount);
         }
+    };
 
-        if (mesh->HasTangentsAndBitangents())
+    std::vector<uint32_t> baseVertices(m_Submeshes.size(), 0);
+    if (!fitsWithoutRebasing)
+    {
+        for (size_t i = 0; i < m_Submeshes.size(); ++i)
         {
-            // Transform tangent
-            glm::vec4 tangent_h(mesh->mTangents[i].x, mesh->mTangents[i].y, mesh->mTangents[i].z, 0.0f);
-            tangent_h = transform * tangent_h;
-            vertex.tangent = glm::normalize(glm::vec3(tangent_h));
-
-            // Transform bitangent (initial)
-            glm::vec4 bitangent_h(mesh->mBitangents[i].x, mesh->mBitangents[i].y, mesh->mBitangents[i].z, 0.0f);
-            bitangent_h = transform * bitangent_h;
-            // vertex.bitangent will be recomputed from normal and tangent later.
-
-            // Re-orthogonalize tangent with respect to the transformed normal (vertex.normal)
-            if (mesh->HasNormals()) // Should be true if tangents are present
+            uint32_t minVertex = UINT32_MAX;
+            uint32_t maxVertex = 0;
+            forEachRange(m_Submeshes[i], [&](uint32_t indexStart, uint32_t indexCount)
             {
-                vertex.tangent = glm::normalize(vertex.tangent - vertex.normal * glm::dot(vertex.normal, vertex.tangent));
-                // Recompute bitangent to ensure consistency and correct handedness
-                vertex.bitangent = glm::normalize(glm::cross(vertex.normal, vertex.tangent));
-            }
-            // If somehow no normals but tangents exist, the above might need adjustment or indicates an issue.
-            // aiProcess_CalcTangentSpace usually ensures normals are present with tangents.
-        }
-        // Ensure tangent/bitangent are initialized otherwise, if Vertex struct doesn't default them. Assuming it does.
+                for (uint32_t j = indexStart; j < indexStart + indexCount; ++j)
+                {
+                    minVertex = std::min(minVertex, m_Indices[j]);
+                    maxVertex = std::max(maxVertex, m_Indices[j]);
+                }
+            });
 
-        // Check if vertex is already in uniqueVertices
-        if (uniqueVertices.count(vertex) == 0)
-        {
-            uniqueVertices[vertex] = static_cast<uint32_t>(m_Vertices.size());
-            m_Vertices.push_back(vertex);
+            if (minVertex != UINT32_MAX && maxVertex - minVertex >= MaxShortVertexRange)
+            {
+                return;
+            }
+            baseVertices[i] = minVertex != UINT32_MAX ? minVertex : 0;
         }
     }
 
-    // Process indices
-    for (unsigned int i = 0; i < mesh->mNumFaces; i++)
+    // Indices outside every submesh range are never drawn and stay zero
+    m_ShortIndices.assign(m_Indices.size(), 0);
+    parallelFor(m_Submeshes.size(), [&](size_t i)
     {
-        aiFace face = mesh->mFaces[i];
-        for (unsigned int j = 0; j < face.mNumIndices; j++)
+        const uint32_t baseVertex = baseVertices[i];
+        forEachRange(m_Submeshes[i], [&](uint32_t indexStart, uint32_t indexCount)
         {
-            uint32_t meshIndex = face.mIndices[j];
+            for (uint32_t j = indexStart; j < indexStart + indexCount; ++j)
+            {
+                m_ShortIndices[j] = static_cast<uint16_t>(m_Indices[j] - baseVertex);
+            }
+        });
+    });
 
-            // Construct the vertex from the mesh data directly, applying the same transformations as the first loop
-            Vertex vertex{};
+    for (size_t i = 0; i < m_Submeshes.size(); ++i)
+    {
+        m_Submeshes[i].vertexOffset = static_cast<int32_t>(baseVertices[i]);
+    }
+}
 
-            // Position
-            glm::vec4 pos_val(mesh->mVertices[meshIndex].x, mesh->mVertices[meshIndex].y, mesh->mVertices[meshIndex].z, 1.0f);
-            pos_val = transform * pos_val;
-            vertex.pos = glm::vec3(pos_val);
+void Model::appendTextureRequests(const MaterialDesc& desc, std::vector<TextureCache::Request>& requests) const
+{
+    // Missing textures share the cache's built-in black texel, matching the old default_black.png fallback
+    auto request = [this](const std::string& path, Texture::Format format, TextureCache::BuiltIn fallback = TextureCache::BuiltIn::Black)
+    {
+        return TextureCache::Request{ path.empty() ? std::string() : resolveTexturePath(path), format, fallback };
+    };
 
-            // Normal
-            if (mesh->HasNormals())
-            {
-                glm::vec4 normal_val(mesh->mNormals[meshIndex].x, mesh->mNormals[meshIndex].y, mesh->mNormals[meshIndex].z, 0.0f);
-                normal_val = transform * normal_val;
-                vertex.normal = glm::normalize(glm::vec3(normal_val));
-            }
+    // Normals hold tangent-space X/Y in R/G on both the source and the BC5 path; the shader rebuilds Z
+    requests.push_back(request(desc.diffusePath, Texture::Format::SRGB));
+    requests.push_back(request(desc.normalPath, Texture::Format::TwoChannel, TextureCache::BuiltIn::FlatNormal));
+    requests.push_back(request(desc.metallicRoughnessPath, Texture::Format::MetallicRoughness));
+}
 
-            // TexCoord
-            if (mesh->mTextureCoords[0])
-            {
-                vertex.texCoord = glm::vec2(mesh->mTextureCoords[0][meshIndex].x, mesh->mTextureCoords[0][meshIndex].y);
-            }
-            // Ensure texCoord is initialized otherwise
+Material* Model::createMaterial(const MaterialDesc& desc, Texture* const* ppTextures)
+{
+    Material* material = new Material();
+    material->sampler = m_pSamplerCache->getSampler(desc.sampler);
+    material->pTextureCache = m_pTextureCache;
+    material->pDiffuseTexture = ppTextures[0];
+    material->pNormalTexture = ppTextures[1];
+    material->pMetallicRoughnessTexture = ppTextures[2];
+    return material;
+}
 
-            // Tangent and Bitangent
-            if (mesh->HasTangentsAndBitangents())
-            {
-                // Transform tangent
-                glm::vec4 tangent_h(mesh->mTangents[meshIndex].x, mesh->mTangents[meshIndex].y, mesh->mTangents[meshIndex].z, 0.0f);
-                tangent_h = transform * tangent_h;
-                vertex.tangent = glm::normalize(glm::vec3(tangent_h));
-                
-                // Transform bitangent (initial)
-                // glm::vec4 bitangent_h(mesh->mBitangents[meshIndex].x, mesh->mBitangents[meshIndex].y, mesh->mBitangents[meshIndex].z, 0.0f);
-                // bitangent_h = transform * bitangent_h;
-                // vertex.bitangent will be recomputed.
-
-                // Re-orthogonalize tangent and recompute bitangent using the transformed normal
-                if (mesh->HasNormals()) // vertex.normal should be correctly transformed by now
-                {
-                    vertex.tangent = glm::normalize(vertex.tangent - vertex.normal * glm::dot(vertex.normal, vertex.tangent));
-                    vertex.bitangent = glm::normalize(glm::cross(vertex.normal, vertex.tangent));
-                }
-            }
-            // Ensure tangent/bitangent are initialized otherwise
+std::string Model::resolveTexturePath(const std::string& path) const
+{
+    if (!m_Settings.useCompressedTextures || Texture::isCompressedPath(path))
+    {
+        return path;
+    }
 
-            // Get or create the optimized index for this vertex
-            uint32_t optimizedIndex;
-            if (uniqueVertices.count(vertex) == 0)
-            {
-                optimizedIndex = static_cast<uint32_t>(m_Vertices.size());
-                uniqueVertices[vertex] = optimizedIndex;
-                m_Vertices.push_back(vertex);
-            }
-            else
-            {
-                optimizedIndex = uniqueVertices[vertex];
-            }
+    // BC formats are only sampleable when the device was created with them, and a cook older than its
+    // source is stale; both cases fall back to decoding the source image
+    if (!m_pDevice->getEnabledFeatures().textureCompressionBC)
+    {
+        return path;
+    }
 
-            m_Indices.push_back(optimizedIndex);
-        }
+    const std::string cookedPath = TextureCompressor::getCookedPath(path);
+    std::error_code error;
+    if (!std::filesystem::exists(cookedPath, error) ||
+        std::filesystem::last_write_time(cookedPath, error) < std::filesystem::last_write_time(path, error))
+    {
+        return path;
     }
+    return cookedPath;
+}
+
+Buffer* Model::createDeviceBuffer(const void* pData, VkDeviceSize size, VkBufferUsageFlags usage)
+{
+    Buffer* pBuffer = new Buffer(
+        m_Allocator,
+        size,
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT | usage,
+        VMA_MEMORY_USAGE_GPU_ONLY
+    );
 
-    submesh.indexCount = static_cast<uint32_t>(m_Indices.size()) - submesh.indexStart;
-    submesh.bboxMin = bboxMin;
-    submesh.bboxMax = bboxMax;
+    if (m_pTransferQueue)
+    {
+        m_UploadTicket = std::max(m_UploadTicket, m_pTransferQueue->uploadBuffer(pData, size, pBuffer->get()));
+        return pBuffer;
+    }
+    m_pStagingRing->uploadBuffers(m_pCommandPool, m_pDevice->getGraphicsQueue(), { { pData, size, pBuffer->get(), 0 } });
+    return pBuffer;
+}
 
-    // Update model AABB
-    m_BoundingBoxMin = glm::min(m_BoundingBoxMin, bboxMin);
-    m_BoundingBoxMax = glm::max(m_BoundingBoxMax, bboxMax);
+void Model::createVertexBuffer()
+{
+   // spdlog::debug("Creating vertex buffer");
+    VkDeviceSize bufferSize = 0;
+    const void* pVertexData = getVertexData(bufferSize);
+    m_pVertexBuffer = createDeviceBuffer(pVertexData, bufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
 
-    // Process material (existing code)
-    if (mesh->mMaterialIndex >= 0)
+    VkDeviceSize depthBufferSize = 0;
+    const void* pDepthVertexData = getDepthVertexData(depthBufferSize);
+    if (depthBufferSize != 0)
     {
-        aiMaterial* aiMat = scene->mMaterials[mesh->mMaterialIndex];
-        Material* material = new Material();
+        m_pDepthVertexBuffer = createDeviceBuffer(pDepthVertexData, depthBufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+    }
 
-        // Albedo texture
-        aiString albedoPath;
-        if (aiMat->GetTexture(aiTextureType_BASE_COLOR, 0, &albedoPath) == AI_SUCCESS ||
-            aiMat->GetTexture(aiTextureType_DIFFUSE, 0, &albedoPath) == AI_SUCCESS)
-        {
-            std::string fullPath = m_Directory + "/" + albedoPath.C_Str();
-            material->pDiffuseTexture = new Texture(m_pDevice, m_Allocator, m_pCommandPool, fullPath, m_pPhysicalDevice->get());
-        }
-        else
-        {
-            material->pDiffuseTexture = new Texture(m_pDevice, m_Allocator, m_pCommandPool, "default/default_black.png", m_pPhysicalDevice->get());
-        }
+   // spdlog::debug("Vertex buffer created with size: {}", bufferSize);
+}
 
-        // Normal texture
-        aiString normalPath;
-        if (aiMat->GetTexture(aiTextureType_NORMAL_CAMERA, 0, &normalPath) == AI_SUCCESS ||
-            aiMat->GetTexture(aiTextureType_NORMALS, 0, &normalPath) == AI_SUCCESS ||
-            aiMat->GetTexture(aiTextureType_HEIGHT, 0, &normalPath) == AI_SUCCESS)
-        {
-            std::string fullPath = m_Directory + "/" + normalPath.C_Str();
-            material->pNormalTexture = new Texture(m_pDevice, m_Allocator, m_pCommandPool, fullPath, m_pPhysicalDevice->get(), Texture::Format::UNORM);
-        }
-        else
-        {
-            material->pNormalTexture = new Texture(m_pDevice, m_Allocator, m_pCommandPool, "default/default_black.png", m_pPhysicalDevice->get(), Texture::Format::UNORM);
-        }
+void Model::createIndexBuffer()
+{
+   // spdlog::debug("Creating index buffer");
+    size_t indexCount = 0;
+    VkIndexType indexType = VK_INDEX_TYPE_UINT32;
+    const void* pIndexData = getIndexData(indexCount, indexType);
+    m_pIndexBuffer = createDeviceBuffer(pIndexData, CookedMesh::getIndexSize(indexType) * indexCount, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
 
-        // Metallic-Roughness texture
-        aiString mrPath;
-        if (aiMat->GetTexture(aiTextureType_UNKNOWN, 0, &mrPath) == AI_SUCCESS)
-        {
-            std::string fullPath = m_Directory + "/" + mrPath.C_Str();
-            material->pMetallicRoughnessTexture = new Texture(m_pDevice, m_Allocator, m_pCommandPool, fullPath, m_pPhysicalDevice->get());
-        }
-        else
-        {
-            material->pMetallicRoughnessTexture = new Texture(m_pDevice, m_Allocator, m_pCommandPool, "default/default_black.png", m_pPhysicalDevice->get());
-        }
+    //spdlog::debug("Index buffer created successfully");
+}
 
-        m_Materials.push_back(material);
-        submesh.materialIndex = static_cast<uint32_t>(m_Materials.size() - 1);
+void Model::createPooledBuffers(GeometryPool* pGeometryPool)
+{
+    const GeometryPool::Settings& poolSettings = pGeometryPool->getSettings();
+    if (poolSettings.vertexFormat != m_Settings.vertexFormat || poolSettings.depthStream != m_Settings.depthStream)
+    {
+        throw std::runtime_error("Geometry pool vertex layout does not match model: " + m_ModelPath);
+    }
+
+    VkDeviceSize vertexDataSize = 0;
+    const void* pVertexData = getVertexData(vertexDataSize);
+    VkDeviceSize depthVertexDataSize = 0;
+    const void* pDepthVertexData = getDepthVertexData(depthVertexDataSize);
+    size_t indexCount = 0;
+    VkIndexType indexType = VK_INDEX_TYPE_UINT32;
+    const void* pIndexData = getIndexData(indexCount, indexType);
+
+    const size_t vertexCount = static_cast<size_t>(vertexDataSize) / CookedMesh::getVertexStride(m_Settings.vertexFormat);
+    GeometryPool::Allocation allocation = pGeometryPool->allocate(static_cast<uint32_t>(vertexCount), static_cast<uint32_t>(indexCount));
+    try
+    {
+        m_UploadTicket = std::max(m_UploadTicket, pGeometryPool->upload(allocation, pVertexData, pDepthVertexData, pIndexData, indexType));
+    }
+    catch (...)
+    {
+        pGeometryPool->free(allocation);
+        throw;
     }
 
-    m_Submeshes.push_back(submesh);
+    m_pGeometryPool = pGeometryPool;
+    m_PoolAllocation = allocation;
 }
 
-*/
 VkBuffer Model::getVertexBuffer() const
 {
-    return m_pVertexBuffer->get();
+    return m_pGeometryPool ? m_pGeometryPool->getVertexBuffer(m_PoolAllocation.block) : m_pVertexBuffer->get();
 }
 
 VkBuffer Model::getIndexBuffer() const
 {
-    return m_pIndexBuffer->get();
+    return m_pGeometryPool ? m_pGeometryPool->getIndexBuffer(m_PoolAllocation.block) : m_pIndexBuffer->get();
+}
+
+VkBuffer Model::getDepthVertexBuffer() const
+{
+    if (m_pGeometryPool)
+    {
+        return m_pGeometryPool->getDepthVertexBuffer(m_PoolAllocation.block);
+    }
+    return m_pDepthVertexBuffer ? m_pDepthVertexBuffer->get() : VK_NULL_HANDLE;
 }
 
 size_t Model::getIndexCount() const
 {
-    return m_Indices.size();
+    return m_CookedMesh.isOpen() ? m_CookedMesh.getIndexCount() : m_Indices.size();
+}
+
+VkIndexType Model::getIndexType() const
+{
+    if (m_pGeometryPool)
+    {
+        return m_pGeometryPool->getSettings().indexType;
+    }
+    if (m_CookedMesh.isOpen())
+    {
+        return m_CookedMesh.getIndexType();
+    }
+    return m_ShortIndices.empty() ? VK_INDEX_TYPE_UINT32 : VK_INDEX_TYPE_UINT16;
+}
+
+void Model::bind(VkCommandBuffer commandBuffer) const
+{
+    if (m_pGeometryPool)
+    {
+        m_pGeometryPool->bind(commandBuffer, m_PoolAllocation.block);
+        return;
+    }
+
+    VkBuffer vertexBuffer = m_pVertexBuffer->get();
+    VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer, &offset);
+    vkCmdBindIndexBuffer(commandBuffer, m_pIndexBuffer->get(), 0, getIndexType());
+}
+
+void Model::drawSubmesh(VkCommandBuffer commandBuffer, const Submesh& submesh, uint32_t lod) const
+{
+    uint32_t indexStart = submesh.indexStart;
+    uint32_t indexCount = submesh.indexCount;
+    if (lod != 0 && lod < submesh.lodCount)
+    {
+        indexStart = m_Lods[submesh.lodOffset + lod].indexStart;
+        indexCount = m_Lods[submesh.lodOffset + lod].indexCount;
+    }
+    vkCmdDrawIndexed(commandBuffer, indexCount, 1, getFirstIndex() + indexStart,
+                     static_cast<int32_t>(getBaseVertex()) + submesh.vertexOffset, 0);
+}
+
+uint32_t Model::selectLod(const Submesh& submesh, const glm::vec3& cameraPosition, float projectionScale, float maxPixelError) const
+{
+    if (submesh.lodCount == 0)
+    {
+        return 0;
+    }
+
+    // Distance to the closest point of the bounds, so the LOD never coarsens while the camera is inside
+    glm::vec3 closest = glm::max(submesh.bboxMin, glm::min(cameraPosition, submesh.bboxMax));
+    float distance = std::max(glm::length(cameraPosition - closest), 1e-4f);
+    return MeshSimplifier::selectLod(&m_Lods[submesh.lodOffset], submesh.lodCount, distance, projectionScale, maxPixelError);
 }
 
 bool Vertex::operator==(const Vertex& other) const
@@ -407,6 +702,16 @@ std::vector<VkVertexInputAttributeDescription> Vertex::getAttributeDescriptions(
     return attributeDescriptions;
 }
 
+VkVertexInputBindingDescription Vertex::getBindingDescription(VertexFormat format)
+{
+    return format == VertexFormat::Standard ? getBindingDescription() : CompactVertex::getBindingDescription();
+}
+
+std::vector<VkVertexInputAttributeDescription> Vertex::getAttributeDescriptions(VertexFormat format)
+{
+    return format == VertexFormat::Standard ? getAttributeDescriptions() : CompactVertex::getAttributeDescriptions(format);
+}
+
 std::vector<VkVertexInputAttributeDescription> Vertex::getDepthAttributeDescriptions()
 {
     std::vector<VkVertexInputAttributeDescription> attributeDescriptions(2);
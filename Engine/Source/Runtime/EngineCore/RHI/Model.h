@@ -3,24 +3,29 @@
 #include <vulkan/vulkan.h>
 
 #include <glm/glm.hpp>
-#define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtx/hash.hpp>
+#include <memory>
 #include <string>
 #include <vector>
-#include <unordered_map>
-
-// #include <assimp/Importer.hpp>
-// #include <assimp/scene.h>
-// #include <assimp/postprocess.h>
-// Assimp not yet integrated - commenting out for now
 
 #include "Buffer.h"
 #include "CommandPool.h"
 #include "Device.h"
 #include "Texture.h"
 #include "Material.h"
+#include "VertexWelder.h"
+#include "MeshOptimizer.h"
+#include "CompactVertex.h"
+#include "MeshletBuilder.h"
+#include "MeshSimplifier.h"
+#include "CookedMesh.h"
+#include "DepthVertexStream.h"
+#include "GeometryPool.h"
+#include "SamplerCache.h"
+#include "StagingRing.h"
+#include "TextureCache.h"
+#include "TextureCompressor.h"
 
 struct Vertex
 {
@@ -32,32 +37,14 @@ struct Vertex
 
     static VkVertexInputBindingDescription getBindingDescription();
     static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions();
+    static VkVertexInputBindingDescription getBindingDescription(VertexFormat format);
+    static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions(VertexFormat format);
+    // Depth-only attributes read from the interleaved Vertex; prefer DepthVertexStream when the model emits one
     static std::vector<VkVertexInputAttributeDescription> getDepthAttributeDescriptions();
 
     bool operator==(const Vertex& other) const;
 };
 
-namespace std
-{
-    template<> struct hash<Vertex>
-    {
-        size_t operator()(const Vertex& vertex) const
-        {
-            size_t seed = 0;
-            hash<glm::vec3> vec3Hasher;
-            hash<glm::vec2> vec2Hasher;
-
-            seed ^= vec3Hasher(vertex.pos) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            seed ^= vec2Hasher(vertex.texCoord) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            seed ^= vec3Hasher(vertex.normal) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            seed ^= vec3Hasher(vertex.tangent) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            seed ^= vec3Hasher(vertex.bitangent) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-
-            return seed;
-        }
-    };
-}
-
 struct Submesh
 {
     uint32_t indexStart;
@@ -66,47 +53,158 @@ struct Submesh
 
     glm::vec3 bboxMin;
     glm::vec3 bboxMax;
+
+    // Range in Model::getMeshlets(); empty unless meshlets were built
+    uint32_t meshletOffset = 0;
+    uint32_t meshletCount = 0;
+
+    // Range in Model::getLods(); LOD 0 is this submesh's own index range
+    uint32_t lodOffset = 0;
+    uint32_t lodCount = 0;
+
+    // Added to every index of this submesh and its LODs; non-zero when 16-bit indices were rebased
+    int32_t vertexOffset = 0;
+};
+
+// Import-time processing applied by Model::loadModel
+struct ModelSettings
+{
+    bool weldVertices = true;
+    VertexWelder::Settings weld;
+
+    bool optimizeMesh = true;
+    MeshOptimizer::Settings optimizer;
+
+    // Compact formats force per-submesh welding since positions are quantized per submesh
+    VertexFormat vertexFormat = VertexFormat::Standard;
+
+    bool buildMeshlets = false;
+    MeshletBuilder::Settings meshlets;
+
+    bool generateLods = true;
+    MeshSimplifier::Settings lods;
+
+    // Uploads 16-bit indices when every submesh's vertex range fits, rebasing per submesh if needed
+    bool allowShortIndices = true;
+
+    // Emits a second, tightly packed vertex buffer for depth prepass and shadow pipelines
+    DepthStream depthStream = DepthStream::None;
+
+    // Loads the block-compressed .ktx2 written by Model::cookTextures() instead of a source image when the device
+    // has BC enabled and the cook is at least as new as its source
+    bool useCompressedTextures = true;
+    TextureCompressor::Settings textureCompression;
 };
 
 class PhysicalDevice;
+class TransferQueue;
 class Model
 {
 public:
-    Model(VmaAllocator allocator, Device* pDevice, PhysicalDevice* pPhysicalDevice, CommandPool* pCommandPool, const std::string& modelPath);
+    // Null caches are replaced by ones owned by the model. Needs pStagingRing or pTransferQueue for its uploads,
+    // which the owned texture cache shares.
+    Model(VmaAllocator allocator, Device* pDevice, PhysicalDevice* pPhysicalDevice, CommandPool* pCommandPool, const std::string& modelPath,
+          const ModelSettings& settings, TextureCache* pTextureCache, SamplerCache* pSamplerCache, StagingRing* pStagingRing,
+          TransferQueue* pTransferQueue);
     ~Model();
 
+    // Imports .gltf/.glb sources, or maps a .cmesh written by cook() and uses it in place
     void loadModel();
+    // Writes the loaded, fully processed geometry as a cooked mesh for zero-parse loading
+    void cook(const std::string& cookedPath) const;
+    // Block-compresses every material texture into a .ktx2 next to its source; up-to-date files are skipped
+    void cookTextures() const;
     void createVertexBuffer();
     void createIndexBuffer();
+    // Alternative to createVertexBuffer/createIndexBuffer: sub-allocates all geometry from a shared pool,
+    // which must match the model's vertex format and depth stream. The range is released in the destructor.
+    void createPooledBuffers(GeometryPool* pGeometryPool);
 
     VkBuffer getVertexBuffer() const;
     VkBuffer getIndexBuffer() const;
+    // VK_NULL_HANDLE unless ModelSettings::depthStream is set; describe it with DepthVertexStream
+    VkBuffer getDepthVertexBuffer() const;
+    DepthStream getDepthStream() const { return m_Settings.depthStream; }
     size_t getIndexCount() const;
+    VkIndexType getIndexType() const;
+    // Offsets of this model inside its GeometryPool block; zero for models with their own buffers
+    uint32_t getBaseVertex() const { return m_PoolAllocation.firstVertex; }
+    uint32_t getFirstIndex() const { return m_PoolAllocation.firstIndex; }
+    uint32_t getGeometryBlock() const { return m_PoolAllocation.block; }
+    bool isPooled() const { return m_pGeometryPool != nullptr; }
+    // TransferQueue ticket covering the model's buffers and material textures. When uploads go through a
+    // TransferQueue (given here or to the TextureCache/GeometryPool) the model must not be drawn or destroyed
+    // before the queue isAcquired() it; 0 when every upload completed synchronously.
+    uint64_t getUploadTicket() const { return m_UploadTicket; }
+
+    // Binds the vertex and index buffers with the model's index type
+    void bind(VkCommandBuffer commandBuffer) const;
+    // Draws one LOD of a submesh; lod indexes into the submesh's range of getLods()
+    void drawSubmesh(VkCommandBuffer commandBuffer, const Submesh& submesh, uint32_t lod = 0) const;
+    VertexFormat getVertexFormat() const { return m_Settings.vertexFormat; }
 
     std::vector<Submesh> getSubmeshes() const { return m_Submeshes; }
     std::vector<Material*> getMaterials() const { return m_Materials; }
+    const std::vector<MeshLod>& getLods() const { return m_Lods; }
+    // Index into getLods() relative to submesh.lodOffset; projectionScale from MeshSimplifier::getProjectionScale
+    uint32_t selectLod(const Submesh& submesh, const glm::vec3& cameraPosition, float projectionScale, float maxPixelError = 1.0f) const;
+    const std::vector<Meshlet>& getMeshlets() const { return m_Meshlets; }
+    const std::vector<uint32_t>& getMeshletVertices() const { return m_MeshletVertices; }
+    const std::vector<uint8_t>& getMeshletTriangles() const { return m_MeshletTriangles; }
     std::pair<glm::vec3, glm::vec3> getAABB() const 
     {
         return { m_BoundingBoxMin, m_BoundingBoxMax };
     }
 
 private:
-    //void processNode(); // Disabled until Assimp is integrated
-    //void processMesh(); // Disabled until Assimp is integrated
+    void importSource();
+    void loadCooked();
+    void packShortIndices();
+    // Appends the diffuse, normal and metallic-roughness requests for one material, in that order
+    void appendTextureRequests(const MaterialDesc& desc, std::vector<TextureCache::Request>& requests) const;
+    Material* createMaterial(const MaterialDesc& desc, Texture* const* ppTextures);
+    std::string resolveTexturePath(const std::string& path) const;
+
+    // Vertex and index ranges to upload; they point into the cooked mapping when one is open
+    const void* getVertexData(VkDeviceSize& size) const;
+    const void* getIndexData(size_t& count, VkIndexType& indexType) const;
+    const void* getDepthVertexData(VkDeviceSize& size) const;
+    Buffer* createDeviceBuffer(const void* pData, VkDeviceSize size, VkBufferUsageFlags usage);
+
     VmaAllocator m_Allocator;
     Device* m_pDevice;
     PhysicalDevice* m_pPhysicalDevice;
     CommandPool* m_pCommandPool;
+    TextureCache* m_pTextureCache; // Shared cache, or m_pOwnedTextureCache when none was given
+    std::unique_ptr<TextureCache> m_pOwnedTextureCache;
+    SamplerCache* m_pSamplerCache; // Shared cache, or m_pOwnedSamplerCache when none was given
+    std::unique_ptr<SamplerCache> m_pOwnedSamplerCache;
+    StagingRing* m_pStagingRing; // Synchronous vertex and index uploads when no transfer queue is given
+    TransferQueue* m_pTransferQueue; // Asynchronous vertex, index and owned-cache texture uploads when given
+    uint64_t m_UploadTicket = 0;
     std::string m_ModelPath;
     std::string m_Directory;
+    ModelSettings m_Settings;
 
     std::vector<Vertex> m_Vertices;
+    std::vector<CompactVertex> m_CompactVertices;
     std::vector<uint32_t> m_Indices;
+    std::vector<uint16_t> m_ShortIndices; // Upload copy of m_Indices when 16-bit indices are used
+    std::vector<uint8_t> m_DepthVertices;
+    CookedMesh m_CookedMesh;
 
     Buffer* m_pVertexBuffer;
     Buffer* m_pIndexBuffer;
+    Buffer* m_pDepthVertexBuffer;
+    GeometryPool* m_pGeometryPool = nullptr;
+    GeometryPool::Allocation m_PoolAllocation;
 
     std::vector<Submesh> m_Submeshes;
+    std::vector<MeshLod> m_Lods;
+    std::vector<Meshlet> m_Meshlets;
+    std::vector<uint32_t> m_MeshletVertices;
+    std::vector<uint8_t> m_MeshletTriangles;
+    std::vector<MaterialDesc> m_MaterialDescs;
     std::vector<Material*> m_Materials;
 	glm::vec3 m_BoundingBoxMin;
 	glm::vec3 m_BoundingBoxMax;
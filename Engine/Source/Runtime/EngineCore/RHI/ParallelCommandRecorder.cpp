@@ -0,0 +1,281 @@
+#include "ParallelCommandRecorder.h"
+
+#include "Device.h"
+#include "Runtime/EngineCore/Core/Log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+ParallelCommandRecorder::ParallelCommandRecorder(Device* pDevice, uint32_t queueFamilyIndex, uint32_t framesInFlight)
+    : ParallelCommandRecorder(pDevice, queueFamilyIndex, framesInFlight, Settings{})
+{
+}
+
+ParallelCommandRecorder::ParallelCommandRecorder(Device* pDevice, uint32_t queueFamilyIndex, uint32_t framesInFlight, const Settings& settings)
+    : m_pDevice(pDevice), m_FramesInFlight(framesInFlight)
+{
+    uint32_t workerCount = settings.workerCount;
+    if (workerCount == ~0u)
+    {
+        const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        workerCount = std::min(hardwareThreads - 1, 7u);
+    }
+    const uint32_t threadCount = workerCount + 1;
+
+    // Transient pools are only ever reset as a whole, which is cheaper than resetting each buffer
+    m_Pools.resize(static_cast<size_t>(m_FramesInFlight) * threadCount);
+    for (ThreadPool& threadPool : m_Pools)
+    {
+        VkCommandPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        poolInfo.queueFamilyIndex = queueFamilyIndex;
+        if (vkCreateCommandPool(m_pDevice->get(), &poolInfo, nullptr, &threadPool.pool) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to create a recording command pool!");
+        }
+    }
+
+    m_Workers.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i)
+    {
+        m_Workers.emplace_back(&ParallelCommandRecorder::workerLoop, this, i + 1);
+    }
+    CAE_LOG_DEBUG(RHI, "ParallelCommandRecorder created with " << threadCount << " recording threads");
+}
+
+ParallelCommandRecorder::~ParallelCommandRecorder()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_WorkReady.notify_all();
+    for (std::thread& worker : m_Workers)
+    {
+        worker.join();
+    }
+
+    // Destroying a pool frees its command buffers
+    for (ThreadPool& threadPool : m_Pools)
+    {
+        vkDestroyCommandPool(m_pDevice->get(), threadPool.pool, nullptr);
+    }
+}
+
+void ParallelCommandRecorder::beginFrame(uint32_t frameIndex, const RenderTarget& target)
+{
+    if (frameIndex >= m_FramesInFlight)
+    {
+        throw std::runtime_error("ParallelCommandRecorder: frame index out of range");
+    }
+    m_FrameIndex = frameIndex;
+
+    const uint32_t threadCount = getThreadCount();
+    for (uint32_t thread = 0; thread < threadCount; ++thread)
+    {
+        ThreadPool& threadPool = m_Pools[static_cast<size_t>(frameIndex) * threadCount + thread];
+        vkResetCommandPool(m_pDevice->get(), threadPool.pool, 0);
+        threadPool.usedCount = 0;
+    }
+
+    m_Target = target;
+    m_RenderingInheritance = {};
+    m_RenderingInheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR;
+    m_RenderingInheritance.colorAttachmentCount = static_cast<uint32_t>(m_Target.colorFormats.size());
+    m_RenderingInheritance.pColorAttachmentFormats = m_Target.colorFormats.data();
+    m_RenderingInheritance.depthAttachmentFormat = m_Target.depthFormat;
+    m_RenderingInheritance.stencilAttachmentFormat = m_Target.stencilFormat;
+    m_RenderingInheritance.rasterizationSamples = m_Target.samples;
+
+    m_Inheritance = {};
+    m_Inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    m_Inheritance.pNext = &m_RenderingInheritance;
+
+    m_Tasks.clear();
+    m_ParallelTasks.clear();
+}
+
+void ParallelCommandRecorder::addTask(RecordFunction record, bool mainThread)
+{
+    Task task;
+    task.record = std::move(record);
+    task.mainThread = mainThread;
+    if (!mainThread)
+    {
+        m_ParallelTasks.push_back(m_Tasks.size());
+    }
+    m_Tasks.push_back(std::move(task));
+}
+
+void ParallelCommandRecorder::execute(VkCommandBuffer primary)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    m_NextTask.store(0);
+    m_WorkerTasks.store(0);
+    m_FirstError = nullptr;
+
+    // Workers only wake when there is something for them; single parallel tasks stay on this thread
+    const bool useWorkers = !m_Workers.empty() && m_ParallelTasks.size() > 1;
+    if (useWorkers)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_BusyWorkers = static_cast<uint32_t>(m_Workers.size());
+        ++m_Generation;
+    }
+    if (useWorkers)
+    {
+        m_WorkReady.notify_all();
+    }
+
+    // Main-thread tasks first, while the workers start on the parallel ones
+    for (Task& task : m_Tasks)
+    {
+        if (!task.mainThread)
+        {
+            continue;
+        }
+        try
+        {
+            recordTask(task, 0);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (!m_FirstError)
+            {
+                m_FirstError = std::current_exception();
+            }
+        }
+    }
+    runTasks(0);
+
+    if (useWorkers)
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_WorkDone.wait(lock, [this]() { return m_BusyWorkers == 0; });
+    }
+
+    std::vector<Task> tasks = std::move(m_Tasks);
+    m_Tasks.clear();
+    m_ParallelTasks.clear();
+    if (m_FirstError)
+    {
+        std::rethrow_exception(m_FirstError);
+    }
+
+    // Task order, not recording order, decides the draw order
+    std::vector<VkCommandBuffer> commandBuffers;
+    commandBuffers.reserve(tasks.size());
+    for (const Task& task : tasks)
+    {
+        commandBuffers.push_back(task.commandBuffer);
+    }
+    if (!commandBuffers.empty())
+    {
+        vkCmdExecuteCommands(primary, static_cast<uint32_t>(commandBuffers.size()), commandBuffers.data());
+    }
+
+    m_Stats.tasks = tasks.size();
+    m_Stats.workerTasks = m_WorkerTasks.load();
+    m_Stats.recordMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void ParallelCommandRecorder::workerLoop(uint32_t threadIndex)
+{
+    uint64_t generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_WorkReady.wait(lock, [this, generation]() { return m_Stop || m_Generation != generation; });
+            if (m_Stop)
+            {
+                return;
+            }
+            generation = m_Generation;
+        }
+
+        runTasks(threadIndex);
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (--m_BusyWorkers == 0)
+        {
+            m_WorkDone.notify_one();
+        }
+    }
+}
+
+void ParallelCommandRecorder::runTasks(uint32_t threadIndex)
+{
+    const size_t count = m_ParallelTasks.size();
+    for (size_t i = m_NextTask.fetch_add(1); i < count; i = m_NextTask.fetch_add(1))
+    {
+        try
+        {
+            recordTask(m_Tasks[m_ParallelTasks[i]], threadIndex);
+            if (threadIndex != 0)
+            {
+                m_WorkerTasks.fetch_add(1);
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (!m_FirstError)
+            {
+                m_FirstError = std::current_exception();
+            }
+            m_NextTask.store(count);
+        }
+    }
+}
+
+void ParallelCommandRecorder::recordTask(Task& task, uint32_t threadIndex)
+{
+    VkCommandBuffer commandBuffer = acquireCommandBuffer(threadIndex);
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &m_Inheritance;
+    if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to begin secondary command buffer!");
+    }
+
+    // Dynamic state is not inherited by secondary command buffers
+    vkCmdSetViewport(commandBuffer, 0, 1, &m_Target.viewport);
+    vkCmdSetScissor(commandBuffer, 0, 1, &m_Target.scissor);
+
+    task.record(commandBuffer);
+
+    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to record secondary command buffer!");
+    }
+    task.commandBuffer = commandBuffer;
+}
+
+VkCommandBuffer ParallelCommandRecorder::acquireCommandBuffer(uint32_t threadIndex)
+{
+    ThreadPool& threadPool = m_Pools[static_cast<size_t>(m_FrameIndex) * getThreadCount() + threadIndex];
+    if (threadPool.usedCount == threadPool.commandBuffers.size())
+    {
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = threadPool.pool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandBufferCount = 1;
+
+        VkCommandBuffer commandBuffer;
+        if (vkAllocateCommandBuffers(m_pDevice->get(), &allocInfo, &commandBuffer) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to allocate secondary command buffer!");
+        }
+        threadPool.commandBuffers.push_back(commandBuffer);
+    }
+    return threadPool.commandBuffers[threadPool.usedCount++];
+}
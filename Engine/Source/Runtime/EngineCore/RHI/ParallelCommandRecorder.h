@@ -0,0 +1,123 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Device;
+
+//
+// Records the contents of a dynamic rendering instance on several threads. Each task added between
+// beginFrame() and execute() records into its own secondary command buffer, begun with
+// VkCommandBufferInheritanceRenderingInfo for the frame's attachment formats and with the frame's
+// viewport and scissor already set. execute() runs the tasks on persistent worker threads and then
+// executes the secondary buffers into the primary in the order the tasks were added, so the result
+// does not depend on which thread recorded what. Every thread owns one transient command pool per
+// frame in flight, reset as a whole by beginFrame(). Tasks that touch main-thread state (ImGui,
+// GLFW) are added with mainThread = true and run on the thread calling execute().
+//
+class ParallelCommandRecorder
+{
+public:
+    using RecordFunction = std::function<void(VkCommandBuffer)>;
+
+    struct Settings
+    {
+        uint32_t workerCount = ~0u; // ~0u: one per hardware thread besides the caller, at most 7
+    };
+
+    // Attachment formats and dynamic state of the rendering instance the tasks draw into
+    struct RenderTarget
+    {
+        std::vector<VkFormat> colorFormats;
+        VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+        VkFormat stencilFormat = VK_FORMAT_UNDEFINED;
+        VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+        VkViewport viewport{};
+        VkRect2D scissor{};
+    };
+
+    struct Stats
+    {
+        size_t tasks = 0;        // Last frame
+        size_t workerTasks = 0;  // Last frame, recorded off the calling thread
+        double recordMs = 0.0;   // Last frame, wall time of execute()
+    };
+
+    ParallelCommandRecorder(Device* pDevice, uint32_t queueFamilyIndex, uint32_t framesInFlight);
+    ParallelCommandRecorder(Device* pDevice, uint32_t queueFamilyIndex, uint32_t framesInFlight, const Settings& settings);
+    ~ParallelCommandRecorder();
+
+    ParallelCommandRecorder(const ParallelCommandRecorder&) = delete;
+    ParallelCommandRecorder& operator=(const ParallelCommandRecorder&) = delete;
+
+    // Resets the frame's command pools; the frame's previous submission must have completed
+    void beginFrame(uint32_t frameIndex, const RenderTarget& target);
+
+    // Tasks must only record into the command buffer they are given and must not depend on each other
+    void addTask(RecordFunction record, bool mainThread = false);
+
+    // Records every task and calls vkCmdExecuteCommands on primary, which must be inside a rendering
+    // instance begun with VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT. The first exception
+    // thrown by a task is rethrown here after all tasks have finished.
+    void execute(VkCommandBuffer primary);
+
+    uint32_t getThreadCount() const { return static_cast<uint32_t>(m_Workers.size()) + 1; }
+    const Stats& getStats() const { return m_Stats; }
+
+private:
+    struct ThreadPool
+    {
+        VkCommandPool pool = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer> commandBuffers; // Allocated on demand and reused every frame
+        size_t usedCount = 0;
+    };
+
+    struct Task
+    {
+        RecordFunction record;
+        bool mainThread = false;
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    };
+
+    void workerLoop(uint32_t threadIndex);
+    // Takes parallel tasks until none are left; threadIndex selects the command pool
+    void runTasks(uint32_t threadIndex);
+    void recordTask(Task& task, uint32_t threadIndex);
+    VkCommandBuffer acquireCommandBuffer(uint32_t threadIndex);
+
+    Device* m_pDevice;
+    uint32_t m_FramesInFlight;
+    uint32_t m_FrameIndex = 0;
+
+    // m_Pools[frame * threadCount + thread]
+    std::vector<ThreadPool> m_Pools;
+
+    RenderTarget m_Target;
+    VkCommandBufferInheritanceRenderingInfo m_RenderingInheritance{};
+    VkCommandBufferInheritanceInfo m_Inheritance{};
+
+    std::vector<Task> m_Tasks;
+    std::vector<size_t> m_ParallelTasks; // Indices into m_Tasks
+    std::atomic<size_t> m_NextTask{ 0 };
+    std::atomic<size_t> m_WorkerTasks{ 0 };
+
+    std::vector<std::thread> m_Workers;
+    std::mutex m_Mutex;
+    std::condition_variable m_WorkReady;
+    std::condition_variable m_WorkDone;
+    uint64_t m_Generation = 0; // Bumped once per execute() to release the workers
+    uint32_t m_BusyWorkers = 0;
+    bool m_Stop = false;
+    std::exception_ptr m_FirstError;
+
+    Stats m_Stats;
+};
@@ -1,7 +1,7 @@
 #include "PhysicalDevice.h"
+#include "Runtime/EngineCore/Core/Log.h"
 #include <stdexcept>
 #include <set>
-#include <iostream>
 
 PhysicalDevice::PhysicalDevice(VkInstance instance, VkSurfaceKHR surface,
     const std::vector<const char*>& requiredExtensions,
@@ -32,7 +32,7 @@ PhysicalDevice::PhysicalDevice(VkInstance instance, VkSurfaceKHR surface,
     }
 
     pickPhysicalDevice();
-	std::cout << "PhysicalDevice created." << std::endl;
+	CAE_LOG_TRACE(RHI, "PhysicalDevice created.");
 }
 
 // Move constructor
@@ -91,7 +91,7 @@ void PhysicalDevice::pickPhysicalDevice()
     {
         throw std::runtime_error("Failed to find GPUs with Vulkan support!");
     }
-	std::cout << "Found " << deviceCount << " devices" << std::endl;
+	CAE_LOG_INFO(RHI, "Found " << deviceCount << " devices");
 
     std::vector<VkPhysicalDevice> devices(deviceCount);
     vkEnumeratePhysicalDevices(m_Instance, &deviceCount, devices.data());
@@ -100,11 +100,11 @@ void PhysicalDevice::pickPhysicalDevice()
     {
         VkPhysicalDeviceProperties deviceProperties;
         vkGetPhysicalDeviceProperties(device, &deviceProperties);
-        std::cout << "Checking device: " << deviceProperties.deviceName << std::endl;
+        CAE_LOG_DEBUG(RHI, "Checking device: " << deviceProperties.deviceName);
 
         if (isDeviceSuitable(device))
         {
-            std::cout << "Found suitable device: " << deviceProperties.deviceName << std::endl;
+            CAE_LOG_INFO(RHI, "Found suitable device: " << deviceProperties.deviceName);
             m_PhysicalDevice = device;
             m_QueueFamilyIndices = findQueueFamilies(device);
             m_SwapChainSupportDetails = querySwapChainSupport();
@@ -154,13 +154,13 @@ bool PhysicalDevice::checkFeatureSupport(VkPhysicalDevice device)
     {
         if (!supportedVulkan13Features.dynamicRendering)
         {
-            std::cout << "Device does not support dynamic rendering!" << std::endl;
+            CAE_LOG_DEBUG(RHI, "Device does not support dynamic rendering!");
             return false;
         }
         
         if (!supportedVulkan13Features.synchronization2)
         {
-            std::cout << "Device does not support synchronization2!" << std::endl;
+            CAE_LOG_DEBUG(RHI, "Device does not support synchronization2!");
             return false;
         }
     }
@@ -205,9 +205,9 @@ bool PhysicalDevice::isDeviceSuitable(VkPhysicalDevice device)
     bool swapChainAdequate = false;
     bool storageImageSupported = false;
 
-    std::cout << "  - Graphics queue family: " << (indices.graphicsFamily.has_value() ? "FOUND" : "NOT FOUND") << std::endl;
-    std::cout << "  - Present queue family: " << (indices.presentFamily.has_value() ? "FOUND" : "NOT FOUND") << std::endl;
-    std::cout << "  - Extensions supported: " << (extensionsSupported ? "YES" : "NO") << std::endl;
+    CAE_LOG_DEBUG(RHI, "  - Graphics queue family: " << (indices.graphicsFamily.has_value() ? "FOUND" : "NOT FOUND"));
+    CAE_LOG_DEBUG(RHI, "  - Present queue family: " << (indices.presentFamily.has_value() ? "FOUND" : "NOT FOUND"));
+    CAE_LOG_DEBUG(RHI, "  - Extensions supported: " << (extensionsSupported ? "YES" : "NO"));
 
     if (extensionsSupported)
     {
@@ -221,14 +221,14 @@ bool PhysicalDevice::isDeviceSuitable(VkPhysicalDevice device)
 
         // If you want to log this information for debugging:
         if (storageImageSupported) {
-            std::cout << "Device supports storage images for swapchain" << std::endl;
+            CAE_LOG_DEBUG(RHI, "Device supports storage images for swapchain");
         }
         else {
-            std::cerr << "Device DOES NOT support storage images for swapchain" << std::endl;
+            CAE_LOG_WARNING(RHI, "Device DOES NOT support storage images for swapchain");
         }
         
-        std::cout << "  - Swap chain adequate: " << (swapChainAdequate ? "YES" : "NO") << std::endl;
-        std::cout << "  - Storage image supported: " << (storageImageSupported ? "YES" : "NO") << std::endl;
+        CAE_LOG_DEBUG(RHI, "  - Swap chain adequate: " << (swapChainAdequate ? "YES" : "NO"));
+        CAE_LOG_DEBUG(RHI, "  - Storage image supported: " << (storageImageSupported ? "YES" : "NO"));
     }
 
     VkPhysicalDeviceFeatures supportedFeatures;
@@ -240,10 +240,10 @@ bool PhysicalDevice::isDeviceSuitable(VkPhysicalDevice device)
     bool isDiscreteGPU = deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU;
     bool anisotropySupported = !m_RequiredFeatures.samplerAnisotropy || supportedFeatures.samplerAnisotropy;
     
-    std::cout << "  - Is discrete GPU: " << (isDiscreteGPU ? "YES" : "NO") << std::endl;
-    std::cout << "  - Required anisotropy: " << (m_RequiredFeatures.samplerAnisotropy ? "YES" : "NO") << std::endl;
-    std::cout << "  - Supported anisotropy: " << (supportedFeatures.samplerAnisotropy ? "YES" : "NO") << std::endl;
-    std::cout << "  - Anisotropy supported: " << (anisotropySupported ? "YES" : "NO") << std::endl;
+    CAE_LOG_DEBUG(RHI, "  - Is discrete GPU: " << (isDiscreteGPU ? "YES" : "NO"));
+    CAE_LOG_DEBUG(RHI, "  - Required anisotropy: " << (m_RequiredFeatures.samplerAnisotropy ? "YES" : "NO"));
+    CAE_LOG_DEBUG(RHI, "  - Supported anisotropy: " << (supportedFeatures.samplerAnisotropy ? "YES" : "NO"));
+    CAE_LOG_DEBUG(RHI, "  - Anisotropy supported: " << (anisotropySupported ? "YES" : "NO"));
 
     bool suitable = indices.isComplete()
         && extensionsSupported
@@ -252,7 +252,7 @@ bool PhysicalDevice::isDeviceSuitable(VkPhysicalDevice device)
         && isDiscreteGPU
         && storageImageSupported; // Add storage image support as a requirement
         
-    std::cout << "  - Device is suitable: " << (suitable ? "YES" : "NO") << std::endl;
+    CAE_LOG_DEBUG(RHI, "  - Device is suitable: " << (suitable ? "YES" : "NO"));
 
     return suitable;
 }
@@ -267,24 +267,28 @@ PhysicalDevice::QueueFamilyIndices PhysicalDevice::findQueueFamilies(VkPhysicalD
     std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
     vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilies.data());
 
+    bool transferOnlyFound = false;
     uint32_t i = 0;
     for (const auto& queueFamily : queueFamilies)
     {
-        if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT)
+        if ((queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) && !indices.graphicsFamily.has_value())
         {
             indices.graphicsFamily = i;
         }
 
         VkBool32 presentSupport = false;
         vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_Surface, &presentSupport);
-        if (presentSupport)
+        if (presentSupport && !indices.presentFamily.has_value())
         {
             indices.presentFamily = i;
         }
 
-        if (indices.isComplete())
+        // Compute queues implicitly support transfers; a transfer-only family is preferred over async compute
+        const VkQueueFlags flags = queueFamily.queueFlags;
+        if (!(flags & VK_QUEUE_GRAPHICS_BIT) && (flags & (VK_QUEUE_TRANSFER_BIT | VK_QUEUE_COMPUTE_BIT)) && !transferOnlyFound)
         {
-            break;
+            indices.transferFamily = i;
+            transferOnlyFound = !(flags & VK_QUEUE_COMPUTE_BIT);
         }
         i++;
     }
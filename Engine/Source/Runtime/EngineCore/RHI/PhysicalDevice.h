@@ -25,6 +25,9 @@ public:
     {
         std::optional<uint32_t> graphicsFamily;
         std::optional<uint32_t> presentFamily;
+        // Transfer-capable family without graphics support (DMA engine); unset on devices with a
+        // single queue family, which then upload on the graphics queue
+        std::optional<uint32_t> transferFamily;
 
         bool isComplete() const;
     };
@@ -1,8 +1,8 @@
 #include "RenderPass.h"
+#include "Runtime/EngineCore/Core/Log.h"
 #include <array>
 #include <vector>
 #include <stdexcept>
-#include <iostream>
 
 //
 // Will probably change this to use a builder pattern later
@@ -11,12 +11,12 @@ RenderPass::RenderPass(VkDevice device, VkFormat swapChainImageFormat, VkFormat
     : m_Device(device) 
 {
     createRenderPass(swapChainImageFormat, depthFormat);
-	std::cout << "RenderPass created." << std::endl;
+	CAE_LOG_TRACE(RHI, "RenderPass created.");
 }
 
 RenderPass::~RenderPass() {
     vkDestroyRenderPass(m_Device, m_RenderPass, nullptr);
-	std::cout << "RenderPass destroyed." << std::endl;
+	CAE_LOG_TRACE(RHI, "RenderPass destroyed.");
 }
 
 VkRenderPass RenderPass::get() const 
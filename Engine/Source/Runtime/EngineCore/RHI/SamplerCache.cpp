@@ -0,0 +1,105 @@
+#include "SamplerCache.h"
+
+#include "Device.h"
+#include "Runtime/EngineCore/Core/Log.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+bool SamplerCache::Desc::operator<(const Desc& other) const
+{
+    return std::tie(magFilter, minFilter, mipmapMode, addressModeU, addressModeV, addressModeW, maxAnisotropy,
+                    mipLodBias, minLod, maxLod, compareEnable, compareOp, borderColor) <
+           std::tie(other.magFilter, other.minFilter, other.mipmapMode, other.addressModeU, other.addressModeV,
+                    other.addressModeW, other.maxAnisotropy, other.mipLodBias, other.minLod, other.maxLod,
+                    other.compareEnable, other.compareOp, other.borderColor);
+}
+
+SamplerCache::SamplerCache(Device* pDevice, VkPhysicalDevice physicalDevice)
+    : m_pDevice(pDevice)
+{
+    VkPhysicalDeviceFeatures features{};
+    vkGetPhysicalDeviceFeatures(physicalDevice, &features);
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    // The renderer enables samplerAnisotropy whenever the device supports it
+    m_MaxAnisotropy = features.samplerAnisotropy ? properties.limits.maxSamplerAnisotropy : 1.0f;
+    m_MaxSamplerAllocations = properties.limits.maxSamplerAllocationCount;
+}
+
+SamplerCache::~SamplerCache()
+{
+    for (auto& entry : m_Samplers)
+    {
+        vkDestroySampler(m_pDevice->get(), entry.second, nullptr);
+    }
+    CAE_LOG_DEBUG(RHI, "SamplerCache destroyed (" << m_Stats.samplers << " samplers, " << m_Stats.hits << " of "
+        << m_Stats.requests << " requests shared)");
+}
+
+SamplerCache::Desc SamplerCache::normalize(const Desc& desc) const
+{
+    Desc normalized = desc;
+    normalized.maxAnisotropy = std::min(std::max(desc.maxAnisotropy, 1.0f), m_MaxAnisotropy);
+    if (normalized.compareEnable == VK_FALSE)
+    {
+        normalized.compareOp = VK_COMPARE_OP_ALWAYS;
+    }
+    return normalized;
+}
+
+VkSampler SamplerCache::getSampler(const Desc& desc)
+{
+    const Desc key = normalize(desc);
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    ++m_Stats.requests;
+
+    auto it = m_Samplers.find(key);
+    if (it != m_Samplers.end())
+    {
+        ++m_Stats.hits;
+        return it->second;
+    }
+
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = key.magFilter;
+    samplerInfo.minFilter = key.minFilter;
+    samplerInfo.mipmapMode = key.mipmapMode;
+    samplerInfo.addressModeU = key.addressModeU;
+    samplerInfo.addressModeV = key.addressModeV;
+    samplerInfo.addressModeW = key.addressModeW;
+    samplerInfo.mipLodBias = key.mipLodBias;
+    samplerInfo.anisotropyEnable = key.maxAnisotropy > 1.0f ? VK_TRUE : VK_FALSE;
+    samplerInfo.maxAnisotropy = key.maxAnisotropy;
+    samplerInfo.compareEnable = key.compareEnable;
+    samplerInfo.compareOp = key.compareOp;
+    samplerInfo.minLod = key.minLod;
+    samplerInfo.maxLod = key.maxLod;
+    samplerInfo.borderColor = key.borderColor;
+    samplerInfo.unnormalizedCoordinates = VK_FALSE;
+
+    VkSampler sampler;
+    if (vkCreateSampler(m_pDevice->get(), &samplerInfo, nullptr, &sampler) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create texture sampler!");
+    }
+
+    m_Samplers.emplace(key, sampler);
+    ++m_Stats.samplers;
+    if (m_Stats.samplers * 2 > m_MaxSamplerAllocations)
+    {
+        CAE_LOG_WARNING(RHI, "SamplerCache: " << m_Stats.samplers << " samplers, over half of the device limit of "
+            << m_MaxSamplerAllocations);
+    }
+    return sampler;
+}
+
+SamplerCache::Stats SamplerCache::getStats() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Stats;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+class Device;
+
+//
+// Deduplicates VkSamplers by their full create-info state. Every request for an equivalent state
+// returns the same handle, so materials can each pick their own filtering and addressing without
+// creating one sampler per material; drivers cap the number of live samplers
+// (maxSamplerAllocationCount, 4000 on many GPUs). Samplers live as long as the cache, which also
+// makes them safe to bake into descriptor set layouts as immutable samplers.
+//
+class SamplerCache
+{
+public:
+    // Mirrors VkSamplerCreateInfo. The defaults are trilinear, repeating, anisotropic filtering
+    struct Desc
+    {
+        VkFilter magFilter = VK_FILTER_LINEAR;
+        VkFilter minFilter = VK_FILTER_LINEAR;
+        VkSamplerMipmapMode mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+        VkSamplerAddressMode addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        VkSamplerAddressMode addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        VkSamplerAddressMode addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        float maxAnisotropy = 16.0f; // 1 or less disables anisotropy; clamped to the device limit
+        float mipLodBias = 0.0f;
+        float minLod = 0.0f;
+        float maxLod = VK_LOD_CLAMP_NONE;
+        VkBool32 compareEnable = VK_FALSE;
+        VkCompareOp compareOp = VK_COMPARE_OP_ALWAYS;
+        VkBorderColor borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+
+        bool operator<(const Desc& other) const;
+    };
+
+    struct Stats
+    {
+        size_t requests = 0;
+        size_t hits = 0;     // Requests served by an existing sampler
+        size_t samplers = 0; // Live VkSamplers
+    };
+
+    SamplerCache(Device* pDevice, VkPhysicalDevice physicalDevice);
+    ~SamplerCache();
+
+    SamplerCache(const SamplerCache&) = delete;
+    SamplerCache& operator=(const SamplerCache&) = delete;
+
+    VkSampler getSampler(const Desc& desc = Desc{});
+
+    Stats getStats() const;
+
+private:
+    // Applies device limits so states that end up identical on this device share one sampler
+    Desc normalize(const Desc& desc) const;
+
+    Device* m_pDevice;
+    float m_MaxAnisotropy = 1.0f; // 1 when the samplerAnisotropy feature is unsupported
+    uint32_t m_MaxSamplerAllocations = 0;
+
+    mutable std::mutex m_Mutex;
+    std::map<Desc, VkSampler> m_Samplers;
+    Stats m_Stats;
+};
@@ -0,0 +1,245 @@
+#include "StagingRing.h"
+
+#include "CommandPool.h"
+#include "Device.h"
+#include "Runtime/EngineCore/Core/Log.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+StagingRing::StagingRing(Device* pDevice, VmaAllocator allocator, const Settings& settings)
+    : m_pDevice(pDevice), m_Allocator(allocator), m_Capacity(alignUp(settings.size, 256))
+{
+    m_pBuffer = std::make_unique<Buffer>(
+        m_Allocator,
+        m_Capacity,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VMA_MEMORY_USAGE_CPU_ONLY,
+        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT);
+    m_pData = static_cast<uint8_t*>(m_pBuffer->map());
+}
+
+StagingRing::~StagingRing()
+{
+    if (m_OpenBytes != 0 || !m_OpenOverflowBuffers.empty())
+    {
+        CAE_LOG_WARNING(RHI, "StagingRing destroyed with " << m_OpenBytes / 1024 << " KB staged but never submitted");
+    }
+    while (!m_InFlight.empty())
+    {
+        retireOldest();
+    }
+    for (VkFence fence : m_FreeFences)
+    {
+        vkDestroyFence(m_pDevice->get(), fence, nullptr);
+    }
+    CAE_LOG_DEBUG(RHI, "StagingRing destroyed: " << m_Stats.allocations << " allocations (" << m_Stats.overflowAllocations
+        << " overflow), " << m_Stats.bytesAllocated / 1024 << " KB, " << m_Stats.segments << " submits, "
+        << m_Stats.fenceWaits << " waits");
+}
+
+VkDeviceSize StagingRing::getConsumedBytes(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset) const
+{
+    offset = alignUp(m_Head, alignment);
+    if (offset + size <= m_Capacity)
+    {
+        return offset + size - m_Head;
+    }
+
+    // Skip the tail end of the buffer; offset 0 satisfies any alignment
+    offset = 0;
+    return m_Capacity - m_Head + size;
+}
+
+bool StagingRing::fits(VkDeviceSize size, VkDeviceSize alignment) const
+{
+    if (size > m_Capacity)
+    {
+        return true; // Served by an overflow buffer
+    }
+    if (m_OpenBytes == 0)
+    {
+        return true; // Waiting for every in-flight segment always frees enough space
+    }
+    VkDeviceSize offset;
+    return m_OpenBytes + getConsumedBytes(size, alignment, offset) <= m_Capacity;
+}
+
+StagingRing::Allocation StagingRing::allocate(VkDeviceSize size, VkDeviceSize alignment)
+{
+    ++m_Stats.allocations;
+    m_Stats.bytesAllocated += size;
+
+    Allocation allocation;
+    if (size > m_Capacity)
+    {
+        auto pOverflow = std::make_unique<Buffer>(
+            m_Allocator,
+            size,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VMA_MEMORY_USAGE_CPU_ONLY,
+            VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT);
+        allocation.buffer = pOverflow->get();
+        allocation.pData = static_cast<uint8_t*>(pOverflow->map());
+        m_OpenOverflowBuffers.push_back(std::move(pOverflow));
+        ++m_Stats.overflowAllocations;
+        return allocation;
+    }
+
+    retireSignalled();
+    VkDeviceSize offset;
+    VkDeviceSize consumed = getConsumedBytes(size, alignment, offset);
+    while (m_UsedBytes + consumed > m_Capacity && !m_InFlight.empty())
+    {
+        ++m_Stats.fenceWaits;
+        retireOldest();
+    }
+
+    // With nothing live the ring restarts at 0, which keeps large allocations from wrapping needlessly
+    if (m_UsedBytes == 0)
+    {
+        m_Head = 0;
+        consumed = getConsumedBytes(size, alignment, offset);
+    }
+    if (m_UsedBytes + consumed > m_Capacity)
+    {
+        throw std::runtime_error("StagingRing: the open segment is full, submit it before staging more");
+    }
+
+    m_Head = (offset + size) % m_Capacity;
+    m_UsedBytes += consumed;
+    m_OpenBytes += consumed;
+
+    allocation.buffer = m_pBuffer->get();
+    allocation.offset = offset;
+    allocation.pData = m_pData + offset;
+    return allocation;
+}
+
+VkFence StagingRing::closeSegment()
+{
+    // A no-op on the host-coherent memory staging usually lands in
+    m_pBuffer->flush();
+
+    VkFence fence = VK_NULL_HANDLE;
+    if (!m_FreeFences.empty())
+    {
+        fence = m_FreeFences.back();
+        m_FreeFences.pop_back();
+    }
+    else
+    {
+        VkFenceCreateInfo fenceInfo{};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        if (vkCreateFence(m_pDevice->get(), &fenceInfo, nullptr, &fence) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create staging fence!");
+        }
+    }
+
+    pushOpenSegment(fence);
+    return fence;
+}
+
+void StagingRing::closeWaitedSegment()
+{
+    m_pBuffer->flush();
+    pushOpenSegment(VK_NULL_HANDLE);
+}
+
+void StagingRing::pushOpenSegment(VkFence fence)
+{
+    Segment segment;
+    segment.bytes = m_OpenBytes;
+    segment.fence = fence;
+    segment.overflowBuffers = std::move(m_OpenOverflowBuffers);
+    m_InFlight.push_back(std::move(segment));
+
+    m_OpenBytes = 0;
+    m_OpenOverflowBuffers.clear();
+    ++m_Stats.segments;
+}
+
+void StagingRing::retireSignalled()
+{
+    while (!m_InFlight.empty() &&
+        (m_InFlight.front().fence == VK_NULL_HANDLE || vkGetFenceStatus(m_pDevice->get(), m_InFlight.front().fence) == VK_SUCCESS))
+    {
+        retireOldest();
+    }
+}
+
+void StagingRing::retireOldest()
+{
+    Segment& segment = m_InFlight.front();
+    if (segment.fence != VK_NULL_HANDLE)
+    {
+        vkWaitForFences(m_pDevice->get(), 1, &segment.fence, VK_TRUE, UINT64_MAX);
+        vkResetFences(m_pDevice->get(), 1, &segment.fence);
+        m_FreeFences.push_back(segment.fence);
+    }
+    m_UsedBytes -= segment.bytes;
+    m_InFlight.pop_front();
+}
+
+void StagingRing::submitCopies(CommandPool* pCommandPool, VkQueue queue, const std::vector<VkBufferCopy>& regions,
+                               const std::vector<std::pair<VkBuffer, VkBuffer>>& buffers)
+{
+    VkCommandBuffer commandBuffer = pCommandPool->beginSingleTimeCommands();
+    for (size_t i = 0; i < regions.size(); ++i)
+    {
+        vkCmdCopyBuffer(commandBuffer, buffers[i].first, buffers[i].second, 1, &regions[i]);
+    }
+
+    // The destination buffers are used right after this returns, so the submission is waited on and
+    // the segment is reclaimed without a fence of its own
+    closeWaitedSegment();
+    pCommandPool->endSingleTimeCommands(commandBuffer, queue);
+}
+
+void StagingRing::uploadBuffers(CommandPool* pCommandPool, VkQueue queue, const std::vector<BufferUpload>& uploads)
+{
+    if (m_OpenBytes != 0 || !m_OpenOverflowBuffers.empty())
+    {
+        throw std::runtime_error("StagingRing: uploadBuffers called while other allocations are waiting to be submitted");
+    }
+
+    std::vector<VkBufferCopy> regions;
+    std::vector<std::pair<VkBuffer, VkBuffer>> buffers; // Source and destination of each region
+    for (const BufferUpload& upload : uploads)
+    {
+        if (upload.size == 0)
+        {
+            continue;
+        }
+        if (!fits(upload.size))
+        {
+            submitCopies(pCommandPool, queue, regions, buffers);
+            regions.clear();
+            buffers.clear();
+        }
+
+        Allocation allocation = allocate(upload.size);
+        memcpy(allocation.pData, upload.pData, static_cast<size_t>(upload.size));
+
+        VkBufferCopy copyRegion{};
+        copyRegion.srcOffset = allocation.offset;
+        copyRegion.dstOffset = upload.dstOffset;
+        copyRegion.size = upload.size;
+        regions.push_back(copyRegion);
+        buffers.emplace_back(allocation.buffer, upload.dstBuffer);
+    }
+
+    if (!regions.empty())
+    {
+        submitCopies(pCommandPool, queue, regions, buffers);
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include "vk_mem_alloc.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Buffer.h"
+
+class Device;
+class CommandPool;
+
+//
+// One persistently mapped staging buffer used as a ring for every CPU-to-GPU upload. Allocations
+// are handed out sequentially into the open segment; closeSegment() returns a fence that the
+// submission reading the segment must signal, and the segment's space is reclaimed once that fence
+// has signalled. Allocating into space still in flight waits on the oldest fences first. Uploads
+// larger than the ring get a dedicated buffer that is released with their segment. Space is reclaimed
+// in order, so only one user may have allocations waiting for closeSegment() at a time.
+//
+class StagingRing
+{
+public:
+    struct Settings
+    {
+        VkDeviceSize size = 32ull * 1024ull * 1024ull;
+    };
+
+    struct Allocation
+    {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+        uint8_t* pData = nullptr; // Mapped pointer to the start of the allocation
+    };
+
+    struct BufferUpload
+    {
+        const void* pData;
+        VkDeviceSize size;
+        VkBuffer dstBuffer;
+        VkDeviceSize dstOffset;
+    };
+
+    struct Stats
+    {
+        size_t allocations = 0;
+        size_t overflowAllocations = 0; // Uploads larger than the ring
+        size_t segments = 0;
+        size_t fenceWaits = 0;          // Allocations that had to wait for the GPU to free space
+        VkDeviceSize bytesAllocated = 0;
+    };
+
+    // Satisfies bufferOffset alignment for every texel, block and index size we upload
+    static constexpr VkDeviceSize DefaultAlignment = 16;
+
+    StagingRing(Device* pDevice, VmaAllocator allocator, const Settings& settings = Settings{});
+    ~StagingRing();
+
+    StagingRing(const StagingRing&) = delete;
+    StagingRing& operator=(const StagingRing&) = delete;
+
+    Allocation allocate(VkDeviceSize size, VkDeviceSize alignment = DefaultAlignment);
+    // True when size can be allocated without closing the open segment first. Callers that batch
+    // many uploads into one segment submit early when this turns false.
+    bool fits(VkDeviceSize size, VkDeviceSize alignment = DefaultAlignment) const;
+
+    // Ends the open segment. The returned fence must be signalled by exactly one queue submission that
+    // reads every allocation made since the previous close; the ring owns and recycles it.
+    VkFence closeSegment();
+    // Ends the open segment for a submission the caller waits on before the ring is used again, such as
+    // CommandPool::endSingleTimeCommands(). Call it before submitting; the segment needs no fence.
+    void closeWaitedSegment();
+
+    // Stages every range, records the copies into one command buffer, submits it on queue and waits.
+    // Uploads that do not fit in the ring together are split over several submissions. Must not be
+    // called while allocations made with allocate() are still waiting for their closeSegment().
+    void uploadBuffers(CommandPool* pCommandPool, VkQueue queue, const std::vector<BufferUpload>& uploads);
+
+    VkDeviceSize getCapacity() const { return m_Capacity; }
+    const Stats& getStats() const { return m_Stats; }
+
+private:
+    struct Segment
+    {
+        VkDeviceSize bytes = 0; // Ring bytes including alignment padding and wrap-around waste
+        VkFence fence = VK_NULL_HANDLE; // VK_NULL_HANDLE for a waited segment, which is already complete
+        std::vector<std::unique_ptr<Buffer>> overflowBuffers;
+    };
+
+    // Bytes the allocation would consume at the head and its offset, wrapping to 0 when it does not fit at the end
+    VkDeviceSize getConsumedBytes(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset) const;
+    void submitCopies(CommandPool* pCommandPool, VkQueue queue, const std::vector<VkBufferCopy>& regions,
+                      const std::vector<std::pair<VkBuffer, VkBuffer>>& buffers);
+    void pushOpenSegment(VkFence fence);
+    void retireSignalled();
+    void retireOldest();
+
+    Device* m_pDevice;
+    VmaAllocator m_Allocator;
+
+    std::unique_ptr<Buffer> m_pBuffer;
+    uint8_t* m_pData = nullptr;
+    VkDeviceSize m_Capacity = 0;
+    VkDeviceSize m_Head = 0;      // Next free byte; live data is the m_UsedBytes before it (wrapping)
+    VkDeviceSize m_UsedBytes = 0; // In-flight segments plus the open segment
+    VkDeviceSize m_OpenBytes = 0;
+    std::vector<std::unique_ptr<Buffer>> m_OpenOverflowBuffers;
+
+    std::deque<Segment> m_InFlight;
+    std::vector<VkFence> m_FreeFences;
+    Stats m_Stats;
+};
@@ -1,6 +1,6 @@
 #include "Surface.h"
+#include "Runtime/EngineCore/Core/Log.h"
 #include <stdexcept>
-#include <iostream>
 
 Surface::Surface(VkInstance vkInstance, GLFWwindow* window)
     : m_Instance(vkInstance), m_Surface(VK_NULL_HANDLE)
@@ -10,14 +10,14 @@ Surface::Surface(VkInstance vkInstance, GLFWwindow* window)
         throw std::runtime_error("Failed to create window surface!");
     }
 
-	std::cout << "Window surface created: " << static_cast<void*>(m_Surface) << std::endl;
+	CAE_LOG_TRACE(RHI, "Window surface created: " << static_cast<void*>(m_Surface));
 }
 
 Surface::~Surface() 
 {
     vkDestroySurfaceKHR(m_Instance, m_Surface, nullptr);
 
-	std::cout << "Window surface destroyed." << std::endl;
+	CAE_LOG_TRACE(RHI, "Window surface destroyed.");
 }
 
 VkSurfaceKHR Surface::get() const 
@@ -1,5 +1,5 @@
 #include "SwapChain.h"
-#include <iostream>
+#include "Runtime/EngineCore/Core/Log.h"
 
 SwapChain::SwapChain(VkDevice device, VkSurfaceKHR surface, VkSwapchainKHR swapChain,
                      std::vector<VkImage> images, std::vector<VkImageView> imageViews,
@@ -8,17 +8,17 @@ SwapChain::SwapChain(VkDevice device, VkSurfaceKHR surface, VkSwapchainKHR swapC
     m_Images(images), m_ImageViews(imageViews),
     m_ImageFormat(imageFormat), m_Extent(extent) 
 {
-	std::cout << "SwapChain created with " << m_Images.size() << " images and " << m_ImageViews.size() << " image views" << std::endl;
-	std::cout << "SwapChain extent: " << m_Extent.width << "x" << m_Extent.height << std::endl;
+	CAE_LOG_DEBUG(RHI, "SwapChain created with " << m_Images.size() << " images and " << m_ImageViews.size() << " image views");
+	CAE_LOG_DEBUG(RHI, "SwapChain extent: " << m_Extent.width << "x" << m_Extent.height);
 }
 
 SwapChain::~SwapChain() 
 {
-    std::cout << "SwapChain destructor called, destroying " << m_ImageViews.size() << " image views" << std::endl;
+    CAE_LOG_TRACE(RHI, "SwapChain destructor called, destroying " << m_ImageViews.size() << " image views");
 
     for (auto imageView : m_ImageViews) 
     {
-        std::cout << "Destroying image view: " << static_cast<void*>(imageView) << std::endl;
+        CAE_LOG_TRACE(RHI, "Destroying image view: " << static_cast<void*>(imageView));
         vkDestroyImageView(m_Device, imageView, nullptr);
     }
 
@@ -26,7 +26,7 @@ SwapChain::~SwapChain()
     {
         vkDestroySwapchainKHR(m_Device, m_SwapChain, nullptr);
     }
-	std::cout << "SwapChain destroyed" << std::endl;
+	CAE_LOG_TRACE(RHI, "SwapChain destroyed");
 }
 
 
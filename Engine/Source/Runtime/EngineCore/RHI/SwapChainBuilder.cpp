@@ -1,8 +1,8 @@
 #include "SwapChainBuilder.h"
 #include "SwapChain.h"
+#include "Runtime/EngineCore/Core/Log.h"
 #include <algorithm>
 #include <stdexcept>
-#include <iostream>
 #include <string>
 
 SwapChainBuilder& SwapChainBuilder::setDevice(VkDevice device)
@@ -65,7 +65,7 @@ SwapChain* SwapChainBuilder::build()
         throw std::runtime_error("SwapChainBuilder: Missing required parameters.");
     }
 
-    std::cout << "Building Swapchain" << std::endl;
+    CAE_LOG_DEBUG(RHI, "Building Swapchain");
 
     auto swapChainSupport = querySwapChainSupport();
 
@@ -165,7 +165,7 @@ SwapChain* SwapChainBuilder::build()
             throw std::runtime_error("SwapChainBuilder: Failed to create image views.");
         }
 
-        std::cout << "Created image view for swap chain image " << i << ": " << static_cast<void*>(imageViews[i]) << std::endl;
+        CAE_LOG_TRACE(RHI, "Created image view for swap chain image " << i << ": " << static_cast<void*>(imageViews[i]));
 
         if (imageViews[i] == VK_NULL_HANDLE)
         {
@@ -174,8 +174,8 @@ SwapChain* SwapChainBuilder::build()
 
         if (m_GraphicsFamilyIndex != m_PresentFamilyIndex)
         {
-            std::cout << "Using different queue families for graphics (" << m_GraphicsFamilyIndex 
-               << ") and presentation (" << m_PresentFamilyIndex << ")" << std::endl;
+            CAE_LOG_DEBUG(RHI, "Using different queue families for graphics (" << m_GraphicsFamilyIndex 
+                << ") and presentation (" << m_PresentFamilyIndex << ")");
 
         }
 
@@ -2,7 +2,7 @@
 #include <vulkan/vulkan.h>
 #include <vector>
 #include <stdexcept>
-#include <iostream>
+#include "Runtime/EngineCore/Core/Log.h"
 
 class SynchronizationObjects 
 {
@@ -30,10 +30,10 @@ public:
                 throw std::runtime_error("failed to create synchronization objects for a frame!");
             }
         }
-		std::cout << "Semaphores: " << m_ImageAvailableSemaphores.size() << " image available, " 
-               << m_RenderFinishedSemaphores.size() << " render finished,\n Fences " 
-               << m_InFlightFences.size() << " in flight fences" << std::endl;
-		std::cout << "Synchronization objects created" << std::endl;
+		CAE_LOG_TRACE(RHI, "Semaphores: " << m_ImageAvailableSemaphores.size() << " image available, " 
+		    << m_RenderFinishedSemaphores.size() << " render finished,\n Fences " 
+		    << m_InFlightFences.size() << " in flight fences");
+		CAE_LOG_TRACE(RHI, "Synchronization objects created");
     }
 
     ~SynchronizationObjects() 
@@ -43,7 +43,7 @@ public:
             vkDestroySemaphore(m_Device, m_ImageAvailableSemaphores[i], nullptr);
             vkDestroyFence(m_Device, m_InFlightFences[i], nullptr);
         }
-		std::cout << "Synchronization objects destroyed" << std::endl;
+		CAE_LOG_TRACE(RHI, "Synchronization objects destroyed");
     }
 
     const VkSemaphore* getImageAvailableSemaphore(size_t index) const 
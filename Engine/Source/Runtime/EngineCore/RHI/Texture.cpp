@@ -1,30 +1,58 @@
 #include "Texture.h"
 #include "Buffer.h"
 #include "Device.h"
-#include <stb_image.h>
+#include "HdrEncoder.h"
+#include "MipGenerator.h"
+#include "TextureUploadBatch.h"
+#include "Runtime/EngineCore/Core/Log.h"
+#include <cctype>
 #include <stdexcept>
-#include <iostream>
-
-VkSampler Texture::s_textureSampler = VK_NULL_HANDLE;
-size_t Texture::s_samplerUsers = 0;
 
 Texture::Texture(Device* pDevice, VmaAllocator allocator, CommandPool* pCommandPool,
-    const std::string& texturePath, VkPhysicalDevice physicalDevice, Format format)
+    const std::string& texturePath, VkPhysicalDevice physicalDevice, Format format,
+    TextureUploadBatch* pUploadBatch)
     : m_pDevice(pDevice), m_Allocator(allocator), m_pCommandPool(pCommandPool),
     m_TexturePath(texturePath), m_PhysicalDevice(physicalDevice),
     m_pTextureImage(nullptr), m_TextureImageView(VK_NULL_HANDLE), m_Format(format)
 {
-    std::cout << "Creating Texture: " << m_TexturePath << " with format " << (m_Format == Format::SRGB ? "SRGB" : "UNORM") << std::endl;
-    createTextureImage();
+    CAE_LOG_TRACE(Asset, "Creating Texture: " << m_TexturePath << " with format " << getFormatName(m_Format));
+    TextureDecoder::DecodedImage image;
+    TextureDecoder::decode(getDecodeRequest(m_TexturePath, m_Format), image);
+    createTextureImage(image, pUploadBatch);
     createTextureImageView();
 
-    // Increase sampler user count
-    if (s_textureSampler == VK_NULL_HANDLE) {
-        createTextureSampler(m_pDevice->get(), m_PhysicalDevice);
-    }
-    s_samplerUsers++;
+    CAE_LOG_TRACE(Asset, "Texture created: " << m_TexturePath);
+}
+
+Texture::Texture(Device* pDevice, VmaAllocator allocator, CommandPool* pCommandPool,
+    const TextureDecoder::DecodedImage& image, VkPhysicalDevice physicalDevice, Format format,
+    TextureUploadBatch* pUploadBatch)
+    : m_pDevice(pDevice), m_Allocator(allocator), m_pCommandPool(pCommandPool),
+    m_TexturePath(image.path), m_PhysicalDevice(physicalDevice),
+    m_pTextureImage(nullptr), m_TextureImageView(VK_NULL_HANDLE), m_Format(format)
+{
+    createTextureImage(image, pUploadBatch);
+    createTextureImageView();
+
+    CAE_LOG_TRACE(Asset, "Texture created: " << m_TexturePath);
+}
+
+Texture::Texture(Device* pDevice, VmaAllocator allocator, CommandPool* pCommandPool,
+    const std::string& name, VkPhysicalDevice physicalDevice, Format format,
+    uint32_t width, uint32_t height, const void* pPixels, TextureUploadBatch* pUploadBatch)
+    : m_pDevice(pDevice), m_Allocator(allocator), m_pCommandPool(pCommandPool),
+    m_TexturePath(name), m_PhysicalDevice(physicalDevice),
+    m_pTextureImage(nullptr), m_TextureImageView(VK_NULL_HANDLE), m_Format(format)
+{
+    uploadPixels(pPixels, width, height, pUploadBatch);
+    createTextureImageView();
 
-    std::cout << "Texture created: " << m_TexturePath << std::endl;
+    CAE_LOG_TRACE(Asset, "Texture created from memory: " << m_TexturePath << " (" << width << "x" << height << ")");
+}
+
+VkDeviceSize Texture::getMemorySize() const
+{
+    return m_MemorySize;
 }
 
 
@@ -32,47 +60,120 @@ Texture::~Texture()
 {
     vkDestroyImageView(m_pDevice->get(), m_TextureImageView, nullptr);
     delete m_pTextureImage;
-    s_samplerUsers--;
+	CAE_LOG_TRACE(Asset, "Texture destroyed: " << m_TexturePath);
+}
 
-    // Destroy sampler if no more users
-    if (s_samplerUsers == 0 && s_textureSampler != VK_NULL_HANDLE) 
+void Texture::createTextureImage(const TextureDecoder::DecodedImage& image, TextureUploadBatch* pUploadBatch)
+{
+    VkFormatProperties formatProperties;
+    vkGetPhysicalDeviceFormatProperties(m_PhysicalDevice, image.format, &formatProperties);
+    if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT))
     {
-        vkDestroySampler(m_pDevice->get(), s_textureSampler, nullptr);
-        s_textureSampler = VK_NULL_HANDLE;
+        throw std::runtime_error("Texture format " + std::to_string(image.format) + " is not supported by the device: " + m_TexturePath);
     }
-	std::cout << "Texture destroyed: " << m_TexturePath << std::endl;
+
+    m_Components = image.components;
+    uploadLevels(image.format, image.width, image.height, image.data.data(), image.data.size(), image.levels, pUploadBatch);
+
+    CAE_LOG_DEBUG(Asset, "Texture image created: " << m_TexturePath << " (" << image.width << "x" << image.height
+        << ", " << image.levels.size() << " mips, VkFormat " << image.format << ", "
+        << m_MemorySize / 1024 << " KB)");
 }
 
-void Texture::createTextureImage()
+bool Texture::isCompressedPath(const std::string& path)
 {
-    int texWidth, texHeight, texChannels;
-    stbi_uc* pixels = stbi_load(m_TexturePath.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
-    VkDeviceSize imageSize = texWidth * texHeight * 4;
+    const size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos)
+    {
+        return false;
+    }
+    std::string extension = path.substr(dot + 1);
+    for (char& c : extension)
+    {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return extension == "ktx2";
+}
 
-    if (!pixels)
+const char* Texture::getFormatName(Format format)
+{
+    switch (format)
     {
-        throw std::runtime_error("Failed to load texture image!");
+    case Format::SRGB:
+        return "SRGB";
+    case Format::UNORM:
+        return "UNORM";
+    case Format::HDR:
+        return "HDR";
+    case Format::Mask:
+        return "Mask";
+    case Format::TwoChannel:
+        return "TwoChannel";
+    case Format::MetallicRoughness:
+        return "MetallicRoughness";
     }
+    return "Unknown";
+}
 
-    // Create staging buffer
-    Buffer stagingBuffer(
-        m_Allocator,
-        imageSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VMA_MEMORY_USAGE_CPU_ONLY,
-        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
-        VMA_ALLOCATION_CREATE_MAPPED_BIT
-    );
+TextureDecoder::Request Texture::getDecodeRequest(const std::string& path, Format format, HdrEncoder::Encoding hdrEncoding)
+{
+    TextureDecoder::Request request;
+    request.path = path;
+    request.srgb = format == Format::SRGB;
+    request.hdr = format == Format::HDR;
+    request.hdrEncoding = hdrEncoding;
+    switch (format)
+    {
+    case Format::UNORM:
+        request.channels = TextureDecoder::Channels::Detect;
+        break;
+    case Format::Mask:
+        request.channels = TextureDecoder::Channels::R;
+        break;
+    case Format::TwoChannel:
+        request.channels = TextureDecoder::Channels::RG;
+        break;
+    case Format::MetallicRoughness:
+        request.channels = TextureDecoder::Channels::MetallicRoughness;
+        break;
+    default:
+        request.channels = TextureDecoder::Channels::RGBA;
+        break;
+    }
+    return request;
+}
 
-    // Copy image data to staging buffer
-    void* data = stagingBuffer.map();
-    memcpy(data, pixels, static_cast<size_t>(imageSize));
-    stagingBuffer.unmap();
+void Texture::uploadPixels(const void* pPixels, uint32_t texWidth, uint32_t texHeight, TextureUploadBatch* pUploadBatch)
+{
+    // Build the full mip chain up front so minified sampling reads the matching level
+    if (m_Format == Format::HDR)
+    {
+        std::vector<uint8_t> mipData;
+        std::vector<MipLevel> mipLevels;
+        const uint8_t* pBytes = static_cast<const uint8_t*>(pPixels);
+        std::vector<float> hdrPixels(static_cast<size_t>(texWidth) * texHeight * 4);
+        for (size_t i = 0; i < hdrPixels.size(); ++i)
+        {
+            hdrPixels[i] = pBytes[i] / 255.0f;
+        }
+        HdrEncoder::encode(hdrPixels.data(), texWidth, texHeight, HdrEncoder::Encoding::RGBA16F, mipData, mipLevels);
+        uploadLevels(HdrEncoder::getVkFormat(HdrEncoder::Encoding::RGBA16F), texWidth, texHeight, mipData.data(), mipData.size(), mipLevels, pUploadBatch);
+        return;
+    }
 
-    stbi_image_free(pixels);
+    // In-memory pixels count as 4-channel sources, so UNORM keeps RGBA while the packed formats still repack
+    TextureDecoder::DecodedImage image;
+    TextureDecoder::decodePixels(static_cast<const uint8_t*>(pPixels), texWidth, texHeight, 4,
+                                 getDecodeRequest(m_TexturePath, m_Format), image);
+    m_Components = image.components;
+    uploadLevels(image.format, texWidth, texHeight, image.data.data(), image.data.size(), image.levels, pUploadBatch);
+}
 
-    // Determine the Vulkan format based on the texture format
-    VkFormat vkFormat = (m_Format == Format::SRGB) ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+void Texture::uploadLevels(VkFormat vkFormat, uint32_t texWidth, uint32_t texHeight, const void* pData, VkDeviceSize size,
+                           const std::vector<MipLevel>& levels, TextureUploadBatch* pUploadBatch)
+{
+    m_VkFormat = vkFormat;
+    m_MemorySize = size;
 
     // Create texture image
     m_pTextureImage = new Image(m_pDevice, m_Allocator);
@@ -82,90 +183,29 @@ void Texture::createTextureImage()
         vkFormat,
         VK_IMAGE_TILING_OPTIMAL,
         VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-        VMA_MEMORY_USAGE_GPU_ONLY
+        VMA_MEMORY_USAGE_GPU_ONLY,
+        static_cast<uint32_t>(levels.size())
     );
 
-    // Transition image layouts and copy buffer to image
-    m_pTextureImage->transitionImageLayout(
-        m_pCommandPool,
-        m_pDevice->getGraphicsQueue(),
-        vkFormat,
-        VK_IMAGE_LAYOUT_UNDEFINED,
-        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-    );
-
-    m_pTextureImage->copyBufferToImage(
-        m_pCommandPool,
-        stagingBuffer.get(),
-        static_cast<uint32_t>(texWidth),
-        static_cast<uint32_t>(texHeight)
-    );
-
-    m_pTextureImage->transitionImageLayout(
-        m_pCommandPool,
-        m_pDevice->getGraphicsQueue(),
-        vkFormat,
-        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-    );
-
-    std::cout << "Texture image created: " << m_TexturePath << " (" << texWidth << "x" << texHeight 
-               << ", " << texChannels << " channels, format: " 
-               << (m_Format == Format::SRGB ? "SRGB" : "UNORM") << ")" << std::endl;
+    // Stage the data; the transitions and the copies are recorded when the batch is flushed
+    if (!pUploadBatch)
+    {
+        throw std::runtime_error("Texture: an upload batch is required for " + m_TexturePath);
+    }
+    m_UploadTicket = pUploadBatch->add(m_pTextureImage, pData, size, levels);
 }
 
 
 void Texture::createTextureImageView()
 {
-    VkFormat vkFormat = (m_Format == Format::SRGB) ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
     m_TextureImageView = m_pTextureImage->createImageView(
-        vkFormat,
-        VK_IMAGE_ASPECT_COLOR_BIT
+        m_VkFormat,
+        VK_IMAGE_ASPECT_COLOR_BIT,
+        m_Components
     );
 }
 
 
-void Texture::createTextureSampler(VkDevice device, VkPhysicalDevice physicalDevice) 
-{
-    VkSamplerCreateInfo samplerInfo{};
-    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
-
-    samplerInfo.magFilter = VK_FILTER_LINEAR;
-    samplerInfo.minFilter = VK_FILTER_LINEAR;
-
-    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-
-    VkPhysicalDeviceProperties properties{};
-    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
-
-    samplerInfo.anisotropyEnable = VK_TRUE;
-    samplerInfo.maxAnisotropy = properties.limits.maxSamplerAnisotropy;
-
-    samplerInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
-    samplerInfo.unnormalizedCoordinates = VK_FALSE;
-
-    samplerInfo.compareEnable = VK_FALSE;
-    samplerInfo.compareOp = VK_COMPARE_OP_ALWAYS;
-
-    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
-    samplerInfo.mipLodBias = 0.0f;
-    samplerInfo.minLod = 0.0f;
-    samplerInfo.maxLod = 0.0f;
-
-    if (vkCreateSampler(device, &samplerInfo, nullptr, &s_textureSampler) != VK_SUCCESS) 
-    {
-        throw std::runtime_error("Failed to create texture sampler!");
-    }
-	std::cout << "Texture sampler created" << std::endl;
-}
-
-VkSampler Texture::getTextureSampler() 
-{
-    return s_textureSampler;
-}
-
 VkImageView Texture::getTextureImageView() const 
 {
     return m_TextureImageView;
@@ -4,33 +4,68 @@
 #include "vk_mem_alloc.h"
 #include "CommandPool.h"
 #include "Image.h"
+#include "MipGenerator.h"
+#include "TextureDecoder.h"
 #include <string>
 
 //
-// Texture sampler will probably not be static later.
+// Sampled image with its full mip chain. Sampler state is not part of the texture; Materials get
+// their samplers from a SamplerCache.
 //
 class Device;
+class TextureUploadBatch;
 class Texture
 {
 public:
     enum class Format {
         SRGB,
         UNORM,
-        HDR
+        HDR, // Linear float data, stored as RGBA16F unless the decoder was asked for a packed encoding
+        Mask, // Red channel only, R8
+        TwoChannel, // Red and green, R8G8
+        MetallicRoughness // glTF metallic-roughness repacked to R8G8: R = metallic, G = roughness
     };
 
+    // Paths ending in .ktx2 load pre-compressed blocks and mips as stored; other images are decoded to the
+    // layout of the format. UNORM stores greyscale files as R8 (R8G8 with alpha) behind a swizzled view.
+    // The pixels are only staged into pUploadBatch; the texture is usable after the batch is flushed
     Texture(Device* pDevice, VmaAllocator allocator, CommandPool* pCommandPool,
-        const std::string& texturePath, VkPhysicalDevice physicalDevice, Format format = Format::SRGB);
+        const std::string& texturePath, VkPhysicalDevice physicalDevice, Format format,
+        TextureUploadBatch* pUploadBatch);
+    // Creates the texture from an image decoded ahead of time, e.g. by TextureDecoder::decodeAll on worker threads
+    Texture(Device* pDevice, VmaAllocator allocator, CommandPool* pCommandPool,
+        const TextureDecoder::DecodedImage& image, VkPhysicalDevice physicalDevice, Format format,
+        TextureUploadBatch* pUploadBatch);
+    // Creates the texture from RGBA8 pixels in memory; name is only used for logging. HDR textures
+    // take the pixels as linear values
+    Texture(Device* pDevice, VmaAllocator allocator, CommandPool* pCommandPool,
+        const std::string& name, VkPhysicalDevice physicalDevice, Format format,
+        uint32_t width, uint32_t height, const void* pPixels, TextureUploadBatch* pUploadBatch);
     ~Texture();
 
-    void createTextureImage();
+    void createTextureImage(const TextureDecoder::DecodedImage& image, TextureUploadBatch* pUploadBatch = nullptr);
     void createTextureImageView();
     VkImageView getTextureImageView() const;
 
-    static void createTextureSampler(VkDevice device, VkPhysicalDevice physicalDevice);
-    static VkSampler getTextureSampler();
+    const std::string& getPath() const { return m_TexturePath; }
+    Format getFormat() const { return m_Format; }
+    VkFormat getVkFormat() const { return m_VkFormat; }
+    uint32_t getWidth() const { return m_pTextureImage->getWidth(); }
+    uint32_t getHeight() const { return m_pTextureImage->getHeight(); }
+    VkDeviceSize getMemorySize() const;
+    // TransferQueue ticket of the pixel upload when the batch went through one, 0 when it completed synchronously
+    uint64_t getUploadTicket() const { return m_UploadTicket; }
+
+    static bool isCompressedPath(const std::string& path);
+    static const char* getFormatName(Format format);
+    static TextureDecoder::Request getDecodeRequest(const std::string& path, Format format,
+        HdrEncoder::Encoding hdrEncoding = HdrEncoder::Encoding::RGBA16F);
 
 private:
+    void uploadPixels(const void* pPixels, uint32_t width, uint32_t height, TextureUploadBatch* pUploadBatch);
+    void uploadLevels(VkFormat vkFormat, uint32_t width, uint32_t height, const void* pData, VkDeviceSize size,
+                      const std::vector<MipLevel>& levels, TextureUploadBatch* pUploadBatch);
+
     Device* m_pDevice;
     VmaAllocator m_Allocator;
     CommandPool* m_pCommandPool;
@@ -41,8 +76,9 @@ private:
     VkImageView m_TextureImageView;
 
     Format m_Format; // New member to store the texture format
-
-    static VkSampler s_textureSampler;
-    static size_t s_samplerUsers; // Reference count for the sampler
+    VkFormat m_VkFormat = VK_FORMAT_UNDEFINED;
+    VkComponentMapping m_Components = {};
+    VkDeviceSize m_MemorySize = 0; // All mip levels
+    uint64_t m_UploadTicket = 0;
 };
 
@@ -0,0 +1,231 @@
+#include "TextureCache.h"
+#include "Runtime/EngineCore/Core/Log.h"
+
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+
+namespace
+{
+    const char* getBuiltInName(TextureCache::BuiltIn builtIn)
+    {
+        switch (builtIn)
+        {
+        case TextureCache::BuiltIn::Black:
+            return "builtin:black";
+        case TextureCache::BuiltIn::White:
+            return "builtin:white";
+        case TextureCache::BuiltIn::FlatNormal:
+            return "builtin:flat_normal";
+        }
+        return "builtin:unknown";
+    }
+
+    void getBuiltInTexel(TextureCache::BuiltIn builtIn, uint8_t texel[4])
+    {
+        texel[3] = 255;
+        switch (builtIn)
+        {
+        case TextureCache::BuiltIn::Black:
+            texel[0] = texel[1] = texel[2] = 0;
+            break;
+        case TextureCache::BuiltIn::White:
+            texel[0] = texel[1] = texel[2] = 255;
+            break;
+        case TextureCache::BuiltIn::FlatNormal:
+            texel[0] = texel[1] = 128;
+            texel[2] = 255;
+            break;
+        }
+    }
+}
+
+TextureCache::TextureCache(Device* pDevice, VmaAllocator allocator, CommandPool* pCommandPool, VkPhysicalDevice physicalDevice,
+    const Settings& settings, StagingRing* pStagingRing, TransferQueue* pTransferQueue)
+    : m_pDevice(pDevice), m_Allocator(allocator), m_pCommandPool(pCommandPool), m_PhysicalDevice(physicalDevice), m_Settings(settings),
+    m_pStagingRing(pStagingRing), m_pTransferQueue(pTransferQueue)
+{
+    if (!m_pStagingRing && !m_pTransferQueue)
+    {
+        throw std::runtime_error("TextureCache: a staging ring or a transfer queue is required");
+    }
+}
+
+TextureCache::~TextureCache()
+{
+    if (!m_Entries.empty())
+    {
+        CAE_LOG_WARNING(Asset, "TextureCache destroyed with " << m_Entries.size() << " textures still referenced");
+    }
+    for (auto& entry : m_Entries)
+    {
+        delete entry.second.pTexture;
+    }
+}
+
+std::string TextureCache::normalizePath(const std::string& path)
+{
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+Texture* TextureCache::acquire(const std::string& path, Texture::Format format)
+{
+    return acquireEntry(Key(normalizePath(path), format), BuiltIn::Black, false);
+}
+
+Texture* TextureCache::acquire(BuiltIn builtIn, Texture::Format format)
+{
+    return acquireEntry(Key(getBuiltInName(builtIn), format), builtIn, true);
+}
+
+void TextureCache::acquire(const std::vector<Request>& requests, std::vector<Texture*>& textures)
+{
+    // Collect the distinct files that are not resident yet; decoding happens without the lock held
+    std::vector<TextureDecoder::Request> decodeRequests;
+    std::map<Key, size_t> decodeIndices;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for (const Request& request : requests)
+        {
+            if (request.path.empty())
+            {
+                continue;
+            }
+            Key key(normalizePath(request.path), request.format);
+            if (m_Entries.find(key) == m_Entries.end() && decodeIndices.find(key) == decodeIndices.end())
+            {
+                decodeIndices.emplace(key, decodeRequests.size());
+                decodeRequests.push_back(Texture::getDecodeRequest(key.first, request.format, m_Settings.hdrEncoding));
+            }
+        }
+    }
+
+    std::vector<TextureDecoder::DecodedImage> images;
+    const auto decodeStart = std::chrono::steady_clock::now();
+    TextureDecoder::decodeAll(decodeRequests, images);
+    const double decodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - decodeStart).count();
+
+    // Creation and staging stay on this thread, in request order
+    textures.clear();
+    textures.reserve(requests.size());
+    for (const Request& request : requests)
+    {
+        if (request.path.empty())
+        {
+            textures.push_back(acquire(request.fallback, request.format));
+            continue;
+        }
+
+        Key key(normalizePath(request.path), request.format);
+        auto decoded = decodeIndices.find(key);
+        textures.push_back(acquireEntry(key, BuiltIn::Black, false, decoded != decodeIndices.end() ? &images[decoded->second] : nullptr));
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stats.decodeMs += decodeMs;
+}
+
+Texture* TextureCache::acquireEntry(const Key& key, BuiltIn builtIn, bool isBuiltIn, const TextureDecoder::DecodedImage* pDecoded)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    ++m_Stats.requests;
+
+    auto it = m_Entries.find(key);
+    if (it != m_Entries.end())
+    {
+        ++it->second.references;
+        ++m_Stats.hits;
+        m_Stats.bytesSaved += it->second.pTexture->getMemorySize();
+        return it->second.pTexture;
+    }
+
+    if (!m_pUploadBatch)
+    {
+        m_pUploadBatch = std::make_unique<TextureUploadBatch>(m_pDevice, m_Allocator, m_pCommandPool, m_pStagingRing, m_pTransferQueue);
+    }
+    TextureUploadBatch* pUploadBatch = m_pUploadBatch.get();
+    Texture* pTexture = nullptr;
+    if (isBuiltIn)
+    {
+        uint8_t texel[4];
+        getBuiltInTexel(builtIn, texel);
+        pTexture = new Texture(m_pDevice, m_Allocator, m_pCommandPool, key.first, m_PhysicalDevice, key.second, 1, 1, texel, pUploadBatch);
+    }
+    else if (pDecoded)
+    {
+        pTexture = new Texture(m_pDevice, m_Allocator, m_pCommandPool, *pDecoded, m_PhysicalDevice, key.second, pUploadBatch);
+    }
+    else
+    {
+        TextureDecoder::DecodedImage image;
+        TextureDecoder::decode(Texture::getDecodeRequest(key.first, key.second, m_Settings.hdrEncoding), image);
+        pTexture = new Texture(m_pDevice, m_Allocator, m_pCommandPool, image, m_PhysicalDevice, key.second, pUploadBatch);
+    }
+
+    if (m_BatchDepth == 0)
+    {
+        pUploadBatch->flush();
+    }
+
+    m_Entries.emplace(key, Entry{ pTexture, 1 });
+    m_Keys.emplace(pTexture, key);
+    ++m_Stats.loads;
+    ++m_Stats.liveTextures;
+    m_Stats.residentBytes += pTexture->getMemorySize();
+    return pTexture;
+}
+
+void TextureCache::release(Texture* pTexture)
+{
+    if (pTexture == nullptr)
+    {
+        return;
+    }
+
+    Texture* pDestroyed = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto keyIt = m_Keys.find(pTexture);
+        if (keyIt == m_Keys.end())
+        {
+            throw std::runtime_error("TextureCache: releasing a texture that is not owned by the cache");
+        }
+
+        auto entryIt = m_Entries.find(keyIt->second);
+        if (--entryIt->second.references == 0)
+        {
+            pDestroyed = entryIt->second.pTexture;
+            --m_Stats.liveTextures;
+            m_Stats.residentBytes -= pDestroyed->getMemorySize();
+            m_Entries.erase(entryIt);
+            m_Keys.erase(keyIt);
+        }
+    }
+
+    delete pDestroyed;
+}
+
+void TextureCache::beginBatch()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    ++m_BatchDepth;
+}
+
+void TextureCache::endBatch()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_BatchDepth == 0)
+    {
+        throw std::runtime_error("TextureCache: endBatch without matching beginBatch");
+    }
+    if (--m_BatchDepth == 0 && m_pUploadBatch)
+    {
+        m_pUploadBatch->flush();
+    }
+}
+
+TextureCache::Stats TextureCache::getStats() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Stats;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include "vk_mem_alloc.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Texture.h"
+#include "TextureUploadBatch.h"
+
+class Device;
+class CommandPool;
+class StagingRing;
+class TransferQueue;
+
+//
+// Reference-counted texture cache keyed on (path, Texture::Format). Every request for the same
+// file and format returns the same Texture, so it is decoded and uploaded once. Built-in 1x1
+// textures are generated in memory and never touch the file system. Textures are destroyed when
+// their last reference is released.
+//
+class TextureCache
+{
+public:
+    enum class BuiltIn
+    {
+        Black,      // (0, 0, 0, 255)
+        White,      // (255, 255, 255, 255)
+        FlatNormal  // (128, 128, 255, 255), tangent-space +Z
+    };
+
+    struct Settings
+    {
+        // Storage for Format::HDR textures: RGBA16F keeps alpha and full half precision, the packed
+        // 32-bit encodings halve the memory again for opaque data such as environment maps
+        HdrEncoder::Encoding hdrEncoding = HdrEncoder::Encoding::RGBA16F;
+    };
+
+    // An empty path resolves to the fallback built-in
+    struct Request
+    {
+        std::string path;
+        Texture::Format format = Texture::Format::SRGB;
+        BuiltIn fallback = BuiltIn::Black;
+    };
+
+    struct Stats
+    {
+        size_t requests = 0;
+        size_t loads = 0;          // Decodes and uploads actually performed
+        size_t hits = 0;           // Requests served by an existing texture
+        size_t liveTextures = 0;
+        VkDeviceSize residentBytes = 0;
+        VkDeviceSize bytesSaved = 0; // Texture memory not allocated thanks to hits
+        double decodeMs = 0.0;       // Wall time of parallel decoding in acquire(requests)
+    };
+
+    // Needs pStagingRing or pTransferQueue. Without a queue uploads are staged through pStagingRing and waited
+    // on. With pTransferQueue they run asynchronously instead: a new texture may only be sampled, or released,
+    // once pTransferQueue->isAcquired(texture->getUploadTicket()).
+    TextureCache(Device* pDevice, VmaAllocator allocator, CommandPool* pCommandPool, VkPhysicalDevice physicalDevice,
+        const Settings& settings, StagingRing* pStagingRing, TransferQueue* pTransferQueue);
+    ~TextureCache();
+
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    // Each acquire must be paired with a release of the returned texture
+    Texture* acquire(const std::string& path, Texture::Format format = Texture::Format::SRGB);
+    Texture* acquire(BuiltIn builtIn, Texture::Format format = Texture::Format::SRGB);
+    // Acquires many textures at once: every file not yet cached is decoded in parallel on worker
+    // threads, then textures are created and staged on the calling thread in request order.
+    // textures[i] matches requests[i]; each must be released like a single acquire.
+    void acquire(const std::vector<Request>& requests, std::vector<Texture*>& textures);
+    void release(Texture* pTexture);
+
+    // Between beginBatch() and endBatch() new textures are staged into one TextureUploadBatch and
+    // must not be sampled before endBatch() submits it. Calls may nest; the outermost end submits.
+    // Outside a batch each new texture is submitted on its own.
+    void beginBatch();
+    void endBatch();
+
+    Stats getStats() const;
+
+private:
+    struct Entry
+    {
+        Texture* pTexture = nullptr;
+        size_t references = 0;
+    };
+
+    using Key = std::pair<std::string, Texture::Format>;
+
+    Texture* acquireEntry(const Key& key, BuiltIn builtIn, bool isBuiltIn, const TextureDecoder::DecodedImage* pDecoded = nullptr);
+    static std::string normalizePath(const std::string& path);
+
+    Device* m_pDevice;
+    VmaAllocator m_Allocator;
+    CommandPool* m_pCommandPool;
+    VkPhysicalDevice m_PhysicalDevice;
+    Settings m_Settings;
+    StagingRing* m_pStagingRing;
+    TransferQueue* m_pTransferQueue;
+
+    mutable std::mutex m_Mutex;
+    std::map<Key, Entry> m_Entries;
+    std::unordered_map<const Texture*, Key> m_Keys;
+    std::unique_ptr<TextureUploadBatch> m_pUploadBatch; // Created on first use, flushed at the end of every acquire batch
+    uint32_t m_BatchDepth = 0;
+    Stats m_Stats;
+};
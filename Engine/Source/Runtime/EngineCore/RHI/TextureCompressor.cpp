@@ -0,0 +1,115 @@
+#include "TextureCompressor.h"
+
+#include "Ktx2File.h"
+#include "MipGenerator.h"
+#include "Runtime/EngineCore/Core/Log.h"
+
+#include <stb_image.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    bool isOpaque(const uint8_t* pPixels, size_t texelCount)
+    {
+        for (size_t i = 0; i < texelCount; ++i)
+        {
+            if (pPixels[i * 4 + 3] != 255)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+std::string TextureCompressor::getCookedPath(const std::string& sourcePath)
+{
+    const size_t dot = sourcePath.find_last_of('.');
+    const size_t slash = sourcePath.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+    {
+        return sourcePath + ".ktx2";
+    }
+    return sourcePath.substr(0, dot) + ".ktx2";
+}
+
+void TextureCompressor::cook(const std::string& sourcePath, const std::string& cookedPath, Usage usage,
+                             const Settings& settings, Stats* pStats)
+{
+    const auto startTime = std::chrono::high_resolution_clock::now();
+
+    int width, height, channels;
+    stbi_uc* pixels = stbi_load(sourcePath.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    if (!pixels)
+    {
+        throw std::runtime_error("Failed to load texture for compression: " + sourcePath);
+    }
+
+    BlockCompressor::Format blockFormat = BlockCompressor::Format::BC7;
+    VkFormat vkFormat = VK_FORMAT_BC7_SRGB_BLOCK;
+    uint32_t blockChannels[2] = { 0, 1 };
+    switch (usage)
+    {
+    case Usage::Albedo:
+        if (settings.bc1ForOpaqueAlbedo && isOpaque(pixels, static_cast<size_t>(width) * height))
+        {
+            blockFormat = BlockCompressor::Format::BC1;
+            vkFormat = VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+        }
+        break;
+    case Usage::Normal:
+        blockFormat = BlockCompressor::Format::BC5;
+        vkFormat = VK_FORMAT_BC5_UNORM_BLOCK;
+        break;
+    case Usage::Mask:
+        blockFormat = BlockCompressor::Format::BC4;
+        vkFormat = VK_FORMAT_BC4_UNORM_BLOCK;
+        break;
+    case Usage::MetallicRoughness:
+        blockFormat = BlockCompressor::Format::BC5;
+        vkFormat = VK_FORMAT_BC5_UNORM_BLOCK;
+        blockChannels[0] = 2;
+        blockChannels[1] = 1;
+        break;
+    }
+
+    std::vector<uint8_t> mipData;
+    std::vector<MipLevel> mipLevels;
+    MipGenerator::generate(pixels, static_cast<uint32_t>(width), static_cast<uint32_t>(height), 4, usage == Usage::Albedo, mipData, mipLevels);
+    stbi_image_free(pixels);
+
+    std::vector<uint8_t> compressedData;
+    std::vector<MipLevel> compressedLevels;
+    std::vector<uint8_t> levelBlocks;
+    for (const MipLevel& level : mipLevels)
+    {
+        BlockCompressor::compress(mipData.data() + level.offset, level.width, level.height, blockFormat, blockChannels, levelBlocks);
+
+        MipLevel compressedLevel = level;
+        compressedLevel.offset = compressedData.size();
+        compressedLevel.size = levelBlocks.size();
+        compressedLevels.push_back(compressedLevel);
+        compressedData.insert(compressedData.end(), levelBlocks.begin(), levelBlocks.end());
+    }
+
+    Ktx2File::write(cookedPath, vkFormat, static_cast<uint32_t>(width), static_cast<uint32_t>(height), compressedData, compressedLevels);
+
+    const double encodeMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+    CAE_LOG_INFO(Asset, "Texture cooked: " << sourcePath << " -> " << cookedPath << " (" << width << "x" << height << ", "
+        << mipLevels.size() << " mips, " << mipData.size() / 1024 << " KB -> " << compressedData.size() / 1024
+        << " KB, " << encodeMs << " ms)");
+
+    if (pStats)
+    {
+        pStats->format = vkFormat;
+        pStats->width = static_cast<uint32_t>(width);
+        pStats->height = static_cast<uint32_t>(height);
+        pStats->mipCount = static_cast<uint32_t>(mipLevels.size());
+        pStats->sourceBytes = mipData.size();
+        pStats->compressedBytes = compressedData.size();
+        pStats->encodeMs = encodeMs;
+    }
+}
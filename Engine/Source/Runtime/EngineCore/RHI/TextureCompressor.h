@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <string>
+
+#include "BlockCompressor.h"
+
+//
+// Offline texture cook: decodes a source image, builds its mip chain and block-compresses every
+// level into a KTX2 file. The BC format follows from how the texture is used:
+//   Albedo            - BC7 sRGB (BC1 sRGB for opaque images when bc1ForOpaqueAlbedo is set)
+//   Normal            - BC5 holding tangent-space X/Y only
+//   Mask              - BC4 of the red channel
+//   MetallicRoughness - BC5 with R = metallic (glTF blue), G = roughness (glTF green)
+// Model requests the uncompressed fallbacks in the same layouts (normals as TwoChannel, metallic-roughness
+// repacked), so a material shader always rebuilds the normal's Z as sqrt(max(1 - x^2 - y^2, 0)) and reads
+// metallic from R and roughness from G, whichever path loaded the texture.
+//
+class TextureCompressor
+{
+public:
+    enum class Usage
+    {
+        Albedo,
+        Normal,
+        Mask,
+        MetallicRoughness
+    };
+
+    struct Settings
+    {
+        bool bc1ForOpaqueAlbedo = false; // Halves albedo size again at a visible quality cost
+    };
+
+    struct Stats
+    {
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t mipCount = 0;
+        size_t sourceBytes = 0;     // RGBA8 size of the full chain
+        size_t compressedBytes = 0;
+        double encodeMs = 0.0;
+    };
+
+    static void cook(const std::string& sourcePath, const std::string& cookedPath, Usage usage,
+                     const Settings& settings = Settings{}, Stats* pStats = nullptr);
+
+    // Path of the cooked file next to a source image (extension replaced with .ktx2)
+    static std::string getCookedPath(const std::string& sourcePath);
+};
@@ -0,0 +1,216 @@
+#include "TextureDecoder.h"
+
+#include "Ktx2File.h"
+#include "Texture.h"
+#include "Runtime/EngineCore/Core/FileScan.h"
+#include "Runtime/EngineCore/Core/ParallelFor.h"
+#include "Runtime/EngineCore/Core/Log.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+void TextureDecoder::decode(const Request& request, DecodedImage& image, bool parallelMips)
+{
+    image = DecodedImage{};
+    image.path = request.path;
+
+    if (Texture::isCompressedPath(request.path))
+    {
+        Ktx2File file(request.path);
+        image.format = file.getFormat();
+        image.width = file.getWidth();
+        image.height = file.getHeight();
+        image.levels = file.getLevels();
+        image.data.assign(file.getLevelData(), file.getLevelData() + file.getLevelDataSize());
+        return;
+    }
+
+    int width, height, channels;
+    if (request.hdr)
+    {
+        // 8-bit files are promoted here rather than by stbi_loadf, which would apply a 2.2 gamma
+        float* pLoadedPixels = nullptr;
+        std::vector<float> promotedPixels;
+        if (stbi_is_hdr(request.path.c_str()))
+        {
+            pLoadedPixels = stbi_loadf(request.path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+            if (!pLoadedPixels)
+            {
+                throw std::runtime_error("Failed to load HDR texture image: " + request.path + " (" + stbi_failure_reason() + ")");
+            }
+        }
+        else
+        {
+            stbi_uc* pixels = stbi_load(request.path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+            if (!pixels)
+            {
+                throw std::runtime_error("Failed to load texture image: " + request.path + " (" + stbi_failure_reason() + ")");
+            }
+            promotedPixels.resize(static_cast<size_t>(width) * height * 4);
+            for (size_t i = 0; i < promotedPixels.size(); ++i)
+            {
+                promotedPixels[i] = pixels[i] / 255.0f;
+            }
+            stbi_image_free(pixels);
+        }
+
+        image.format = HdrEncoder::getVkFormat(request.hdrEncoding);
+        image.width = static_cast<uint32_t>(width);
+        image.height = static_cast<uint32_t>(height);
+        image.sourceChannels = static_cast<uint32_t>(channels);
+        HdrEncoder::encode(pLoadedPixels ? pLoadedPixels : promotedPixels.data(), image.width, image.height,
+                           request.hdrEncoding, image.data, image.levels, parallelMips);
+        stbi_image_free(pLoadedPixels);
+        return;
+    }
+
+    stbi_uc* pixels = stbi_load(request.path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    if (!pixels)
+    {
+        throw std::runtime_error("Failed to load texture image: " + request.path + " (" + stbi_failure_reason() + ")");
+    }
+
+    decodePixels(pixels, static_cast<uint32_t>(width), static_cast<uint32_t>(height), static_cast<uint32_t>(channels),
+                 request, image, parallelMips);
+    stbi_image_free(pixels);
+}
+
+void TextureDecoder::decodePixels(const uint8_t* pPixels, uint32_t width, uint32_t height, uint32_t sourceChannels,
+                                  const Request& request, DecodedImage& image, bool parallelMips)
+{
+    image.width = width;
+    image.height = height;
+    image.sourceChannels = sourceChannels;
+    image.components = {};
+
+    // Source channel for each packed channel; stb expands greyscale to RGB, so red holds the luminance
+    uint32_t sources[2] = { 0, 0 };
+    uint32_t channelCount = 4;
+    switch (request.srgb ? Channels::RGBA : request.channels)
+    {
+    case Channels::RGBA:
+        break;
+    case Channels::Detect:
+        if (sourceChannels == 1)
+        {
+            channelCount = 1;
+            image.components = { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_ONE };
+        }
+        else if (sourceChannels == 2)
+        {
+            channelCount = 2;
+            sources[1] = 3;
+            image.components = { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G };
+        }
+        break;
+    case Channels::R:
+        channelCount = 1;
+        break;
+    case Channels::RG:
+        channelCount = 2;
+        sources[1] = 1;
+        break;
+    case Channels::MetallicRoughness:
+        channelCount = 2;
+        sources[0] = 2;
+        sources[1] = 1;
+        break;
+    }
+
+    switch (channelCount)
+    {
+    case 1:
+        image.format = VK_FORMAT_R8_UNORM;
+        break;
+    case 2:
+        image.format = VK_FORMAT_R8G8_UNORM;
+        break;
+    default:
+        image.format = request.srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+        break;
+    }
+
+    if (channelCount == 4)
+    {
+        MipGenerator::generate(pPixels, width, height, 4, request.srgb, image.data, image.levels, parallelMips);
+        return;
+    }
+
+    const size_t texelCount = static_cast<size_t>(width) * height;
+    std::vector<uint8_t> packed(texelCount * channelCount);
+    for (size_t i = 0; i < texelCount; ++i)
+    {
+        for (uint32_t c = 0; c < channelCount; ++c)
+        {
+            packed[i * channelCount + c] = pPixels[i * 4 + sources[c]];
+        }
+    }
+    MipGenerator::generate(packed.data(), width, height, channelCount, false, image.data, image.levels, parallelMips);
+}
+
+void TextureDecoder::decodeAll(const std::vector<Request>& requests, std::vector<DecodedImage>& images, size_t maxThreads)
+{
+    images.clear();
+    images.resize(requests.size());
+
+    // Images are the unit of parallelism; a lone image parallelizes its mip generation instead
+    const bool parallelMips = requests.size() == 1;
+    parallelFor(requests.size(), [&](size_t i)
+    {
+        decode(requests[i], images[i], parallelMips);
+    }, maxThreads);
+}
+
+void TextureDecoder::runBenchmark(const std::string& folder)
+{
+    std::vector<Request> requests;
+    for (const std::string& path : findFiles(folder, { ".png", ".jpg", ".jpeg", ".tga", ".bmp" }))
+    {
+        requests.push_back({ path, true });
+    }
+    for (const std::string& path : findFiles(folder, { ".hdr" }))
+    {
+        requests.push_back({ path, false, true, HdrEncoder::Encoding::B10G11R11 });
+    }
+
+    if (requests.empty())
+    {
+        CAE_LOG_INFO(Asset, "Texture decode benchmark: no images in " << folder);
+        return;
+    }
+
+    const size_t coreCount = std::max(1u, std::thread::hardware_concurrency());
+    CAE_LOG_INFO(Asset, "Texture decode benchmark: " << requests.size() << " images from " << folder);
+
+    double singleThreadSeconds = 0.0;
+    for (size_t threads = 1;; threads = std::min(threads * 2, coreCount))
+    {
+        std::vector<DecodedImage> images;
+        const auto start = std::chrono::steady_clock::now();
+        decodeAll(requests, images, threads);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        size_t megapixels = 0;
+        for (const DecodedImage& image : images)
+        {
+            megapixels += static_cast<size_t>(image.width) * image.height;
+        }
+        if (threads == 1)
+        {
+            singleThreadSeconds = seconds;
+        }
+
+        CAE_LOG_INFO(Asset, "  " << threads << " threads: " << seconds * 1000.0 << " ms, "
+            << requests.size() / seconds << " images/s, " << megapixels / 1.0e6 / seconds << " MPix/s, "
+            << "speedup " << singleThreadSeconds / seconds << "x");
+
+        if (threads == coreCount)
+        {
+            break;
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "HdrEncoder.h"
+#include "MipGenerator.h"
+
+//
+// CPU half of a texture load: file read, image decode and mip generation, producing a chain
+// ready to be copied into staging memory. Decoding touches no Vulkan objects, so many images can
+// be decoded on worker threads while the GPU-side creation and upload stay on the caller in order.
+//
+class TextureDecoder
+{
+public:
+    // Texel layout of decoded 8-bit images. Packed layouts are always UNORM; sRGB requests keep RGBA
+    enum class Channels
+    {
+        RGBA,
+        Detect,            // Greyscale files become R8 and grey-alpha R8G8, swizzled back to (L, L, L, A)
+        R,                 // Red channel only as R8, e.g. masks
+        RG,                // Red and green as R8G8
+        MetallicRoughness  // glTF metallic (B) and roughness (G) repacked to R8G8: R = metallic, G = roughness
+    };
+
+    struct Request
+    {
+        std::string path;
+        bool srgb = true; // Selects sRGB-correct mip filtering and an sRGB VkFormat for decoded images
+        bool hdr = false; // Decodes to linear float and converts to hdrEncoding instead of RGBA8
+        Channels channels = Channels::RGBA;
+        HdrEncoder::Encoding hdrEncoding = HdrEncoder::Encoding::RGBA16F;
+    };
+
+    struct DecodedImage
+    {
+        std::string path;
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t sourceChannels = 0;
+        VkComponentMapping components = {}; // View swizzle, identity unless a packed layout expands channels
+        std::vector<uint8_t> data;
+        std::vector<MipLevel> levels;
+    };
+
+    // Decodes one image; .ktx2 files are read as stored, anything else goes through stb_image.
+    // HDR requests accept Radiance .hdr files; 8-bit images are promoted to float as linear values
+    static void decode(const Request& request, DecodedImage& image, bool parallelMips = true);
+
+    // Packs RGBA8 pixels to the request's channel layout and builds the mip chain; sourceChannels is the
+    // channel count of the original file, used by Channels::Detect
+    static void decodePixels(const uint8_t* pPixels, uint32_t width, uint32_t height, uint32_t sourceChannels,
+                             const Request& request, DecodedImage& image, bool parallelMips = true);
+
+    // Decodes every request with parallelFor; images[i] matches requests[i]. maxThreads 0 uses all cores.
+    static void decodeAll(const std::vector<Request>& requests, std::vector<DecodedImage>& images, size_t maxThreads = 0);
+
+    // Logs decode throughput for every PNG/JPEG/TGA/BMP/HDR in a folder at 1, 2, 4, ... threads up to the core count
+    static void runBenchmark(const std::string& folder);
+};
@@ -0,0 +1,182 @@
+#include "TextureUploadBatch.h"
+
+#include "CommandPool.h"
+#include "Device.h"
+#include "Image.h"
+#include "TransferQueue.h"
+#include "Runtime/EngineCore/Core/Log.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    VkImageMemoryBarrier2 makeBarrier(const Image* pImage, VkImageLayout oldLayout, VkImageLayout newLayout)
+    {
+        VkImageMemoryBarrier2 barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+        barrier.oldLayout = oldLayout;
+        barrier.newLayout = newLayout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = pImage->getImage();
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseMipLevel = 0;
+        barrier.subresourceRange.levelCount = pImage->getMipLevels();
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = 1;
+
+        if (newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
+        {
+            barrier.srcStageMask = VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT;
+            barrier.srcAccessMask = 0;
+            barrier.dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+            barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        }
+        else
+        {
+            barrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+            barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+            barrier.dstStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+            barrier.dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT;
+        }
+        return barrier;
+    }
+
+    void recordBarriers(VkCommandBuffer commandBuffer, const std::vector<VkImageMemoryBarrier2>& barriers)
+    {
+        VkDependencyInfo dependencyInfo{};
+        dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(barriers.size());
+        dependencyInfo.pImageMemoryBarriers = barriers.data();
+        vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+    }
+}
+
+TextureUploadBatch::TextureUploadBatch(Device* pDevice, VmaAllocator allocator, CommandPool* pCommandPool, StagingRing* pStagingRing,
+    TransferQueue* pTransferQueue)
+    : m_pDevice(pDevice), m_Allocator(allocator), m_pCommandPool(pCommandPool), m_pStagingRing(pStagingRing),
+    m_pTransferQueue(pTransferQueue)
+{
+    if (!m_pStagingRing && !m_pTransferQueue)
+    {
+        throw std::runtime_error("TextureUploadBatch: a staging ring or a transfer queue is required");
+    }
+}
+
+TextureUploadBatch::~TextureUploadBatch()
+{
+    if (!isEmpty())
+    {
+        CAE_LOG_WARNING(Asset, "TextureUploadBatch destroyed with " << m_Pending.size() + m_QueuedUploads << " uploads pending, flushing");
+        flush();
+    }
+}
+
+uint64_t TextureUploadBatch::add(Image* pImage, const void* pPixels, VkDeviceSize size, uint32_t width, uint32_t height)
+{
+    MipLevel level;
+    level.size = size;
+    level.width = width;
+    level.height = height;
+    return add(pImage, pPixels, size, std::vector<MipLevel>{ level });
+}
+
+uint64_t TextureUploadBatch::add(Image* pImage, const void* pData, VkDeviceSize size, const std::vector<MipLevel>& levels)
+{
+    if (levels.size() != pImage->getMipLevels())
+    {
+        throw std::runtime_error("TextureUploadBatch: level count does not match the image's mip levels");
+    }
+
+    ++m_Stats.uploads;
+    m_Stats.bytesUploaded += size;
+    if (m_pTransferQueue)
+    {
+        // The queue stages and records the copy itself; only the submit is left to flush()
+        m_StagedBytes += size;
+        ++m_QueuedUploads;
+        return m_pTransferQueue->uploadImage(pImage, pData, size, levels);
+    }
+
+    if (!m_pStagingRing->fits(size))
+    {
+        flush();
+    }
+    const StagingRing::Allocation allocation = m_pStagingRing->allocate(size);
+    memcpy(allocation.pData, pData, static_cast<size_t>(size));
+
+    m_Pending.push_back({ pImage, allocation.buffer, m_Regions.size(), static_cast<uint32_t>(levels.size()) });
+    for (uint32_t mip = 0; mip < levels.size(); ++mip)
+    {
+        VkBufferImageCopy region{};
+        region.bufferOffset = allocation.offset + levels[mip].offset;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = mip;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = 1;
+        region.imageExtent = { levels[mip].width, levels[mip].height, 1 };
+        m_Regions.push_back(region);
+    }
+    m_StagedBytes += size;
+    return 0;
+}
+
+uint64_t TextureUploadBatch::flush()
+{
+    if (m_pTransferQueue)
+    {
+        if (m_QueuedUploads == 0)
+        {
+            return 0;
+        }
+        const uint64_t ticket = m_pTransferQueue->submit();
+        CAE_LOG_DEBUG(Asset, "Texture upload batch submitted to the transfer queue: " << m_QueuedUploads << " textures, "
+            << m_StagedBytes / 1024 << " KB staged, ticket " << ticket);
+        ++m_Stats.submits;
+        m_QueuedUploads = 0;
+        m_StagedBytes = 0;
+        return ticket;
+    }
+
+    if (m_Pending.empty())
+    {
+        return 0;
+    }
+
+    std::vector<VkImageMemoryBarrier2> toTransfer;
+    std::vector<VkImageMemoryBarrier2> toShaderRead;
+    toTransfer.reserve(m_Pending.size());
+    toShaderRead.reserve(m_Pending.size());
+    for (const PendingUpload& upload : m_Pending)
+    {
+        toTransfer.push_back(makeBarrier(upload.pImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL));
+        toShaderRead.push_back(makeBarrier(upload.pImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL));
+    }
+
+    VkCommandBuffer commandBuffer = m_pCommandPool->beginSingleTimeCommands();
+    recordBarriers(commandBuffer, toTransfer);
+    for (const PendingUpload& upload : m_Pending)
+    {
+        vkCmdCopyBufferToImage(commandBuffer, upload.stagingBuffer, upload.pImage->getImage(),
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, upload.regionCount, &m_Regions[upload.firstRegion]);
+    }
+    recordBarriers(commandBuffer, toShaderRead);
+
+    m_pStagingRing->closeWaitedSegment();
+    m_pCommandPool->endSingleTimeCommands(commandBuffer, m_pDevice->getGraphicsQueue());
+
+    for (const PendingUpload& upload : m_Pending)
+    {
+        upload.pImage->setImageLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    }
+
+    CAE_LOG_DEBUG(Asset, "Texture upload batch submitted: " << m_Pending.size() << " textures, "
+        << m_StagedBytes / 1024 << " KB staged");
+
+    ++m_Stats.submits;
+    m_Pending.clear();
+    m_Regions.clear();
+    m_StagedBytes = 0;
+    return 0;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include "vk_mem_alloc.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Buffer.h"
+#include "MipGenerator.h"
+#include "StagingRing.h"
+
+class Device;
+class CommandPool;
+class Image;
+class TransferQueue;
+
+//
+// Collects texture uploads and submits them together. Pixel data is written into a StagingRing;
+// flush() records every layout transition and copy into a single command buffer (all pre-copy
+// barriers in one call, all post-copy barriers in another), submits it once through the command
+// pool's single-time path and waits on it. When the ring is full the pending uploads are flushed early, so any number
+// of textures can go through one batch. With a TransferQueue the uploads are handed to it instead and
+// flush() submits its job without waiting; add() then returns the queue's ticket for the texture.
+//
+class TextureUploadBatch
+{
+public:
+    struct Stats
+    {
+        size_t uploads = 0;
+        size_t submits = 0;
+        VkDeviceSize bytesUploaded = 0;
+    };
+
+    // Needs pStagingRing or pTransferQueue. Uploads go through pTransferQueue when given; the ring and command
+    // pool are then unused. Otherwise they stage into pStagingRing, which no other user may allocate from
+    // while uploads are pending.
+    TextureUploadBatch(Device* pDevice, VmaAllocator allocator, CommandPool* pCommandPool, StagingRing* pStagingRing,
+        TransferQueue* pTransferQueue);
+    ~TextureUploadBatch();
+
+    TextureUploadBatch(const TextureUploadBatch&) = delete;
+    TextureUploadBatch& operator=(const TextureUploadBatch&) = delete;
+
+    // Copies the pixels into staging right away; pImage must be an UNDEFINED colour image with
+    // TRANSFER_DST usage and must stay alive until the next flush(). It is SHADER_READ_ONLY afterwards.
+    // Returns the TransferQueue ticket of the upload, or 0 without a queue.
+    uint64_t add(Image* pImage, const void* pPixels, VkDeviceSize size, uint32_t width, uint32_t height);
+    // Uploads every level of a packed mip chain; level offsets are relative to pData
+    uint64_t add(Image* pImage, const void* pData, VkDeviceSize size, const std::vector<MipLevel>& levels);
+
+    // Submits the pending uploads and waits for them to complete. With a TransferQueue it submits the
+    // queue's open job without waiting and returns its ticket; the images are usable once it was acquired.
+    uint64_t flush();
+
+    bool isEmpty() const { return m_Pending.empty() && m_QueuedUploads == 0; }
+    const Stats& getStats() const { return m_Stats; }
+
+private:
+    struct PendingUpload
+    {
+        Image* pImage;
+        VkBuffer stagingBuffer;
+        size_t firstRegion;
+        uint32_t regionCount;
+    };
+
+    Device* m_pDevice;
+    VmaAllocator m_Allocator;
+    CommandPool* m_pCommandPool;
+    StagingRing* m_pStagingRing;
+    TransferQueue* m_pTransferQueue;
+    size_t m_QueuedUploads = 0; // Recorded into the queue's open job since the last flush()
+    VkDeviceSize m_StagedBytes = 0;
+
+    std::vector<PendingUpload> m_Pending;
+    std::vector<VkBufferImageCopy> m_Regions;
+    Stats m_Stats;
+};
@@ -0,0 +1,355 @@
+#include "TransferQueue.h"
+
+#include "Device.h"
+#include "Image.h"
+#include "Runtime/EngineCore/Core/Log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    VkImageMemoryBarrier2 makeImageBarrier(const Image* pImage, VkImageLayout oldLayout, VkImageLayout newLayout)
+    {
+        VkImageMemoryBarrier2 barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+        barrier.oldLayout = oldLayout;
+        barrier.newLayout = newLayout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = pImage->getImage();
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseMipLevel = 0;
+        barrier.subresourceRange.levelCount = pImage->getMipLevels();
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = 1;
+        return barrier;
+    }
+
+    VkBufferMemoryBarrier2 makeBufferBarrier(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size)
+    {
+        VkBufferMemoryBarrier2 barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer = buffer;
+        barrier.offset = offset;
+        barrier.size = size;
+        return barrier;
+    }
+
+    void recordBarriers(VkCommandBuffer commandBuffer, const std::vector<VkBufferMemoryBarrier2>& bufferBarriers,
+                        const std::vector<VkImageMemoryBarrier2>& imageBarriers)
+    {
+        if (bufferBarriers.empty() && imageBarriers.empty())
+        {
+            return;
+        }
+        VkDependencyInfo dependencyInfo{};
+        dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependencyInfo.bufferMemoryBarrierCount = static_cast<uint32_t>(bufferBarriers.size());
+        dependencyInfo.pBufferMemoryBarriers = bufferBarriers.data();
+        dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(imageBarriers.size());
+        dependencyInfo.pImageMemoryBarriers = imageBarriers.data();
+        vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+    }
+}
+
+TransferQueue::TransferQueue(Device* pDevice, StagingRing* pStagingRing)
+    : m_pDevice(pDevice), m_Queue(pDevice->getTransferQueue()), m_QueueFamily(pDevice->getTransferQueueFamily()),
+    m_GraphicsQueueFamily(pDevice->getGraphicsQueueFamily()), m_Dedicated(pDevice->hasDedicatedTransferQueue()),
+    m_pStagingRing(pStagingRing)
+{
+    if (!m_pStagingRing)
+    {
+        throw std::runtime_error("TransferQueue: a staging ring is required");
+    }
+    m_pCommandPool = std::make_unique<CommandPool>(m_pDevice->get(), m_QueueFamily);
+
+    VkSemaphoreTypeCreateInfo typeInfo{};
+    typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = &typeInfo;
+    if (vkCreateSemaphore(m_pDevice->get(), &semaphoreInfo, nullptr, &m_TimelineSemaphore) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create transfer timeline semaphore!");
+    }
+
+    CAE_LOG_INFO(RHI, "TransferQueue created on " << (m_Dedicated ? "a dedicated" : "the graphics") << " queue family ("
+        << m_QueueFamily << ")");
+}
+
+TransferQueue::~TransferQueue()
+{
+    if (m_OpenJob.commandBuffer != VK_NULL_HANDLE)
+    {
+        CAE_LOG_WARNING(RHI, "TransferQueue destroyed with unsubmitted uploads, submitting");
+        submit();
+    }
+    if (m_NextValue > 1)
+    {
+        wait(m_NextValue - 1);
+    }
+    // The command pool frees the remaining command buffers
+    m_Submitted.clear();
+    vkDestroySemaphore(m_pDevice->get(), m_TimelineSemaphore, nullptr);
+    m_pCommandPool.reset();
+
+    CAE_LOG_DEBUG(RHI, "TransferQueue destroyed: " << m_Stats.bufferUploads << " buffer and " << m_Stats.imageUploads
+        << " image uploads, " << m_Stats.bytesUploaded / 1024 << " KB in " << m_Stats.submits << " submits");
+}
+
+void TransferQueue::beginJob()
+{
+    if (m_OpenJob.commandBuffer != VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    m_OpenJob.commandBuffer = m_pCommandPool->allocateCommandBuffer();
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(m_OpenJob.commandBuffer, &beginInfo);
+}
+
+uint64_t TransferQueue::uploadBuffer(const void* pData, VkDeviceSize size, VkBuffer dstBuffer, VkDeviceSize dstOffset)
+{
+    if (size == 0)
+    {
+        return m_NextValue - 1;
+    }
+    if (!m_pStagingRing->fits(size))
+    {
+        submit();
+    }
+    beginJob();
+
+    const StagingRing::Allocation allocation = m_pStagingRing->allocate(size);
+    memcpy(allocation.pData, pData, static_cast<size_t>(size));
+
+    VkBufferCopy copyRegion{};
+    copyRegion.srcOffset = allocation.offset;
+    copyRegion.dstOffset = dstOffset;
+    copyRegion.size = size;
+    vkCmdCopyBuffer(m_OpenJob.commandBuffer, allocation.buffer, dstBuffer, 1, &copyRegion);
+
+    VkBufferMemoryBarrier2 release = makeBufferBarrier(dstBuffer, dstOffset, size);
+    release.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    release.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    if (m_Dedicated)
+    {
+        // The destination stages belong to the acquire on the graphics queue
+        release.srcQueueFamilyIndex = m_QueueFamily;
+        release.dstQueueFamilyIndex = m_GraphicsQueueFamily;
+
+        VkBufferMemoryBarrier2 acquire = release;
+        acquire.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+        acquire.srcAccessMask = VK_ACCESS_2_NONE;
+        acquire.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        acquire.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+        m_OpenJob.bufferAcquires.push_back(acquire);
+    }
+    else
+    {
+        release.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        release.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+    }
+    m_OpenJob.bufferReleases.push_back(release);
+
+    ++m_Stats.bufferUploads;
+    m_Stats.bytesUploaded += size;
+    return m_NextValue;
+}
+
+uint64_t TransferQueue::uploadImage(Image* pImage, const void* pData, VkDeviceSize size, const std::vector<MipLevel>& levels)
+{
+    if (levels.size() != pImage->getMipLevels())
+    {
+        throw std::runtime_error("TransferQueue: level count does not match the image's mip levels");
+    }
+    if (!m_pStagingRing->fits(size))
+    {
+        submit();
+    }
+    beginJob();
+
+    const StagingRing::Allocation allocation = m_pStagingRing->allocate(size);
+    memcpy(allocation.pData, pData, static_cast<size_t>(size));
+
+    VkImageMemoryBarrier2 toTransfer = makeImageBarrier(pImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    toTransfer.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+    toTransfer.srcAccessMask = VK_ACCESS_2_NONE;
+    toTransfer.dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    toTransfer.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    recordBarriers(m_OpenJob.commandBuffer, {}, { toTransfer });
+
+    // Whole mip levels always satisfy the minImageTransferGranularity of transfer-only queues
+    std::vector<VkBufferImageCopy> regions(levels.size());
+    for (uint32_t mip = 0; mip < levels.size(); ++mip)
+    {
+        VkBufferImageCopy& region = regions[mip];
+        region.bufferOffset = allocation.offset + levels[mip].offset;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = mip;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = 1;
+        region.imageExtent = { levels[mip].width, levels[mip].height, 1 };
+    }
+    vkCmdCopyBufferToImage(m_OpenJob.commandBuffer, allocation.buffer, pImage->getImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        static_cast<uint32_t>(regions.size()), regions.data());
+
+    VkImageMemoryBarrier2 release = makeImageBarrier(pImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    release.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    release.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    if (m_Dedicated)
+    {
+        // Release and acquire both carry the layout transition; it is executed once
+        release.srcQueueFamilyIndex = m_QueueFamily;
+        release.dstQueueFamilyIndex = m_GraphicsQueueFamily;
+
+        VkImageMemoryBarrier2 acquire = release;
+        acquire.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+        acquire.srcAccessMask = VK_ACCESS_2_NONE;
+        acquire.dstStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+        acquire.dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT;
+        m_OpenJob.imageAcquires.push_back(acquire);
+    }
+    else
+    {
+        release.dstStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+        release.dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT;
+    }
+    m_OpenJob.imageReleases.push_back(release);
+    m_OpenJob.images.push_back(pImage);
+
+    ++m_Stats.imageUploads;
+    m_Stats.bytesUploaded += size;
+    return m_NextValue;
+}
+
+uint64_t TransferQueue::submit()
+{
+    if (m_OpenJob.commandBuffer == VK_NULL_HANDLE)
+    {
+        return m_NextValue - 1;
+    }
+
+    recordBarriers(m_OpenJob.commandBuffer, m_OpenJob.bufferReleases, m_OpenJob.imageReleases);
+    vkEndCommandBuffer(m_OpenJob.commandBuffer);
+
+    VkCommandBufferSubmitInfo commandBufferInfo{};
+    commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+    commandBufferInfo.commandBuffer = m_OpenJob.commandBuffer;
+
+    VkSemaphoreSubmitInfo signalInfo{};
+    signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+    signalInfo.semaphore = m_TimelineSemaphore;
+    signalInfo.value = m_NextValue;
+    signalInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+    VkSubmitInfo2 submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+    submitInfo.commandBufferInfoCount = 1;
+    submitInfo.pCommandBufferInfos = &commandBufferInfo;
+    submitInfo.signalSemaphoreInfoCount = 1;
+    submitInfo.pSignalSemaphoreInfos = &signalInfo;
+
+    // The ring's fence lets its space be reused independently of the timeline
+    VkFence fence = m_pStagingRing->closeSegment();
+    if (vkQueueSubmit2(m_Queue, 1, &submitInfo, fence) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to submit transfer job!");
+    }
+
+    m_OpenJob.value = m_NextValue++;
+    m_OpenJob.bufferReleases.clear();
+    m_OpenJob.imageReleases.clear();
+    m_Submitted.push_back(std::move(m_OpenJob));
+    m_OpenJob = Job{};
+    ++m_Stats.submits;
+    return m_NextValue - 1;
+}
+
+uint64_t TransferQueue::getCompletedValue()
+{
+    uint64_t value = 0;
+    if (vkGetSemaphoreCounterValue(m_pDevice->get(), m_TimelineSemaphore, &value) == VK_SUCCESS)
+    {
+        m_CompletedValue = value;
+    }
+    return m_CompletedValue;
+}
+
+bool TransferQueue::isComplete(uint64_t value)
+{
+    return value <= m_CompletedValue || value <= getCompletedValue();
+}
+
+void TransferQueue::wait(uint64_t value)
+{
+    if (value >= m_NextValue)
+    {
+        submit();
+    }
+    if (isComplete(value))
+    {
+        return;
+    }
+
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &m_TimelineSemaphore;
+    waitInfo.pValues = &value;
+    vkWaitSemaphores(m_pDevice->get(), &waitInfo, UINT64_MAX);
+    getCompletedValue();
+}
+
+uint64_t TransferQueue::recordAcquireBarriers(VkCommandBuffer commandBuffer)
+{
+    const uint64_t completed = getCompletedValue();
+
+    std::vector<VkBufferMemoryBarrier2> bufferAcquires;
+    std::vector<VkImageMemoryBarrier2> imageAcquires;
+    uint64_t waitValue = 0;
+    for (Job& job : m_Submitted)
+    {
+        if (job.value > completed)
+        {
+            break;
+        }
+        if (job.acquired)
+        {
+            continue;
+        }
+
+        bufferAcquires.insert(bufferAcquires.end(), job.bufferAcquires.begin(), job.bufferAcquires.end());
+        imageAcquires.insert(imageAcquires.end(), job.imageAcquires.begin(), job.imageAcquires.end());
+        for (Image* pImage : job.images)
+        {
+            pImage->setImageLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        }
+        job.acquired = true;
+        waitValue = std::max(waitValue, job.value);
+    }
+    m_AcquiredValue = std::max(m_AcquiredValue, waitValue);
+
+    recordBarriers(commandBuffer, bufferAcquires, imageAcquires);
+    return waitValue;
+}
+
+void TransferQueue::update()
+{
+    getCompletedValue();
+    while (!m_Submitted.empty() && m_Submitted.front().acquired)
+    {
+        m_pCommandPool->freeCommandBuffer(m_Submitted.front().commandBuffer);
+        m_Submitted.pop_front();
+    }
+}
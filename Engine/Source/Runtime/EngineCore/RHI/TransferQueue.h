@@ -0,0 +1,105 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include "vk_mem_alloc.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "CommandPool.h"
+#include "MipGenerator.h"
+#include "StagingRing.h"
+
+class Device;
+class Image;
+
+//
+// Asynchronous uploads on the device's transfer queue. Uploads are recorded into an open job that
+// submit() hands to the queue without waiting; completion is tracked with a timeline semaphore whose
+// value is returned as the upload's ticket. On devices with a dedicated transfer family each copy
+// ends with a queue family ownership release, and recordAcquireBarriers() records the matching
+// acquires into a graphics command buffer once the job has finished. Devices with a single queue
+// family (lavapipe, some mobile GPUs) run the same jobs on the graphics queue without ownership
+// transfers. Not thread-safe: the fallback shares the graphics VkQueue, so use it on the render thread.
+// Staging comes from a ring owned by the caller; nothing else may allocate from it while a job is open.
+//
+class TransferQueue
+{
+public:
+    struct Stats
+    {
+        size_t bufferUploads = 0;
+        size_t imageUploads = 0;
+        size_t submits = 0;
+        VkDeviceSize bytesUploaded = 0;
+    };
+
+    TransferQueue(Device* pDevice, StagingRing* pStagingRing);
+    ~TransferQueue();
+
+    TransferQueue(const TransferQueue&) = delete;
+    TransferQueue& operator=(const TransferQueue&) = delete;
+
+    // Both record into the open job and return the timeline value that signals once the data is on
+    // the GPU. The destination must not be used before its job was acquired by recordAcquireBarriers().
+    uint64_t uploadBuffer(const void* pData, VkDeviceSize size, VkBuffer dstBuffer, VkDeviceSize dstOffset = 0);
+    // pImage must be an UNDEFINED colour image with TRANSFER_DST usage; it ends in SHADER_READ_ONLY
+    uint64_t uploadImage(Image* pImage, const void* pData, VkDeviceSize size, const std::vector<MipLevel>& levels);
+
+    // Submits the open job without waiting and returns its value (the last value when nothing is open)
+    uint64_t submit();
+
+    bool isComplete(uint64_t value);
+    // Blocks until value has signalled, submitting the open job first when value belongs to it
+    void wait(uint64_t value);
+
+    // Records the acquire half of the ownership transfers of every finished job and returns the value
+    // the graphics submission must wait for on getTimelineSemaphore(), or 0 when nothing was acquired.
+    // Only finished jobs are acquired, so the wait never stalls the frame.
+    uint64_t recordAcquireBarriers(VkCommandBuffer commandBuffer);
+    // True once the job of value was acquired, i.e. its destinations may be used by graphics command
+    // buffers recorded after that recordAcquireBarriers() call. Ticket 0 (a synchronous upload) always is.
+    bool isAcquired(uint64_t value) const { return value <= m_AcquiredValue; }
+    // Releases command buffers of acquired jobs; call once per frame
+    void update();
+
+    VkSemaphore getTimelineSemaphore() const { return m_TimelineSemaphore; }
+    bool isDedicated() const { return m_Dedicated; }
+    const Stats& getStats() const { return m_Stats; }
+
+private:
+    struct Job
+    {
+        uint64_t value = 0;
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        std::vector<VkBufferMemoryBarrier2> bufferReleases;
+        std::vector<VkImageMemoryBarrier2> imageReleases;
+        std::vector<VkBufferMemoryBarrier2> bufferAcquires;
+        std::vector<VkImageMemoryBarrier2> imageAcquires;
+        std::vector<Image*> images;
+        bool acquired = false;
+    };
+
+    void beginJob();
+    uint64_t getCompletedValue();
+
+    Device* m_pDevice;
+    VkQueue m_Queue;
+    uint32_t m_QueueFamily;
+    uint32_t m_GraphicsQueueFamily;
+    bool m_Dedicated;
+
+    std::unique_ptr<CommandPool> m_pCommandPool; // Allocated on the transfer family
+    StagingRing* m_pStagingRing;
+    VkSemaphore m_TimelineSemaphore = VK_NULL_HANDLE;
+    uint64_t m_NextValue = 1;
+    uint64_t m_CompletedValue = 0;
+    uint64_t m_AcquiredValue = 0; // Jobs are acquired in order, so every value up to this one is acquired
+
+    Job m_OpenJob;
+    std::deque<Job> m_Submitted;
+    Stats m_Stats;
+};
@@ -0,0 +1,392 @@
+#include "VertexWelder.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+#include "GltfImporter.h"
+#include "Model.h"
+#include "Runtime/EngineCore/Core/ParallelFor.h"
+#include "Runtime/EngineCore/Core/Log.h"
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/hash.hpp>
+
+// The hash Model.h used before VertexWelder replaced its map; only the benchmark baseline uses it
+namespace std
+{
+    template<> struct hash<Vertex>
+    {
+        size_t operator()(const Vertex& vertex) const
+        {
+            size_t seed = 0;
+            hash<glm::vec3> vec3Hasher;
+            hash<glm::vec2> vec2Hasher;
+
+            seed ^= vec3Hasher(vertex.pos) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            seed ^= vec2Hasher(vertex.texCoord) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            seed ^= vec3Hasher(vertex.normal) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            seed ^= vec3Hasher(vertex.tangent) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            seed ^= vec3Hasher(vertex.bitangent) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+
+            return seed;
+        }
+    };
+}
+
+namespace
+{
+    constexpr size_t FloatsPerVertex = sizeof(Vertex) / sizeof(float);
+    static_assert(sizeof(Vertex) == FloatsPerVertex * sizeof(float), "Vertex must be tightly packed floats");
+    static_assert(FloatsPerVertex % 2 == 0, "Vertex hashing reads 64-bit words");
+
+    constexpr uint32_t EmptySlot = UINT32_MAX;
+
+    struct WeldKey
+    {
+        uint32_t words[FloatsPerVertex];
+
+        bool operator==(const WeldKey& other) const
+        {
+            return memcmp(words, other.words, sizeof(words)) == 0;
+        }
+    };
+
+    struct Slot
+    {
+        uint32_t hash;
+        uint32_t vertexIndex;
+    };
+
+    // Position components come first in Vertex; everything after them is an attribute
+    constexpr size_t PositionFloats = 3;
+
+    WeldKey makeKey(const Vertex& vertex, float inversePositionEpsilon, float inverseAttributeEpsilon)
+    {
+        WeldKey key;
+        memcpy(key.words, &vertex, sizeof(key.words));
+
+        if (inversePositionEpsilon == 0.0f && inverseAttributeEpsilon == 0.0f)
+        {
+            for (uint32_t& word : key.words)
+            {
+                word = (word & 0x7FFFFFFFu) == 0 ? 0 : word; // Fold -0 into +0
+            }
+            return key;
+        }
+
+        float values[FloatsPerVertex];
+        memcpy(values, &vertex, sizeof(values));
+        for (size_t i = 0; i < FloatsPerVertex; ++i)
+        {
+            float inverseEpsilon = i < PositionFloats ? inversePositionEpsilon : inverseAttributeEpsilon;
+            if (inverseEpsilon > 0.0f)
+            {
+                int64_t cell = static_cast<int64_t>(std::floor(static_cast<double>(values[i]) * inverseEpsilon + 0.5));
+                key.words[i] = static_cast<uint32_t>(cell) ^ static_cast<uint32_t>(cell >> 32);
+            }
+            else
+            {
+                key.words[i] = (key.words[i] & 0x7FFFFFFFu) == 0 ? 0 : key.words[i];
+            }
+        }
+        return key;
+    }
+
+    uint32_t hashKey(const WeldKey& key)
+    {
+        // Two independent multiply lanes over 64-bit words keep the dependency chain short
+        uint64_t words[FloatsPerVertex / 2];
+        memcpy(words, key.words, sizeof(words));
+
+        uint64_t laneA = 0x9E3779B97F4A7C15ull;
+        uint64_t laneB = 0xC2B2AE3D27D4EB4Full;
+        for (size_t i = 0; i + 1 < FloatsPerVertex / 2; i += 2)
+        {
+            laneA = (laneA ^ words[i]) * 0xFF51AFD7ED558CCDull;
+            laneB = (laneB ^ words[i + 1]) * 0xC4CEB9FE1A85EC53ull;
+        }
+        if ((FloatsPerVertex / 2) % 2 != 0)
+        {
+            laneA = (laneA ^ words[FloatsPerVertex / 2 - 1]) * 0xFF51AFD7ED558CCDull;
+        }
+
+        uint64_t hash = laneA ^ (laneB >> 29) ^ (laneB << 35);
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 33;
+        return static_cast<uint32_t>(hash);
+    }
+
+    void growTable(std::vector<Slot>& table, size_t& capacity, size_t& mask)
+    {
+        std::vector<Slot> grown(capacity * 2, Slot{ 0, EmptySlot });
+        size_t grownMask = grown.size() - 1;
+        for (const Slot& slot : table)
+        {
+            if (slot.vertexIndex == EmptySlot)
+            {
+                continue;
+            }
+            size_t slotIndex = slot.hash & grownMask;
+            while (grown[slotIndex].vertexIndex != EmptySlot)
+            {
+                slotIndex = (slotIndex + 1) & grownMask;
+            }
+            grown[slotIndex] = slot;
+        }
+
+        table = std::move(grown);
+        capacity = table.size();
+        mask = grownMask;
+    }
+
+    // Baseline for runBenchmark(): the node-based map and hash this welder replaced
+    size_t weldWithUnorderedMap(const std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+    {
+        std::unordered_map<Vertex, uint32_t> uniqueVertices;
+        std::vector<Vertex> welded;
+        for (uint32_t& index : indices)
+        {
+            auto result = uniqueVertices.emplace(vertices[index], static_cast<uint32_t>(welded.size()));
+            if (result.second)
+            {
+                welded.push_back(vertices[index]);
+            }
+            index = result.first->second;
+        }
+        return welded.size();
+    }
+
+    // Corner of a size x size height field with analytic normal and tangent frame. Neighbouring
+    // quads evaluate shared corners with the same inputs, so they weld exactly.
+    Vertex makeGridVertex(uint32_t x, uint32_t z, uint32_t size)
+    {
+        const float fx = static_cast<float>(x);
+        const float fz = static_cast<float>(z);
+        const float dydx = std::cos(fx * 0.05f) * std::cos(fz * 0.03f) * 0.2f;
+        const float dydz = -std::sin(fx * 0.05f) * std::sin(fz * 0.03f) * 0.12f;
+
+        Vertex vertex{};
+        vertex.pos = glm::vec3(fx, std::sin(fx * 0.05f) * std::cos(fz * 0.03f) * 4.0f, fz);
+        vertex.texCoord = glm::vec2(fx / size, fz / size);
+        vertex.tangent = glm::normalize(glm::vec3(1.0f, dydx, 0.0f));
+        vertex.bitangent = glm::normalize(glm::vec3(0.0f, dydz, 1.0f));
+        vertex.normal = glm::normalize(glm::cross(vertex.bitangent, vertex.tangent));
+        return vertex;
+    }
+
+    // Unindexed triangle soup of a size x size grid: 6 * size^2 corners over (size + 1)^2 unique vertices
+    void makeGridSoup(uint32_t size, std::vector<Vertex>& soup)
+    {
+        soup.reserve(soup.size() + static_cast<size_t>(size) * size * 6);
+        for (uint32_t z = 0; z < size; ++z)
+        {
+            for (uint32_t x = 0; x < size; ++x)
+            {
+                soup.push_back(makeGridVertex(x, z, size));
+                soup.push_back(makeGridVertex(x, z + 1, size));
+                soup.push_back(makeGridVertex(x + 1, z, size));
+                soup.push_back(makeGridVertex(x + 1, z, size));
+                soup.push_back(makeGridVertex(x, z + 1, size));
+                soup.push_back(makeGridVertex(x + 1, z + 1, size));
+            }
+        }
+    }
+
+    void benchmarkSoup(const std::string& name, const std::vector<Vertex>& soup, int iterations)
+    {
+        std::vector<uint32_t> sequentialIndices(soup.size());
+        for (size_t i = 0; i < sequentialIndices.size(); ++i)
+        {
+            sequentialIndices[i] = static_cast<uint32_t>(i);
+        }
+
+        double mapSeconds = 0.0;
+        double welderSeconds = 0.0;
+        size_t mapVertexCount = 0;
+        size_t welderVertexCount = 0;
+        for (int iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::vector<uint32_t> indices = sequentialIndices;
+            auto start = std::chrono::steady_clock::now();
+            mapVertexCount = weldWithUnorderedMap(soup, indices);
+            mapSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            std::vector<Vertex> vertices = soup;
+            indices = sequentialIndices;
+            VertexWelder welder;
+            welder.weld(vertices, indices, {});
+            welderSeconds += welder.getStats().seconds;
+            welderVertexCount = vertices.size();
+        }
+        mapSeconds /= iterations;
+        welderSeconds /= iterations;
+
+        CAE_LOG_INFO(Asset, "Vertex weld benchmark (" << name << "): " << soup.size() << " corners -> " << welderVertexCount << " vertices");
+        CAE_LOG_INFO(Asset, "  std::unordered_map<Vertex>: " << mapSeconds * 1000.0 << " ms, " << soup.size() / mapSeconds / 1.0e6 << " M corners/s");
+        CAE_LOG_INFO(Asset, "  VertexWelder: " << welderSeconds * 1000.0 << " ms, " << soup.size() / welderSeconds / 1.0e6 << " M corners/s, "
+            << "speedup " << mapSeconds / welderSeconds << "x");
+        if (mapVertexCount != welderVertexCount)
+        {
+            CAE_LOG_ERROR(Asset, "Vertex weld benchmark (" << name << "): unordered_map kept " << mapVertexCount << " vertices, VertexWelder "
+                << welderVertexCount);
+        }
+    }
+
+    size_t nextPowerOfTwo(size_t value)
+    {
+        size_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+}
+
+VertexWelder::VertexWelder()
+    : m_Settings()
+{
+}
+
+VertexWelder::VertexWelder(const Settings& settings)
+    : m_Settings(settings)
+{
+}
+
+void VertexWelder::weld(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, const std::vector<Submesh>& submeshes)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    m_Stats = Stats{};
+    m_Stats.inputVertexCount = vertices.size();
+    m_Stats.indexCount = indices.size();
+
+    std::vector<Vertex> welded;
+
+    if (m_Settings.mode == Mode::Global || submeshes.empty())
+    {
+        weldRange(vertices.data(), indices.data(), indices.size(), welded);
+    }
+    else
+    {
+        std::vector<std::vector<Vertex>> submeshVertices(submeshes.size());
+        parallelFor(submeshes.size(), [&](size_t i)
+        {
+            const Submesh& submesh = submeshes[i];
+            weldRange(vertices.data(), indices.data() + submesh.indexStart, submesh.indexCount, submeshVertices[i]);
+        });
+
+        size_t totalVertices = 0;
+        for (const std::vector<Vertex>& local : submeshVertices)
+        {
+            totalVertices += local.size();
+        }
+        welded.reserve(totalVertices);
+
+        // Merge: append each submesh's vertices and shift its indices by the running base
+        for (size_t i = 0; i < submeshes.size(); ++i)
+        {
+            const Submesh& submesh = submeshes[i];
+            uint32_t base = static_cast<uint32_t>(welded.size());
+            uint32_t* pIndices = indices.data() + submesh.indexStart;
+            for (uint32_t j = 0; j < submesh.indexCount; ++j)
+            {
+                pIndices[j] += base;
+            }
+            welded.insert(welded.end(), submeshVertices[i].begin(), submeshVertices[i].end());
+        }
+    }
+
+    vertices = std::move(welded);
+
+    m_Stats.outputVertexCount = vertices.size();
+    m_Stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void VertexWelder::weldRange(const Vertex* pSource, uint32_t* pIndices, size_t indexCount, std::vector<Vertex>& output) const
+{
+    const float inversePositionEpsilon = m_Settings.positionEpsilon > 0.0f ? 1.0f / m_Settings.positionEpsilon : 0.0f;
+    const float inverseAttributeEpsilon = m_Settings.attributeEpsilon > 0.0f ? 1.0f / m_Settings.attributeEpsilon : 0.0f;
+
+    // Typical meshes share each vertex between ~6 triangle corners, so start at a quarter of
+    // the index count and grow whenever the load factor would exceed one half
+    size_t capacity = nextPowerOfTwo(indexCount / 4 + 16);
+    size_t mask = capacity - 1;
+
+    std::vector<Slot> table(capacity, Slot{ 0, EmptySlot });
+    std::vector<WeldKey> keys;
+    keys.reserve(capacity / 2);
+    output.clear();
+    output.reserve(capacity / 2);
+
+    for (size_t i = 0; i < indexCount; ++i)
+    {
+        const Vertex& vertex = pSource[pIndices[i]];
+        const WeldKey key = makeKey(vertex, inversePositionEpsilon, inverseAttributeEpsilon);
+        const uint32_t hash = hashKey(key);
+
+        size_t slotIndex = hash & mask;
+        for (;;)
+        {
+            Slot& slot = table[slotIndex];
+            if (slot.vertexIndex == EmptySlot)
+            {
+                if ((keys.size() + 1) * 2 > capacity)
+                {
+                    growTable(table, capacity, mask);
+                    slotIndex = hash & mask;
+                    continue;
+                }
+
+                // First occurrence becomes the representative for everything that welds onto it
+                slot.hash = hash;
+                slot.vertexIndex = static_cast<uint32_t>(keys.size());
+                keys.push_back(key);
+                output.push_back(vertex);
+                break;
+            }
+            if (slot.hash == hash && keys[slot.vertexIndex] == key)
+            {
+                break;
+            }
+            slotIndex = (slotIndex + 1) & mask;
+        }
+
+        pIndices[i] = table[slotIndex].vertexIndex;
+    }
+}
+
+void VertexWelder::runBenchmark(const std::string& folder, int iterations)
+{
+    // A generated 1024 x 1024 grid gives 6.3M corners, so the comparison runs without any assets
+    std::vector<Vertex> gridSoup;
+    makeGridSoup(1024, gridSoup);
+    benchmarkSoup("1024x1024 grid", gridSoup, iterations);
+
+    std::vector<Vertex> soup;
+    for (const std::string& path : GltfImporter::findScenes(folder))
+    {
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<Submesh> submeshes;
+        std::vector<MaterialDesc> materials;
+        GltfImporter importer(path);
+        importer.import(vertices, indices, submeshes, materials);
+
+        // One vertex per triangle corner, as OBJ-style loaders produce before welding
+        for (uint32_t index : indices)
+        {
+            soup.push_back(vertices[index]);
+        }
+    }
+
+    if (soup.empty())
+    {
+        CAE_LOG_INFO(Asset, "Vertex weld benchmark: no scenes in " << folder);
+        return;
+    }
+    benchmarkSoup(folder, soup, iterations);
+}
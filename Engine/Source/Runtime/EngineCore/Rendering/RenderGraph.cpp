@@ -0,0 +1,1084 @@
+#include "RenderGraph.h"
+
+#include "Runtime/EngineCore/RHI/Device.h"
+#include "Runtime/EngineCore/Core/Log.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    struct UsageInfo
+    {
+        VkImageLayout layout;
+        VkPipelineStageFlags2 stages;
+        VkAccessFlags2 readAccess;  // 0 when the usage cannot read
+        VkAccessFlags2 writeAccess; // 0 when the usage cannot write
+        VkImageUsageFlags imageUsage;
+    };
+
+    const UsageInfo& getUsageInfo(RenderGraphUsage usage)
+    {
+        static const UsageInfo infos[] = {
+            // ColorAttachment
+            { VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+              VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT },
+            // DepthStencilAttachment
+            { VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+              VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+              VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT, VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+              VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT },
+            // FragmentSampled
+            { VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+              VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, VK_ACCESS_2_NONE, VK_IMAGE_USAGE_SAMPLED_BIT },
+            // ComputeSampled
+            { VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+              VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, VK_ACCESS_2_NONE, VK_IMAGE_USAGE_SAMPLED_BIT },
+            // ComputeStorage
+            { VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+              VK_ACCESS_2_SHADER_STORAGE_READ_BIT, VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, VK_IMAGE_USAGE_STORAGE_BIT },
+            // TransferSource
+            { VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+              VK_ACCESS_2_TRANSFER_READ_BIT, VK_ACCESS_2_NONE, VK_IMAGE_USAGE_TRANSFER_SRC_BIT },
+            // TransferDestination
+            { VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+              VK_ACCESS_2_NONE, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_IMAGE_USAGE_TRANSFER_DST_BIT },
+        };
+        static_assert(sizeof(infos) / sizeof(infos[0]) == static_cast<size_t>(RenderGraphUsage::Count));
+        return infos[static_cast<size_t>(usage)];
+    }
+
+    bool isDepthFormat(VkFormat format)
+    {
+        switch (format)
+        {
+        case VK_FORMAT_D16_UNORM:
+        case VK_FORMAT_X8_D24_UNORM_PACK32:
+        case VK_FORMAT_D32_SFLOAT:
+        case VK_FORMAT_D16_UNORM_S8_UINT:
+        case VK_FORMAT_D24_UNORM_S8_UINT:
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:
+        case VK_FORMAT_S8_UINT:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    VkImageAspectFlags getAspectMask(VkFormat format)
+    {
+        switch (format)
+        {
+        case VK_FORMAT_S8_UINT:
+            return VK_IMAGE_ASPECT_STENCIL_BIT;
+        case VK_FORMAT_D16_UNORM_S8_UINT:
+        case VK_FORMAT_D24_UNORM_S8_UINT:
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:
+            return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+        default:
+            return isDepthFormat(format) ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+        }
+    }
+
+    // Only orders the images for slot assignment; the slots are sized from the real requirements
+    uint64_t estimateImageSize(const RenderGraphImageDesc& desc)
+    {
+        uint64_t bytesPerPixel = 4;
+        switch (desc.format)
+        {
+        case VK_FORMAT_R8_UNORM:
+        case VK_FORMAT_S8_UINT:
+            bytesPerPixel = 1;
+            break;
+        case VK_FORMAT_R8G8_UNORM:
+        case VK_FORMAT_R16_SFLOAT:
+        case VK_FORMAT_D16_UNORM:
+            bytesPerPixel = 2;
+            break;
+        case VK_FORMAT_R16G16B16A16_SFLOAT:
+        case VK_FORMAT_R32G32_SFLOAT:
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:
+            bytesPerPixel = 8;
+            break;
+        case VK_FORMAT_R32G32B32A32_SFLOAT:
+            bytesPerPixel = 16;
+            break;
+        default:
+            break;
+        }
+        const uint64_t mipFactor = desc.mipLevels > 1 ? 4 : 3; // A full chain adds about a third
+        return static_cast<uint64_t>(desc.width) * desc.height * bytesPerPixel * desc.samples * mipFactor / 3;
+    }
+
+    bool sameDesc(const RenderGraphImageDesc& a, const RenderGraphImageDesc& b)
+    {
+        return a.width == b.width && a.height == b.height && a.format == b.format &&
+            a.mipLevels == b.mipLevels && a.samples == b.samples;
+    }
+
+    const char* getLayoutName(VkImageLayout layout)
+    {
+        switch (layout)
+        {
+        case VK_IMAGE_LAYOUT_UNDEFINED: return "UNDEFINED";
+        case VK_IMAGE_LAYOUT_GENERAL: return "GENERAL";
+        case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL: return "COLOR_ATTACHMENT";
+        case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL: return "DEPTH_STENCIL_ATTACHMENT";
+        case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL: return "DEPTH_STENCIL_READ_ONLY";
+        case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL: return "SHADER_READ_ONLY";
+        case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL: return "TRANSFER_SRC";
+        case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL: return "TRANSFER_DST";
+        case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR: return "PRESENT_SRC";
+        default: return "OTHER";
+        }
+    }
+
+    struct FlagName
+    {
+        uint64_t bit;
+        const char* name;
+    };
+
+    const FlagName stageNames[] = {
+        { VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, "TOP_OF_PIPE" },
+        { VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, "FRAGMENT_SHADER" },
+        { VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT, "EARLY_FRAGMENT_TESTS" },
+        { VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT, "LATE_FRAGMENT_TESTS" },
+        { VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, "COLOR_ATTACHMENT_OUTPUT" },
+        { VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, "COMPUTE_SHADER" },
+        { VK_PIPELINE_STAGE_2_TRANSFER_BIT, "TRANSFER" },
+        { VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, "BOTTOM_OF_PIPE" },
+        { VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, "ALL_COMMANDS" },
+    };
+
+    const FlagName accessNames[] = {
+        { VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, "SAMPLED_READ" },
+        { VK_ACCESS_2_SHADER_STORAGE_READ_BIT, "STORAGE_READ" },
+        { VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, "STORAGE_WRITE" },
+        { VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT, "COLOR_READ" },
+        { VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, "COLOR_WRITE" },
+        { VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT, "DEPTH_READ" },
+        { VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, "DEPTH_WRITE" },
+        { VK_ACCESS_2_TRANSFER_READ_BIT, "TRANSFER_READ" },
+        { VK_ACCESS_2_TRANSFER_WRITE_BIT, "TRANSFER_WRITE" },
+        { VK_ACCESS_2_MEMORY_READ_BIT, "MEMORY_READ" },
+        { VK_ACCESS_2_MEMORY_WRITE_BIT, "MEMORY_WRITE" },
+    };
+
+    template <size_t N>
+    void writeFlags(std::ostringstream& out, uint64_t flags, const FlagName (&names)[N])
+    {
+        if (flags == 0)
+        {
+            out << "NONE";
+            return;
+        }
+        const char* separator = "";
+        for (const FlagName& name : names)
+        {
+            if (flags & name.bit)
+            {
+                out << separator << name.name;
+                separator = "|";
+                flags &= ~name.bit;
+            }
+        }
+        if (flags != 0)
+        {
+            out << separator << "0x" << std::hex << flags << std::dec;
+        }
+    }
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Read(RenderGraphResource resource, RenderGraphUsage usage)
+{
+    m_pGraph->addAccess(m_Pass, resource, usage, false);
+    return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Write(RenderGraphResource resource, RenderGraphUsage usage)
+{
+    m_pGraph->addAccess(m_Pass, resource, usage, true);
+    return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::SetSideEffects()
+{
+    m_pGraph->m_Passes[m_Pass].sideEffects = true;
+    m_pGraph->m_Compiled = false;
+    return *this;
+}
+
+RenderGraph::RenderGraph(Device* pDevice, VmaAllocator allocator, uint32_t framesInFlight)
+    : m_pDevice(pDevice), m_Allocator(allocator), m_FramesInFlight(framesInFlight)
+{
+    CAE_LOG_TRACE(Render, "RenderGraph created.");
+}
+
+RenderGraph::~RenderGraph()
+{
+    for (const PhysicalImage& physicalImage : m_PhysicalImages)
+    {
+        retire(physicalImage.image, physicalImage.view, physicalImage.dedicated);
+    }
+    for (const MemorySlot& slot : m_Slots)
+    {
+        retire(VK_NULL_HANDLE, VK_NULL_HANDLE, slot.allocation);
+    }
+    destroyRetired(true);
+    CAE_LOG_TRACE(Render, "RenderGraph destroyed.");
+}
+
+void RenderGraph::Reset()
+{
+    m_Passes.clear();
+    m_Resources.clear();
+    m_Compiled = false;
+}
+
+RenderGraphResource RenderGraph::CreateImage(const std::string& name, const RenderGraphImageDesc& desc)
+{
+    Resource resource;
+    resource.name = name;
+    resource.desc = desc;
+    m_Resources.push_back(std::move(resource));
+    m_Compiled = false;
+    return RenderGraphResource{ static_cast<uint32_t>(m_Resources.size() - 1) };
+}
+
+RenderGraphResource RenderGraph::ImportImage(const std::string& name, const RenderGraphImportedImage& image)
+{
+    Resource resource;
+    resource.name = name;
+    resource.imported = true;
+    resource.import = image;
+    resource.desc.width = image.extent.width;
+    resource.desc.height = image.extent.height;
+    resource.desc.format = image.format;
+    resource.image = image.image;
+    resource.view = image.view;
+    m_Resources.push_back(std::move(resource));
+    m_Compiled = false;
+    return RenderGraphResource{ static_cast<uint32_t>(m_Resources.size() - 1) };
+}
+
+RenderGraph::PassBuilder RenderGraph::AddPass(const std::string& name, ExecuteFunction execute)
+{
+    Pass pass;
+    pass.name = name;
+    pass.execute = std::move(execute);
+    m_Passes.push_back(std::move(pass));
+    m_Compiled = false;
+    return PassBuilder(this, static_cast<uint32_t>(m_Passes.size() - 1));
+}
+
+void RenderGraph::addAccess(uint32_t pass, RenderGraphResource resource, RenderGraphUsage usage, bool write)
+{
+    Pass& graphPass = m_Passes[pass];
+    Resource& graphResource = m_Resources.at(resource.index);
+    const UsageInfo& info = getUsageInfo(usage);
+
+    const VkAccessFlags2 readAccess = write ? VK_ACCESS_2_NONE : info.readAccess;
+    const VkAccessFlags2 writeAccess = write ? info.writeAccess : VK_ACCESS_2_NONE;
+    if ((write ? writeAccess : readAccess) == VK_ACCESS_2_NONE)
+    {
+        throw std::runtime_error("RenderGraph: pass '" + graphPass.name + "' cannot " +
+            (write ? "write '" : "read '") + graphResource.name + "' with this usage");
+    }
+
+    auto existing = std::find_if(graphPass.accesses.begin(), graphPass.accesses.end(),
+        [&](const Access& access) { return access.resource == resource.index; });
+    if (existing == graphPass.accesses.end())
+    {
+        graphPass.accesses.push_back({ resource.index, info.layout, info.stages, readAccess, writeAccess });
+    }
+    else
+    {
+        if (existing->layout != info.layout)
+        {
+            throw std::runtime_error("RenderGraph: pass '" + graphPass.name + "' uses '" + graphResource.name +
+                "' in two layouts");
+        }
+        existing->stages |= info.stages;
+        existing->readAccess |= readAccess;
+        existing->writeAccess |= writeAccess;
+    }
+
+    graphResource.usage |= info.imageUsage;
+    m_Compiled = false;
+}
+
+const RenderGraphPlan& RenderGraph::Compile()
+{
+    m_Plan = RenderGraphPlan{};
+    m_Plan.firstUse.assign(m_Resources.size(), ~0u);
+    m_Plan.lastUse.assign(m_Resources.size(), ~0u);
+    m_Plan.memorySlots.assign(m_Resources.size(), ~0u);
+
+    std::vector<bool> alive(m_Passes.size(), false);
+    cullPasses(alive);
+    for (uint32_t pass = 0; pass < m_Passes.size(); ++pass)
+    {
+        if (alive[pass])
+        {
+            m_Plan.steps.push_back({ pass, {} });
+        }
+        else
+        {
+            m_Plan.culledPasses.push_back(pass);
+        }
+    }
+
+    std::vector<bool> written(m_Resources.size(), false);
+    for (uint32_t step = 0; step < m_Plan.steps.size(); ++step)
+    {
+        const Pass& pass = m_Passes[m_Plan.steps[step].pass];
+        for (const Access& access : pass.accesses)
+        {
+            const Resource& resource = m_Resources[access.resource];
+            if (!resource.imported && access.readAccess != VK_ACCESS_2_NONE && !written[access.resource])
+            {
+                throw std::runtime_error("RenderGraph: pass '" + pass.name + "' reads '" + resource.name +
+                    "' before any pass writes it");
+            }
+            written[access.resource] = written[access.resource] || access.writeAccess != VK_ACCESS_2_NONE;
+
+            if (m_Plan.firstUse[access.resource] == ~0u)
+            {
+                m_Plan.firstUse[access.resource] = step;
+            }
+            m_Plan.lastUse[access.resource] = step;
+        }
+    }
+
+    assignMemorySlots();
+    m_Plan.slotStartStates.resize(m_Plan.slotCount);
+    for (uint32_t slot = 0; slot < m_Plan.slotCount && slot < m_Slots.size(); ++slot)
+    {
+        m_Plan.slotStartStates[slot] = m_Slots[slot].carried;
+    }
+    planBarriers();
+    m_Compiled = true;
+    return m_Plan;
+}
+
+void RenderGraph::cullPasses(std::vector<bool>& alive) const
+{
+    // Walk back from the imported images: a pass is needed when it writes something a later needed
+    // pass reads, or an imported image nothing overwrites afterwards
+    std::vector<bool> needed(m_Resources.size(), false);
+    for (size_t i = 0; i < m_Resources.size(); ++i)
+    {
+        needed[i] = m_Resources[i].imported;
+    }
+
+    for (size_t i = m_Passes.size(); i-- > 0;)
+    {
+        const Pass& pass = m_Passes[i];
+        bool isAlive = pass.sideEffects;
+        for (const Access& access : pass.accesses)
+        {
+            isAlive = isAlive || (access.writeAccess != VK_ACCESS_2_NONE && needed[access.resource]);
+        }
+        alive[i] = isAlive;
+        if (!isAlive)
+        {
+            continue;
+        }
+
+        // Writes that do not read the previous contents make earlier writes dead
+        for (const Access& access : pass.accesses)
+        {
+            if (access.writeAccess != VK_ACCESS_2_NONE && access.readAccess == VK_ACCESS_2_NONE)
+            {
+                needed[access.resource] = false;
+            }
+        }
+        for (const Access& access : pass.accesses)
+        {
+            if (access.readAccess != VK_ACCESS_2_NONE)
+            {
+                needed[access.resource] = true;
+            }
+        }
+    }
+}
+
+void RenderGraph::assignMemorySlots()
+{
+    std::vector<uint32_t> transients;
+    for (uint32_t i = 0; i < m_Resources.size(); ++i)
+    {
+        if (!m_Resources[i].imported && m_Plan.firstUse[i] != ~0u)
+        {
+            transients.push_back(i);
+        }
+    }
+    // Largest first, so smaller images fill the gaps in the lifetimes of larger ones
+    std::stable_sort(transients.begin(), transients.end(), [this](uint32_t a, uint32_t b)
+        {
+            return estimateImageSize(m_Resources[a].desc) > estimateImageSize(m_Resources[b].desc);
+        });
+
+    // Depth and color images are kept apart; some devices place them in different memory types
+    std::vector<std::vector<uint32_t>> slotResidents;
+    std::vector<bool> slotIsDepth;
+    for (uint32_t resource : transients)
+    {
+        const bool depth = isDepthFormat(m_Resources[resource].desc.format);
+        uint32_t slot = 0;
+        for (; slot < slotResidents.size(); ++slot)
+        {
+            if (slotIsDepth[slot] != depth)
+            {
+                continue;
+            }
+            const bool overlaps = std::any_of(slotResidents[slot].begin(), slotResidents[slot].end(), [&](uint32_t other)
+                {
+                    return m_Plan.firstUse[resource] <= m_Plan.lastUse[other] && m_Plan.firstUse[other] <= m_Plan.lastUse[resource];
+                });
+            if (!overlaps)
+            {
+                break;
+            }
+        }
+        if (slot == slotResidents.size())
+        {
+            slotResidents.emplace_back();
+            slotIsDepth.push_back(depth);
+        }
+        slotResidents[slot].push_back(resource);
+        m_Plan.memorySlots[resource] = slot;
+    }
+    m_Plan.slotCount = static_cast<uint32_t>(slotResidents.size());
+}
+
+void RenderGraph::planBarriers()
+{
+    struct State
+    {
+        VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        VkPipelineStageFlags2 writeStages = VK_PIPELINE_STAGE_2_NONE; // Last write or layout transition
+        VkAccessFlags2 writeAccess = VK_ACCESS_2_NONE;
+        VkPipelineStageFlags2 readStages = VK_PIPELINE_STAGE_2_NONE;  // Reads since then
+        VkPipelineStageFlags2 visibleStages = VK_PIPELINE_STAGE_2_NONE; // Reads already synchronized with it
+        VkAccessFlags2 visibleAccess = VK_ACCESS_2_NONE;
+    };
+
+    std::vector<State> states(m_Resources.size());
+    for (size_t i = 0; i < m_Resources.size(); ++i)
+    {
+        if (m_Resources[i].imported)
+        {
+            const RenderGraphImportedImage& import = m_Resources[i].import;
+            states[i].layout = import.initialLayout;
+            states[i].writeStages = import.initialStages;
+            states[i].writeAccess = import.initialAccess;
+        }
+    }
+    std::vector<uint32_t> slotOccupants(m_Plan.slotCount, ~0u);
+
+    for (uint32_t step = 0; step < m_Plan.steps.size(); ++step)
+    {
+        RenderGraphPlan::Step& planStep = m_Plan.steps[step];
+        for (const Access& access : m_Passes[planStep.pass].accesses)
+        {
+            State& state = states[access.resource];
+
+            RenderGraphBarrier barrier;
+            barrier.resource = access.resource;
+            barrier.dstStages = access.stages;
+            barrier.dstAccess = access.readAccess | access.writeAccess;
+            barrier.oldLayout = state.layout;
+            barrier.newLayout = access.layout;
+            bool needed = false;
+
+            if (!m_Resources[access.resource].imported && m_Plan.firstUse[access.resource] == step)
+            {
+                // The previous contents are discarded, but the memory's previous user must be done with it
+                const uint32_t slot = m_Plan.memorySlots[access.resource];
+                const uint32_t previous = slotOccupants[slot];
+                if (previous != ~0u)
+                {
+                    barrier.srcStages = states[previous].writeStages | states[previous].readStages;
+                    barrier.srcAccess = states[previous].writeAccess;
+                }
+                else
+                {
+                    barrier.srcStages = m_Plan.slotStartStates[slot].stages;
+                    barrier.srcAccess = m_Plan.slotStartStates[slot].access;
+                }
+                slotOccupants[slot] = access.resource;
+                barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+                needed = true;
+            }
+            else if (state.layout != access.layout || access.writeAccess != VK_ACCESS_2_NONE)
+            {
+                // Layout transitions and writes wait for earlier reads and writes
+                barrier.srcStages = state.writeStages | state.readStages;
+                barrier.srcAccess = state.writeAccess;
+                needed = state.layout != access.layout || barrier.srcStages != VK_PIPELINE_STAGE_2_NONE;
+            }
+            else
+            {
+                // Reads only wait for the last write, once per stage and access
+                barrier.srcStages = state.writeStages;
+                barrier.srcAccess = state.writeAccess;
+                needed = state.writeStages != VK_PIPELINE_STAGE_2_NONE &&
+                    ((access.stages & ~state.visibleStages) != 0 || (access.readAccess & ~state.visibleAccess) != 0);
+            }
+
+            const bool transition = needed && barrier.oldLayout != barrier.newLayout;
+            if (needed)
+            {
+                planStep.barriers.push_back(barrier);
+            }
+
+            state.layout = access.layout;
+            if (access.writeAccess != VK_ACCESS_2_NONE)
+            {
+                state.writeStages = access.stages;
+                state.writeAccess = access.writeAccess;
+                state.readStages = VK_PIPELINE_STAGE_2_NONE;
+                state.visibleStages = VK_PIPELINE_STAGE_2_NONE;
+                state.visibleAccess = VK_ACCESS_2_NONE;
+            }
+            else if (transition)
+            {
+                // The transition is a write that later reads in other stages still have to wait for
+                state.writeStages = access.stages;
+                state.writeAccess = VK_ACCESS_2_NONE;
+                state.readStages = access.stages;
+                state.visibleStages = access.stages;
+                state.visibleAccess = access.readAccess;
+            }
+            else
+            {
+                state.readStages |= access.stages;
+                if (needed)
+                {
+                    state.visibleStages |= access.stages;
+                    state.visibleAccess |= access.readAccess;
+                }
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < m_Resources.size(); ++i)
+    {
+        const Resource& resource = m_Resources[i];
+        if (!resource.imported || resource.import.finalLayout == VK_IMAGE_LAYOUT_UNDEFINED)
+        {
+            continue;
+        }
+        const State& state = states[i];
+        const VkPipelineStageFlags2 srcStages = state.writeStages | state.readStages;
+        const bool transition = state.layout != resource.import.finalLayout;
+        if (!transition && (resource.import.finalStages == VK_PIPELINE_STAGE_2_NONE || srcStages == VK_PIPELINE_STAGE_2_NONE))
+        {
+            continue;
+        }
+
+        RenderGraphBarrier barrier;
+        barrier.resource = i;
+        barrier.srcStages = srcStages;
+        barrier.srcAccess = state.writeAccess;
+        barrier.dstStages = resource.import.finalStages;
+        barrier.dstAccess = resource.import.finalAccess;
+        barrier.oldLayout = state.layout;
+        barrier.newLayout = resource.import.finalLayout;
+        m_Plan.finalBarriers.push_back(barrier);
+    }
+
+    m_Plan.slotEndStates.resize(m_Plan.slotCount);
+    for (uint32_t slot = 0; slot < m_Plan.slotCount; ++slot)
+    {
+        const State& state = states[slotOccupants[slot]];
+        m_Plan.slotEndStates[slot].stages = state.writeStages | state.readStages;
+        m_Plan.slotEndStates[slot].access = state.writeAccess;
+    }
+}
+
+std::string RenderGraph::DescribePlan() const
+{
+    std::ostringstream out;
+    out << "RenderGraph: " << m_Plan.steps.size() << " passes, " << m_Plan.culledPasses.size() << " culled, "
+        << m_Plan.slotCount << " transient memory slots";
+
+    auto writeBarrier = [&](const RenderGraphBarrier& barrier)
+        {
+            out << "\n    " << m_Resources[barrier.resource].name << ": ";
+            if (barrier.oldLayout != barrier.newLayout)
+            {
+                out << getLayoutName(barrier.oldLayout) << " -> " << getLayoutName(barrier.newLayout) << ", ";
+            }
+            writeFlags(out, barrier.srcStages, stageNames);
+            out << " / ";
+            writeFlags(out, barrier.srcAccess, accessNames);
+            out << " -> ";
+            writeFlags(out, barrier.dstStages, stageNames);
+            out << " / ";
+            writeFlags(out, barrier.dstAccess, accessNames);
+        };
+
+    for (uint32_t step = 0; step < m_Plan.steps.size(); ++step)
+    {
+        out << "\n  [" << step << "] " << m_Passes[m_Plan.steps[step].pass].name;
+        for (const RenderGraphBarrier& barrier : m_Plan.steps[step].barriers)
+        {
+            writeBarrier(barrier);
+        }
+    }
+    if (!m_Plan.finalBarriers.empty())
+    {
+        out << "\n  [end]";
+        for (const RenderGraphBarrier& barrier : m_Plan.finalBarriers)
+        {
+            writeBarrier(barrier);
+        }
+    }
+    for (uint32_t pass : m_Plan.culledPasses)
+    {
+        out << "\n  culled " << m_Passes[pass].name;
+    }
+    for (uint32_t slot = 0; slot < m_Plan.slotCount; ++slot)
+    {
+        out << "\n  slot " << slot << ":";
+        for (uint32_t i = 0; i < m_Resources.size(); ++i)
+        {
+            if (m_Plan.memorySlots[i] == slot)
+            {
+                out << " " << m_Resources[i].name << " [" << m_Plan.firstUse[i] << "-" << m_Plan.lastUse[i] << "]";
+            }
+        }
+        const RenderGraphPlan::SlotState& start = m_Plan.slotStartStates[slot];
+        if (start.stages != VK_PIPELINE_STAGE_2_NONE)
+        {
+            out << ", after ";
+            writeFlags(out, start.stages, stageNames);
+            out << " / ";
+            writeFlags(out, start.access, accessNames);
+        }
+    }
+    return out.str();
+}
+
+void RenderGraph::Execute(VkCommandBuffer commandBuffer)
+{
+    if (!m_Compiled)
+    {
+        Compile();
+    }
+
+    destroyRetired(false);
+    realizeTransientImages();
+
+    for (const RenderGraphPlan::Step& step : m_Plan.steps)
+    {
+        recordBarriers(commandBuffer, step.barriers);
+        m_Passes[step.pass].execute(commandBuffer);
+    }
+    recordBarriers(commandBuffer, m_Plan.finalBarriers);
+
+    for (uint32_t slot = 0; slot < m_Plan.slotCount; ++slot)
+    {
+        m_Slots[slot].carried = m_Plan.slotEndStates[slot];
+    }
+    ++m_FrameNumber;
+}
+
+void RenderGraph::realizeTransientImages()
+{
+    for (PhysicalImage& physicalImage : m_PhysicalImages)
+    {
+        physicalImage.used = false;
+    }
+
+    // Slots past the plan's count are released, together with every image bound to them
+    for (uint32_t slot = m_Plan.slotCount; slot < m_Slots.size(); ++slot)
+    {
+        retire(VK_NULL_HANDLE, VK_NULL_HANDLE, m_Slots[slot].allocation);
+    }
+    m_Slots.resize(m_Plan.slotCount);
+
+    // Reuse an image created for the same slot and description, or create one without memory
+    std::vector<size_t> physicalIndices(m_Resources.size(), ~size_t(0));
+    for (uint32_t i = 0; i < m_Resources.size(); ++i)
+    {
+        const uint32_t slot = m_Plan.memorySlots[i];
+        if (slot == ~0u)
+        {
+            continue;
+        }
+        const Resource& resource = m_Resources[i];
+        auto cached = std::find_if(m_PhysicalImages.begin(), m_PhysicalImages.end(), [&](const PhysicalImage& physicalImage)
+            {
+                return !physicalImage.used && physicalImage.slot == slot && physicalImage.usage == resource.usage &&
+                    sameDesc(physicalImage.desc, resource.desc);
+            });
+        if (cached == m_PhysicalImages.end())
+        {
+            m_PhysicalImages.push_back(createPhysicalImage(slot, resource));
+            cached = m_PhysicalImages.end() - 1;
+        }
+        cached->used = true;
+        physicalIndices[i] = static_cast<size_t>(cached - m_PhysicalImages.begin());
+    }
+
+    for (uint32_t slotIndex = 0; slotIndex < m_Plan.slotCount; ++slotIndex)
+    {
+        MemorySlot& slot = m_Slots[slotIndex];
+
+        VkMemoryRequirements combined{};
+        combined.memoryTypeBits = ~0u;
+        uint32_t largestTypeBits = ~0u;
+        for (const PhysicalImage& physicalImage : m_PhysicalImages)
+        {
+            if (!physicalImage.used || physicalImage.slot != slotIndex)
+            {
+                continue;
+            }
+            VkMemoryRequirements requirements;
+            vkGetImageMemoryRequirements(m_pDevice->get(), physicalImage.image, &requirements);
+            if (requirements.size > combined.size)
+            {
+                largestTypeBits = requirements.memoryTypeBits;
+            }
+            combined.size = std::max(combined.size, requirements.size);
+            combined.alignment = std::max(combined.alignment, requirements.alignment);
+            combined.memoryTypeBits &= requirements.memoryTypeBits;
+        }
+        if (combined.memoryTypeBits == 0)
+        {
+            // Images that do not accept the largest image's memory type get memory of their own
+            combined.memoryTypeBits = largestTypeBits;
+        }
+
+        VmaAllocationInfo allocationInfo{};
+        if (slot.allocation != VK_NULL_HANDLE)
+        {
+            vmaGetAllocationInfo(m_Allocator, slot.allocation, &allocationInfo);
+        }
+        const bool fits = slot.allocation != VK_NULL_HANDLE && slot.size >= combined.size &&
+            (combined.memoryTypeBits & (1u << slot.memoryType)) != 0 && allocationInfo.offset % combined.alignment == 0;
+        if (!fits)
+        {
+            // Images stay bound to the memory they were created with, so they are replaced along with it
+            if (slot.allocation != VK_NULL_HANDLE)
+            {
+                for (size_t i = 0; i < m_PhysicalImages.size(); ++i)
+                {
+                    PhysicalImage& physicalImage = m_PhysicalImages[i];
+                    if (physicalImage.slot != slotIndex || !physicalImage.bound || physicalImage.dedicated != VK_NULL_HANDLE)
+                    {
+                        continue;
+                    }
+                    retire(physicalImage.image, physicalImage.view, VK_NULL_HANDLE);
+                    physicalImage.image = VK_NULL_HANDLE;
+                    physicalImage.view = VK_NULL_HANDLE;
+                    if (physicalImage.used)
+                    {
+                        const uint32_t resource = static_cast<uint32_t>(std::find(physicalIndices.begin(), physicalIndices.end(), i) - physicalIndices.begin());
+                        physicalImage = createPhysicalImage(slotIndex, m_Resources[resource]);
+                        physicalImage.used = true;
+                    }
+                }
+                retire(VK_NULL_HANDLE, VK_NULL_HANDLE, slot.allocation);
+            }
+
+            VmaAllocationCreateInfo allocInfo{};
+            allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+            slot = MemorySlot{};
+            if (vmaAllocateMemory(m_Allocator, &combined, &allocInfo, &slot.allocation, &allocationInfo) != VK_SUCCESS)
+            {
+                throw std::runtime_error("failed to allocate render graph memory!");
+            }
+            slot.size = combined.size;
+            slot.memoryType = allocationInfo.memoryType;
+            CAE_LOG_DEBUG(Render, "RenderGraph memory slot " << slotIndex << " allocated with size: " << slot.size << " bytes");
+        }
+
+        for (PhysicalImage& physicalImage : m_PhysicalImages)
+        {
+            if (physicalImage.used && physicalImage.slot == slotIndex && !physicalImage.bound)
+            {
+                bindPhysicalImage(physicalImage, slot);
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < m_Resources.size(); ++i)
+    {
+        if (physicalIndices[i] != ~size_t(0))
+        {
+            m_Resources[i].image = m_PhysicalImages[physicalIndices[i]].image;
+            m_Resources[i].view = m_PhysicalImages[physicalIndices[i]].view;
+        }
+    }
+
+    // Images no declared resource matched this frame
+    auto unused = std::stable_partition(m_PhysicalImages.begin(), m_PhysicalImages.end(),
+        [](const PhysicalImage& physicalImage) { return physicalImage.used; });
+    for (auto it = unused; it != m_PhysicalImages.end(); ++it)
+    {
+        retire(it->image, it->view, it->dedicated);
+    }
+    m_PhysicalImages.erase(unused, m_PhysicalImages.end());
+}
+
+RenderGraph::PhysicalImage RenderGraph::createPhysicalImage(uint32_t slot, const Resource& resource) const
+{
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = resource.desc.format;
+    imageInfo.extent = { resource.desc.width, resource.desc.height, 1 };
+    imageInfo.mipLevels = resource.desc.mipLevels;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = resource.desc.samples;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = resource.usage;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    PhysicalImage physicalImage;
+    physicalImage.slot = slot;
+    physicalImage.desc = resource.desc;
+    physicalImage.usage = resource.usage;
+    if (vkCreateImage(m_pDevice->get(), &imageInfo, nullptr, &physicalImage.image) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create render graph image!");
+    }
+    CAE_LOG_TRACE(Render, "RenderGraph image created for " << resource.name << " with width: " << resource.desc.width
+        << ", height: " << resource.desc.height);
+    return physicalImage;
+}
+
+void RenderGraph::bindPhysicalImage(PhysicalImage& physicalImage, const MemorySlot& slot)
+{
+    VkMemoryRequirements requirements;
+    vkGetImageMemoryRequirements(m_pDevice->get(), physicalImage.image, &requirements);
+
+    VkResult result;
+    if ((requirements.memoryTypeBits & (1u << slot.memoryType)) != 0)
+    {
+        result = vmaBindImageMemory(m_Allocator, slot.allocation, physicalImage.image);
+    }
+    else
+    {
+        VmaAllocationCreateInfo allocInfo{};
+        allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+        result = vmaAllocateMemoryForImage(m_Allocator, physicalImage.image, &allocInfo, &physicalImage.dedicated, nullptr);
+        if (result == VK_SUCCESS)
+        {
+            result = vmaBindImageMemory(m_Allocator, physicalImage.dedicated, physicalImage.image);
+        }
+        CAE_LOG_DEBUG(Render, "RenderGraph image in slot " << physicalImage.slot << " needs another memory type and is not aliased");
+    }
+    if (result != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to bind render graph image memory!");
+    }
+
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = physicalImage.image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = physicalImage.desc.format;
+    viewInfo.subresourceRange.aspectMask = getAspectMask(physicalImage.desc.format);
+    viewInfo.subresourceRange.levelCount = physicalImage.desc.mipLevels;
+    viewInfo.subresourceRange.layerCount = 1;
+    if (vkCreateImageView(m_pDevice->get(), &viewInfo, nullptr, &physicalImage.view) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create render graph image view!");
+    }
+    physicalImage.bound = true;
+}
+
+void RenderGraph::retire(VkImage image, VkImageView view, VmaAllocation allocation)
+{
+    if (image != VK_NULL_HANDLE || view != VK_NULL_HANDLE || allocation != VK_NULL_HANDLE)
+    {
+        m_Retired.push_back({ m_FrameNumber, image, view, allocation });
+    }
+}
+
+void RenderGraph::destroyRetired(bool all)
+{
+    // Execute() for frame N runs after the fence of frame N - framesInFlight has been waited on
+    auto expired = std::stable_partition(m_Retired.begin(), m_Retired.end(), [this, all](const Retired& retired)
+        {
+            return !all && m_FrameNumber < retired.frame + m_FramesInFlight;
+        });
+
+    // Images before the memory they are bound to
+    for (auto it = expired; it != m_Retired.end(); ++it)
+    {
+        if (it->view != VK_NULL_HANDLE)
+        {
+            vkDestroyImageView(m_pDevice->get(), it->view, nullptr);
+        }
+        if (it->image != VK_NULL_HANDLE)
+        {
+            vkDestroyImage(m_pDevice->get(), it->image, nullptr);
+        }
+    }
+    for (auto it = expired; it != m_Retired.end(); ++it)
+    {
+        if (it->allocation != VK_NULL_HANDLE)
+        {
+            vmaFreeMemory(m_Allocator, it->allocation);
+        }
+    }
+    m_Retired.erase(expired, m_Retired.end());
+}
+
+void RenderGraph::recordBarriers(VkCommandBuffer commandBuffer, const std::vector<RenderGraphBarrier>& barriers)
+{
+    if (barriers.empty())
+    {
+        return;
+    }
+
+    VkMemoryBarrier2 memoryBarrier{};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    bool hasMemoryBarrier = false;
+
+    m_ImageBarriers.clear();
+    for (const RenderGraphBarrier& barrier : barriers)
+    {
+        if (barrier.oldLayout == barrier.newLayout)
+        {
+            memoryBarrier.srcStageMask |= barrier.srcStages;
+            memoryBarrier.srcAccessMask |= barrier.srcAccess;
+            memoryBarrier.dstStageMask |= barrier.dstStages;
+            memoryBarrier.dstAccessMask |= barrier.dstAccess;
+            hasMemoryBarrier = true;
+            continue;
+        }
+
+        const Resource& resource = m_Resources[barrier.resource];
+        VkImageMemoryBarrier2 imageBarrier{};
+        imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+        imageBarrier.srcStageMask = barrier.srcStages;
+        imageBarrier.srcAccessMask = barrier.srcAccess;
+        imageBarrier.dstStageMask = barrier.dstStages;
+        imageBarrier.dstAccessMask = barrier.dstAccess;
+        imageBarrier.oldLayout = barrier.oldLayout;
+        imageBarrier.newLayout = barrier.newLayout;
+        imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.image = resource.image;
+        imageBarrier.subresourceRange.aspectMask = getAspectMask(resource.desc.format);
+        imageBarrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+        imageBarrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+        m_ImageBarriers.push_back(imageBarrier);
+    }
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.memoryBarrierCount = hasMemoryBarrier ? 1 : 0;
+    dependencyInfo.pMemoryBarriers = &memoryBarrier;
+    dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(m_ImageBarriers.size());
+    dependencyInfo.pImageMemoryBarriers = m_ImageBarriers.data();
+    vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+}
+
+const RenderGraph::Resource& RenderGraph::getResource(RenderGraphResource resource) const
+{
+    if (resource.index >= m_Resources.size())
+    {
+        throw std::runtime_error("RenderGraph: invalid resource");
+    }
+    return m_Resources[resource.index];
+}
+
+VkImage RenderGraph::GetImage(RenderGraphResource resource) const
+{
+    return getResource(resource).image;
+}
+
+VkImageView RenderGraph::GetImageView(RenderGraphResource resource) const
+{
+    return getResource(resource).view;
+}
+
+VkExtent2D RenderGraph::GetExtent(RenderGraphResource resource) const
+{
+    const Resource& graphResource = getResource(resource);
+    return { graphResource.desc.width, graphResource.desc.height };
+}
+
+VkFormat RenderGraph::GetFormat(RenderGraphResource resource) const
+{
+    return getResource(resource).desc.format;
+}
+
+VkDeviceSize RenderGraph::GetTransientMemorySize() const
+{
+    VkDeviceSize size = 0;
+    for (const MemorySlot& slot : m_Slots)
+    {
+        size += slot.size;
+    }
+    return size;
+}
+
+bool RenderGraph::RunSelfCheck()
+{
+    RenderGraph graph(nullptr, nullptr, 2);
+    const ExecuteFunction noop = [](VkCommandBuffer) {};
+
+    RenderGraphImportedImage swapChain;
+    swapChain.format = VK_FORMAT_B8G8R8A8_SRGB;
+    swapChain.extent = { 1280, 720 };
+    swapChain.initialStages = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    swapChain.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    const RenderGraphResource backBuffer = graph.ImportImage("SwapChain", swapChain);
+    const RenderGraphResource depth = graph.CreateImage("Depth", { 1280, 720, VK_FORMAT_D32_SFLOAT });
+    const RenderGraphResource hdr = graph.CreateImage("HDR", { 1280, 720, VK_FORMAT_R16G16B16A16_SFLOAT });
+    const RenderGraphResource bloom = graph.CreateImage("Bloom", { 640, 360, VK_FORMAT_R16G16B16A16_SFLOAT });
+    const RenderGraphResource bloomBlur = graph.CreateImage("BloomBlur", { 640, 360, VK_FORMAT_R16G16B16A16_SFLOAT });
+    const RenderGraphResource debug = graph.CreateImage("Debug", { 1280, 720, VK_FORMAT_R8G8B8A8_UNORM });
+
+    graph.AddPass("DepthPrepass", noop).Write(depth, RenderGraphUsage::DepthStencilAttachment);
+    graph.AddPass("Lighting", noop).Read(depth, RenderGraphUsage::DepthStencilAttachment).Write(hdr, RenderGraphUsage::ColorAttachment);
+    graph.AddPass("DebugView", noop).Read(hdr, RenderGraphUsage::FragmentSampled).Write(debug, RenderGraphUsage::ColorAttachment);
+    graph.AddPass("BloomExtract", noop).Read(hdr, RenderGraphUsage::ComputeSampled).Write(bloom, RenderGraphUsage::ComputeStorage);
+    graph.AddPass("BloomBlur", noop).Read(bloom, RenderGraphUsage::ComputeSampled).Write(bloomBlur, RenderGraphUsage::ComputeStorage);
+    graph.AddPass("Tonemap", noop).Read(bloomBlur, RenderGraphUsage::FragmentSampled).Write(backBuffer, RenderGraphUsage::ColorAttachment);
+    graph.Compile();
+
+    const std::string expected =
+        "RenderGraph: 5 passes, 1 culled, 3 transient memory slots"
+        "\n  [0] DepthPrepass"
+        "\n    Depth: UNDEFINED -> DEPTH_STENCIL_ATTACHMENT, NONE / NONE -> EARLY_FRAGMENT_TESTS|LATE_FRAGMENT_TESTS / DEPTH_WRITE"
+        "\n  [1] Lighting"
+        "\n    Depth: EARLY_FRAGMENT_TESTS|LATE_FRAGMENT_TESTS / DEPTH_WRITE -> EARLY_FRAGMENT_TESTS|LATE_FRAGMENT_TESTS / DEPTH_READ"
+        "\n    HDR: UNDEFINED -> COLOR_ATTACHMENT, NONE / NONE -> COLOR_ATTACHMENT_OUTPUT / COLOR_WRITE"
+        "\n  [2] BloomExtract"
+        "\n    HDR: COLOR_ATTACHMENT -> SHADER_READ_ONLY, COLOR_ATTACHMENT_OUTPUT / COLOR_WRITE -> COMPUTE_SHADER / SAMPLED_READ"
+        "\n    Bloom: UNDEFINED -> GENERAL, NONE / NONE -> COMPUTE_SHADER / STORAGE_WRITE"
+        "\n  [3] BloomBlur"
+        "\n    Bloom: GENERAL -> SHADER_READ_ONLY, COMPUTE_SHADER / STORAGE_WRITE -> COMPUTE_SHADER / SAMPLED_READ"
+        "\n    BloomBlur: UNDEFINED -> GENERAL, COMPUTE_SHADER / NONE -> COMPUTE_SHADER / STORAGE_WRITE"
+        "\n  [4] Tonemap"
+        "\n    BloomBlur: GENERAL -> SHADER_READ_ONLY, COMPUTE_SHADER / STORAGE_WRITE -> FRAGMENT_SHADER / SAMPLED_READ"
+        "\n    SwapChain: UNDEFINED -> COLOR_ATTACHMENT, COLOR_ATTACHMENT_OUTPUT / NONE -> COLOR_ATTACHMENT_OUTPUT / COLOR_WRITE"
+        "\n  [end]"
+        "\n    SwapChain: COLOR_ATTACHMENT -> PRESENT_SRC, COLOR_ATTACHMENT_OUTPUT / COLOR_WRITE -> NONE / NONE"
+        "\n  culled DebugView"
+        "\n  slot 0: HDR [1-2] BloomBlur [3-4]"
+        "\n  slot 1: Depth [0-1]"
+        "\n  slot 2: Bloom [2-3]";
+    const std::string plan = graph.DescribePlan();
+    if (plan != expected)
+    {
+        CAE_LOG_ERROR(Render, "RenderGraph self-check failed, plan:\n" << plan << "\nexpected:\n" << expected);
+        return false;
+    }
+    CAE_LOG_INFO(Render, "RenderGraph self-check passed: " << graph.m_Plan.steps.size() << " passes, "
+        << graph.m_Plan.culledPasses.size() << " culled, " << graph.m_Plan.slotCount << " memory slots");
+    return true;
+}
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include "vk_mem_alloc.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class Device;
+
+// How a pass uses an image. Decides the layout, pipeline stages and access of the barriers around it.
+enum class RenderGraphUsage : uint8_t
+{
+    ColorAttachment,        // Read when loaded, written by draws
+    DepthStencilAttachment, // Read by depth tests, written by depth writes
+    FragmentSampled,        // Read only
+    ComputeSampled,         // Read only
+    ComputeStorage,         // Storage image in GENERAL layout
+    TransferSource,         // Read only
+    TransferDestination,    // Write only
+    Count
+};
+
+struct RenderGraphResource
+{
+    uint32_t index = ~0u;
+
+    bool IsValid() const { return index != ~0u; }
+};
+
+// An image created and owned by the graph. Its memory is aliased with other transient images whose
+// lifetimes within the frame do not overlap, and its contents do not survive the frame.
+struct RenderGraphImageDesc
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    uint32_t mipLevels = 1;
+    VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+};
+
+// An image owned outside the graph, such as a swapchain image. The initial and final state chain the
+// graph's barriers with whatever comes before and after the frame, for example a semaphore wait.
+struct RenderGraphImportedImage
+{
+    VkImage image = VK_NULL_HANDLE;
+    VkImageView view = VK_NULL_HANDLE;
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    VkExtent2D extent{};
+
+    VkImageLayout initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkPipelineStageFlags2 initialStages = VK_PIPELINE_STAGE_2_NONE; // Stages the previous use ran in
+    VkAccessFlags2 initialAccess = VK_ACCESS_2_NONE;                // Writes of the previous use
+
+    VkImageLayout finalLayout = VK_IMAGE_LAYOUT_UNDEFINED;          // UNDEFINED keeps the last layout
+    VkPipelineStageFlags2 finalStages = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2 finalAccess = VK_ACCESS_2_NONE;
+};
+
+struct RenderGraphBarrier
+{
+    uint32_t resource = ~0u;
+    VkPipelineStageFlags2 srcStages = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2 srcAccess = VK_ACCESS_2_NONE;
+    VkPipelineStageFlags2 dstStages = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2 dstAccess = VK_ACCESS_2_NONE;
+    VkImageLayout oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkImageLayout newLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+};
+
+// Output of RenderGraph::Compile(), built on the CPU without touching the device
+struct RenderGraphPlan
+{
+    struct Step
+    {
+        uint32_t pass = ~0u;
+        // Recorded as one vkCmdPipelineBarrier2 before the pass. Barriers without a layout change are
+        // merged into a single global memory barrier.
+        std::vector<RenderGraphBarrier> barriers;
+    };
+
+    struct SlotState
+    {
+        VkPipelineStageFlags2 stages = VK_PIPELINE_STAGE_2_NONE;
+        VkAccessFlags2 access = VK_ACCESS_2_NONE;
+    };
+
+    std::vector<Step> steps;                       // Passes that run, in the order they were added
+    std::vector<RenderGraphBarrier> finalBarriers; // Imported images into their final layouts
+    std::vector<uint32_t> culledPasses;            // Passes whose results nothing uses
+
+    // Per resource: step range in which it is used, ~0u when unused
+    std::vector<uint32_t> firstUse;
+    std::vector<uint32_t> lastUse;
+    // Per resource: memory slot of a transient image, ~0u for imported or unused images
+    std::vector<uint32_t> memorySlots;
+    uint32_t slotCount = 0;
+    // Per slot: what the first use of its memory waits for, i.e. the slotEndStates of the last executed
+    // plan. NONE for slots that did not exist then and for graphs that have never executed.
+    std::vector<SlotState> slotStartStates;
+    // Per slot: last use of its memory in the frame, which the next frame's first use waits for
+    std::vector<SlotState> slotEndStates;
+};
+
+//
+// Frame render graph. Each frame the renderer declares its images and the passes that read and write
+// them, then executes the graph. Compile() works on the CPU only:
+// - culls passes whose results are never read and that do not write an imported image,
+// - plans the minimal synchronization2 barriers and layout transitions, batched into one barrier per pass,
+// - assigns transient images with non-overlapping lifetimes to shared memory slots.
+// Execute() creates or reuses the transient images, records the barriers and runs the passes. Transient
+// memory and images are kept across frames and only replaced when the declared images change. Because the
+// memory is reused, the one input Compile() takes from earlier frames is the end state of each slot in the
+// last executed plan (RenderGraphPlan::slotStartStates); the same declarations compile to the same plan
+// otherwise, and a graph that never executes always starts its slots from NONE.
+//
+class RenderGraph
+{
+public:
+    using ExecuteFunction = std::function<void(VkCommandBuffer commandBuffer)>;
+
+    class PassBuilder
+    {
+    public:
+        // A pass that reads and writes an image declares both; the usages must agree on the layout
+        PassBuilder& Read(RenderGraphResource resource, RenderGraphUsage usage);
+        PassBuilder& Write(RenderGraphResource resource, RenderGraphUsage usage);
+        // Keeps the pass even if nothing reads what it writes, for passes with effects outside the graph
+        PassBuilder& SetSideEffects();
+
+    private:
+        friend class RenderGraph;
+        PassBuilder(RenderGraph* pGraph, uint32_t pass) : m_pGraph(pGraph), m_Pass(pass) {}
+
+        RenderGraph* m_pGraph;
+        uint32_t m_Pass;
+    };
+
+    // pDevice may be nullptr for a graph that is only compiled, e.g. to inspect the barrier plan
+    RenderGraph(Device* pDevice, VmaAllocator allocator, uint32_t framesInFlight);
+    ~RenderGraph();
+
+    RenderGraph(const RenderGraph&) = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+
+    // Clears the previous frame's passes and images; transient memory is kept for reuse
+    void Reset();
+
+    RenderGraphResource CreateImage(const std::string& name, const RenderGraphImageDesc& desc);
+    RenderGraphResource ImportImage(const std::string& name, const RenderGraphImportedImage& image);
+    PassBuilder AddPass(const std::string& name, ExecuteFunction execute);
+
+    const RenderGraphPlan& Compile();
+    // One line per pass, barrier, culled pass and memory slot of the last compiled plan
+    std::string DescribePlan() const;
+
+    // Compiles if needed, then records the barriers and passes into commandBuffer
+    void Execute(VkCommandBuffer commandBuffer);
+
+    // Valid inside pass callbacks
+    VkImage GetImage(RenderGraphResource resource) const;
+    VkImageView GetImageView(RenderGraphResource resource) const;
+    VkExtent2D GetExtent(RenderGraphResource resource) const;
+    VkFormat GetFormat(RenderGraphResource resource) const;
+
+    // Bytes of device memory held by the transient memory slots
+    VkDeviceSize GetTransientMemorySize() const;
+
+    // Compiles a small deferred frame without a device and compares DescribePlan() with the expected
+    // culling, barriers and slot aliasing; logs the difference and returns false on a mismatch
+    static bool RunSelfCheck();
+
+private:
+    // Read and write declarations of one image by one pass, merged
+    struct Access
+    {
+        uint32_t resource;
+        VkImageLayout layout;
+        VkPipelineStageFlags2 stages;
+        VkAccessFlags2 readAccess;
+        VkAccessFlags2 writeAccess;
+    };
+
+    struct Pass
+    {
+        std::string name;
+        ExecuteFunction execute;
+        std::vector<Access> accesses; // At most one per resource
+        bool sideEffects = false;
+    };
+
+    struct Resource
+    {
+        std::string name;
+        bool imported = false;
+        RenderGraphImageDesc desc;
+        RenderGraphImportedImage import;
+        VkImageUsageFlags usage = 0; // Union of the declared usages
+        VkImage image = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+    };
+
+    struct MemorySlot
+    {
+        VmaAllocation allocation = VK_NULL_HANDLE;
+        VkDeviceSize size = 0;
+        uint32_t memoryType = ~0u;
+        RenderGraphPlan::SlotState carried; // End state in the last executed plan, the next Compile()'s start state
+    };
+
+    struct PhysicalImage
+    {
+        uint32_t slot;
+        RenderGraphImageDesc desc;
+        VkImageUsageFlags usage;
+        VkImage image = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        VmaAllocation dedicated = VK_NULL_HANDLE; // Only when the slot's memory type does not suit the image
+        bool bound = false;
+        bool used = false;
+    };
+
+    // Destroyed once the frames that may still use it have completed
+    struct Retired
+    {
+        uint64_t frame;
+        VkImage image = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        VmaAllocation allocation = VK_NULL_HANDLE;
+    };
+
+    void addAccess(uint32_t pass, RenderGraphResource resource, RenderGraphUsage usage, bool write);
+    void cullPasses(std::vector<bool>& alive) const;
+    void assignMemorySlots();
+    void planBarriers();
+    void realizeTransientImages();
+    PhysicalImage createPhysicalImage(uint32_t slot, const Resource& resource) const;
+    void bindPhysicalImage(PhysicalImage& physicalImage, const MemorySlot& slot);
+    void retire(VkImage image, VkImageView view, VmaAllocation allocation);
+    void destroyRetired(bool all);
+    void recordBarriers(VkCommandBuffer commandBuffer, const std::vector<RenderGraphBarrier>& barriers);
+    const Resource& getResource(RenderGraphResource resource) const;
+
+    Device* m_pDevice;
+    VmaAllocator m_Allocator;
+    uint32_t m_FramesInFlight;
+    uint64_t m_FrameNumber = 0;
+
+    std::vector<Pass> m_Passes;
+    std::vector<Resource> m_Resources;
+    RenderGraphPlan m_Plan;
+    bool m_Compiled = false;
+
+    std::vector<MemorySlot> m_Slots;
+    std::vector<PhysicalImage> m_PhysicalImages;
+    std::vector<Retired> m_Retired;
+    std::vector<VkImageMemoryBarrier2> m_ImageBarriers; // Reused by recordBarriers()
+};
@@ -6,9 +6,9 @@
 #include "Runtime/EngineCore/RHI/Device.h"
 #include "Runtime/EngineCore/RHI/Surface.h"
 #include "Runtime/EngineCore/RHI/SwapChain.h"
-#include <iostream>
 #include <stdexcept>
 #include "imgui_internal.h"
+#include "Runtime/EngineCore/Core/Log.h"
 
 #ifdef _DEBUG
 #define APP_USE_VULKAN_DEBUG_REPORT
@@ -34,16 +34,19 @@ void ImGuiLayer::check_vk_result(VkResult err)
 {
     if (err == VK_SUCCESS)
         return;
-    std::cerr << "[vulkan] Error: VkResult = " << err << std::endl;
+    CAE_LOG_ERROR(Render, "[vulkan] Error: VkResult = " << err);
     if (err < 0)
+    {
+        Log::flush();
         std::abort();
+    }
 }
 
 #ifdef APP_USE_VULKAN_DEBUG_REPORT
 static VKAPI_ATTR VkBool32 VKAPI_CALL debug_report(VkDebugReportFlagsEXT flags, VkDebugReportObjectTypeEXT objectType, uint64_t object, size_t location, int32_t messageCode, const char* pLayerPrefix, const char* pMessage, void* pUserData)
 {
     (void)flags; (void)object; (void)location; (void)messageCode; (void)pUserData; (void)pLayerPrefix;
-    std::cerr << "[vulkan] Debug report from ObjectType: " << objectType << "\nMessage: " << pMessage << "\n\n" << std::endl;
+    CAE_LOG_WARNING(Render, "[vulkan] Debug report from ObjectType: " << objectType << "\nMessage: " << pMessage);
     return VK_FALSE;
 }
 #endif
@@ -144,8 +147,11 @@ void ImGuiLayer::OnAttach()
     
     init_info.CheckVkResultFn = [](VkResult err) { 
         if (err != VK_SUCCESS) {
-            std::cerr << "[vulkan] Error: VkResult = " << err << std::endl;
-            if (err < 0) std::abort();
+            CAE_LOG_ERROR(Render, "[vulkan] Error: VkResult = " << err);
+            if (err < 0) {
+                Log::flush();
+                std::abort();
+            }
         }
     };
     
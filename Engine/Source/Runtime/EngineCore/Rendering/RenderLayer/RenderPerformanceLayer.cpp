@@ -274,3 +274,8 @@ void RenderPerformanceLayer::OnRender(VkCommandBuffer commandBuffer)
     // This layer renders ImGui content during OnUpdate(), not during Vulkan rendering
     // The ImGuiLayer will handle all Vulkan command buffer recording for ImGui
 }
+
+void RenderPerformanceLayer::OnRecord(ParallelCommandRecorder& recorder)
+{
+    // Nothing to record, so no secondary command buffer is spent on this layer
+}
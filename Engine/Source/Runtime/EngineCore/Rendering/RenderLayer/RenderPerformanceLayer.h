@@ -19,6 +19,7 @@ public:
     void OnDetach() override;
     void OnUpdate(float deltaTime) override;
     void OnRender(VkCommandBuffer commandBuffer) override;
+    void OnRecord(ParallelCommandRecorder& recorder) override;
 
     void SetRendererContext(Renderer* renderer);
 
@@ -1,6 +1,5 @@
 #include "Renderer.h"
 #include <stdexcept>
-#include <iostream>
 #include <glm/glm.hpp>
 #include <chrono>
 
@@ -10,6 +9,7 @@
 #include "Runtime/EngineCore/RHI/DeviceBuilder.h"
 #include "Runtime/EngineCore/RHI/PhysicalDeviceBuilder.h"
 #include "Runtime/EngineCore/RHI/SwapChainBuilder.h"
+#include "Runtime/EngineCore/Core/Log.h"
 
 //TODO: Will move to vulkan specific RHI types
 const std::vector<char const*> validationLayers = {
@@ -26,13 +26,13 @@ constexpr bool enableValidationLayers = true;
 
 Renderer::Renderer(Window* window)
 {
-    std::cout << "Renderer created." << std::endl;
+    CAE_LOG_TRACE(Render, "Renderer created.");
 }
 
 Renderer::~Renderer() 
 {
     Shutdown();
-    std::cout << "Destroying Renderer." << std::endl;
+    CAE_LOG_TRACE(Render, "Destroying Renderer.");
 }
 
 void Renderer::Initialize(Window* window)
@@ -68,6 +68,26 @@ void Renderer::Shutdown()
         CleanupSwapChainResources();
         
         // Clean up Vulkan objects in correct order
+        if (m_RenderGraph) {
+            m_RenderGraph.reset();
+        }
+        
+        if (m_CommandRecorder) {
+            m_CommandRecorder.reset();
+        }
+        
+        if (m_UniformAllocator) {
+            m_UniformAllocator.reset();
+        }
+        
+        if (m_TransferQueue) {
+            m_TransferQueue.reset();
+        }
+        
+        if (m_StagingRing) {
+            m_StagingRing.reset();
+        }
+        
         if (m_CommandPool) {
             m_CommandPool.reset();
         }
@@ -156,11 +176,19 @@ void Renderer::InitializeVulkan()
     VkPhysicalDeviceVulkan12Features vulkan12Features{};
     vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
     vulkan12Features.bufferDeviceAddress = VK_TRUE;
+    vulkan12Features.timelineSemaphore = VK_TRUE; // Core in 1.2, tracks transfer queue jobs
 
     VkPhysicalDeviceVulkan13Features vulkan13Features{};
     vulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
     vulkan13Features.dynamicRendering = VK_TRUE;
     vulkan13Features.synchronization2 = VK_TRUE;
+
+    // Optional core features used by textures: block-compressed sampling and anisotropic filtering
+    VkPhysicalDeviceFeatures supportedFeatures{};
+    vkGetPhysicalDeviceFeatures(m_PhysicalDevice->get(), &supportedFeatures);
+    VkPhysicalDeviceFeatures enabledFeatures{};
+    enabledFeatures.textureCompressionBC = supportedFeatures.textureCompressionBC;
+    enabledFeatures.samplerAnisotropy = supportedFeatures.samplerAnisotropy;
     
 m_Device = std::unique_ptr<Device>(DeviceBuilder()
         .setPhysicalDevice(m_PhysicalDevice->get())
@@ -168,6 +196,7 @@ m_Device = std::unique_ptr<Device>(DeviceBuilder()
         .setQueueFamilyIndices(queueIndices)
         .addRequiredExtension(VK_KHR_SWAPCHAIN_EXTENSION_NAME)
         .addRequiredExtension(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME)
+        .setEnabledFeatures(enabledFeatures)
         .setVulkan12Features(vulkan12Features)
         .setVulkan13Features(vulkan13Features)
         .build());
@@ -200,6 +229,15 @@ m_Device = std::unique_ptr<Device>(DeviceBuilder()
     
 // Create Command Pool
     m_CommandPool = std::make_unique<CommandPool>(m_Device->get(), m_PhysicalDevice->getQueueFamilyIndices().graphicsFamily.value());
+    StagingRing::Settings stagingSettings;
+    stagingSettings.size = 64ull * 1024ull * 1024ull;
+    m_StagingRing = std::make_unique<StagingRing>(m_Device.get(), m_Device->getAllocator(), stagingSettings);
+    m_TransferQueue = std::make_unique<TransferQueue>(m_Device.get(), m_StagingRing.get());
+    m_UniformAllocator = std::make_unique<FrameUniformAllocator>(m_Device.get(), m_Device->getAllocator(), m_PhysicalDevice->get(),
+        MAX_FRAMES_IN_FLIGHT);
+    m_CommandRecorder = std::make_unique<ParallelCommandRecorder>(m_Device.get(),
+        m_PhysicalDevice->getQueueFamilyIndices().graphicsFamily.value(), MAX_FRAMES_IN_FLIGHT);
+    m_RenderGraph = std::make_unique<RenderGraph>(m_Device.get(), m_Device->getAllocator(), MAX_FRAMES_IN_FLIGHT);
     
 CreateCommandBuffers();
     CreateSyncObjects();
@@ -218,7 +256,7 @@ CreateCommandBuffers();
     renderPerformanceLayer->SetRendererContext(this);
     m_LayerStack->PushOverlay(renderPerformanceLayer); // Use PushOverlay to render after ImGui
     
-    std::cout << "Layer system initialized with ImGui and Render Performance layers" << std::endl;
+    CAE_LOG_DEBUG(Render, "Layer system initialized with ImGui and Render Performance layers");
 }
 
 void Renderer::CreateCommandBuffers()
@@ -330,26 +368,44 @@ void Renderer::drawFrame(float DeltaTime)
         throw std::runtime_error("failed to acquire swap chain image!");
     }
 
+// The fence has signalled, so the GPU is done with this frame's uniform region
+    m_UniformAllocator->beginFrame(m_FrameIndex, m_DrawFences[m_FrameIndex]);
 vkResetFences(m_Device->get(), 1, &m_DrawFences[m_FrameIndex]);
 
 // Update layers (this will call ImGui NewFrame)
     UpdateLayers(0.016f); // Assume 60 FPS for now
 
+    // Hand this frame's uploads to the transfer queue and recycle jobs acquired by earlier frames
+    m_TransferQueue->submit();
+    m_TransferQueue->update();
+
+    buildRenderGraph(imageIndex);
+
     vkResetCommandBuffer(m_CommandBuffers[m_FrameIndex], 0);
-    recordCommandBuffer(imageIndex);
+    recordCommandBuffer();
+
+    // The transfer wait only covers finished jobs, so it is already satisfied and never stalls the frame
+    VkSemaphore waitSemaphores[] = { m_PresentCompleteSemaphores[m_FrameIndex], m_TransferQueue->getTimelineSemaphore() };
+    VkPipelineStageFlags waitDestinationStageMasks[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT };
+    uint64_t waitValues[] = { 0, m_TransferWaitValue };
 
-    VkPipelineStageFlags waitDestinationStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    VkTimelineSemaphoreSubmitInfo timelineInfo{};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.waitSemaphoreValueCount = 2;
+    timelineInfo.pWaitSemaphoreValues = waitValues;
 
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = &m_PresentCompleteSemaphores[m_FrameIndex];
-    submitInfo.pWaitDstStageMask = &waitDestinationStageMask;
+    submitInfo.pNext = m_TransferWaitValue != 0 ? &timelineInfo : nullptr;
+    submitInfo.waitSemaphoreCount = m_TransferWaitValue != 0 ? 2 : 1;
+    submitInfo.pWaitSemaphores = waitSemaphores;
+    submitInfo.pWaitDstStageMask = waitDestinationStageMasks;
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &m_CommandBuffers[m_FrameIndex];
     submitInfo.signalSemaphoreCount = 1;
     submitInfo.pSignalSemaphores = &m_RenderFinishedSemaphores[imageIndex];
 
+    m_UniformAllocator->flush();
     if (vkQueueSubmit(m_Device->getGraphicsQueue(), 1, &submitInfo, m_DrawFences[m_FrameIndex]) != VK_SUCCESS) {
         throw std::runtime_error("failed to submit draw command buffer!");
     }
@@ -490,7 +546,35 @@ m_SwapChain = std::unique_ptr<SwapChain>(builder.build());
     CreateTimingQueries();
 }
 
-void Renderer::recordCommandBuffer(uint32_t imageIndex)
+void Renderer::buildRenderGraph(uint32_t imageIndex)
+{
+    m_RenderGraph->Reset();
+
+    // The acquire semaphore is waited on at COLOR_ATTACHMENT_OUTPUT, so the first transition chains with it
+    RenderGraphImportedImage swapChainImage;
+    swapChainImage.image = m_SwapChain->getImages()[imageIndex];
+    swapChainImage.view = m_SwapChain->getImageViews()[imageIndex];
+    swapChainImage.format = m_SwapChainFormat;
+    swapChainImage.extent = m_SwapChainExtent;
+    swapChainImage.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    swapChainImage.initialStages = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    swapChainImage.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    RenderGraphResource backBuffer = m_RenderGraph->ImportImage("SwapChain", swapChainImage);
+
+    m_RenderGraph->AddPass("Layers", [this, backBuffer](VkCommandBuffer commandBuffer)
+        {
+            recordLayers(commandBuffer, m_RenderGraph->GetImageView(backBuffer));
+        })
+        .Write(backBuffer, RenderGraphUsage::ColorAttachment);
+
+    m_RenderGraph->Compile();
+    if (m_FrameCount == 1)
+    {
+        CAE_LOG_DEBUG(Render, m_RenderGraph->DescribePlan());
+    }
+}
+
+void Renderer::recordCommandBuffer()
 {
     VkCommandBuffer commandBuffer = m_CommandBuffers[m_FrameIndex];
 
@@ -501,19 +585,34 @@ void Renderer::recordCommandBuffer(uint32_t imageIndex)
         throw std::runtime_error("failed to begin recording command buffer!");
     }
 
-// Transition the swapchain image to color attachment layout
-    transition_image_layout(imageIndex, 
-        VK_IMAGE_LAYOUT_UNDEFINED, 
-        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-        VK_ACCESS_NONE_KHR,
-        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    // Take ownership of resources whose transfer jobs have finished
+    m_TransferWaitValue = m_TransferQueue->recordAcquireBarriers(commandBuffer);
+
+// Reset and start GPU timestamp query before the render graph
+    if (!m_QueryPools.empty() && m_FrameIndex < m_QueryPools.size() && m_QueryPools[m_FrameIndex] != VK_NULL_HANDLE) {
+        vkCmdResetQueryPool(commandBuffer, m_QueryPools[m_FrameIndex], 0, 2);
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_QueryPools[m_FrameIndex], 0);
+    }
+
+    // Records the passes with their layout transitions, ending with the swapchain image in PRESENT_SRC
+    m_RenderGraph->Execute(commandBuffer);
+
+// End GPU timestamp query
+    if (!m_QueryPools.empty() && m_FrameIndex < m_QueryPools.size() && m_QueryPools[m_FrameIndex] != VK_NULL_HANDLE) {
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_QueryPools[m_FrameIndex], 1);
+    }
+
+    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to record command buffer!");
+    }
+}
 
+void Renderer::recordLayers(VkCommandBuffer commandBuffer, VkImageView target)
+{
     // Set up dynamic rendering
     VkRenderingAttachmentInfoKHR colorAttachment{};
     colorAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
-    colorAttachment.imageView = m_SwapChain->getImageViews()[imageIndex];
+    colorAttachment.imageView = target;
     colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
     colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
     colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
@@ -529,96 +628,38 @@ void Renderer::recordCommandBuffer(uint32_t imageIndex)
     renderInfo.layerCount = 1;
     renderInfo.colorAttachmentCount = 1;
     renderInfo.pColorAttachments = &colorAttachment;
-
-// Reset and start GPU timestamp query before render pass
-    if (!m_QueryPools.empty() && m_FrameIndex < m_QueryPools.size() && m_QueryPools[m_FrameIndex] != VK_NULL_HANDLE) {
-        vkCmdResetQueryPool(commandBuffer, m_QueryPools[m_FrameIndex], 0, 2);
-    }
+    // Layers record into secondary command buffers, so the primary may only execute them in here
+    renderInfo.flags = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR;
 
     this->vkCmdBeginRenderingKHR(commandBuffer, &renderInfo);
-    
-    // Start GPU timestamp query
-    if (!m_QueryPools.empty() && m_FrameIndex < m_QueryPools.size() && m_QueryPools[m_FrameIndex] != VK_NULL_HANDLE) {
-        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_QueryPools[m_FrameIndex], 0);
-    }
 
-    // Set viewport and scissor
-    VkViewport viewport{};
+    // Viewport and scissor are set at the start of every secondary command buffer
+    ParallelCommandRecorder::RenderTarget renderTarget;
+    renderTarget.colorFormats = { m_SwapChainFormat };
+
+    VkViewport& viewport = renderTarget.viewport;
     viewport.x = 0.0f;
     viewport.y = 0.0f;
     viewport.width = static_cast<float>(m_SwapChainExtent.width);
     viewport.height = static_cast<float>(m_SwapChainExtent.height);
     viewport.minDepth = 0.0f;
     viewport.maxDepth = 1.0f;
-    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
 
-    VkRect2D scissor{};
-    scissor.offset = {0, 0};
-    scissor.extent = m_SwapChainExtent;
-    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+    renderTarget.scissor.offset = {0, 0};
+    renderTarget.scissor.extent = m_SwapChainExtent;
 
-// Render all layers
+// Record all layers; their buffers are executed in layer stack order whichever thread recorded them
+    m_CommandRecorder->beginFrame(m_FrameIndex, renderTarget);
     for (auto layer : *m_LayerStack)
     {
         if (layer->IsEnabled())
         {
-            layer->OnRender(commandBuffer);
+            layer->OnRecord(*m_CommandRecorder);
         }
     }
-    
-// End GPU timestamp query
-    if (!m_QueryPools.empty() && m_FrameIndex < m_QueryPools.size() && m_QueryPools[m_FrameIndex] != VK_NULL_HANDLE) {
-        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_QueryPools[m_FrameIndex], 1);
-    }
+    m_CommandRecorder->execute(commandBuffer);
 
 this->vkCmdEndRenderingKHR(commandBuffer);
-
-    // Transition the swapchain image to present layout
-    transition_image_layout(imageIndex,
-        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-        VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
-        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-        VK_ACCESS_NONE_KHR,
-        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
-
-    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
-        throw std::runtime_error("failed to record command buffer!");
-    }
-}
-
-void Renderer::transition_image_layout(
-    uint32_t imageIndex,
-    VkImageLayout old_layout,
-    VkImageLayout new_layout,
-    VkAccessFlags src_access_mask,
-    VkAccessFlags dst_access_mask,
-    VkPipelineStageFlags src_stage_mask,
-    VkPipelineStageFlags dst_stage_mask)
-{
-    VkImageMemoryBarrier barrier{};
-    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.oldLayout = old_layout;
-    barrier.newLayout = new_layout;
-    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image = m_SwapChain->getImages()[imageIndex];
-    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrier.subresourceRange.baseMipLevel = 0;
-    barrier.subresourceRange.levelCount = 1;
-    barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount = 1;
-    barrier.srcAccessMask = src_access_mask;
-    barrier.dstAccessMask = dst_access_mask;
-
-    vkCmdPipelineBarrier(
-        m_CommandBuffers[m_FrameIndex],
-        src_stage_mask, dst_stage_mask,
-        0,
-        0, nullptr,
-        0, nullptr,
-        1, &barrier
-    );
 }
 
 std::vector<const char*> Renderer::getRequiredExtensions() {
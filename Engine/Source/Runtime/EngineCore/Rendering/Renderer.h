@@ -4,14 +4,19 @@
 
 #include "Runtime/EngineCore/Window.h"
 #include "Runtime/EngineCore/Layer/LayerStack.h"
+#include "Runtime/EngineCore/Rendering/RenderGraph.h"
 #include "Runtime/EngineCore/RHI/CommandPool.h"
 #include "Runtime/EngineCore/RHI/Device.h"
+#include "Runtime/EngineCore/RHI/FrameUniformAllocator.h"
 #include "Runtime/EngineCore/RHI/Instance.h"
 #include "Runtime/EngineCore/RHI/IRHIContext.h"
+#include "Runtime/EngineCore/RHI/ParallelCommandRecorder.h"
 #include "Runtime/EngineCore/RHI/PhysicalDevice.h"
 #include "Runtime/EngineCore/RHI/RenderPass.h"
+#include "Runtime/EngineCore/RHI/StagingRing.h"
 #include "Runtime/EngineCore/RHI/Surface.h"
 #include "Runtime/EngineCore/RHI/SwapChain.h"
+#include "Runtime/EngineCore/RHI/TransferQueue.h"
 
 class Renderer : public IRHIContext
 {
@@ -42,6 +47,14 @@ public:
     Surface* GetSurface() const { return m_Surface.get(); }
     SwapChain* GetSwapChain() const { return m_SwapChain.get(); }
     RenderPass* GetRenderPass() const { return m_RenderPass.get(); }
+    // Asynchronous uploads (Model, GeometryPool, TextureCache); jobs are submitted and acquired by the renderer every frame
+    TransferQueue* GetTransferQueue() const { return m_TransferQueue.get(); }
+    // Per-frame uniform data bound with dynamic offsets; rewound by the renderer at the start of each frame
+    FrameUniformAllocator* GetUniformAllocator() const { return m_UniformAllocator.get(); }
+    // Records the layers into secondary command buffers on worker threads
+    ParallelCommandRecorder* GetCommandRecorder() const { return m_CommandRecorder.get(); }
+    // Rebuilt by the renderer every frame
+    RenderGraph* GetRenderGraph() const { return m_RenderGraph.get(); }
     Window* GetWindow() const;
     uint32_t GetQueueFamilyIndex() const { return m_QueueIndex; }
 
@@ -59,10 +72,10 @@ void CreateCommandBuffers();
     void drawFrame(float DeltaTime);
     void CleanupSwapChainResources();
     void RecreateSwapChain();
-    void recordCommandBuffer(uint32_t imageIndex);
-void transition_image_layout(uint32_t imageIndex, VkImageLayout old_layout, VkImageLayout new_layout,
-        VkAccessFlags src_access_mask, VkAccessFlags dst_access_mask,
-        VkPipelineStageFlags src_stage_mask, VkPipelineStageFlags dst_stage_mask);
+    // Declares the frame's images and passes; layout transitions are planned by the graph
+    void buildRenderGraph(uint32_t imageIndex);
+    void recordCommandBuffer();
+    void recordLayers(VkCommandBuffer commandBuffer, VkImageView target);
     
 
     // Helper functions
@@ -79,6 +92,11 @@ void transition_image_layout(uint32_t imageIndex, VkImageLayout old_layout, VkIm
     std::unique_ptr<SwapChain> m_SwapChain;
 std::unique_ptr<RenderPass> m_RenderPass; // Kept for compatibility but not used with dynamic rendering
     std::unique_ptr<CommandPool> m_CommandPool;
+    std::unique_ptr<StagingRing> m_StagingRing; // Staging for m_TransferQueue, the only user allocating from it
+    std::unique_ptr<TransferQueue> m_TransferQueue;
+    std::unique_ptr<FrameUniformAllocator> m_UniformAllocator;
+    std::unique_ptr<ParallelCommandRecorder> m_CommandRecorder;
+    std::unique_ptr<RenderGraph> m_RenderGraph;
     
 
     
@@ -94,6 +112,7 @@ std::unique_ptr<RenderPass> m_RenderPass; // Kept for compatibility but not used
 // State
     uint32_t m_QueueIndex = ~0;
     uint32_t m_FrameIndex = 0;
+    uint64_t m_TransferWaitValue = 0; // Transfer timeline value the current frame's submission waits for
     VkExtent2D m_SwapChainExtent;
     VkFormat m_SwapChainFormat;
     
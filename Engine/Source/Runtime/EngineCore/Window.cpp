@@ -1,4 +1,5 @@
 #include "Window.h"
+#include "Runtime/EngineCore/Core/Log.h"
 
 Window::Window(const char *title, int width, int height) : backgroundColor(glm::vec4(0, 0, 0, 1))
 {
@@ -42,7 +43,7 @@ bool Window::init()
     if(!m_Window)
     {
         glfwTerminate();
-        std::cerr << "ERROR::GLFW::Could not initialise GLFW Window" << '\n';
+        CAE_LOG_ERROR(Core, "ERROR::GLFW::Could not initialise GLFW Window");
         return false;
     }
     glfwSetWindowUserPointer(m_Window, this);
@@ -136,7 +137,7 @@ void Window::Update() const
 
 void glfw_initialisation_error(int error, const char* description)
 {
-    std::cerr << "ERROR::GLFW::" << error << "::DESCRIPTION::" << description << std::endl;
+    CAE_LOG_ERROR(Core, "ERROR::GLFW::" << error << "::DESCRIPTION::" << description);
 }
 
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
@@ -151,7 +152,7 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
     // Window closing
     if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
     {
-        std::cout << "Escape Key Pressed..." << "Quiting..." <<'\n';
+        CAE_LOG_INFO(Core, "Escape Key Pressed..." << "Quiting...");
         glfwSetWindowShouldClose(window, GLFW_TRUE);
     }
 }
@@ -49,14 +49,19 @@ defines
 			"CAE_PLATFORM_WINDOWS"
 		}
 
+	-- Core/Log.h picks the compiled-in log level from these, so they must match the Game project's
 	filter "configurations:Debug"
+		defines { "CAE_DEBUG" }
 		runtime "Debug"
 		symbols "on"
 
 	filter "configurations:Release"
+		defines { "CAE_RELEASE" }
 		runtime "Release"
 		optimize "on"
 
-	filter "configurations:Distribution"
+	filter "configurations:Dist"
+		defines { "CAE_DIST" }
 		runtime "Release"
-		optimize "off"
\ No newline at end of file
+		optimize "on"
+		symbols "off"
\ No newline at end of file